@@ -0,0 +1,187 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Text;
+using Microsoft.Build.Framework;
+using Microsoft.Build.Utilities;
+
+/// <summary>
+/// MSBuild task that compiles the Unicode data files under eng/unicode/&lt;version&gt;/
+/// into the two-level lookup table used by <c>Hex1b.Terminal.DisplayWidth</c>.
+///
+/// Every code point resolves to a single byte of flags:
+///   bits 0-1: display width (0, 1 or 2)
+///   bit 2:    Emoji_Presentation
+///
+/// The code point space is split into 256-entry blocks. Stage1 maps
+/// <c>codePoint &gt;&gt; 8</c> to a block number and Stage2 holds the de-duplicated
+/// blocks back to back, so a lookup is <c>Stage2[(Stage1[cp &gt;&gt; 8] &lt;&lt; 8) | (cp &amp; 0xFF)]</c>.
+/// Block 0 (Latin-1) is always emitted first so it can be indexed directly.
+/// </summary>
+public class GenerateDisplayWidthTables : Task
+{
+    private const int CodePointCount = 0x110000;
+    private const int BlockSize = 256;
+
+    private const byte WidthMask = 0b011;
+    private const byte EmojiPresentationFlag = 0b100;
+
+    /// <summary>Unicode version the data files belong to, e.g. "14.0.0".</summary>
+    [Required]
+    public string UnicodeVersion { get; set; } = "";
+
+    /// <summary>Directory containing EastAsianWidth.txt, emoji-data.txt and DerivedGeneralCategory.txt.</summary>
+    [Required]
+    public string DataDirectory { get; set; } = "";
+
+    /// <summary>Terminal-specific width overrides applied last.</summary>
+    [Required]
+    public string OverridesFile { get; set; } = "";
+
+    /// <summary>Path of the generated C# file.</summary>
+    [Required]
+    public string OutputFile { get; set; } = "";
+
+    public override bool Execute()
+    {
+        var properties = new byte[CodePointCount];
+        SetWidth(properties, 0, CodePointCount - 1, 1);
+
+        // East Asian Wide and Fullwidth characters occupy two cells.
+        foreach (var (start, end, value) in ReadRanges(Path.Combine(DataDirectory, "EastAsianWidth.txt")))
+        {
+            if (value == "W" || value == "F")
+                SetWidth(properties, start, end, 2);
+        }
+
+        // Emoji that default to emoji presentation are wide and flagged so that
+        // whole emoji clusters (ZWJ sequences, flags) can be measured as two cells.
+        foreach (var (start, end, value) in ReadRanges(Path.Combine(DataDirectory, "emoji-data.txt")))
+        {
+            if (value != "Emoji_Presentation")
+                continue;
+
+            for (var cp = start; cp <= end; cp++)
+                properties[cp] = 2 | EmojiPresentationFlag;
+        }
+
+        // Controls, format characters and non-spacing/enclosing marks take no cells.
+        foreach (var (start, end, value) in ReadRanges(Path.Combine(DataDirectory, "DerivedGeneralCategory.txt")))
+        {
+            if (value == "Cc" || value == "Cf" || value == "Mn" || value == "Me")
+                SetWidth(properties, start, end, 0);
+        }
+
+        foreach (var (start, end, value) in ReadRanges(OverridesFile))
+        {
+            if (!byte.TryParse(value, NumberStyles.None, CultureInfo.InvariantCulture, out var width) || width > 2)
+            {
+                Log.LogError($"{OverridesFile}: invalid width '{value}' for {start:X4}..{end:X4}.");
+                return false;
+            }
+            SetWidth(properties, start, end, width);
+        }
+
+        var (stage1, stage2) = BuildStages(properties);
+        if (stage2.Count / BlockSize > byte.MaxValue + 1)
+        {
+            Log.LogError($"Unicode {UnicodeVersion} produced {stage2.Count / BlockSize} distinct blocks; Stage1 entries no longer fit in a byte.");
+            return false;
+        }
+
+        Directory.CreateDirectory(Path.GetDirectoryName(OutputFile)!);
+        File.WriteAllText(OutputFile, Emit(stage1, stage2));
+        return !Log.HasLoggedErrors;
+    }
+
+    private static void SetWidth(byte[] properties, int start, int end, byte width)
+    {
+        for (var cp = start; cp <= end; cp++)
+            properties[cp] = (byte)((properties[cp] & ~WidthMask) | width);
+    }
+
+    private static (byte[] Stage1, List<byte> Stage2) BuildStages(byte[] properties)
+    {
+        var stage1 = new byte[CodePointCount / BlockSize];
+        var stage2 = new List<byte>();
+        var blocks = new Dictionary<string, int>();
+
+        for (var block = 0; block < stage1.Length; block++)
+        {
+            var segment = new ArraySegment<byte>(properties, block * BlockSize, BlockSize);
+            var key = Convert.ToBase64String(segment.Array!, segment.Offset, segment.Count);
+            if (!blocks.TryGetValue(key, out var index))
+            {
+                index = blocks.Count;
+                blocks.Add(key, index);
+                stage2.AddRange(segment);
+            }
+            stage1[block] = (byte)index;
+        }
+
+        return (stage1, stage2);
+    }
+
+    private static IEnumerable<(int Start, int End, string Value)> ReadRanges(string path)
+    {
+        foreach (var rawLine in File.ReadLines(path))
+        {
+            var line = rawLine;
+            var comment = line.IndexOf('#');
+            if (comment >= 0)
+                line = line.Substring(0, comment);
+
+            var fields = line.Split(';');
+            if (fields.Length < 2)
+                continue;
+
+            var range = fields[0].Trim();
+            var separator = range.IndexOf("..", StringComparison.Ordinal);
+            var start = int.Parse(separator < 0 ? range : range.Substring(0, separator), NumberStyles.HexNumber, CultureInfo.InvariantCulture);
+            var end = separator < 0 ? start : int.Parse(range.Substring(separator + 2), NumberStyles.HexNumber, CultureInfo.InvariantCulture);
+
+            yield return (start, end, fields[1].Trim());
+        }
+    }
+
+    private string Emit(byte[] stage1, List<byte> stage2)
+    {
+        var sb = new StringBuilder();
+        sb.AppendLine("// <auto-generated>");
+        sb.AppendLine($"// Generated by eng/unicode/GenerateDisplayWidthTables.cs from Unicode {UnicodeVersion} data.");
+        sb.AppendLine("// Do not edit; change the data files or the generator instead.");
+        sb.AppendLine("// </auto-generated>");
+        sb.AppendLine();
+        sb.AppendLine("namespace Hex1b.Terminal;");
+        sb.AppendLine();
+        sb.AppendLine("public static partial class DisplayWidth");
+        sb.AppendLine("{");
+        sb.AppendLine("    /// <summary>");
+        sb.AppendLine("    /// The Unicode version the display width tables were generated from.");
+        sb.AppendLine("    /// </summary>");
+        sb.AppendLine($"    public const string UnicodeVersion = \"{UnicodeVersion}\";");
+        sb.AppendLine();
+        AppendTable(sb, "Stage1", stage1);
+        sb.AppendLine();
+        AppendTable(sb, "Stage2", stage2);
+        sb.AppendLine("}");
+        return sb.ToString();
+    }
+
+    private static void AppendTable(StringBuilder sb, string name, IReadOnlyList<byte> values)
+    {
+        sb.AppendLine($"    private static ReadOnlySpan<byte> {name} => new byte[{values.Count}]");
+        sb.AppendLine("    {");
+        for (var i = 0; i < values.Count; i += 32)
+        {
+            sb.Append("        ");
+            for (var j = i; j < Math.Min(i + 32, values.Count); j++)
+            {
+                sb.Append("0x").Append(values[j].ToString("X2", CultureInfo.InvariantCulture)).Append(',');
+            }
+            sb.AppendLine();
+        }
+        sb.AppendLine("    };");
+    }
+}
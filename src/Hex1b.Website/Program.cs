@@ -106,6 +106,9 @@ builder.Services.AddSingleton<IGalleryExample, ScrollInfiniteExample>();
 // Register Align widget documentation examples
 builder.Services.AddSingleton<IGalleryExample, AlignDemoExample>();
 
+// All example connections render on one shared set of workers
+builder.Services.AddSingleton(_ => new Hex1bSessionHost(new Hex1bSessionHostOptions { MaxFramesPerSecond = 30 }));
+
 var app = builder.Build();
 
 // Enable WebSockets
@@ -207,7 +210,9 @@ app.Map("/examples/{exampleId}", async (HttpContext context, string exampleId, I
         return;
     }
 
-    using var webSocket = await context.WebSockets.AcceptWebSocketAsync();
+    // Clients that request the binary protocol get it; others keep the text protocol
+    var subProtocol = WebSocketPresentationOptions.NegotiateSubProtocol(context.WebSockets.WebSocketRequestedProtocols);
+    using var webSocket = await context.WebSockets.AcceptWebSocketAsync(subProtocol);
 
     // Handle Hex1b-based example
     await HandleHex1bExampleAsync(webSocket, example, context.RequestAborted);
@@ -231,7 +236,9 @@ app.Map("/apps/{exampleId}", async (HttpContext context, string exampleId, IEnum
         return;
     }
 
-    using var webSocket = await context.WebSockets.AcceptWebSocketAsync();
+    // Clients that request the binary protocol get it; others keep the text protocol
+    var subProtocol = WebSocketPresentationOptions.NegotiateSubProtocol(context.WebSockets.WebSocketRequestedProtocols);
+    using var webSocket = await context.WebSockets.AcceptWebSocketAsync(subProtocol);
 
     // Handle Hex1b-based example
     await HandleHex1bExampleAsync(webSocket, example, context.RequestAborted);
@@ -248,22 +255,13 @@ async Task HandleHex1bExampleAsync(WebSocket webSocket, IGalleryExample example,
     using var cts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
     
     // Create the presentation adapter for WebSocket I/O
-    await using var presentation = new WebSocketPresentationAdapter(webSocket, 80, 24, enableMouse: example.EnableMouse);
-    
-    // Create the workload adapter that Hex1bApp will use
-    var workload = new Hex1bAppWorkloadAdapter(presentation.Capabilities);
-    
-    // Create terminal options with render optimization filter for delta encoding
-    var terminalOptions = new Hex1bTerminalOptions
-    {
-        PresentationAdapter = presentation,
-        WorkloadAdapter = workload
-    };
-    terminalOptions.AddHex1bAppRenderOptimization();
+    var presentation = new WebSocketPresentationAdapter(webSocket, 80, 24, enableMouse: example.EnableMouse);
     
-    // Create the terminal that bridges presentation ↔ workload
-    // Terminal auto-starts I/O pumps when presentation is provided
-    using var terminal = new Hex1bTerminal(terminalOptions);
+    // The session owns the terminal bridging presentation ↔ workload, with render
+    // optimization for delta encoding, and disposes the presentation with it
+    var sessionHost = app.Services.GetRequiredService<Hex1bSessionHost>();
+    await using var session = sessionHost.CreateSession(presentation);
+    var workload = session.Workload;
     
     // Check if the example manages its own app lifecycle
     var runTask = example.RunAsync(workload, cts.Token);
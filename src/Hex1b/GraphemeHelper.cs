@@ -1,4 +1,3 @@
-using System.Globalization;
 using Hex1b.Terminal;
 
 namespace Hex1b;
@@ -12,6 +11,8 @@ namespace Hex1b;
 /// This class provides methods to navigate text by grapheme cluster boundaries,
 /// ensuring operations like delete, cursor movement, and selection work correctly
 /// with emojis, combining characters, and other complex Unicode sequences.
+/// Segmentation is done with <see cref="DisplayWidth.EnumerateGraphemes(ReadOnlySpan{char})"/>,
+/// so none of the navigation methods allocate.
 /// </summary>
 public static class GraphemeHelper
 {
@@ -30,17 +31,13 @@ public static class GraphemeHelper
         if (index > text.Length)
             index = text.Length;
 
-        // Find all cluster boundaries
-        var boundaries = GetClusterBoundaries(text);
-        
-        // Find the largest boundary that is less than index
+        // Find the start of the last cluster that begins before index
         int result = 0;
-        foreach (var boundary in boundaries)
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes(text))
         {
-            if (boundary < index)
-                result = boundary;
-            else
+            if (cluster.Start >= index)
                 break;
+            result = cluster.Start;
         }
         return result;
     }
@@ -60,14 +57,11 @@ public static class GraphemeHelper
         if (index < 0)
             index = 0;
 
-        // Find all cluster boundaries
-        var boundaries = GetClusterBoundaries(text);
-        
-        // Find the smallest boundary that is greater than index
-        foreach (var boundary in boundaries)
+        // Find the end of the first cluster that ends after index
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes(text))
         {
-            if (boundary > index)
-                return boundary;
+            if (cluster.End > index)
+                return cluster.End;
         }
         return text.Length;
     }
@@ -83,12 +77,9 @@ public static class GraphemeHelper
         if (string.IsNullOrEmpty(text))
             return boundaries;
 
-        var enumerator = StringInfo.GetTextElementEnumerator(text);
-        while (enumerator.MoveNext())
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes(text))
         {
-            var clusterStart = enumerator.ElementIndex;
-            var cluster = (string)enumerator.Current;
-            boundaries.Add(clusterStart + cluster.Length);
+            boundaries.Add(cluster.End);
         }
         
         return boundaries;
@@ -110,14 +101,13 @@ public static class GraphemeHelper
         if (index >= text.Length)
             return text.Length;
 
-        var boundaries = GetClusterBoundaries(text);
-        
-        // If already at a boundary, return as-is
-        if (boundaries.Contains(index))
-            return index;
-
-        // Otherwise, snap to the previous boundary (start of containing cluster)
-        return GetPreviousClusterBoundary(text, index);
+        // Snap to the start of the containing cluster (a no-op if already at a boundary)
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes(text))
+        {
+            if (cluster.End > index)
+                return cluster.Start;
+        }
+        return text.Length;
     }
 
     /// <summary>
@@ -151,8 +141,12 @@ public static class GraphemeHelper
         if (string.IsNullOrEmpty(text))
             return 0;
 
-        var info = new StringInfo(text);
-        return info.LengthInTextElements;
+        int count = 0;
+        foreach (var _ in DisplayWidth.EnumerateGraphemes(text))
+        {
+            count++;
+        }
+        return count;
     }
 
     /// <summary>
@@ -184,14 +178,12 @@ public static class GraphemeHelper
 
         // Sum the display widths of all graphemes before this index
         int column = 0;
-        var enumerator = StringInfo.GetTextElementEnumerator(text);
-        while (enumerator.MoveNext())
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes(text))
         {
-            if (enumerator.ElementIndex >= index)
+            if (cluster.Start >= index)
                 break;
             
-            var grapheme = (string)enumerator.Current;
-            column += DisplayWidth.GetGraphemeWidth(grapheme);
+            column += cluster.Width;
         }
         
         return column;
@@ -207,24 +199,20 @@ public static class GraphemeHelper
             return 0;
 
         int currentColumn = 0;
-        var enumerator = StringInfo.GetTextElementEnumerator(text);
-        while (enumerator.MoveNext())
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes(text))
         {
-            var grapheme = (string)enumerator.Current;
-            var width = DisplayWidth.GetGraphemeWidth(grapheme);
-            
-            if (currentColumn + width > column)
+            if (currentColumn + cluster.Width > column)
             {
                 // This grapheme spans the target column
-                return enumerator.ElementIndex;
+                return cluster.Start;
             }
             
-            currentColumn += width;
+            currentColumn += cluster.Width;
             
             if (currentColumn >= column)
             {
                 // Reached or passed the target column
-                return enumerator.ElementIndex + grapheme.Length;
+                return cluster.End;
             }
         }
         
@@ -102,10 +102,11 @@ public class Hex1bApp : IDisposable, IAsyncDisposable
     // Default CTRL-C binding option
     private readonly bool _enableDefaultCtrlCExit;
     
-    // Input coalescing options
+    // Input coalescing option
     private readonly bool _enableInputCoalescing;
-    private readonly int _inputCoalescingInitialDelayMs;
-    private readonly int _inputCoalescingMaxDelayMs;
+    
+    // Set when the app runs as a session of a Hex1bSessionHost
+    private readonly IHex1bAppFrameScheduler? _frameScheduler;
 
     /// <summary>
     /// Creates a Hex1bApp with an async widget builder.
@@ -152,10 +153,10 @@ public class Hex1bApp : IDisposable, IAsyncDisposable
         // Default CTRL-C binding option
         _enableDefaultCtrlCExit = options.EnableDefaultCtrlCExit;
         
-        // Input coalescing options
+        // Input coalescing option
         _enableInputCoalescing = options.EnableInputCoalescing;
-        _inputCoalescingInitialDelayMs = options.InputCoalescingInitialDelayMs;
-        _inputCoalescingMaxDelayMs = options.InputCoalescingMaxDelayMs;
+        
+        _frameScheduler = (_adapter as Hex1bAppWorkloadAdapter)?.FrameScheduler;
     }
 
     /// <summary>
@@ -251,7 +252,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable
         try
         {
             // Initial render
-            await RenderFrameAsync(cancellationToken);
+            await RenderScheduledFrameAsync(cancellationToken);
 
             // React to input events and invalidation signals
             while (!cancellationToken.IsCancellationRequested && !_stopRequested)
@@ -264,36 +265,23 @@ public class Hex1bApp : IDisposable, IAsyncDisposable
                 
                 if (completedTask == inputTask)
                 {
-                    // Process the first input event
                     var inputEvent = await inputTask;
-                    await ProcessInputEventAsync(inputEvent, cancellationToken);
                     
-                    // Input coalescing: batch rapid inputs together before rendering
-                    // This prevents back pressure from rapid input (key repeats, mouse moves)
+                    // Input coalescing: handle everything already queued before rendering,
+                    // so rapid input (key repeats, mouse moves) doesn't cost a frame per event
                     if (_enableInputCoalescing)
                     {
-                        // Adaptive delay: scales based on output queue depth
-                        var outputBacklog = _adapter.OutputQueueDepth;
-                        var coalescingDelayMs = Math.Min(
-                            _inputCoalescingInitialDelayMs + (outputBacklog * 10), 
-                            _inputCoalescingMaxDelayMs);
-                        await Task.Delay(coalescingDelayMs, cancellationToken);
-                    
-                        // Drain any pending input that arrived during the delay
-                        while (_adapter.InputEvents.TryRead(out var pendingEvent))
-                        {
-                            await ProcessInputEventAsync(pendingEvent, cancellationToken);
-                            
-                            // Check for stop request between events
-                            if (_stopRequested || cancellationToken.IsCancellationRequested)
-                                break;
-                        }
+                        await ProcessQueuedInputAsync(inputEvent, cancellationToken);
+                    }
+                    else
+                    {
+                        await ProcessInputEventAsync(inputEvent, cancellationToken);
                     }
                 }
                 // If invalidateTask completed, we just need to re-render (no input to handle)
 
                 // Re-render after handling ALL input or invalidation (state may have changed)
-                await RenderFrameAsync(cancellationToken);
+                await RenderScheduledFrameAsync(cancellationToken);
             }
         }
         catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested)
@@ -311,6 +299,58 @@ public class Hex1bApp : IDisposable, IAsyncDisposable
         }
     }
 
+    /// <summary>
+    /// Processes <paramref name="firstEvent"/> and the input events already queued behind it,
+    /// without waiting for more. Mouse motion and wheel ticks that arrived in separate reads
+    /// are merged here the way the input decoder merges them within a read; every other event
+    /// is processed in order.
+    /// </summary>
+    private async Task ProcessQueuedInputAsync(Hex1bEvent firstEvent, CancellationToken cancellationToken)
+    {
+        Hex1bMouseEvent? pendingMouse = null;
+        Hex1bEvent? inputEvent = firstEvent;
+
+        while (inputEvent != null)
+        {
+            if (inputEvent is Hex1bMouseEvent mouseEvent)
+            {
+                if (pendingMouse != null && Hex1bMouseEvent.TryCoalesce(pendingMouse, mouseEvent, out var merged))
+                {
+                    pendingMouse = merged;
+                }
+                else
+                {
+                    if (pendingMouse != null)
+                    {
+                        await ProcessInputEventAsync(pendingMouse, cancellationToken);
+                    }
+                    pendingMouse = mouseEvent;
+                }
+            }
+            else
+            {
+                // Anything else ends the run of mouse events, which is handled first
+                if (pendingMouse != null)
+                {
+                    await ProcessInputEventAsync(pendingMouse, cancellationToken);
+                    pendingMouse = null;
+                }
+                await ProcessInputEventAsync(inputEvent, cancellationToken);
+            }
+
+            // Check for stop request between events
+            if (_stopRequested || cancellationToken.IsCancellationRequested)
+                break;
+
+            inputEvent = _adapter.InputEvents.TryRead(out var nextEvent) ? nextEvent : null;
+        }
+
+        if (pendingMouse != null)
+        {
+            await ProcessInputEventAsync(pendingMouse, cancellationToken);
+        }
+    }
+
     /// <summary>
     /// Processes a single input event (key, mouse, resize, etc.).
     /// </summary>
@@ -339,6 +379,11 @@ public class Hex1bApp : IDisposable, IAsyncDisposable
                 await InputRouter.RouteInputAsync(_rootNode, keyEvent, _focusRing, _inputRouterState, RequestStop, cancellationToken, CopyToClipboard);
                 break;
             
+            // Pastes go to the focused node as one block of text
+            case Hex1bPasteEvent pasteEvent when _rootNode != null:
+                await InputRouter.RoutePasteAsync(_rootNode, pasteEvent, _focusRing, _inputRouterState, RequestStop, cancellationToken, CopyToClipboard);
+                break;
+            
             // Mouse events: update cursor position and handle clicks/drags
             case Hex1bMouseEvent mouseEvent:
                 _mouseX = mouseEvent.X;
@@ -375,6 +420,34 @@ public class Hex1bApp : IDisposable, IAsyncDisposable
         }
     }
 
+    /// <summary>
+    /// Renders a frame once the frame scheduler, if any, allows it.
+    /// </summary>
+    private async Task RenderScheduledFrameAsync(CancellationToken cancellationToken)
+    {
+        if (_frameScheduler == null)
+        {
+            await RenderFrameAsync(cancellationToken);
+            return;
+        }
+
+        if (await _frameScheduler.BeginFrameAsync(cancellationToken))
+        {
+            // The session was parked and its render state released - redraw everything
+            _rootNode?.MarkDirty();
+            _isFirstFrame = true;
+        }
+
+        try
+        {
+            await RenderFrameAsync(cancellationToken);
+        }
+        finally
+        {
+            _frameScheduler.EndFrame();
+        }
+    }
+
     private async Task RenderFrameAsync(CancellationToken cancellationToken)
     {
         // Update theme if we have a dynamic theme provider
@@ -484,6 +557,10 @@ public class Hex1bApp : IDisposable, IAsyncDisposable
         {
             RenderTree(_rootNode);
         }
+
+        // Step 8.5: Kitty images stay on screen until deleted, so take down the placements
+        // of image nodes that reconciliation dropped
+        _context.DeleteDetachedKittyPlacements(_rootNode);
         
         // Step 9: End frame buffering - Hex1bAppRenderOptimizationFilter will now emit only
         // the net changes (e.g., clear + re-render same content = no output)
@@ -558,13 +635,11 @@ public class Hex1bApp : IDisposable, IAsyncDisposable
             if (layoutForChild != null)
             {
                 // Set up clipping context for this child
-                var previousLayout = _context.CurrentLayoutProvider;
-                layoutForChild.ParentLayoutProvider = previousLayout;
-                _context.CurrentLayoutProvider = layoutForChild;
+                _context.PushLayoutProvider(layoutForChild);
                 
                 RenderTree(child, effectiveTheme);
                 
-                _context.CurrentLayoutProvider = previousLayout;
+                _context.PopLayoutProvider();
             }
             else
             {
@@ -822,7 +897,7 @@ public class Hex1bApp : IDisposable, IAsyncDisposable
         var localY = mouseEvent.Y - hitNode.Bounds.Y;
         
         // Create action context for mouse bindings (includes mouse coordinates)
-        var actionContext = new InputBindingActionContext(_focusRing, RequestStop, cancellationToken, mouseEvent.X, mouseEvent.Y, CopyToClipboard);
+        var actionContext = new InputBindingActionContext(_focusRing, RequestStop, cancellationToken, mouseEvent.X, mouseEvent.Y, CopyToClipboard, mouseEvent.ScrollTicks);
         
         // Check if the node has a drag binding for this event (checked first)
         var builder = hitNode.BuildBindings();
@@ -70,26 +70,24 @@ public class Hex1bAppOptions
     public bool EnableDefaultCtrlCExit { get; set; } = true;
     
     /// <summary>
-    /// Whether to enable input coalescing. When enabled, multiple rapid inputs are
-    /// batched together before rendering, improving performance under back pressure.
+    /// Whether to enable input coalescing. When enabled, all input already queued is handled
+    /// before the next frame is rendered, with consecutive mouse motion merged into its latest
+    /// position and consecutive wheel ticks summed into one scroll. Key events are never merged
+    /// or reordered.
     /// Disable for testing to ensure each input triggers a separate frame.
     /// Default is true.
     /// </summary>
     public bool EnableInputCoalescing { get; set; } = true;
     
     /// <summary>
-    /// Initial delay in milliseconds for input coalescing. After processing an input,
-    /// the app waits this long to allow additional inputs to arrive before rendering.
-    /// Only applies when <see cref="EnableInputCoalescing"/> is true.
-    /// Default is 5ms.
+    /// No longer used: coalescing no longer waits for more input before rendering.
     /// </summary>
+    [Obsolete("Input coalescing no longer delays rendering; queued events are merged instead. This value is ignored.")]
     public int InputCoalescingInitialDelayMs { get; set; } = 5;
     
     /// <summary>
-    /// Maximum delay in milliseconds for input coalescing. The delay adaptively scales
-    /// based on output queue depth but will not exceed this value.
-    /// Only applies when <see cref="EnableInputCoalescing"/> is true.
-    /// Default is 100ms.
+    /// No longer used: coalescing no longer waits for more input before rendering.
     /// </summary>
+    [Obsolete("Input coalescing no longer delays rendering; queued events are merged instead. This value is ignored.")]
     public int InputCoalescingMaxDelayMs { get; set; } = 100;
 }
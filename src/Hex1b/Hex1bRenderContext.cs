@@ -1,3 +1,6 @@
+#pragma warning disable HEX1B_IMAGES // Image API is experimental - internal usage is allowed
+
+using System.Text;
 using Hex1b.Layout;
 using Hex1b.Nodes;
 using Hex1b.Terminal;
@@ -8,6 +11,13 @@ namespace Hex1b;
 public class Hex1bRenderContext
 {
     private readonly IHex1bAppTerminalWorkloadAdapter _adapter;
+    private readonly StringBuilder _runBuilder = new();
+
+    // Image nodes with a kitty placement on screen. Text doesn't cover placements, so a node
+    // that leaves the tree has to delete its own; see DeleteDetachedKittyPlacements.
+    private readonly HashSet<ImageNode> _kittyPlacements = new();
+    private readonly HashSet<Hex1bNode> _attachedNodes = new();
+    private readonly Stack<Hex1bNode> _nodeWalk = new();
 
     public Hex1bRenderContext(IHex1bAppTerminalWorkloadAdapter adapter, Hex1bTheme? theme = null)
     {
@@ -30,10 +40,132 @@ public class Hex1bRenderContext
     /// <summary>
     /// The current layout provider in scope. Child nodes can use this to query
     /// whether characters should be rendered (for clipping support).
-    /// Layout providers should consult their ParentLayoutProvider to ensure
-    /// proper nested clipping.
     /// </summary>
-    public ILayoutProvider? CurrentLayoutProvider { get; set; }
+    /// <remarks>
+    /// Containers should scope their children with <see cref="PushLayoutProvider"/> and
+    /// <see cref="PopLayoutProvider"/>, which resolve each provider's effective clip rect once.
+    /// Assigning this property replaces the whole clip stack with the given provider, resolving
+    /// its clip rect from its <see cref="ILayoutProvider.ParentLayoutProvider"/> chain.
+    /// </remarks>
+    public ILayoutProvider? CurrentLayoutProvider
+    {
+        get => _clipStack.Count > 0 ? _clipStack[^1].Provider : null;
+        set
+        {
+            _clipStack.Clear();
+            if (value != null)
+            {
+                _clipStack.Add(new ClipScope(
+                    value,
+                    value.ParentLayoutProvider,
+                    LayoutProviderHelper.GetEffectiveClipRect(value),
+                    LayoutProviderHelper.IsUnclipped(value)));
+            }
+        }
+    }
+    
+    /// <summary>
+    /// A layout provider on the clip stack along with its resolved clip.
+    /// </summary>
+    /// <param name="Provider">The layout provider.</param>
+    /// <param name="PreviousParent">The provider's parent before it was pushed, restored on pop.</param>
+    /// <param name="EffectiveClipRect">The provider's clip rect intersected with every ancestor's.</param>
+    /// <param name="IsUnclipped">Whether content in this scope is drawn without clipping.</param>
+    private readonly record struct ClipScope(
+        ILayoutProvider Provider,
+        ILayoutProvider? PreviousParent,
+        Rect EffectiveClipRect,
+        bool IsUnclipped);
+    
+    private readonly List<ClipScope> _clipStack = new();
+    
+    /// <summary>
+    /// Makes <paramref name="provider"/> the current layout provider, parented to the previous one.
+    /// Its effective clip rect is intersected with the parent's cached rect here, so clipping
+    /// inside the scope is a single rect test regardless of nesting depth.
+    /// Every call must be balanced by <see cref="PopLayoutProvider"/>.
+    /// </summary>
+    public void PushLayoutProvider(ILayoutProvider provider)
+    {
+        var previousParent = provider.ParentLayoutProvider;
+        var clipRect = provider.ClipRect;
+        ILayoutProvider? parent = null;
+        
+        if (_clipStack.Count > 0)
+        {
+            var parentScope = _clipStack[^1];
+            parent = parentScope.Provider;
+            clipRect = LayoutProviderHelper.IntersectRects(clipRect, parentScope.EffectiveClipRect);
+        }
+        
+        provider.ParentLayoutProvider = parent;
+        _clipStack.Add(new ClipScope(
+            provider,
+            previousParent,
+            clipRect,
+            LayoutProviderHelper.IsUnclipped(provider)));
+    }
+    
+    /// <summary>
+    /// Restores the layout provider that was current before the matching <see cref="PushLayoutProvider"/>.
+    /// </summary>
+    public void PopLayoutProvider()
+    {
+        if (_clipStack.Count == 0)
+            throw new InvalidOperationException("No layout provider has been pushed.");
+        
+        var scope = _clipStack[^1];
+        _clipStack.RemoveAt(_clipStack.Count - 1);
+        scope.Provider.ParentLayoutProvider = scope.PreviousParent;
+    }
+    
+    /// <summary>
+    /// Pops any providers pushed above <paramref name="provider"/> without a matching pop,
+    /// e.g. because a descendant threw while rendering.
+    /// </summary>
+    internal void UnwindLayoutProvidersTo(ILayoutProvider provider)
+    {
+        while (_clipStack.Count > 0 && !ReferenceEquals(_clipStack[^1].Provider, provider))
+        {
+            PopLayoutProvider();
+        }
+    }
+
+    internal void TrackKittyPlacement(ImageNode node) => _kittyPlacements.Add(node);
+    internal void UntrackKittyPlacement(ImageNode node) => _kittyPlacements.Remove(node);
+
+    /// <summary>
+    /// Deletes the kitty placements of image nodes that are no longer in the tree under
+    /// <paramref name="root"/>, or that are no longer reachable in it (e.g. an inactive tab).
+    /// </summary>
+    internal void DeleteDetachedKittyPlacements(Hex1bNode? root)
+    {
+        if (_kittyPlacements.Count == 0)
+            return;
+
+        _attachedNodes.Clear();
+        if (root != null)
+        {
+            _nodeWalk.Push(root);
+        }
+        while (_nodeWalk.TryPop(out var node))
+        {
+            _attachedNodes.Add(node);
+            foreach (var child in node.GetChildren())
+            {
+                _nodeWalk.Push(child);
+            }
+        }
+
+        foreach (var imageNode in _kittyPlacements.ToArray())
+        {
+            if (!_attachedNodes.Contains(imageNode))
+            {
+                imageNode.DeleteKittyPlacement(this);
+            }
+        }
+        _attachedNodes.Clear();
+    }
 
     public void EnterAlternateScreen() => _adapter.EnterTuiMode();
     public void ExitAlternateScreen() => _adapter.ExitTuiMode();
@@ -105,8 +237,7 @@ public class Hex1bRenderContext
         var bg = Theme.GetGlobalBackground();
         if (!bg.IsDefault)
         {
-            var bgCode = bg.ToBackgroundAnsi();
-            Write(bgCode);
+            Write(Theme.GetBackgroundAnsi(GlobalTheme.BackgroundColor));
         }
         else
         {
@@ -132,15 +263,15 @@ public class Hex1bRenderContext
     /// <param name="text">The text to write.</param>
     public void WriteClipped(int x, int y, string text)
     {
-        if (CurrentLayoutProvider == null)
+        if (_clipStack.Count == 0 || _clipStack[^1].IsUnclipped)
         {
-            // No layout provider - write directly
+            // No clipping in effect - write directly
             SetCursorPosition(x, y);
             Write(text);
             return;
         }
         
-        var (adjustedX, clippedText) = CurrentLayoutProvider.ClipString(x, y, text);
+        var (adjustedX, clippedText) = LayoutProviderHelper.ClipString(_clipStack[^1].EffectiveClipRect, x, y, text);
         if (clippedText.Length > 0)
         {
             SetCursorPosition(adjustedX, y);
@@ -148,12 +279,141 @@ public class Hex1bRenderContext
         }
     }
     
+    /// <summary>
+    /// Writes styled runs at the current cursor position without clipping.
+    /// If any run carries a style, colors are reset to the theme's global colors afterwards.
+    /// </summary>
+    /// <param name="runs">The runs to write, in order.</param>
+    public void Write(ReadOnlySpan<StyledRun> runs)
+    {
+        var builder = _runBuilder.Clear();
+        TextStyle? activeStyle = null;
+        
+        foreach (var run in runs)
+        {
+            AppendStyle(builder, run.Style, ref activeStyle);
+            builder.Append(run.Span);
+        }
+        
+        WriteRunBuilder(builder, activeStyle != null);
+    }
+    
+    /// <summary>
+    /// Writes styled runs at the specified position, respecting the current layout provider's clipping.
+    /// Runs entirely inside the clip region are copied as-is; only a run that crosses a clip edge
+    /// is split, and a wide character cut by the edge is replaced by spaces.
+    /// If any run carries a style, colors are reset to the theme's global colors afterwards.
+    /// </summary>
+    /// <param name="x">The X position to start writing.</param>
+    /// <param name="y">The Y position to write at.</param>
+    /// <param name="runs">The runs to write, in order.</param>
+    public void WriteClipped(int x, int y, ReadOnlySpan<StyledRun> runs)
+    {
+        var clipLeft = int.MinValue;
+        var clipRight = int.MaxValue;
+        if (_clipStack.Count > 0 && !_clipStack[^1].IsUnclipped &&
+            !LayoutProviderHelper.TryGetClipColumns(_clipStack[^1].EffectiveClipRect, y, out clipLeft, out clipRight))
+        {
+            return;
+        }
+        
+        var builder = _runBuilder.Clear();
+        TextStyle? activeStyle = null;
+        int? startX = null;
+        var column = x;
+        
+        foreach (var run in runs)
+        {
+            var runStart = column;
+            var runEnd = column + run.Width;
+            column = runEnd;
+            
+            if (runStart >= clipRight)
+                break;
+            if (run.Length == 0 || runEnd <= clipLeft)
+                continue;
+            
+            startX ??= Math.Max(runStart, clipLeft);
+            AppendStyle(builder, run.Style, ref activeStyle);
+            
+            if (runStart >= clipLeft && runEnd <= clipRight)
+            {
+                builder.Append(run.Span);
+            }
+            else
+            {
+                AppendClippedSpan(builder, run.Span, clipLeft - runStart, clipRight - runStart);
+            }
+        }
+        
+        if (startX == null)
+            return;
+        
+        SetCursorPosition(startX.Value, y);
+        WriteRunBuilder(builder, activeStyle != null);
+    }
+    
+    private static void AppendStyle(StringBuilder builder, TextStyle style, ref TextStyle? activeStyle)
+    {
+        // Consecutive runs usually share a style; only emit SGR when it changes.
+        if (style.IsInherited || activeStyle == style)
+            return;
+        
+        style.AppendSgr(builder);
+        activeStyle = style;
+    }
+    
+    /// <summary>
+    /// Appends the part of <paramref name="text"/> between two columns relative to its start.
+    /// </summary>
+    private static void AppendClippedSpan(StringBuilder builder, ReadOnlySpan<char> text, int fromColumn, int toColumn)
+    {
+        var column = 0;
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes(text))
+        {
+            if (column >= toColumn)
+                break;
+            
+            var end = column + cluster.Width;
+            if (column < fromColumn)
+            {
+                // Cut into on the left: pad the visible half of a wide character
+                if (end > fromColumn)
+                    builder.Append(' ', Math.Min(end, toColumn) - fromColumn);
+            }
+            else if (end > toColumn)
+            {
+                // Cut into on the right
+                builder.Append(' ', toColumn - column);
+            }
+            else
+            {
+                builder.Append(text.Slice(cluster.Start, cluster.Length));
+            }
+            
+            column = end;
+        }
+    }
+    
+    private void WriteRunBuilder(StringBuilder builder, bool styled)
+    {
+        if (styled)
+            builder.Append(Theme.GetResetToGlobalCodes());
+        
+        if (builder.Length > 0)
+            Write(builder.ToString());
+    }
+    
     /// <summary>
     /// Checks if a position should be rendered based on the current layout provider.
     /// If no layout provider is active, returns true.
     /// </summary>
     public bool ShouldRenderAt(int x, int y)
     {
-        return CurrentLayoutProvider?.ShouldRenderAt(x, y) ?? true;
+        if (_clipStack.Count == 0)
+            return true;
+        
+        var scope = _clipStack[^1];
+        return scope.IsUnclipped || scope.EffectiveClipRect.Contains(x, y);
     }
 }
@@ -0,0 +1,386 @@
+using Hex1b.Terminal;
+using Hex1b.Widgets;
+
+namespace Hex1b;
+
+/// <summary>
+/// A terminal session run by a <see cref="Hex1bSessionHost"/>.
+/// </summary>
+/// <remarks>
+/// <para>
+/// A session owns a terminal connected to its presentation adapter, with render optimization
+/// enabled, and the <see cref="Workload"/> adapter an app runs on. Apps created on that adapter
+/// render only when one of the host's workers grants them a frame, and only within the host's
+/// frame rate and render time budgets. Input is still read and processed as it arrives; only
+/// rendering waits, so a throttled frame simply draws the latest state when it runs.
+/// </para>
+/// <para>
+/// Disposing the session disposes its terminal, which disposes the presentation adapter.
+/// </para>
+/// </remarks>
+public sealed class Hex1bSession : IHex1bAppFrameScheduler, IAsyncDisposable
+{
+    private readonly Hex1bSessionHost _host;
+    private readonly TimeProvider _timeProvider;
+    private readonly Hex1bAppRenderOptimizationFilter _renderFilter;
+    private readonly TimeSpan _minFrameInterval;
+
+    // Render time earned per unit of wall-clock time, and the most that can be banked
+    private readonly double _budgetRate;
+    private readonly double _maxBudgetTicks;
+
+    // Guards everything below; frames come from the app's loop, parking from the host's timer
+    private readonly object _stateLock = new();
+    private TaskCompletionSource? _turnGranted;
+    private TaskCompletionSource? _turnCompleted;
+    private bool _inFrame;
+    private bool _parked;
+    private bool _disposed;
+    private long _frameStart;
+    private long _lastFrameStart;
+    private long _lastActivity;
+    private double _budgetTicks;
+    private long _budgetUpdated;
+    private bool _restorePending;
+    private long? _restoreStart;
+
+    private long _framesRendered;
+    private long _framesThrottled;
+    private long _totalRenderTicks;
+    private long _maxRenderTicks;
+    private long _totalQueueTicks;
+    private int _parkCount;
+    private int _hibernateCount;
+    private TimeSpan? _lastRestoreLatency;
+
+    internal Hex1bSession(
+        Hex1bSessionHost host,
+        long id,
+        Hex1bTerminal terminal,
+        Hex1bAppWorkloadAdapter workload,
+        Hex1bAppRenderOptimizationFilter renderFilter)
+    {
+        _host = host;
+        _timeProvider = host.Options.TimeProvider;
+        _renderFilter = renderFilter;
+        Id = id;
+        Terminal = terminal;
+        Workload = workload;
+
+        var options = host.Options;
+        _minFrameInterval = options.MaxFramesPerSecond > 0
+            ? TimeSpan.FromTicks(TimeSpan.TicksPerSecond / options.MaxFramesPerSecond)
+            : TimeSpan.Zero;
+
+        if (options.RenderTimeBudget > TimeSpan.Zero)
+        {
+            _budgetRate = (double)options.RenderTimeBudget.Ticks / TimeSpan.TicksPerSecond;
+            _maxBudgetTicks = options.RenderTimeBudget.Ticks;
+            _budgetTicks = _maxBudgetTicks;
+        }
+
+        _lastActivity = _budgetUpdated = _timeProvider.GetTimestamp();
+    }
+
+    /// <summary>
+    /// The session's identifier within its host.
+    /// </summary>
+    public long Id { get; }
+
+    /// <summary>
+    /// The terminal bridging the presentation adapter and <see cref="Workload"/>.
+    /// </summary>
+    public Hex1bTerminal Terminal { get; }
+
+    /// <summary>
+    /// The workload adapter to run the session's <see cref="Hex1bApp"/> on.
+    /// </summary>
+    public Hex1bAppWorkloadAdapter Workload { get; }
+
+    /// <summary>
+    /// Whether the session is parked because it has been idle.
+    /// </summary>
+    public bool IsParked
+    {
+        get { lock (_stateLock) return _parked; }
+    }
+
+    /// <summary>
+    /// Runs an app on this session until it stops or <paramref name="cancellationToken"/> is cancelled.
+    /// </summary>
+    /// <param name="builder">A function that builds the widget tree.</param>
+    /// <param name="options">Optional app options. <see cref="Hex1bAppOptions.WorkloadAdapter"/> is set to <see cref="Workload"/>.</param>
+    /// <param name="cancellationToken">Cancels the app.</param>
+    public async Task RunAppAsync(
+        Func<RootContext, Task<Hex1bWidget>> builder,
+        Hex1bAppOptions? options = null,
+        CancellationToken cancellationToken = default)
+    {
+        options ??= new Hex1bAppOptions();
+        options.WorkloadAdapter = Workload;
+
+        await using var app = new Hex1bApp(builder, options);
+        await app.RunAsync(cancellationToken);
+    }
+
+    /// <summary>
+    /// Gets a snapshot of the session's counters.
+    /// </summary>
+    public Hex1bSessionMetrics GetMetrics()
+    {
+        lock (_stateLock)
+        {
+            return new Hex1bSessionMetrics(
+                Id,
+                _framesRendered,
+                _framesThrottled,
+                TimeSpan.FromTicks(_totalRenderTicks),
+                TimeSpan.FromTicks(_maxRenderTicks),
+                TimeSpan.FromTicks(_totalQueueTicks),
+                _parkCount,
+                _parked,
+                _hibernateCount,
+                Terminal.IsHibernated,
+                _inFrame ? TimeSpan.Zero : _timeProvider.GetElapsedTime(_lastActivity),
+                _lastRestoreLatency);
+        }
+    }
+
+    /// <inheritdoc />
+    async ValueTask<bool> IHex1bAppFrameScheduler.BeginFrameAsync(CancellationToken ct)
+    {
+        TimeSpan delay;
+        lock (_stateLock)
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+
+            var now = _timeProvider.GetTimestamp();
+            _inFrame = true;
+            _lastActivity = now;
+            delay = GetBudgetDelay(now);
+            if (delay > TimeSpan.Zero)
+            {
+                _framesThrottled++;
+            }
+
+            if (_restorePending)
+            {
+                _restorePending = false;
+                _restoreStart = now;
+            }
+        }
+
+        try
+        {
+            // Usually already awake if input arrived first
+            Terminal.Wake();
+
+            if (delay > TimeSpan.Zero)
+            {
+                await Task.Delay(delay, _timeProvider, ct);
+            }
+
+            // Wait for a worker; the run queue is FIFO, so busy sessions take turns
+            var granted = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+            var queued = _timeProvider.GetTimestamp();
+            lock (_stateLock)
+            {
+                ObjectDisposedException.ThrowIf(_disposed, this);
+                _turnGranted = granted;
+            }
+
+            if (!_host.TryEnqueue(this))
+            {
+                throw new ObjectDisposedException(nameof(Hex1bSessionHost));
+            }
+
+            using (ct.Register(static state => ((TaskCompletionSource)state!).TrySetCanceled(), granted))
+            {
+                await granted.Task;
+            }
+
+            lock (_stateLock)
+            {
+                _frameStart = _timeProvider.GetTimestamp();
+                _totalQueueTicks += _timeProvider.GetElapsedTime(queued, _frameStart).Ticks;
+
+                var fullRedraw = _parked;
+                _parked = false;
+                return fullRedraw;
+            }
+        }
+        catch
+        {
+            lock (_stateLock)
+            {
+                _inFrame = false;
+                _turnGranted = null;
+            }
+            throw;
+        }
+    }
+
+    /// <inheritdoc />
+    void IHex1bAppFrameScheduler.EndFrame()
+    {
+        TaskCompletionSource? completed;
+        lock (_stateLock)
+        {
+            var now = _timeProvider.GetTimestamp();
+            var renderTicks = _timeProvider.GetElapsedTime(_frameStart, now).Ticks;
+
+            _framesRendered++;
+            _totalRenderTicks += renderTicks;
+            _maxRenderTicks = Math.Max(_maxRenderTicks, renderTicks);
+            _budgetTicks -= renderTicks;
+            _lastFrameStart = _frameStart;
+            _lastActivity = now;
+            _inFrame = false;
+
+            if (_restoreStart is { } restoreStart)
+            {
+                _lastRestoreLatency = _timeProvider.GetElapsedTime(restoreStart, now);
+                _restoreStart = null;
+            }
+
+            completed = _turnCompleted;
+            _turnCompleted = null;
+        }
+
+        completed?.TrySetResult();
+    }
+
+    /// <summary>
+    /// Lets the session waiting in the run queue render, and completes when its frame ends.
+    /// </summary>
+    internal Task RunTurnAsync()
+    {
+        var completed = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        TaskCompletionSource? granted;
+        lock (_stateLock)
+        {
+            granted = _turnGranted;
+            _turnGranted = null;
+            _turnCompleted = completed;
+        }
+
+        // The wait was cancelled, or the session disposed, while queued
+        if (granted == null || !granted.TrySetResult())
+        {
+            lock (_stateLock)
+            {
+                _turnCompleted = null;
+            }
+            return Task.CompletedTask;
+        }
+
+        return completed.Task;
+    }
+
+    /// <summary>
+    /// Parks the session if it has been idle for at least <paramref name="idleTimeout"/>.
+    /// </summary>
+    internal bool TryPark(long now, TimeSpan idleTimeout)
+    {
+        lock (_stateLock)
+        {
+            if (_parked || _inFrame || _disposed)
+                return false;
+
+            if (_timeProvider.GetElapsedTime(_lastActivity, now) < idleTimeout)
+                return false;
+
+            if (!_renderFilter.ReleaseBuffers())
+                return false;
+
+            _parked = true;
+            _parkCount++;
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// Hibernates the terminal of a parked session that has been idle for at least <paramref name="hibernateTimeout"/>.
+    /// </summary>
+    internal bool TryHibernate(long now, TimeSpan hibernateTimeout, string? directory)
+    {
+        lock (_stateLock)
+        {
+            if (!_parked || _inFrame || _disposed || Terminal.IsHibernated)
+                return false;
+
+            if (_timeProvider.GetElapsedTime(_lastActivity, now) < hibernateTimeout)
+                return false;
+
+            var path = directory != null
+                ? Path.Combine(directory, $"hex1b-session-{Guid.NewGuid():N}.state")
+                : null;
+            Terminal.Hibernate(path);
+
+            _hibernateCount++;
+            _restorePending = true;
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// Gets how long the next frame must wait to stay within the session's budgets.
+    /// </summary>
+    private TimeSpan GetBudgetDelay(long now)
+    {
+        var delay = TimeSpan.Zero;
+
+        if (_framesRendered > 0)
+        {
+            var sinceLastFrame = _timeProvider.GetElapsedTime(_lastFrameStart, now);
+            if (sinceLastFrame < _minFrameInterval)
+            {
+                delay = _minFrameInterval - sinceLastFrame;
+            }
+        }
+
+        if (_budgetRate > 0)
+        {
+            var earned = _timeProvider.GetElapsedTime(_budgetUpdated, now).Ticks * _budgetRate;
+            _budgetTicks = Math.Min(_maxBudgetTicks, _budgetTicks + earned);
+            _budgetUpdated = now;
+
+            if (_budgetTicks < 0)
+            {
+                var refill = TimeSpan.FromTicks((long)Math.Ceiling(-_budgetTicks / _budgetRate));
+                if (refill > delay)
+                {
+                    delay = refill;
+                }
+            }
+        }
+
+        return delay;
+    }
+
+    /// <summary>
+    /// Removes the session from its host and disposes the terminal.
+    /// </summary>
+    public async ValueTask DisposeAsync()
+    {
+        TaskCompletionSource? granted;
+        TaskCompletionSource? completed;
+        lock (_stateLock)
+        {
+            if (_disposed) return;
+            _disposed = true;
+
+            granted = _turnGranted;
+            completed = _turnCompleted;
+            _turnGranted = null;
+            _turnCompleted = null;
+        }
+
+        // Release a waiting frame and the worker running this session's turn, if any
+        granted?.TrySetCanceled();
+        completed?.TrySetResult();
+
+        _host.Remove(this);
+        await Terminal.DisposeAsync();
+    }
+}
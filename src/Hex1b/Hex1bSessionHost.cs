@@ -0,0 +1,180 @@
+using System.Collections.Concurrent;
+using System.Threading.Channels;
+using Hex1b.Terminal;
+
+namespace Hex1b;
+
+/// <summary>
+/// Runs many terminal sessions on a fixed set of worker loops.
+/// </summary>
+/// <example>
+/// <para>Serve each WebSocket connection as a session of one shared host:</para>
+/// <code>
+/// var host = new Hex1bSessionHost(new Hex1bSessionHostOptions { MaxFramesPerSecond = 30 });
+///
+/// // Per connection
+/// await using var session = host.CreateSession(new WebSocketPresentationAdapter(webSocket, 80, 24));
+/// await session.RunAppAsync(ctx =&gt; Task.FromResult&lt;Hex1bWidget&gt;(ctx.Text("Hello")), cancellationToken: ct);
+/// </code>
+/// </example>
+/// <remarks>
+/// <para>
+/// Sessions that want to render join a single FIFO run queue. Each of the
+/// <see cref="Hex1bSessionHostOptions.WorkerCount"/> workers takes the next session, lets its
+/// app render one frame and waits for the frame to finish before taking another. A session is
+/// in the queue at most once, so busy sessions take turns and a burst from one session cannot
+/// starve the others. Before queueing, a session waits out its frame rate and render time
+/// budgets; frames it skips are merged into the next one.
+/// </para>
+/// <para>
+/// Scheduling is cooperative: a frame holds its worker until it completes, so the render time
+/// budget throttles a slow session's later frames rather than interrupting the current one.
+/// </para>
+/// <para>
+/// Sessions that have not rendered for <see cref="Hex1bSessionHostOptions.IdleTimeout"/> are
+/// parked. Parking releases the render optimization shadow buffers, which are the bulk of a
+/// session's per-cell memory besides the terminal's own screen buffer; the next frame redraws
+/// the whole screen and rebuilds them. Parked sessions idle for
+/// <see cref="Hex1bSessionHostOptions.HibernateTimeout"/> are also hibernated, which swaps the
+/// terminal's screen buffer for a compact snapshot, optionally on disk, until the session is
+/// used again. The app and its node tree stay in memory.
+/// </para>
+/// </remarks>
+public sealed class Hex1bSessionHost : IAsyncDisposable
+{
+    private readonly TimeProvider _timeProvider;
+    private readonly Channel<Hex1bSession> _runQueue = Channel.CreateUnbounded<Hex1bSession>();
+    private readonly ConcurrentDictionary<long, Hex1bSession> _sessions = new();
+    private readonly Task[] _workers;
+    private readonly ITimer? _idleTimer;
+    private long _nextSessionId;
+    private volatile bool _disposed;
+
+    /// <summary>
+    /// Creates a session host and starts its workers.
+    /// </summary>
+    /// <param name="options">Optional configuration options.</param>
+    public Hex1bSessionHost(Hex1bSessionHostOptions? options = null)
+    {
+        Options = options ?? new Hex1bSessionHostOptions();
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(Options.WorkerCount, nameof(options));
+        _timeProvider = Options.TimeProvider;
+
+        _workers = new Task[Options.WorkerCount];
+        for (var i = 0; i < _workers.Length; i++)
+        {
+            _workers[i] = Task.Run(WorkerLoopAsync);
+        }
+
+        if (Options.IdleTimeout > TimeSpan.Zero)
+        {
+            // Check a few times per timeout so sessions park reasonably close to it
+            var period = TimeSpan.FromTicks(Math.Clamp(
+                Options.IdleTimeout.Ticks / 4,
+                TimeSpan.FromMilliseconds(100).Ticks,
+                TimeSpan.FromSeconds(5).Ticks));
+            _idleTimer = _timeProvider.CreateTimer(_ => ParkIdleSessions(), null, period, period);
+        }
+    }
+
+    /// <summary>
+    /// The options the host was created with.
+    /// </summary>
+    public Hex1bSessionHostOptions Options { get; }
+
+    /// <summary>
+    /// Number of sessions currently hosted.
+    /// </summary>
+    public int SessionCount => _sessions.Count;
+
+    /// <summary>
+    /// Creates a session that presents through <paramref name="presentation"/>.
+    /// </summary>
+    /// <param name="presentation">The presentation adapter for the session's I/O. Owned by the session.</param>
+    public Hex1bSession CreateSession(IHex1bTerminalPresentationAdapter presentation)
+    {
+        ArgumentNullException.ThrowIfNull(presentation);
+        ObjectDisposedException.ThrowIf(_disposed, this);
+
+        var workload = new Hex1bAppWorkloadAdapter(presentation.Capabilities);
+        var terminalOptions = new Hex1bTerminalOptions
+        {
+            PresentationAdapter = presentation,
+            WorkloadAdapter = workload,
+            TimeProvider = _timeProvider
+        };
+        var renderFilter = terminalOptions.AddHex1bAppRenderOptimization();
+        var terminal = new Hex1bTerminal(terminalOptions);
+
+        var session = new Hex1bSession(this, Interlocked.Increment(ref _nextSessionId), terminal, workload, renderFilter);
+        workload.FrameScheduler = session;
+        _sessions[session.Id] = session;
+        return session;
+    }
+
+    /// <summary>
+    /// Gets a snapshot of every session's counters.
+    /// </summary>
+    public IReadOnlyList<Hex1bSessionMetrics> GetMetrics()
+    {
+        var metrics = new List<Hex1bSessionMetrics>(_sessions.Count);
+        foreach (var session in _sessions.Values)
+        {
+            metrics.Add(session.GetMetrics());
+        }
+        return metrics;
+    }
+
+    internal bool TryEnqueue(Hex1bSession session) => _runQueue.Writer.TryWrite(session);
+
+    internal void Remove(Hex1bSession session) => _sessions.TryRemove(session.Id, out _);
+
+    private async Task WorkerLoopAsync()
+    {
+        var reader = _runQueue.Reader;
+        while (await reader.WaitToReadAsync())
+        {
+            while (reader.TryRead(out var session))
+            {
+                await session.RunTurnAsync();
+            }
+        }
+    }
+
+    private void ParkIdleSessions()
+    {
+        var now = _timeProvider.GetTimestamp();
+        var hibernate = Options.HibernateTimeout >= TimeSpan.Zero;
+        foreach (var session in _sessions.Values)
+        {
+            session.TryPark(now, Options.IdleTimeout);
+
+            if (hibernate)
+            {
+                session.TryHibernate(now, Options.HibernateTimeout, Options.HibernationDirectory);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Disposes every remaining session and stops the workers.
+    /// </summary>
+    public async ValueTask DisposeAsync()
+    {
+        if (_disposed) return;
+        _disposed = true;
+
+        if (_idleTimer != null)
+        {
+            await _idleTimer.DisposeAsync();
+        }
+
+        foreach (var session in _sessions.Values)
+        {
+            await session.DisposeAsync();
+        }
+
+        _runQueue.Writer.TryComplete();
+        await Task.WhenAll(_workers);
+    }
+}
@@ -0,0 +1,55 @@
+namespace Hex1b;
+
+/// <summary>
+/// Options for configuring a <see cref="Hex1bSessionHost"/>.
+/// </summary>
+public sealed class Hex1bSessionHostOptions
+{
+    /// <summary>
+    /// Number of worker loops that grant frames. At most this many sessions render at once.
+    /// Defaults to the processor count.
+    /// </summary>
+    public int WorkerCount { get; set; } = Environment.ProcessorCount;
+
+    /// <summary>
+    /// Most frames a single session may render per second. Further frames wait, and the
+    /// changes they would have drawn are picked up by the next frame. Default is 60.
+    /// Zero removes the limit.
+    /// </summary>
+    public int MaxFramesPerSecond { get; set; } = 60;
+
+    /// <summary>
+    /// Render time a single session may use per second of wall-clock time. A session that
+    /// overspends waits until its budget has refilled before rendering again. Budget
+    /// accumulates for at most one second while a session is quiet. Default is 100 ms,
+    /// a tenth of one worker. Use <see cref="Timeout.InfiniteTimeSpan"/> for no limit.
+    /// </summary>
+    public TimeSpan RenderTimeBudget { get; set; } = TimeSpan.FromMilliseconds(100);
+
+    /// <summary>
+    /// Sessions that have not rendered for this long are parked: their render state is
+    /// released and rebuilt with a full redraw when they next render. Default is 30 seconds.
+    /// Use <see cref="Timeout.InfiniteTimeSpan"/> to never park sessions.
+    /// </summary>
+    public TimeSpan IdleTimeout { get; set; } = TimeSpan.FromSeconds(30);
+
+    /// <summary>
+    /// Parked sessions that have not rendered for this long are hibernated: their terminal's
+    /// screen state is saved as a compact snapshot and its screen buffer released until the
+    /// session receives input or renders again. Default is <see cref="Timeout.InfiniteTimeSpan"/>,
+    /// which never hibernates sessions. Only takes effect once a session is parked, so values
+    /// below <see cref="IdleTimeout"/> behave like it.
+    /// </summary>
+    public TimeSpan HibernateTimeout { get; set; } = Timeout.InfiniteTimeSpan;
+
+    /// <summary>
+    /// Directory that hibernated sessions' snapshots are written to. When null, snapshots are
+    /// kept in memory.
+    /// </summary>
+    public string? HibernationDirectory { get; set; }
+
+    /// <summary>
+    /// The time provider used for budgets, delays and idle detection. Defaults to system time.
+    /// </summary>
+    public TimeProvider TimeProvider { get; set; } = TimeProvider.System;
+}
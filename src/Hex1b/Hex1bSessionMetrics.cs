@@ -0,0 +1,33 @@
+namespace Hex1b;
+
+/// <summary>
+/// Counters for one session of a <see cref="Hex1bSessionHost"/>.
+/// </summary>
+/// <param name="SessionId">The session's identifier within its host.</param>
+/// <param name="FramesRendered">Frames the session has rendered.</param>
+/// <param name="FramesThrottled">Frames that waited for the frame rate or render time budget.</param>
+/// <param name="TotalRenderTime">Time spent rendering frames.</param>
+/// <param name="MaxRenderTime">Longest single frame.</param>
+/// <param name="TotalQueueTime">Time frames spent waiting for a free worker.</param>
+/// <param name="ParkCount">Number of times the session was parked.</param>
+/// <param name="IsParked">Whether the session is currently parked.</param>
+/// <param name="HibernateCount">Number of times the session was hibernated.</param>
+/// <param name="IsHibernated">Whether the session's terminal is currently hibernated.</param>
+/// <param name="IdleTime">Time since the session last asked to render.</param>
+/// <param name="LastRestoreLatency">
+/// For the most recent hibernation, time from the first frame request afterwards until that
+/// frame finished, including restoring the terminal. Null if the session never woke from hibernation.
+/// </param>
+public sealed record Hex1bSessionMetrics(
+    long SessionId,
+    long FramesRendered,
+    long FramesThrottled,
+    TimeSpan TotalRenderTime,
+    TimeSpan MaxRenderTime,
+    TimeSpan TotalQueueTime,
+    int ParkCount,
+    bool IsParked,
+    int HibernateCount,
+    bool IsHibernated,
+    TimeSpan IdleTime,
+    TimeSpan? LastRestoreLatency);
@@ -0,0 +1,23 @@
+namespace Hex1b;
+
+/// <summary>
+/// Decides when a <see cref="Hex1bApp"/> may render its next frame.
+/// </summary>
+/// <remarks>
+/// The app picks up a scheduler from its <see cref="Terminal.Hex1bAppWorkloadAdapter"/>.
+/// Every frame is bracketed by <see cref="BeginFrameAsync"/> and <see cref="EndFrame"/>,
+/// which lets <see cref="Hex1bSessionHost"/> throttle, queue and measure the sessions it runs.
+/// </remarks>
+internal interface IHex1bAppFrameScheduler
+{
+    /// <summary>
+    /// Waits until the app may render.
+    /// </summary>
+    /// <returns>True when the whole screen must be redrawn, for example after the session was parked.</returns>
+    ValueTask<bool> BeginFrameAsync(CancellationToken ct);
+
+    /// <summary>
+    /// Reports that the frame started by <see cref="BeginFrameAsync"/> is complete.
+    /// </summary>
+    void EndFrame();
+}
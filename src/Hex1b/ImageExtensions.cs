@@ -0,0 +1,46 @@
+using System.Diagnostics.CodeAnalysis;
+
+namespace Hex1b;
+
+using Hex1b.Widgets;
+
+/// <summary>
+/// Extension methods for creating ImageWidget.
+/// </summary>
+[Experimental("HEX1B_IMAGES", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/images.md")]
+public static class ImageExtensions
+{
+    /// <summary>
+    /// Creates an ImageWidget with the specified image and fallback widget.
+    /// </summary>
+    /// <param name="ctx">The widget context.</param>
+    /// <param name="image">The image, created once and kept while it is shown.</param>
+    /// <param name="fallback">A widget to display if the terminal can't show images.</param>
+    /// <param name="width">Optional width in character cells.</param>
+    /// <param name="height">Optional height in character cells.</param>
+    public static ImageWidget Image<TParent>(
+        this WidgetContext<TParent> ctx,
+        TerminalImage image,
+        Hex1bWidget fallback,
+        int? width = null,
+        int? height = null)
+        where TParent : Hex1bWidget
+        => new(image, fallback, width, height);
+
+    /// <summary>
+    /// Creates an ImageWidget with the specified image and a text fallback.
+    /// </summary>
+    /// <param name="ctx">The widget context.</param>
+    /// <param name="image">The image, created once and kept while it is shown.</param>
+    /// <param name="fallbackText">Text to display if the terminal can't show images.</param>
+    /// <param name="width">Optional width in character cells.</param>
+    /// <param name="height">Optional height in character cells.</param>
+    public static ImageWidget Image<TParent>(
+        this WidgetContext<TParent> ctx,
+        TerminalImage image,
+        string fallbackText,
+        int? width = null,
+        int? height = null)
+        where TParent : Hex1bWidget
+        => new(image, new TextBlockWidget(fallbackText), width, height);
+}
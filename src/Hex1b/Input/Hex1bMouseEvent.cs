@@ -1,3 +1,5 @@
+using System.Diagnostics.CodeAnalysis;
+
 namespace Hex1b.Input;
 
 /// <summary>
@@ -27,10 +29,45 @@ public sealed record Hex1bMouseEvent(
     /// Returns true if this is a triple-click event (ClickCount == 3).
     /// </summary>
     public bool IsTripleClick => ClickCount == 3;
+
+    /// <summary>
+    /// The number of wheel ticks this event stands for. Consecutive wheel ticks in the same
+    /// direction are merged into one event, so handlers should scroll by this many steps.
+    /// Always 1 for events other than <see cref="MouseButton.ScrollUp"/> and <see cref="MouseButton.ScrollDown"/>.
+    /// </summary>
+    public int ScrollTicks { get; init; } = 1;
     
     /// <summary>
     /// Creates a copy of this event with a different click count.
     /// Used by Hex1bApp to set the computed click count.
     /// </summary>
     public Hex1bMouseEvent WithClickCount(int clickCount) => this with { ClickCount = clickCount };
+
+    /// <summary>
+    /// Merges <paramref name="next"/> into <paramref name="previous"/> when handling only the
+    /// merged event is equivalent to handling both: motion with the same buttons and modifiers
+    /// keeps the latest position, and wheel ticks in the same direction at the same position
+    /// are summed.
+    /// </summary>
+    /// <returns>True if the events were merged into <paramref name="merged"/>.</returns>
+    internal static bool TryCoalesce(Hex1bMouseEvent previous, Hex1bMouseEvent next, [NotNullWhen(true)] out Hex1bMouseEvent? merged)
+    {
+        merged = null;
+        if (previous.Button != next.Button || previous.Action != next.Action || previous.Modifiers != next.Modifiers)
+            return false;
+
+        if (next.Action is MouseAction.Move or MouseAction.Drag)
+        {
+            merged = next;
+            return true;
+        }
+
+        if (next.Button is MouseButton.ScrollUp or MouseButton.ScrollDown && previous.X == next.X && previous.Y == next.Y)
+        {
+            merged = next with { ScrollTicks = previous.ScrollTicks + next.ScrollTicks };
+            return true;
+        }
+
+        return false;
+    }
 }
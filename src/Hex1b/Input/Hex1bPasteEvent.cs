@@ -0,0 +1,43 @@
+using System.Text;
+
+namespace Hex1b.Input;
+
+/// <summary>
+/// Text pasted into a terminal with bracketed paste mode on, delivered as one event (a paste
+/// over a megabyte arrives in several). Routed to the focused node; see
+/// <see cref="Hex1bNode.HandlePasteAsync"/>.
+/// </summary>
+/// <param name="Text">
+/// The pasted text. Line breaks are normalized to '\n'. Escape characters are removed, so the
+/// text can't inject escape sequences.
+/// </param>
+public sealed record Hex1bPasteEvent(string Text) : Hex1bEvent
+{
+    /// <summary>
+    /// Gets the key events typing the text would produce, for nodes that don't take pastes
+    /// as a whole.
+    /// </summary>
+    internal IEnumerable<Hex1bKeyEvent> ToKeyEvents()
+    {
+        foreach (var rune in Text.EnumerateRunes())
+        {
+            if (TerminalInputDecoder.GetKeyEvent(rune) is { } keyEvent)
+            {
+                yield return keyEvent;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Creates the event for pasted UTF-8 bytes.
+    /// </summary>
+    internal static Hex1bPasteEvent FromUtf8(ReadOnlySpan<byte> pasted)
+    {
+        var text = Encoding.UTF8.GetString(pasted);
+        if (text.Contains('\r'))
+        {
+            text = text.Replace("\r\n", "\n").Replace('\r', '\n');
+        }
+        return new Hex1bPasteEvent(text);
+    }
+}
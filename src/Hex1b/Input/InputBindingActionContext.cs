@@ -30,13 +30,21 @@ public sealed class InputBindingActionContext
     /// </summary>
     public int MouseY { get; }
 
+    /// <summary>
+    /// The number of wheel ticks the mouse event stands for, if this context was created for a
+    /// scroll binding. Consecutive ticks are merged into one event, so scroll handlers should
+    /// move this many steps. 1 for every other binding.
+    /// </summary>
+    public int ScrollTicks { get; }
+
     internal InputBindingActionContext(
         FocusRing focusRing, 
         Action? requestStop = null, 
         CancellationToken cancellationToken = default,
         int mouseX = -1,
         int mouseY = -1,
-        Action<string>? copyToClipboard = null)
+        Action<string>? copyToClipboard = null,
+        int scrollTicks = 1)
     {
         _focusRing = focusRing;
         _requestStop = requestStop;
@@ -44,6 +52,7 @@ public sealed class InputBindingActionContext
         CancellationToken = cancellationToken;
         MouseX = mouseX;
         MouseY = mouseY;
+        ScrollTicks = scrollTicks;
     }
 
     /// <summary>
@@ -150,6 +150,48 @@ public static class InputRouter
         return InputResult.NotHandled;
     }
     
+    /// <summary>
+    /// Routes a paste to the focused node, bubbling up to its containers until one handles it.
+    /// If none does, the text is routed as the key events typing it would produce.
+    /// </summary>
+    public static async Task<InputResult> RoutePasteAsync(
+        Hex1bNode root,
+        Hex1bPasteEvent pasteEvent,
+        FocusRing focusRing,
+        InputRouterState state,
+        Action? requestStop = null,
+        CancellationToken cancellationToken = default,
+        Action<string>? copyToClipboard = null)
+    {
+        var path = BuildPathToFocused(root);
+        var lastNode = path[^1];
+        if (lastNode.IsFocusable && lastNode.IsFocused)
+        {
+            // A paste is text, not a key: it cancels a pending chord rather than continuing it
+            state.Reset();
+
+            var actionContext = new InputBindingActionContext(focusRing, requestStop, cancellationToken, copyToClipboard: copyToClipboard);
+            for (int i = path.Count - 1; i >= 0; i--)
+            {
+                if (await path[i].HandlePasteAsync(pasteEvent, actionContext) == InputResult.Handled)
+                {
+                    return InputResult.Handled;
+                }
+            }
+        }
+
+        // Nothing takes the paste as a whole, so type it
+        var result = InputResult.NotHandled;
+        foreach (var keyEvent in pasteEvent.ToKeyEvents())
+        {
+            if (await RouteInputAsync(root, keyEvent, focusRing, state, requestStop, cancellationToken, copyToClipboard) == InputResult.Handled)
+            {
+                result = InputResult.Handled;
+            }
+        }
+        return result;
+    }
+    
     private static async Task<InputResult> ContinueChordAsync(
         Hex1bKeyEvent keyEvent, 
         List<Hex1bNode> path, 
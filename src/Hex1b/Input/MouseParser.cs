@@ -54,6 +54,19 @@ public static class MouseParser
             return false;
         }
         
+        mouseEvent = CreateSgrEvent(buttonCode, x, y, release: terminator == 'm');
+        return true;
+    }
+
+    /// <summary>
+    /// Creates the event for a parsed SGR mouse report.
+    /// </summary>
+    /// <param name="buttonCode">The button code (Cb), including modifier and motion bits.</param>
+    /// <param name="x">The 1-based column.</param>
+    /// <param name="y">The 1-based row.</param>
+    /// <param name="release">Whether the report ended in 'm' (button up) rather than 'M'.</param>
+    internal static Hex1bMouseEvent CreateSgrEvent(int buttonCode, int x, int y, bool release)
+    {
         // Convert to 0-based coordinates
         x--;
         y--;
@@ -116,10 +129,9 @@ public static class MouseParser
                 3 => MouseButton.None,  // Release (in non-SGR mode)
                 _ => MouseButton.None
             };
-            action = terminator == 'M' ? MouseAction.Down : MouseAction.Up;
+            action = release ? MouseAction.Up : MouseAction.Down;
         }
         
-        mouseEvent = new Hex1bMouseEvent(button, action, x, y, modifiers);
-        return true;
+        return new Hex1bMouseEvent(button, action, x, y, modifiers);
     }
 }
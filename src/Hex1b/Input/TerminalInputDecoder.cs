@@ -0,0 +1,590 @@
+using System.Buffers;
+using System.Text;
+
+namespace Hex1b.Input;
+
+/// <summary>
+/// Decodes raw terminal input bytes into <see cref="Hex1bEvent"/>s.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The decoder works on UTF-8 bytes directly and keeps its state between calls, so an escape
+/// sequence or character split across two reads is decoded once the rest arrives. It
+/// recognizes CSI and SS3 key sequences, SGR mouse reports, bracketed paste (delivered as one
+/// <see cref="Hex1bPasteEvent"/>) and DA1 responses (which are swallowed).
+/// </para>
+/// <para>
+/// A lone ESC at the end of the input can't be told apart from the start of a sequence until
+/// more input arrives or doesn't. The caller calls <see cref="Flush"/> when nothing has
+/// followed for a short while, which turns it into the Escape key.
+/// </para>
+/// <para>
+/// Decoding doesn't allocate strings. Events for ASCII keys are shared, and mouse reports that
+/// repeat a recent one reuse its event, so a flood of motion over the same cells allocates
+/// nothing. An instance is not thread-safe.
+/// </para>
+/// <para>
+/// Consecutive mouse reports in one chunk are merged with <see cref="Hex1bMouseEvent.TryCoalesce"/>:
+/// motion keeps only the latest position and wheel ticks are summed. Key events are never
+/// merged or reordered.
+/// </para>
+/// </remarks>
+internal sealed class TerminalInputDecoder
+{
+    /// <summary>
+    /// The longest escape sequence the decoder waits for. Longer ones are dropped.
+    /// </summary>
+    internal const int MaxSequenceLength = 64;
+
+    private const byte Esc = 0x1b;
+    private const int MouseCacheSize = 256;
+    private const int MaxRetainedPasteBuffer = 64 * 1024;
+
+    /// <summary>
+    /// The most pasted bytes gathered before they are delivered. A longer paste arrives as
+    /// several paste events, so a lost end marker can't grow the buffer without bound.
+    /// </summary>
+    internal const int MaxPasteLength = 1024 * 1024;
+
+    private static readonly Hex1bKeyEvent?[] AsciiKeys = CreateAsciiKeys();
+
+    private static ReadOnlySpan<byte> PasteEnd => "\x1b[201~"u8;
+
+    private readonly byte[] _pending = new byte[MaxSequenceLength];
+    private int _pendingLength;
+    private bool _inPaste;
+    private ArrayBufferWriter<byte> _pasted = new();
+    private readonly (long Key, Hex1bMouseEvent? Event)[] _mouseEvents = new (long, Hex1bMouseEvent?)[MouseCacheSize];
+
+    /// <summary>
+    /// Gets whether the end of the input so far is an incomplete sequence or character.
+    /// </summary>
+    public bool HasPendingInput => _pendingLength > 0;
+
+    /// <summary>
+    /// Gets whether the decoder is between the start and end of a bracketed paste.
+    /// </summary>
+    public bool InPaste => _inPaste;
+
+    /// <summary>
+    /// Decodes the next chunk of input, adding its events to <paramref name="events"/>.
+    /// </summary>
+    /// <param name="data">The input bytes.</param>
+    /// <param name="events">The list the decoded events are added to.</param>
+    public void Decode(ReadOnlySpan<byte> data, List<Hex1bEvent> events)
+    {
+        if (_pendingLength == 0)
+        {
+            Decode(data, events, final: false);
+            return;
+        }
+
+        // Rare: finish the sequence the previous chunk ended in
+        var length = _pendingLength + data.Length;
+        var buffer = ArrayPool<byte>.Shared.Rent(length);
+        try
+        {
+            _pending.AsSpan(0, _pendingLength).CopyTo(buffer);
+            data.CopyTo(buffer.AsSpan(_pendingLength));
+            _pendingLength = 0;
+            Decode(buffer.AsSpan(0, length), events, final: false);
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+    }
+
+    /// <summary>
+    /// Decodes any incomplete input as it stands: a lone ESC becomes the Escape key and a
+    /// truncated character becomes U+FFFD. Does nothing inside a paste, where pending input is
+    /// the start of the end marker and waits for the rest however long it takes.
+    /// </summary>
+    /// <param name="events">The list the decoded events are added to.</param>
+    public void Flush(List<Hex1bEvent> events)
+    {
+        if (_pendingLength == 0 || _inPaste)
+            return;
+
+        Span<byte> pending = stackalloc byte[MaxSequenceLength];
+        _pending.AsSpan(0, _pendingLength).CopyTo(pending);
+        pending = pending[.._pendingLength];
+        _pendingLength = 0;
+        Decode(pending, events, final: true);
+    }
+
+    private void Decode(ReadOnlySpan<byte> data, List<Hex1bEvent> events, bool final)
+    {
+        var i = 0;
+        while (i < data.Length)
+        {
+            var consumed = _inPaste
+                ? DecodePasted(data[i..], events, final)
+                : DecodeNext(data[i..], events, final);
+
+            if (consumed == 0)
+            {
+                // Incomplete: keep the rest for the next chunk
+                data[i..].CopyTo(_pending);
+                _pendingLength = data.Length - i;
+                return;
+            }
+
+            i += consumed;
+        }
+    }
+
+    /// <summary>
+    /// Decodes one key, sequence or character.
+    /// </summary>
+    /// <returns>The number of bytes consumed, or 0 if <paramref name="data"/> ends before it does.</returns>
+    private int DecodeNext(ReadOnlySpan<byte> data, List<Hex1bEvent> events, bool final)
+    {
+        var b = data[0];
+        if (b != Esc)
+        {
+            return DecodeCharacter(data, events, final);
+        }
+
+        if (data.Length == 1)
+        {
+            if (!final)
+                return 0;
+
+            events.Add(AsciiKeys[Esc]!);
+            return 1;
+        }
+
+        switch (data[1])
+        {
+            case (byte)'[':
+                var csiLength = DecodeCsi(data, events);
+                if (csiLength == 0 && final)
+                {
+                    // Never completed: the ESC was a key on its own
+                    events.Add(AsciiKeys[Esc]!);
+                    return 1;
+                }
+                return csiLength;
+
+            case (byte)'O':
+                if (data.Length < 3)
+                {
+                    if (!final)
+                        return 0;
+
+                    events.Add(AsciiKeys[Esc]!);
+                    return 1;
+                }
+
+                var ss3Key = GetSs3Key(data[2]);
+                if (ss3Key != Hex1bKey.None)
+                {
+                    events.Add(new Hex1bKeyEvent(ss3Key, '\0', Hex1bModifiers.None));
+                }
+                return 3;
+
+            default:
+                // ESC followed by a letter or digit = Alt+key (ESC f = Alt+F, ESC 1 = Alt+1)
+                var altKey = CreateAltKeyEvent((char)data[1]);
+                if (altKey != null)
+                {
+                    events.Add(altKey);
+                    return 2;
+                }
+
+                // Unknown escape sequence, just emit Escape
+                events.Add(AsciiKeys[Esc]!);
+                return 1;
+        }
+    }
+
+    /// <summary>
+    /// Decodes a CSI sequence: ESC [ parameters intermediates final.
+    /// </summary>
+    /// <returns>The number of bytes consumed, or 0 if <paramref name="data"/> ends before it does.</returns>
+    private int DecodeCsi(ReadOnlySpan<byte> data, List<Hex1bEvent> events)
+    {
+        var i = 2;
+        while (i < data.Length && data[i] is >= 0x30 and <= 0x3f)
+            i++;
+        var parametersEnd = i;
+        while (i < data.Length && data[i] is >= 0x20 and <= 0x2f)
+            i++;
+
+        if (i >= data.Length)
+        {
+            // Too long to be a sequence we know: drop the introducer and decode the rest as text
+            return i >= MaxSequenceLength ? 2 : 0;
+        }
+
+        var final = data[i];
+        if (final is < 0x40 or > 0x7e)
+        {
+            // Malformed: drop the introducer and decode the rest as text
+            return 2;
+        }
+
+        DispatchCsi(data[2..parametersEnd], parametersEnd == i ? (char)final : '\0', events);
+        return i + 1;
+    }
+
+    private void DispatchCsi(ReadOnlySpan<byte> parameters, char final, List<Hex1bEvent> events)
+    {
+        if (parameters.Length > 0 && parameters[0] is (byte)'<' or (byte)'=' or (byte)'>' or (byte)'?')
+        {
+            // Private sequences: only SGR mouse reports are input. Anything else, like a DA1
+            // response (ESC [ ? ... c), is a reply to a query and is swallowed - capabilities
+            // come from TerminalCapabilities rather than runtime detection.
+            if (parameters[0] == '<' && final is 'M' or 'm')
+            {
+                var mouseEvent = DecodeSgrMouse(parameters[1..], final == 'm');
+                if (mouseEvent == null)
+                    return;
+
+                // Motion and wheel floods collapse into the latest position and one scroll
+                if (events.Count > 0
+                    && events[^1] is Hex1bMouseEvent previous
+                    && Hex1bMouseEvent.TryCoalesce(previous, mouseEvent, out var merged))
+                {
+                    events[^1] = merged;
+                }
+                else
+                {
+                    events.Add(mouseEvent);
+                }
+            }
+            return;
+        }
+
+        var position = 0;
+        var param1 = ReadNumber(parameters, ref position);
+        var param2 = 0;
+        var hasParam2 = false;
+        if (position < parameters.Length && parameters[position] == ';')
+        {
+            position++;
+            hasParam2 = position < parameters.Length && char.IsAsciiDigit((char)parameters[position]);
+            param2 = ReadNumber(parameters, ref position);
+        }
+
+        if (final == '~')
+        {
+            if (param1 == 200)
+            {
+                _inPaste = true;
+                _pasted.ResetWrittenCount();
+                return;
+            }
+            if (param1 == 201)
+            {
+                // A paste end without a start
+                return;
+            }
+        }
+
+        var key = final switch
+        {
+            'A' => Hex1bKey.UpArrow,
+            'B' => Hex1bKey.DownArrow,
+            'C' => Hex1bKey.RightArrow,
+            'D' => Hex1bKey.LeftArrow,
+            'H' => Hex1bKey.Home,
+            'F' => Hex1bKey.End,
+            'Z' => Hex1bKey.Tab,
+            '~' => GetTildeKey(param1),
+            _ => Hex1bKey.None
+        };
+
+        if (key == Hex1bKey.None)
+            return;
+
+        var modifiers = Hex1bModifiers.None;
+        if (hasParam2 && param2 >= 2)
+        {
+            var modifierBits = param2 - 1;
+            if ((modifierBits & 1) != 0) modifiers |= Hex1bModifiers.Shift;
+            if ((modifierBits & 2) != 0) modifiers |= Hex1bModifiers.Alt;
+            if ((modifierBits & 4) != 0) modifiers |= Hex1bModifiers.Control;
+        }
+
+        if (final == 'Z')
+            modifiers |= Hex1bModifiers.Shift;
+
+        events.Add(new Hex1bKeyEvent(key, '\0', modifiers));
+    }
+
+    /// <summary>
+    /// Decodes the parameters of an SGR mouse report (button;x;y, after the '&lt;').
+    /// </summary>
+    private Hex1bMouseEvent? DecodeSgrMouse(ReadOnlySpan<byte> parameters, bool release)
+    {
+        var position = 0;
+        var buttonCode = ReadNumber(parameters, ref position);
+        if (!TrySkip(parameters, ref position, (byte)';'))
+            return null;
+        var x = ReadNumber(parameters, ref position);
+        if (!TrySkip(parameters, ref position, (byte)';'))
+            return null;
+        var y = ReadNumber(parameters, ref position);
+        if (position != parameters.Length || buttonCode > 0xff || x > 0xffff || y > 0xffff)
+            return null;
+
+        // Motion floods repeat the same few reports, so recent events are reused
+        var key = ((long)buttonCode << 33) | ((release ? 1L : 0L) << 32) | ((long)x << 16) | (long)y;
+        var slot = (int)((ulong)key * 0x9E3779B97F4A7C15UL >> 56);
+        ref var cached = ref _mouseEvents[slot];
+        if (cached.Event != null && cached.Key == key)
+        {
+            return cached.Event;
+        }
+
+        var mouseEvent = MouseParser.CreateSgrEvent(buttonCode, x, y, release);
+        cached = (key, mouseEvent);
+        return mouseEvent;
+    }
+
+    /// <summary>
+    /// Gathers bracketed paste content up to the end marker (ESC [ 201 ~), then emits it as
+    /// one <see cref="Hex1bPasteEvent"/>.
+    /// </summary>
+    /// <returns>The number of bytes consumed, or 0 if <paramref name="data"/> ends before it does.</returns>
+    private int DecodePasted(ReadOnlySpan<byte> data, List<Hex1bEvent> events, bool final)
+    {
+        var escape = data.IndexOf(Esc);
+        if (escape != 0)
+        {
+            // Everything up to the next ESC is pasted text, copied as is
+            var text = escape < 0 ? data : data[..escape];
+            text = text[..Math.Min(text.Length, MaxPasteLength - _pasted.WrittenCount)];
+            _pasted.Write(text);
+            if (_pasted.WrittenCount == MaxPasteLength)
+            {
+                EmitPaste(events, GetPasteSplit(_pasted.WrittenSpan));
+            }
+            return text.Length;
+        }
+
+        if (data.StartsWith(PasteEnd))
+        {
+            _inPaste = false;
+            EmitPaste(events, _pasted.WrittenCount);
+            return PasteEnd.Length;
+        }
+
+        if (!final && data.Length < PasteEnd.Length && PasteEnd.StartsWith(data))
+        {
+            return 0;
+        }
+
+        // Pasted text is text: an ESC in it is dropped rather than read as a key or sequence
+        return 1;
+    }
+
+    /// <summary>
+    /// Emits the first <paramref name="length"/> pasted bytes as a paste event, keeping the
+    /// rest for the next one.
+    /// </summary>
+    private void EmitPaste(List<Hex1bEvent> events, int length)
+    {
+        var pasted = _pasted.WrittenSpan;
+        events.Add(Hex1bPasteEvent.FromUtf8(pasted[..length]));
+
+        Span<byte> rest = stackalloc byte[pasted.Length - length];
+        pasted[length..].CopyTo(rest);
+
+        // Don't hold on to the buffer of a large paste
+        if (_pasted.Capacity > MaxRetainedPasteBuffer)
+        {
+            _pasted = new ArrayBufferWriter<byte>();
+        }
+        _pasted.ResetWrittenCount();
+        _pasted.Write(rest);
+    }
+
+    /// <summary>
+    /// Gets where to split a full paste buffer so neither part has half a character or half
+    /// a CR LF pair.
+    /// </summary>
+    private static int GetPasteSplit(ReadOnlySpan<byte> pasted)
+    {
+        // Back up over the continuation bytes of a character that may be incomplete
+        var start = pasted.Length - 1;
+        while (start > 0 && pasted.Length - start < 4 && (pasted[start] & 0xC0) == 0x80)
+        {
+            start--;
+        }
+
+        var split = Rune.DecodeFromUtf8(pasted[start..], out _, out _) == OperationStatus.NeedMoreData
+            ? start
+            : pasted.Length;
+        return split > 0 && pasted[split - 1] == (byte)'\r' ? split - 1 : split;
+    }
+
+    /// <summary>
+    /// Decodes one UTF-8 character into a key event.
+    /// </summary>
+    /// <returns>The number of bytes consumed, or 0 if <paramref name="data"/> ends before it does.</returns>
+    private static int DecodeCharacter(ReadOnlySpan<byte> data, List<Hex1bEvent> events, bool final)
+    {
+        var b = data[0];
+        if (b < 0x80)
+        {
+            if (AsciiKeys[b] is { } asciiKey)
+            {
+                events.Add(asciiKey);
+            }
+            return 1;
+        }
+
+        var status = Rune.DecodeFromUtf8(data, out var rune, out var consumed);
+        if (status == OperationStatus.NeedMoreData && !final)
+        {
+            return 0;
+        }
+
+        // Invalid and truncated characters decode to U+FFFD
+        if (GetKeyEvent(rune) is { } keyEvent)
+        {
+            events.Add(keyEvent);
+        }
+
+        return Math.Max(consumed, 1);
+    }
+
+    /// <summary>
+    /// Gets the key event for typing a character, or null for control characters that aren't keys.
+    /// </summary>
+    internal static Hex1bKeyEvent? GetKeyEvent(Rune rune)
+    {
+        if (rune.IsAscii)
+        {
+            return AsciiKeys[rune.Value];
+        }
+
+        if (rune.IsBmp)
+        {
+            var c = (char)rune.Value;
+            return char.IsControl(c) ? null : new Hex1bKeyEvent(Hex1bKey.None, c, Hex1bModifiers.None);
+        }
+
+        return Hex1bKeyEvent.FromText(rune.ToString());
+    }
+
+    private static int ReadNumber(ReadOnlySpan<byte> data, ref int position)
+    {
+        var value = 0;
+        while (position < data.Length && data[position] is >= (byte)'0' and <= (byte)'9')
+        {
+            // Saturate rather than overflow; no meaningful parameter is this large
+            value = Math.Min(value * 10 + (data[position] - '0'), 1_000_000);
+            position++;
+        }
+        return value;
+    }
+
+    private static bool TrySkip(ReadOnlySpan<byte> data, ref int position, byte expected)
+    {
+        if (position < data.Length && data[position] == expected)
+        {
+            position++;
+            return true;
+        }
+        return false;
+    }
+
+    private static Hex1bKey GetTildeKey(int param)
+    {
+        return param switch
+        {
+            1 => Hex1bKey.Home,
+            2 => Hex1bKey.Insert,
+            3 => Hex1bKey.Delete,
+            4 => Hex1bKey.End,
+            5 => Hex1bKey.PageUp,
+            6 => Hex1bKey.PageDown,
+            _ => Hex1bKey.None
+        };
+    }
+
+    private static Hex1bKey GetSs3Key(byte final)
+    {
+        return final switch
+        {
+            (byte)'A' => Hex1bKey.UpArrow,
+            (byte)'B' => Hex1bKey.DownArrow,
+            (byte)'C' => Hex1bKey.RightArrow,
+            (byte)'D' => Hex1bKey.LeftArrow,
+            (byte)'H' => Hex1bKey.Home,
+            (byte)'F' => Hex1bKey.End,
+            (byte)'P' => Hex1bKey.F1,
+            (byte)'Q' => Hex1bKey.F2,
+            (byte)'R' => Hex1bKey.F3,
+            (byte)'S' => Hex1bKey.F4,
+            _ => Hex1bKey.None
+        };
+    }
+
+    private static Hex1bKeyEvent?[] CreateAsciiKeys()
+    {
+        var keys = new Hex1bKeyEvent?[128];
+        for (var c = 0; c < keys.Length; c++)
+        {
+            keys[c] = CreateKeyEvent((char)c);
+        }
+        return keys;
+    }
+
+    private static Hex1bKeyEvent? CreateKeyEvent(char c)
+    {
+        return c switch
+        {
+            '\r' or '\n' => new Hex1bKeyEvent(Hex1bKey.Enter, c, Hex1bModifiers.None),
+            '\t' => new Hex1bKeyEvent(Hex1bKey.Tab, c, Hex1bModifiers.None),
+            '\x1b' => new Hex1bKeyEvent(Hex1bKey.Escape, c, Hex1bModifiers.None),
+            '\x7f' or '\b' => new Hex1bKeyEvent(Hex1bKey.Backspace, c, Hex1bModifiers.None),
+            ' ' => new Hex1bKeyEvent(Hex1bKey.Spacebar, c, Hex1bModifiers.None),
+            >= 'a' and <= 'z' => new Hex1bKeyEvent(
+                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.A + (c - 'a'))), c, Hex1bModifiers.None),
+            >= 'A' and <= 'Z' => new Hex1bKeyEvent(
+                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.A + (c - 'A'))), c, Hex1bModifiers.Shift),
+            >= '0' and <= '9' => new Hex1bKeyEvent(
+                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.D0 + (c - '0'))), c, Hex1bModifiers.None),
+            >= '\x01' and <= '\x1a' => new Hex1bKeyEvent(
+                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.A + (c - '\x01'))), c, Hex1bModifiers.Control),
+            _ when !char.IsControl(c) => new Hex1bKeyEvent(Hex1bKey.None, c, Hex1bModifiers.None),
+            _ => null
+        };
+    }
+
+    /// <summary>
+    /// Creates an Alt+key event (ESC followed by a character).
+    /// Returns null if the character cannot be an Alt+key combination.
+    /// </summary>
+    private static Hex1bKeyEvent? CreateAltKeyEvent(char c)
+    {
+        // Alt+letter (lowercase: Alt+F sends ESC f)
+        if (c >= 'a' && c <= 'z')
+        {
+            return new Hex1bKeyEvent(
+                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.A + (c - 'a'))), c, Hex1bModifiers.Alt);
+        }
+
+        // Alt+letter (uppercase: Alt+Shift+F sends ESC F)
+        if (c >= 'A' && c <= 'Z')
+        {
+            return new Hex1bKeyEvent(
+                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.A + (c - 'A'))), c, Hex1bModifiers.Alt | Hex1bModifiers.Shift);
+        }
+
+        // Alt+number (Alt+1 sends ESC 1)
+        if (c >= '0' && c <= '9')
+        {
+            return new Hex1bKeyEvent(
+                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.D0 + (c - '0'))), c, Hex1bModifiers.Alt);
+        }
+
+        // Unknown - don't treat as Alt+key
+        return null;
+    }
+}
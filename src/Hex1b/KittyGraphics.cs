@@ -0,0 +1,117 @@
+using System.Diagnostics.CodeAnalysis;
+using System.Text;
+
+namespace Hex1b;
+
+/// <summary>
+/// Builds kitty graphics protocol commands: uploading an image once under an ID, placing it
+/// by ID and deleting it.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Unlike Sixel, which sends the whole image every time it is drawn, a kitty image is sent
+/// once. Drawing it again is a placement of a few dozen bytes, and the terminal scales it to
+/// the cells it is placed in.
+/// </para>
+/// <para>
+/// Every command asks the terminal not to reply (<c>q=2</c>), so responses don't arrive as input.
+/// </para>
+/// </remarks>
+[Experimental("HEX1B_IMAGES", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/images.md")]
+public static class KittyGraphics
+{
+    /// <summary>
+    /// The most base64 data the protocol allows in one command. Larger uploads are split.
+    /// </summary>
+    public const int MaxChunkSize = 4096;
+
+    private const string ApcStart = "\x1b_G";
+    private const string ApcEnd = "\x1b\\";
+
+    /// <summary>
+    /// Builds the commands that upload RGBA pixels under <paramref name="imageId"/>, split
+    /// into chunks of at most <see cref="MaxChunkSize"/> base64 characters.
+    /// </summary>
+    /// <param name="imageId">The image ID, which must not be 0.</param>
+    /// <param name="rgba">The pixels, 4 bytes (R, G, B, A) per pixel, row by row.</param>
+    /// <param name="width">The image width in pixels.</param>
+    /// <param name="height">The image height in pixels.</param>
+    /// <returns>The upload, ready for terminal output. It doesn't show the image.</returns>
+    public static string Transmit(uint imageId, ReadOnlySpan<byte> rgba, int width, int height)
+    {
+        ArgumentOutOfRangeException.ThrowIfZero(imageId);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(width);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(height);
+
+        var length = (long)width * height * 4;
+        if (rgba.Length < length)
+        {
+            throw new ArgumentException($"Expected at least {length} bytes of RGBA data for a {width}x{height} image.", nameof(rgba));
+        }
+
+        var data = Convert.ToBase64String(rgba[..(int)length]);
+        var chunks = (data.Length + MaxChunkSize - 1) / MaxChunkSize;
+        var sb = new StringBuilder(data.Length + chunks * (ApcStart.Length + ApcEnd.Length + 4) + 48);
+
+        for (var offset = 0; offset < data.Length; offset += MaxChunkSize)
+        {
+            var chunkLength = Math.Min(MaxChunkSize, data.Length - offset);
+            var more = offset + chunkLength < data.Length;
+
+            sb.Append(ApcStart);
+            if (offset == 0)
+            {
+                // The first chunk carries the command; the rest only say whether more follow
+                sb.Append("a=t,f=32,s=").Append(width)
+                    .Append(",v=").Append(height)
+                    .Append(",i=").Append(imageId)
+                    .Append(",q=2,");
+            }
+            sb.Append(more ? "m=1;" : "m=0;");
+            sb.Append(data, offset, chunkLength);
+            sb.Append(ApcEnd);
+        }
+
+        return sb.ToString();
+    }
+
+    /// <summary>
+    /// Builds the command that places an uploaded image at the cursor, scaled to
+    /// <paramref name="columns"/> by <paramref name="rows"/> cells. The cursor doesn't move.
+    /// </summary>
+    /// <param name="imageId">The uploaded image's ID.</param>
+    /// <param name="placementId">
+    /// The placement's ID. Placing the image again with the same ID moves it rather than
+    /// showing it twice.
+    /// </param>
+    /// <param name="columns">The placement's width in cells.</param>
+    /// <param name="rows">The placement's height in cells.</param>
+    public static string Place(uint imageId, uint placementId, int columns, int rows)
+    {
+        ArgumentOutOfRangeException.ThrowIfZero(imageId);
+        ArgumentOutOfRangeException.ThrowIfZero(placementId);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(columns);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(rows);
+
+        return $"{ApcStart}a=p,i={imageId},p={placementId},c={columns},r={rows},C=1,q=2{ApcEnd}";
+    }
+
+    /// <summary>
+    /// Builds the command that deletes an image's placements, or one of them.
+    /// </summary>
+    /// <param name="imageId">The image ID.</param>
+    /// <param name="placementId">The placement to delete, or 0 for all of the image's placements.</param>
+    /// <param name="freeData">
+    /// Whether the terminal also frees the uploaded image, which must then be uploaded again
+    /// before it is placed.
+    /// </param>
+    public static string Delete(uint imageId, uint placementId = 0, bool freeData = false)
+    {
+        ArgumentOutOfRangeException.ThrowIfZero(imageId);
+
+        var target = freeData ? 'I' : 'i';
+        return placementId == 0
+            ? $"{ApcStart}a=d,d={target},i={imageId},q=2{ApcEnd}"
+            : $"{ApcStart}a=d,d={target},i={imageId},p={placementId},q=2{ApcEnd}";
+    }
+}
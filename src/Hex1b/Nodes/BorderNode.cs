@@ -101,8 +101,8 @@ public sealed class BorderNode : Hex1bNode, ILayoutProvider
     public override void Render(Hex1bRenderContext context)
     {
         var theme = context.Theme;
-        var borderColor = theme.Get(BorderTheme.BorderColor);
-        var titleColor = theme.Get(BorderTheme.TitleColor);
+        var borderColorCode = theme.GetForegroundAnsi(BorderTheme.BorderColor);
+        var titleColorCode = theme.GetForegroundAnsi(BorderTheme.TitleColor);
         var topLeft = theme.Get(BorderTheme.TopLeftCorner);
         var topRight = theme.Get(BorderTheme.TopRightCorner);
         var bottomLeft = theme.Get(BorderTheme.BottomLeftCorner);
@@ -117,8 +117,8 @@ public sealed class BorderNode : Hex1bNode, ILayoutProvider
 
         // Apply border color with global background
         var globalBg = theme.GetGlobalBackground();
-        var globalBgAnsi = globalBg.IsDefault ? "" : globalBg.ToBackgroundAnsi();
-        var colorCode = $"{globalBgAnsi}{borderColor.ToForegroundAnsi()}";
+        var globalBgAnsi = globalBg.IsDefault ? "" : theme.GetBackgroundAnsi(GlobalTheme.BackgroundColor);
+        var colorCode = $"{globalBgAnsi}{borderColorCode}";
         var resetToGlobal = theme.GetResetToGlobalCodes();
         
         var innerWidth = Math.Max(0, width - 2);
@@ -133,7 +133,7 @@ public sealed class BorderNode : Hex1bNode, ILayoutProvider
             
             topLine = $"{colorCode}{topLeft}" +
                       new string(horizontal[0], leftPadding) +
-                      $"{globalBgAnsi}{titleColor.ToForegroundAnsi()}{titleToShow}{colorCode}" +
+                      $"{globalBgAnsi}{titleColorCode}{titleToShow}{colorCode}" +
                       new string(horizontal[0], rightPadding) +
                       $"{topRight}{resetToGlobal}";
         }
@@ -168,15 +168,12 @@ public sealed class BorderNode : Hex1bNode, ILayoutProvider
         // Render child content with this border as the layout provider for clipping
         if (Child != null)
         {
-            var previousLayout = context.CurrentLayoutProvider;
-            ParentLayoutProvider = previousLayout;
-            context.CurrentLayoutProvider = this;
+            context.PushLayoutProvider(this);
             
             context.SetCursorPosition(Child.Bounds.X, Child.Bounds.Y);
             Child.Render(context);
             
-            context.CurrentLayoutProvider = previousLayout;
-            ParentLayoutProvider = null;
+            context.PopLayoutProvider();
         }
     }
 
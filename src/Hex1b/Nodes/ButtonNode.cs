@@ -78,39 +78,45 @@ public sealed class ButtonNode : Hex1bNode
         var theme = context.Theme;
         var leftBracket = theme.Get(ButtonTheme.LeftBracket);
         var rightBracket = theme.Get(ButtonTheme.RightBracket);
-        var resetToGlobal = theme.GetResetToGlobalCodes();
         
-        string output;
+        TextStyle style;
         if (IsFocused)
         {
-            var fg = theme.Get(ButtonTheme.FocusedForegroundColor);
-            var bg = theme.Get(ButtonTheme.FocusedBackgroundColor);
-            output = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{leftBracket}{Label}{rightBracket}{resetToGlobal}";
+            style = new TextStyle(
+                theme.Get(ButtonTheme.FocusedForegroundColor),
+                theme.Get(ButtonTheme.FocusedBackgroundColor));
         }
         else if (IsHovered)
         {
-            var fg = theme.Get(ButtonTheme.HoveredForegroundColor);
-            var bg = theme.Get(ButtonTheme.HoveredBackgroundColor);
-            output = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{leftBracket}{Label}{rightBracket}{resetToGlobal}";
+            style = new TextStyle(
+                theme.Get(ButtonTheme.HoveredForegroundColor),
+                theme.Get(ButtonTheme.HoveredBackgroundColor));
         }
         else
         {
             var fg = theme.Get(ButtonTheme.ForegroundColor);
             var bg = theme.Get(ButtonTheme.BackgroundColor);
             // Use global colors if theme colors are default
-            var fgCode = fg.IsDefault ? theme.GetGlobalForeground().ToForegroundAnsi() : fg.ToForegroundAnsi();
-            var bgCode = bg.IsDefault ? theme.GetGlobalBackground().ToBackgroundAnsi() : bg.ToBackgroundAnsi();
-            output = $"{fgCode}{bgCode}{leftBracket}{Label}{rightBracket}{resetToGlobal}";
+            style = new TextStyle(
+                fg.IsDefault ? theme.GetGlobalForeground() : fg,
+                bg.IsDefault ? theme.GetGlobalBackground() : bg);
         }
         
+        ReadOnlySpan<StyledRun> runs =
+        [
+            new StyledRun(leftBracket, style),
+            new StyledRun(Label, style),
+            new StyledRun(rightBracket, style),
+        ];
+        
         // Use clipped rendering when a layout provider is active
         if (context.CurrentLayoutProvider != null)
         {
-            context.WriteClipped(Bounds.X, Bounds.Y, output);
+            context.WriteClipped(Bounds.X, Bounds.Y, runs);
         }
         else
         {
-            context.Write(output);
+            context.Write(runs);
         }
     }
 }
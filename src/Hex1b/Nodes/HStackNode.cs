@@ -127,9 +127,7 @@ public sealed class HStackNode : Hex1bNode, ILayoutProvider
 
     public override void Render(Hex1bRenderContext context)
     {
-        var previousLayout = context.CurrentLayoutProvider;
-        ParentLayoutProvider = previousLayout;
-        context.CurrentLayoutProvider = this;
+        context.PushLayoutProvider(this);
         
         // Render children at their positioned bounds
         for (int i = 0; i < Children.Count; i++)
@@ -138,8 +136,7 @@ public sealed class HStackNode : Hex1bNode, ILayoutProvider
             Children[i].Render(context);
         }
         
-        context.CurrentLayoutProvider = previousLayout;
-        ParentLayoutProvider = null;
+        context.PopLayoutProvider();
     }
 
     public override void ConfigureDefaultBindings(InputBindingsBuilder bindings)
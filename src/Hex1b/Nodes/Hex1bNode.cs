@@ -191,6 +191,16 @@ public abstract class Hex1bNode
     /// <returns>Handled if the input was consumed, NotHandled otherwise.</returns>
     public virtual InputResult HandleInput(Hex1bKeyEvent keyEvent) => InputResult.NotHandled;
 
+    /// <summary>
+    /// Handles pasted text as a whole. Override this in nodes that accept text to insert a
+    /// paste in one operation; pastes no node handles are typed as key events instead.
+    /// </summary>
+    /// <param name="pasteEvent">The paste event.</param>
+    /// <param name="context">The action context, for firing change handlers.</param>
+    /// <returns>Handled if the paste was consumed, NotHandled otherwise.</returns>
+    public virtual Task<InputResult> HandlePasteAsync(Hex1bPasteEvent pasteEvent, InputBindingActionContext context)
+        => Task.FromResult(InputResult.NotHandled);
+
     /// <summary>
     /// Handles a mouse click event (after mouse bindings have been checked).
     /// Override this in nodes to handle clicks that weren't matched by any mouse binding.
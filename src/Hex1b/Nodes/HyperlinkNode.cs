@@ -35,6 +35,7 @@ public sealed class HyperlinkNode : Hex1bNode
             if (_uri != value)
             {
                 _uri = value;
+                _osc8Start = null;
                 MarkDirty();
             }
         }
@@ -49,11 +50,18 @@ public sealed class HyperlinkNode : Hex1bNode
             if (_parameters != value)
             {
                 _parameters = value;
+                _osc8Start = null;
                 MarkDirty();
             }
         }
     }
 
+    /// <summary>
+    /// The OSC 8 sequence opening the link, built once per URI and parameters so re-renders
+    /// write the same string (which the terminal resolves to the link it already holds).
+    /// </summary>
+    private string? _osc8Start;
+
     private TextOverflow _overflow = TextOverflow.Truncate;
     public TextOverflow Overflow 
     { 
@@ -336,7 +344,7 @@ public sealed class HyperlinkNode : Hex1bNode
         var resetToGlobal = theme.GetResetToGlobalCodes();
         
         // OSC 8 format: ESC ] 8 ; params ; URI ST text ESC ] 8 ; ; ST
-        var osc8Start = FormatOsc8Start(Uri, Parameters);
+        var osc8Start = _osc8Start ??= FormatOsc8Start(Uri, Parameters);
         var osc8End = "\x1b]8;;\x1b\\";
         
         // Apply styling based on focus/hover state
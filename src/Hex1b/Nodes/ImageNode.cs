@@ -0,0 +1,211 @@
+#pragma warning disable HEX1B_SIXEL // Sixel API is experimental - internal usage is allowed
+
+using System.Diagnostics.CodeAnalysis;
+using Hex1b.Layout;
+
+namespace Hex1b.Nodes;
+
+/// <summary>
+/// A node that shows an image with the best protocol the terminal supports: kitty graphics,
+/// then Sixel, otherwise the fallback node.
+/// </summary>
+/// <remarks>
+/// With kitty graphics the image is uploaded the first time the node renders it and placed
+/// by ID from then on, so redrawing it costs a few bytes rather than the whole image.
+/// </remarks>
+[Experimental("HEX1B_IMAGES", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/images.md")]
+public sealed class ImageNode : Hex1bNode
+{
+    private static uint _nextPlacementId;
+
+    // Each node has its own placement, so placing again moves it rather than adding another
+    private readonly uint _placementId = NextPlacementId();
+
+    private TerminalImage? _image;
+    private TerminalImage? _placedImage;
+    private TerminalImage? _uploadedImage;
+
+    /// <summary>
+    /// The image to show.
+    /// </summary>
+    public TerminalImage? Image
+    {
+        get => _image;
+        set
+        {
+            if (ReferenceEquals(_image, value))
+                return;
+
+            _image = value;
+            MarkDirty();
+        }
+    }
+
+    /// <summary>
+    /// The fallback node to render if the terminal supports no image protocol.
+    /// </summary>
+    public Hex1bNode? Fallback { get; set; }
+
+    /// <summary>
+    /// Requested width in character cells. If null, 40 cells.
+    /// </summary>
+    private int? _requestedWidth;
+    public int? RequestedWidth
+    {
+        get => _requestedWidth;
+        set
+        {
+            if (_requestedWidth != value)
+            {
+                _requestedWidth = value;
+                MarkDirty();
+            }
+        }
+    }
+
+    /// <summary>
+    /// Requested height in character cells. If null, 20 cells.
+    /// </summary>
+    private int? _requestedHeight;
+    public int? RequestedHeight
+    {
+        get => _requestedHeight;
+        set
+        {
+            if (_requestedHeight != value)
+            {
+                _requestedHeight = value;
+                MarkDirty();
+            }
+        }
+    }
+
+    public override Size Measure(Constraints constraints)
+    {
+        // As with SixelNode, which way the image is shown isn't known until render
+        var fallbackSize = Fallback?.Measure(constraints) ?? Size.Zero;
+        var imageSize = constraints.Constrain(new Size(RequestedWidth ?? 40, RequestedHeight ?? 20));
+
+        return new Size(
+            Math.Max(fallbackSize.Width, imageSize.Width),
+            Math.Max(fallbackSize.Height, imageSize.Height));
+    }
+
+    public override void Arrange(Rect bounds)
+    {
+        base.Arrange(bounds);
+        Fallback?.Arrange(bounds);
+    }
+
+    public override IEnumerable<Hex1bNode> GetFocusableNodes()
+    {
+        if (Fallback != null)
+        {
+            foreach (var focusable in Fallback.GetFocusableNodes())
+            {
+                yield return focusable;
+            }
+        }
+    }
+
+    public override void Render(Hex1bRenderContext context)
+    {
+        var capabilities = context.Capabilities;
+
+        if (capabilities.SupportsKittyGraphics)
+        {
+            RenderKitty(context);
+        }
+        else if (capabilities.SupportsSixel)
+        {
+            RenderSixel(context);
+        }
+        else
+        {
+            RenderFallback(context);
+        }
+    }
+
+    private void RenderKitty(Hex1bRenderContext context)
+    {
+        // A placement of a different image (or of none) comes off the screen first
+        if (_placedImage != null && !ReferenceEquals(_placedImage, _image))
+        {
+            DeleteKittyPlacement(context);
+        }
+
+        if (_image == null)
+        {
+            context.SetCursorPosition(Bounds.X, Bounds.Y);
+            context.Write("[No image data]");
+            return;
+        }
+
+        // Hidden by a zero size: clearing the cells wouldn't take the image off the screen
+        if (Bounds.Width <= 0 || Bounds.Height <= 0)
+        {
+            DeleteKittyPlacement(context);
+            return;
+        }
+
+        // The image is uploaded once; every render after that is just the placement
+        if (!ReferenceEquals(_uploadedImage, _image))
+        {
+            context.Write(_image.KittyTransmission);
+            _uploadedImage = _image;
+        }
+
+        context.SetCursorPosition(Bounds.X, Bounds.Y);
+        context.Write(KittyGraphics.Place(_image.Id, _placementId, Bounds.Width, Bounds.Height));
+        _placedImage = _image;
+        context.TrackKittyPlacement(this);
+    }
+
+    /// <summary>
+    /// Deletes the node's kitty placement, if it has one on screen.
+    /// </summary>
+    internal void DeleteKittyPlacement(Hex1bRenderContext context)
+    {
+        if (_placedImage == null)
+            return;
+
+        context.Write(KittyGraphics.Delete(_placedImage.Id, _placementId));
+        context.UntrackKittyPlacement(this);
+        _placedImage = null;
+    }
+
+    private void RenderSixel(Hex1bRenderContext context)
+    {
+        context.SetCursorPosition(Bounds.X, Bounds.Y);
+        context.Write(_image == null ? "[No image data]" : _image.Sixel.Payload);
+    }
+
+    private void RenderFallback(Hex1bRenderContext context)
+    {
+        if (Fallback != null)
+        {
+            Fallback.Render(context);
+        }
+        else
+        {
+            context.SetCursorPosition(Bounds.X, Bounds.Y);
+            context.Write("[Images not supported]");
+        }
+    }
+
+    private static uint NextPlacementId()
+    {
+        // Placement IDs are 32-bit and 0 means none
+        var id = Interlocked.Increment(ref _nextPlacementId);
+        return id != 0 ? id : Interlocked.Increment(ref _nextPlacementId);
+    }
+
+    /// <summary>
+    /// Gets the direct children of this container for input routing.
+    /// Always returns fallback as a potential child - actual rendering depends on capabilities.
+    /// </summary>
+    public override IEnumerable<Hex1bNode> GetChildren()
+    {
+        if (Fallback != null) yield return Fallback;
+    }
+}
@@ -50,14 +50,11 @@ public sealed class LayoutNode : Hex1bNode, ILayoutProvider
     public override void Render(Hex1bRenderContext context)
     {
         // Store ourselves as the current layout provider in the context
-        var previousLayout = context.CurrentLayoutProvider;
-        ParentLayoutProvider = previousLayout;
-        context.CurrentLayoutProvider = this;
+        context.PushLayoutProvider(this);
         
         Child?.Render(context);
         
-        context.CurrentLayoutProvider = previousLayout;
-        ParentLayoutProvider = null;
+        context.PopLayoutProvider();
     }
 
     /// <summary>
@@ -27,22 +27,26 @@ public static class LayoutProviderHelper
         return clipRect;
     }
     
+    /// <summary>
+    /// Gets whether a provider leaves its content unclipped. Only an overflow provider whose
+    /// parent (if any) also overflows is unclipped; otherwise the full effective rect applies.
+    /// </summary>
+    public static bool IsUnclipped(ILayoutProvider provider)
+    {
+        return provider.ClipMode == ClipMode.Overflow &&
+               (provider.ParentLayoutProvider == null || provider.ParentLayoutProvider.ClipMode == ClipMode.Overflow);
+    }
+    
     /// <summary>
     /// Determines if a character at the given absolute position should be rendered,
     /// considering both this provider's clip rect and any parent's.
     /// </summary>
     public static bool ShouldRenderAt(ILayoutProvider provider, int x, int y)
     {
-        if (provider.ClipMode == ClipMode.Overflow && 
-            (provider.ParentLayoutProvider == null || provider.ParentLayoutProvider.ClipMode == ClipMode.Overflow))
+        if (IsUnclipped(provider))
             return true;
         
-        var effectiveRect = GetEffectiveClipRect(provider);
-        
-        return x >= effectiveRect.X && 
-               x < effectiveRect.X + effectiveRect.Width &&
-               y >= effectiveRect.Y && 
-               y < effectiveRect.Y + effectiveRect.Height;
+        return GetEffectiveClipRect(provider).Contains(x, y);
     }
     
     /// <summary>
@@ -50,12 +54,17 @@ public static class LayoutProviderHelper
     /// </summary>
     public static (int adjustedX, string clippedText) ClipString(ILayoutProvider provider, int x, int y, string text)
     {
-        if (provider.ClipMode == ClipMode.Overflow && 
-            (provider.ParentLayoutProvider == null || provider.ParentLayoutProvider.ClipMode == ClipMode.Overflow))
+        if (IsUnclipped(provider))
             return (x, text);
         
-        var effectiveRect = GetEffectiveClipRect(provider);
-        
+        return ClipString(GetEffectiveClipRect(provider), x, y, text);
+    }
+    
+    /// <summary>
+    /// Clips a string to an already resolved effective clip rect.
+    /// </summary>
+    internal static (int adjustedX, string clippedText) ClipString(Rect effectiveRect, int x, int y, string text)
+    {
         // If entire line is outside vertical bounds, return empty
         if (y < effectiveRect.Y || y >= effectiveRect.Y + effectiveRect.Height)
             return (x, "");
@@ -107,11 +116,40 @@ public static class LayoutProviderHelper
         return (adjustedX, clippedText);
     }
     
+    /// <summary>
+    /// Gets the range of columns that may be drawn on row <paramref name="y"/>.
+    /// Used by styled-run rendering, which clips by run width instead of re-parsing text.
+    /// </summary>
+    /// <returns>False if nothing on the row is visible.</returns>
+    public static bool TryGetClipColumns(ILayoutProvider provider, int y, out int clipLeft, out int clipRight)
+    {
+        if (IsUnclipped(provider))
+        {
+            clipLeft = int.MinValue;
+            clipRight = int.MaxValue;
+            return true;
+        }
+
+        return TryGetClipColumns(GetEffectiveClipRect(provider), y, out clipLeft, out clipRight);
+    }
+
+    /// <summary>
+    /// Gets the range of columns that may be drawn on row <paramref name="y"/> of an
+    /// already resolved effective clip rect.
+    /// </summary>
+    internal static bool TryGetClipColumns(Rect effectiveRect, int y, out int clipLeft, out int clipRight)
+    {
+        clipLeft = effectiveRect.X;
+        clipRight = effectiveRect.Right;
+
+        return y >= effectiveRect.Y && y < effectiveRect.Bottom && clipLeft < clipRight;
+    }
+
     /// <summary>
     /// Computes the intersection of two rectangles.
     /// Returns a zero-sized rect if they don't overlap.
     /// </summary>
-    private static Rect IntersectRects(Rect a, Rect b)
+    internal static Rect IntersectRects(Rect a, Rect b)
     {
         var left = Math.Max(a.X, b.X);
         var top = Math.Max(a.Y, b.Y);
@@ -158,8 +158,8 @@ public sealed class ListNode : Hex1bNode
         bindings.Mouse(MouseButton.Left).Action(MouseSelectAndActivate, "Select and activate item");
         
         // Mouse wheel scrolling - navigates selection like arrow keys (ignores cursor position)
-        bindings.Mouse(MouseButton.ScrollUp).Action(MoveUpWithEvent, "Scroll up");
-        bindings.Mouse(MouseButton.ScrollDown).Action(MoveDownWithEvent, "Scroll down");
+        bindings.Mouse(MouseButton.ScrollUp).Action(ScrollUpWithEvent, "Scroll up");
+        bindings.Mouse(MouseButton.ScrollDown).Action(ScrollDownWithEvent, "Scroll down");
     }
 
     private async Task MouseSelectAndActivate(InputBindingActionContext ctx)
@@ -214,6 +214,33 @@ public sealed class ListNode : Hex1bNode
         }
     }
 
+    private async Task ScrollUpWithEvent(InputBindingActionContext ctx)
+    {
+        // One step per wheel tick; whole laps around the list are no-ops
+        var steps = Items.Count == 0 ? 0 : ctx.ScrollTicks % Items.Count;
+        for (var i = 0; i < steps; i++)
+        {
+            MoveUp();
+        }
+        if (SelectionChangedAction != null)
+        {
+            await SelectionChangedAction(ctx);
+        }
+    }
+
+    private async Task ScrollDownWithEvent(InputBindingActionContext ctx)
+    {
+        var steps = Items.Count == 0 ? 0 : ctx.ScrollTicks % Items.Count;
+        for (var i = 0; i < steps; i++)
+        {
+            MoveDown();
+        }
+        if (SelectionChangedAction != null)
+        {
+            await SelectionChangedAction(ctx);
+        }
+    }
+
     /// <summary>
     /// Moves selection up (with wrap-around).
     /// </summary>
@@ -321,8 +348,7 @@ public sealed class ListNode : Hex1bNode
         var hoveredBg = theme.Get(ListTheme.HoveredBackgroundColor);
         
         // Get global colors for non-selected items
-        var globalColors = theme.GetGlobalColorCodes();
-        var resetToGlobal = theme.GetResetToGlobalCodes();
+        var globalStyle = theme.GetGlobalTextStyle();
         
         // Calculate which item is hovered (if any)
         var hoveredItemIndex = -1;
@@ -349,37 +375,42 @@ public sealed class ListNode : Hex1bNode
             var x = Bounds.X;
             var y = Bounds.Y + (i - _scrollOffset);  // Adjust y position for scroll offset
             
-            string text;
+            TextStyle style;
+            string indicator;
             if (isSelected && IsFocused)
             {
                 // Focused and selected: use theme colors
-                text = $"{selectedFg.ToForegroundAnsi()}{selectedBg.ToBackgroundAnsi()}{selectedIndicator}{item}{resetToGlobal}";
+                style = new TextStyle(selectedFg, selectedBg);
+                indicator = selectedIndicator;
             }
             else if (isHoveredItem && !isSelected)
             {
                 // Hovered but not selected: use hover colors
-                text = $"{hoveredFg.ToForegroundAnsi()}{hoveredBg.ToBackgroundAnsi()}{unselectedIndicator}{item}{resetToGlobal}";
-            }
-            else if (isSelected)
-            {
-                // Selected but not focused: just show indicator with global colors
-                text = $"{globalColors}{selectedIndicator}{item}{resetToGlobal}";
+                style = new TextStyle(hoveredFg, hoveredBg);
+                indicator = unselectedIndicator;
             }
             else
             {
-                // Not selected: use global colors
-                text = $"{globalColors}{unselectedIndicator}{item}{resetToGlobal}";
+                // Not focused or not selected: use global colors
+                style = globalStyle;
+                indicator = isSelected ? selectedIndicator : unselectedIndicator;
             }
 
+            ReadOnlySpan<StyledRun> runs =
+            [
+                new StyledRun(indicator, style),
+                new StyledRun(item, style),
+            ];
+
             // Use clipped rendering when a layout provider is active
             if (context.CurrentLayoutProvider != null)
             {
-                context.WriteClipped(x, y, text);
+                context.WriteClipped(x, y, runs);
             }
             else
             {
                 context.SetCursorPosition(x, y);
-                context.Write(text);
+                context.Write(runs);
             }
         }
     }
@@ -321,9 +321,7 @@ public sealed class MenuBarNode : Hex1bNode, ILayoutProvider
         var resetToGlobal = theme.GetResetToGlobalCodes();
         
         // Set layout context
-        var previousLayout = context.CurrentLayoutProvider;
-        ParentLayoutProvider = previousLayout;
-        context.CurrentLayoutProvider = this;
+        context.PushLayoutProvider(this);
         
         // Fill background for the entire bar width
         var bgCode = bg.IsDefault ? "" : bg.ToBackgroundAnsi();
@@ -339,7 +337,6 @@ public sealed class MenuBarNode : Hex1bNode, ILayoutProvider
             node.Render(context);
         }
         
-        context.CurrentLayoutProvider = previousLayout;
-        ParentLayoutProvider = null;
+        context.PopLayoutProvider();
     }
 }
@@ -327,34 +327,34 @@ public sealed class MenuItemNode : Hex1bNode
         if (IsDisabled)
         {
             // Disabled: gray out
-            var fg = theme.Get(MenuItemTheme.DisabledForegroundColor);
-            var bg = theme.Get(MenuItemTheme.BackgroundColor);
-            var output = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{paddedLabel}{resetToGlobal}";
+            var fg = theme.GetForegroundAnsi(MenuItemTheme.DisabledForegroundColor);
+            var bg = theme.GetBackgroundAnsi(MenuItemTheme.BackgroundColor);
+            var output = $"{fg}{bg}{paddedLabel}{resetToGlobal}";
             WriteOutput(context, output);
         }
         else if (IsFocused)
         {
             // Focused: highlight
-            var fg = theme.Get(MenuItemTheme.FocusedForegroundColor);
-            var bg = theme.Get(MenuItemTheme.FocusedBackgroundColor);
-            var output = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{paddedLabel}{resetToGlobal}";
+            var fg = theme.GetForegroundAnsi(MenuItemTheme.FocusedForegroundColor);
+            var bg = theme.GetBackgroundAnsi(MenuItemTheme.FocusedBackgroundColor);
+            var output = $"{fg}{bg}{paddedLabel}{resetToGlobal}";
             WriteOutput(context, output);
         }
         else if (IsHovered)
         {
             // Hovered: subtle gray highlight
-            var fg = theme.Get(MenuItemTheme.HoveredForegroundColor);
-            var bg = theme.Get(MenuItemTheme.HoveredBackgroundColor);
-            var output = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{paddedLabel}{resetToGlobal}";
+            var fg = theme.GetForegroundAnsi(MenuItemTheme.HoveredForegroundColor);
+            var bg = theme.GetBackgroundAnsi(MenuItemTheme.HoveredBackgroundColor);
+            var output = $"{fg}{bg}{paddedLabel}{resetToGlobal}";
             WriteOutput(context, output);
         }
         else
         {
             // Normal: render with accelerator highlighting
-            var fg = theme.Get(MenuItemTheme.ForegroundColor);
-            var bg = theme.Get(MenuItemTheme.BackgroundColor);
-            var accelFg = theme.Get(MenuItemTheme.AcceleratorForegroundColor);
-            var accelBg = theme.Get(MenuItemTheme.AcceleratorBackgroundColor);
+            var fg = theme.GetForegroundAnsi(MenuItemTheme.ForegroundColor);
+            var bg = theme.GetBackgroundAnsi(MenuItemTheme.BackgroundColor);
+            var accelFg = theme.GetForegroundAnsi(MenuItemTheme.AcceleratorForegroundColor);
+            var accelBg = theme.GetBackgroundAnsi(MenuItemTheme.AcceleratorBackgroundColor);
             var accelUnderline = theme.Get(MenuItemTheme.AcceleratorUnderline);
             
             var output = RenderWithAccelerator(paddedLabel, AcceleratorIndex, fg, bg, accelFg, accelBg, accelUnderline, resetToGlobal);
@@ -378,25 +378,25 @@ public sealed class MenuItemNode : Hex1bNode
     private static string RenderWithAccelerator(
         string text,
         int accelIndex,
-        Hex1bColor fg,
-        Hex1bColor bg,
-        Hex1bColor accelFg,
-        Hex1bColor accelBg,
+        string fg,
+        string bg,
+        string accelFg,
+        string accelBg,
         bool accelUnderline,
         string resetToGlobal)
     {
         if (accelIndex < 0 || accelIndex >= text.Length)
         {
             // No accelerator, just render plain
-            return $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{text}{resetToGlobal}";
+            return $"{fg}{bg}{text}{resetToGlobal}";
         }
         
         var before = text[..accelIndex];
         var accelChar = text[accelIndex];
         var after = text[(accelIndex + 1)..];
         
-        var normalCodes = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}";
-        var accelCodes = $"{accelFg.ToForegroundAnsi()}{accelBg.ToBackgroundAnsi()}";
+        var normalCodes = $"{fg}{bg}";
+        var accelCodes = $"{accelFg}{accelBg}";
         if (accelUnderline)
         {
             accelCodes += "\x1b[4m"; // Underline on
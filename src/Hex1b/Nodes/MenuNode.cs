@@ -415,26 +415,26 @@ public sealed class MenuNode : Hex1bNode, ILayoutProvider
         // Show focused styling when: focused (keyboard nav), selected, or open
         if (IsFocused || IsSelected || IsOpen)
         {
-            var fg = theme.Get(MenuBarTheme.FocusedForegroundColor);
-            var bg = theme.Get(MenuBarTheme.FocusedBackgroundColor);
-            var output = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{text}{resetToGlobal}";
+            var fg = theme.GetForegroundAnsi(MenuBarTheme.FocusedForegroundColor);
+            var bg = theme.GetBackgroundAnsi(MenuBarTheme.FocusedBackgroundColor);
+            var output = $"{fg}{bg}{text}{resetToGlobal}";
             WriteOutput(context, output);
         }
         else if (IsHovered)
         {
             // Hovered: subtle gray highlight
-            var fg = theme.Get(MenuBarTheme.HoveredForegroundColor);
-            var bg = theme.Get(MenuBarTheme.HoveredBackgroundColor);
-            var output = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{text}{resetToGlobal}";
+            var fg = theme.GetForegroundAnsi(MenuBarTheme.HoveredForegroundColor);
+            var bg = theme.GetBackgroundAnsi(MenuBarTheme.HoveredBackgroundColor);
+            var output = $"{fg}{bg}{text}{resetToGlobal}";
             WriteOutput(context, output);
         }
         else
         {
             // Normal with accelerator
-            var fg = theme.Get(MenuBarTheme.ForegroundColor);
-            var bg = theme.Get(MenuBarTheme.BackgroundColor);
-            var accelFg = theme.Get(MenuBarTheme.AcceleratorForegroundColor);
-            var accelBg = theme.Get(MenuBarTheme.AcceleratorBackgroundColor);
+            var fg = theme.GetForegroundAnsi(MenuBarTheme.ForegroundColor);
+            var bg = theme.GetBackgroundAnsi(MenuBarTheme.BackgroundColor);
+            var accelFg = theme.GetForegroundAnsi(MenuBarTheme.AcceleratorForegroundColor);
+            var accelBg = theme.GetBackgroundAnsi(MenuBarTheme.AcceleratorBackgroundColor);
             var accelUnderline = theme.Get(MenuBarTheme.AcceleratorUnderline);
             
             // Adjust accelerator index for the leading space
@@ -456,25 +456,25 @@ public sealed class MenuNode : Hex1bNode, ILayoutProvider
         // Use IsSelected for styling in submenus (focus navigates, selection highlights)
         if (IsSelected || IsFocused)
         {
-            var fg = theme.Get(MenuItemTheme.FocusedForegroundColor);
-            var bg = theme.Get(MenuItemTheme.FocusedBackgroundColor);
-            var output = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{paddedLabel}{resetToGlobal}";
+            var fg = theme.GetForegroundAnsi(MenuItemTheme.FocusedForegroundColor);
+            var bg = theme.GetBackgroundAnsi(MenuItemTheme.FocusedBackgroundColor);
+            var output = $"{fg}{bg}{paddedLabel}{resetToGlobal}";
             WriteOutput(context, output);
         }
         else if (IsHovered)
         {
-            var fg = theme.Get(MenuItemTheme.HoveredForegroundColor);
-            var bg = theme.Get(MenuItemTheme.HoveredBackgroundColor);
-            var output = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{paddedLabel}{resetToGlobal}";
+            var fg = theme.GetForegroundAnsi(MenuItemTheme.HoveredForegroundColor);
+            var bg = theme.GetBackgroundAnsi(MenuItemTheme.HoveredBackgroundColor);
+            var output = $"{fg}{bg}{paddedLabel}{resetToGlobal}";
             WriteOutput(context, output);
         }
         else
         {
             // Normal with accelerator
-            var fg = theme.Get(MenuItemTheme.ForegroundColor);
-            var bg = theme.Get(MenuItemTheme.BackgroundColor);
-            var accelFg = theme.Get(MenuItemTheme.AcceleratorForegroundColor);
-            var accelBg = theme.Get(MenuItemTheme.AcceleratorBackgroundColor);
+            var fg = theme.GetForegroundAnsi(MenuItemTheme.ForegroundColor);
+            var bg = theme.GetBackgroundAnsi(MenuItemTheme.BackgroundColor);
+            var accelFg = theme.GetForegroundAnsi(MenuItemTheme.AcceleratorForegroundColor);
+            var accelBg = theme.GetBackgroundAnsi(MenuItemTheme.AcceleratorBackgroundColor);
             var accelUnderline = theme.Get(MenuItemTheme.AcceleratorUnderline);
             
             var output = RenderWithAccelerator(paddedLabel, AcceleratorIndex, fg, bg, accelFg, accelBg, accelUnderline, resetToGlobal);
@@ -498,24 +498,24 @@ public sealed class MenuNode : Hex1bNode, ILayoutProvider
     private static string RenderWithAccelerator(
         string text,
         int accelIndex,
-        Hex1bColor fg,
-        Hex1bColor bg,
-        Hex1bColor accelFg,
-        Hex1bColor accelBg,
+        string fg,
+        string bg,
+        string accelFg,
+        string accelBg,
         bool accelUnderline,
         string resetToGlobal)
     {
         if (accelIndex < 0 || accelIndex >= text.Length)
         {
-            return $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}{text}{resetToGlobal}";
+            return $"{fg}{bg}{text}{resetToGlobal}";
         }
         
         var before = text[..accelIndex];
         var accelChar = text[accelIndex];
         var after = text[(accelIndex + 1)..];
         
-        var normalCodes = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}";
-        var accelCodes = $"{accelFg.ToForegroundAnsi()}{accelBg.ToBackgroundAnsi()}";
+        var normalCodes = $"{fg}{bg}";
+        var accelCodes = $"{accelFg}{accelBg}";
         if (accelUnderline)
         {
             accelCodes += "\x1b[4m";
@@ -410,9 +410,7 @@ public sealed class MenuPopupNode : Hex1bNode, ILayoutProvider
         var contentCodes = $"{fg.ToForegroundAnsi()}{bg.ToBackgroundAnsi()}";
         
         // Set layout context
-        var previousLayout = context.CurrentLayoutProvider;
-        ParentLayoutProvider = previousLayout;
-        context.CurrentLayoutProvider = this;
+        context.PushLayoutProvider(this);
         
         // Top border
         var topBorder = $"{borderCodes}{topLeft}{new string(horizontal, _contentWidth)}{topRight}{resetToGlobal}";
@@ -438,7 +436,6 @@ public sealed class MenuPopupNode : Hex1bNode, ILayoutProvider
         var bottomBorder = $"{borderCodes}{bottomLeft}{new string(horizontal, _contentWidth)}{bottomRight}{resetToGlobal}";
         context.WriteClipped(Bounds.X, bottomY, bottomBorder);
         
-        context.CurrentLayoutProvider = previousLayout;
-        ParentLayoutProvider = null;
+        context.PopLayoutProvider();
     }
 }
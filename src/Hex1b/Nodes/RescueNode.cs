@@ -425,9 +425,7 @@ public sealed class RescueNode : Hex1bNode, ILayoutProvider
     public override void Render(Hex1bRenderContext context)
     {
         // Set up clipping for rescue content
-        var previousLayout = context.CurrentLayoutProvider;
-        ParentLayoutProvider = previousLayout;
-        context.CurrentLayoutProvider = this;
+        context.PushLayoutProvider(this);
 
         try
         {
@@ -446,6 +444,9 @@ public sealed class RescueNode : Hex1bNode, ILayoutProvider
                 CaptureErrorAsync(ex, RescueErrorPhase.Render).GetAwaiter().GetResult();
                 EnsureFallbackNode();
 
+                // Drop clip scopes left open by the descendant that threw
+                context.UnwindLayoutProvidersTo(this);
+
                 // Re-measure and arrange the fallback, then render it
                 if (FallbackChild != null)
                 {
@@ -457,8 +458,7 @@ public sealed class RescueNode : Hex1bNode, ILayoutProvider
         }
         finally
         {
-            context.CurrentLayoutProvider = previousLayout;
-            ParentLayoutProvider = null;
+            context.PopLayoutProvider();
         }
     }
 
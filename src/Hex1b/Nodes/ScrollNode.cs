@@ -194,8 +194,8 @@ public sealed class ScrollNode : Hex1bNode, ILayoutProvider
         bindings.Key(Hex1bKey.Escape).Action(FocusFirst, "Jump to first focusable");
         
         // Mouse wheel scrolling
-        bindings.Mouse(MouseButton.ScrollUp).Action(ctx => ScrollByAmount(-3, ctx), "Scroll up");
-        bindings.Mouse(MouseButton.ScrollDown).Action(ctx => ScrollByAmount(3, ctx), "Scroll down");
+        bindings.Mouse(MouseButton.ScrollUp).Action(ctx => ScrollByAmount(-3 * ctx.ScrollTicks, ctx), "Scroll up");
+        bindings.Mouse(MouseButton.ScrollDown).Action(ctx => ScrollByAmount(3 * ctx.ScrollTicks, ctx), "Scroll down");
         
         // Mouse drag on scrollbar (handles both clicks and thumb dragging)
         bindings.Drag(MouseButton.Left).Action(HandleScrollbarDrag, "Drag scrollbar");
@@ -572,15 +572,12 @@ public sealed class ScrollNode : Hex1bNode, ILayoutProvider
         var theme = context.Theme;
         
         // Store ourselves as the current layout provider to enable clipping
-        var previousLayout = context.CurrentLayoutProvider;
-        ParentLayoutProvider = previousLayout;
-        context.CurrentLayoutProvider = this;
+        context.PushLayoutProvider(this);
         
         // Render child (will be clipped by ILayoutProvider)
         Child?.Render(context);
         
-        context.CurrentLayoutProvider = previousLayout;
-        ParentLayoutProvider = null;
+        context.PopLayoutProvider();
         
         // Render scrollbar if needed
         if (IsScrollable && ShowScrollbar)
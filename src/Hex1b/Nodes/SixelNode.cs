@@ -15,23 +15,44 @@ namespace Hex1b.Nodes;
 [Experimental("HEX1B_SIXEL", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/sixel.md")]
 public sealed class SixelNode : Hex1bNode
 {
+    private SixelImageHandle? _image;
+
     /// <summary>
     /// The Sixel-encoded image data to render.
     /// </summary>
-    private string _imageData = "";
+    /// <remarks>
+    /// Setting the same string again is free; new image data is wrapped and hashed once into
+    /// an <see cref="Image"/> handle.
+    /// </remarks>
     public string ImageData 
     { 
-        get => _imageData; 
+        get => _image?.ImageData ?? ""; 
         set
         {
-            if (_imageData != value)
-            {
-                _imageData = value;
-                // Mark parent dirty to force full re-render of the container
-                // This is a sledgehammer fix for Sixel ghost pixels when switching images
-                Parent?.MarkDirty();
-                MarkDirty();
-            }
+            if ((_image is { Tiles: null } && ReferenceEquals(_image.ImageData, value)) || (_image == null && string.IsNullOrEmpty(value)))
+                return;
+
+            Image = string.IsNullOrEmpty(value) ? null : SixelImageHandle.Create(value);
+        }
+    }
+
+    /// <summary>
+    /// The image to render. A handle for the same image as the current one is ignored, so
+    /// the node is only marked dirty when the image actually changes.
+    /// </summary>
+    public SixelImageHandle? Image
+    {
+        get => _image;
+        set
+        {
+            if (_image == null ? value == null : value != null && _image.HasSameContent(value))
+                return;
+
+            _image = value;
+            // Mark parent dirty to force full re-render of the container
+            // This is a sledgehammer fix for Sixel ghost pixels when switching images
+            Parent?.MarkDirty();
+            MarkDirty();
         }
     }
 
@@ -74,18 +95,6 @@ public sealed class SixelNode : Hex1bNode
         }
     }
 
-    /// <summary>
-    /// Start of Sixel data (DCS - Device Control String).
-    /// Format: DCS q [sixel data] ST
-    /// Using minimal DCS header (parameters default to 0 anyway).
-    /// </summary>
-    private const string SixelStart = "\x1bPq";
-
-    /// <summary>
-    /// End of Sixel data (ST - String Terminator).
-    /// </summary>
-    private const string SixelEnd = "\x1b\\";
-
     public override Size Measure(Constraints constraints)
     {
         // During measure, we don't know if Sixel is supported yet
@@ -138,32 +147,31 @@ public sealed class SixelNode : Hex1bNode
 
     private void RenderSixel(Hex1bRenderContext context)
     {
-        if (string.IsNullOrEmpty(ImageData))
+        if (_image == null)
         {
             context.SetCursorPosition(Bounds.X, Bounds.Y);
             context.Write("[No image data]");
             return;
         }
 
+        if (_image.Tiles is { } tiles)
+        {
+            // Each tile is written at its cell; the optimization filter drops tiles the
+            // terminal already shows, so only changed tiles are sent
+            foreach (var tile in tiles)
+            {
+                context.SetCursorPosition(Bounds.X + tile.Column, Bounds.Y + tile.Row);
+                context.Write(tile.Payload);
+            }
+            return;
+        }
+
         // Position cursor at the image location
         context.SetCursorPosition(Bounds.X, Bounds.Y);
 
-        // Check if data already has a DCS header
-        // Use explicit character comparison instead of StartsWith to avoid escape char issues
-        var startsWithEscP = ImageData.Length >= 2 && ImageData[0] == '\x1b' && ImageData[1] == 'P';
-        var startsWithDCS = ImageData.Length >= 1 && ImageData[0] == '\x90';
-        var hasHeader = startsWithEscP || startsWithDCS;
-        
-        if (hasHeader)
-        {
-            // Already has DCS header
-            context.Write(ImageData);
-        }
-        else
-        {
-            // Wrap in Sixel sequence - write as a single string so parser can detect it
-            context.Write($"{SixelStart}{ImageData}{SixelEnd}");
-        }
+        // The handle's payload is already wrapped in its DCS sequence - write it as a
+        // single string so the parser can detect it
+        context.Write(_image.Payload);
     }
 
     private void RenderFallback(Hex1bRenderContext context)
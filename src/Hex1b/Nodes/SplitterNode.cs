@@ -440,15 +440,12 @@ public sealed class SplitterNode : Hex1bNode, IChildLayoutProvider
         // Render first pane with clipping
         if (First != null)
         {
-            var previousLayout = context.CurrentLayoutProvider;
-            var firstPaneProvider = new RectLayoutProvider(First.Bounds);
-            firstPaneProvider.ParentLayoutProvider = previousLayout;
-            context.CurrentLayoutProvider = firstPaneProvider;
+            context.PushLayoutProvider(new RectLayoutProvider(First.Bounds));
             
             context.SetCursorPosition(First.Bounds.X, First.Bounds.Y);
             First.Render(context);
             
-            context.CurrentLayoutProvider = previousLayout;
+            context.PopLayoutProvider();
         }
         
         if (Orientation == SplitterOrientation.Horizontal)
@@ -463,15 +460,12 @@ public sealed class SplitterNode : Hex1bNode, IChildLayoutProvider
         // Render second pane with clipping
         if (Second != null)
         {
-            var previousLayout = context.CurrentLayoutProvider;
-            var secondPaneProvider = new RectLayoutProvider(Second.Bounds);
-            secondPaneProvider.ParentLayoutProvider = previousLayout;
-            context.CurrentLayoutProvider = secondPaneProvider;
+            context.PushLayoutProvider(new RectLayoutProvider(Second.Bounds));
             
             context.SetCursorPosition(Second.Bounds.X, Second.Bounds.Y);
             Second.Render(context);
             
-            context.CurrentLayoutProvider = previousLayout;
+            context.PopLayoutProvider();
         }
     }
 
@@ -237,101 +237,77 @@ public sealed class TextBlockNode : Hex1bNode
     /// </remarks>
     public override void Render(Hex1bRenderContext context)
     {
-        var colorCodes = context.Theme.GetGlobalColorCodes();
-        var resetCodes = !string.IsNullOrEmpty(colorCodes) ? context.Theme.GetResetToGlobalCodes() : "";
+        var style = context.Theme.GetGlobalTextStyle();
         
         switch (Overflow)
         {
             case TextOverflow.Wrap:
-                RenderWrapped(context, colorCodes, resetCodes);
+                RenderWrapped(context, style);
                 break;
                 
             case TextOverflow.Ellipsis:
-                RenderEllipsis(context, colorCodes, resetCodes);
+                RenderEllipsis(context, style);
                 break;
                 
             case TextOverflow.Truncate:
             default:
-                RenderTruncate(context, colorCodes, resetCodes);
+                RenderTruncate(context, style);
                 break;
         }
     }
 
-    private void RenderTruncate(Hex1bRenderContext context, string colorCodes, string resetCodes)
+    private void RenderTruncate(Hex1bRenderContext context, TextStyle style)
     {
+        ReadOnlySpan<StyledRun> runs = [new StyledRun(Text, style)];
+        
         // When a LayoutProvider is active, use clipped rendering
         // Otherwise, use the original simple behavior for backward compatibility
         if (context.CurrentLayoutProvider != null)
         {
             // Use Bounds for position - parent sets cursor but we need absolute coords for clipping
-            if (!string.IsNullOrEmpty(colorCodes))
-            {
-                context.WriteClipped(Bounds.X, Bounds.Y, $"{colorCodes}{Text}{resetCodes}");
-            }
-            else
-            {
-                context.WriteClipped(Bounds.X, Bounds.Y, Text);
-            }
+            context.WriteClipped(Bounds.X, Bounds.Y, runs);
         }
         else
         {
             // No layout provider - write at current cursor position (original behavior)
-            if (!string.IsNullOrEmpty(colorCodes))
-            {
-                context.Write($"{colorCodes}{Text}{resetCodes}");
-            }
-            else
-            {
-                context.Write(Text);
-            }
+            context.Write(runs);
         }
     }
 
-    private void RenderWrapped(Hex1bRenderContext context, string colorCodes, string resetCodes)
+    private void RenderWrapped(Hex1bRenderContext context, TextStyle style)
     {
         if (_wrappedLines == null || _wrappedLines.Count == 0)
             return;
             
         for (int i = 0; i < _wrappedLines.Count && i < Bounds.Height; i++)
         {
-            var line = _wrappedLines[i];
             var y = Bounds.Y + i;
-            
-            if (!string.IsNullOrEmpty(colorCodes))
-            {
-                context.WriteClipped(Bounds.X, y, $"{colorCodes}{line}{resetCodes}");
-            }
-            else
-            {
-                context.WriteClipped(Bounds.X, y, line);
-            }
+            context.WriteClipped(Bounds.X, y, [new StyledRun(_wrappedLines[i], style)]);
         }
     }
 
-    private void RenderEllipsis(Hex1bRenderContext context, string colorCodes, string resetCodes)
+    private void RenderEllipsis(Hex1bRenderContext context, TextStyle style)
     {
-        var text = Text;
         var textWidth = DisplayWidth.GetStringWidth(Text);
         
         if (textWidth > Bounds.Width && Bounds.Width > 3)
         {
-            // Slice to fit with ellipsis
+            // Slice to fit with ellipsis; the slice is a prefix of Text so no copy is needed
             var (sliced, _) = SliceByWidth(Text, Bounds.Width - 3);
-            text = sliced + "...";
+            context.WriteClipped(Bounds.X, Bounds.Y,
+            [
+                new StyledRun(Text, 0, sliced.Length, style),
+                new StyledRun("...", style),
+            ]);
         }
         else if (textWidth > Bounds.Width)
         {
             var (sliced, _) = SliceByWidth(Text, Bounds.Width);
-            text = sliced;
-        }
-        
-        if (!string.IsNullOrEmpty(colorCodes))
-        {
-            context.WriteClipped(Bounds.X, Bounds.Y, $"{colorCodes}{text}{resetCodes}");
+            context.WriteClipped(Bounds.X, Bounds.Y, [new StyledRun(Text, 0, sliced.Length, style)]);
         }
         else
         {
-            context.WriteClipped(Bounds.X, Bounds.Y, text);
+            context.WriteClipped(Bounds.X, Bounds.Y, [new StyledRun(Text, style)]);
         }
     }
 }
@@ -1,3 +1,4 @@
+using System.Text;
 using Hex1b.Input;
 using Hex1b.Layout;
 using Hex1b.Terminal;
@@ -120,6 +121,52 @@ public sealed class TextBoxNode : Hex1bNode
         bindings.AnyCharacter().Action(InsertTextAsync, "Type text");
     }
 
+    /// <summary>
+    /// Inserts a paste in one operation, replacing the selection if there is one.
+    /// </summary>
+    public override async Task<InputResult> HandlePasteAsync(Hex1bPasteEvent pasteEvent, InputBindingActionContext context)
+    {
+        var text = ToSingleLine(pasteEvent.Text);
+        if (text.Length > 0)
+        {
+            await InsertTextAsync(text, context);
+        }
+        return InputResult.Handled;
+    }
+
+    /// <summary>
+    /// Makes pasted text fit a single-line text box: line breaks and tabs become spaces and
+    /// other control characters are dropped.
+    /// </summary>
+    private static string ToSingleLine(string text)
+    {
+        var firstControl = 0;
+        while (firstControl < text.Length && !char.IsControl(text[firstControl]))
+        {
+            firstControl++;
+        }
+        if (firstControl == text.Length)
+        {
+            return text;
+        }
+
+        var builder = new StringBuilder(text.Length);
+        builder.Append(text, 0, firstControl);
+        for (var i = firstControl; i < text.Length; i++)
+        {
+            var c = text[i];
+            if (c is '\n' or '\t')
+            {
+                builder.Append(' ');
+            }
+            else if (!char.IsControl(c))
+            {
+                builder.Append(c);
+            }
+        }
+        return builder.ToString();
+    }
+
     private async Task InsertTextAsync(string text, InputBindingActionContext ctx)
     {
         var oldText = State.Text;
@@ -341,33 +388,25 @@ public sealed class TextBoxNode : Hex1bNode
             return 0;
 
         int currentColumn = 0;
-        var enumerator = System.Globalization.StringInfo.GetTextElementEnumerator(State.Text);
-        int lastPosition = 0;
-
-        while (enumerator.MoveNext())
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes(State.Text))
         {
-            var grapheme = (string)enumerator.Current;
-            var graphemeWidth = DisplayWidth.GetGraphemeWidth(grapheme);
-            var graphemeStart = enumerator.ElementIndex;
-
             // If the click is before or at the start of this grapheme
-            if (displayColumn < currentColumn + graphemeWidth)
+            if (displayColumn < currentColumn + cluster.Width)
             {
                 // Click is in the first half of the grapheme - position before it
                 // Click is in the second half - position after it
-                var midpoint = currentColumn + (graphemeWidth / 2.0);
+                var midpoint = currentColumn + (cluster.Width / 2.0);
                 if (displayColumn < midpoint)
                 {
-                    return graphemeStart;
+                    return cluster.Start;
                 }
                 else
                 {
-                    return graphemeStart + grapheme.Length;
+                    return cluster.End;
                 }
             }
 
-            currentColumn += graphemeWidth;
-            lastPosition = graphemeStart + grapheme.Length;
+            currentColumn += cluster.Width;
         }
 
         // Click is past the end of the text
@@ -53,7 +53,8 @@ public sealed class ThemePanelNode : Hex1bNode
         var originalTheme = context.Theme;
         
         // Apply the theme mutator if we have one
-        // We clone first so the mutator can safely modify without affecting the original
+        // We clone first so the mutator can safely modify without affecting the original.
+        // Cloning a locked theme only adds an override layer, so this is cheap per frame.
         if (ThemeMutator != null)
         {
             context.Theme = ThemeMutator(originalTheme.Clone());
@@ -64,7 +65,7 @@ public sealed class ThemePanelNode : Hex1bNode
         var bg = context.Theme.GetGlobalBackground();
         if (!bg.IsDefault && Bounds.Width > 0 && Bounds.Height > 0)
         {
-            var bgCode = bg.ToBackgroundAnsi();
+            var bgCode = context.Theme.GetBackgroundAnsi(GlobalTheme.BackgroundColor);
             var resetCode = context.Theme.GetResetToGlobalCodes();
             var spaces = new string(' ', Bounds.Width);
             
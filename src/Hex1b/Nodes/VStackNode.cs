@@ -129,9 +129,7 @@ public sealed class VStackNode : Hex1bNode, ILayoutProvider
 
     public override void Render(Hex1bRenderContext context)
     {
-        var previousLayout = context.CurrentLayoutProvider;
-        ParentLayoutProvider = previousLayout;
-        context.CurrentLayoutProvider = this;
+        context.PushLayoutProvider(this);
         
         for (int i = 0; i < Children.Count; i++)
         {
@@ -140,8 +138,7 @@ public sealed class VStackNode : Hex1bNode, ILayoutProvider
             Children[i].Render(context);
         }
         
-        context.CurrentLayoutProvider = previousLayout;
-        ParentLayoutProvider = null;
+        context.PopLayoutProvider();
     }
 
     public override void ConfigureDefaultBindings(InputBindingsBuilder bindings)
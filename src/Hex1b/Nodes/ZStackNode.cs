@@ -153,9 +153,7 @@ public sealed class ZStackNode : Hex1bNode, ILayoutProvider, IPopupHost
 
     public override void Render(Hex1bRenderContext context)
     {
-        var previousLayout = context.CurrentLayoutProvider;
-        ParentLayoutProvider = previousLayout;
-        context.CurrentLayoutProvider = this;
+        context.PushLayoutProvider(this);
         
         // Render children in order - first child is at bottom, last is on top
         // Later children will overwrite cells from earlier children
@@ -165,8 +163,7 @@ public sealed class ZStackNode : Hex1bNode, ILayoutProvider, IPopupHost
             Children[i].Render(context);
         }
         
-        context.CurrentLayoutProvider = previousLayout;
-        ParentLayoutProvider = null;
+        context.PopLayoutProvider();
     }
 
     public override void ConfigureDefaultBindings(InputBindingsBuilder bindings)
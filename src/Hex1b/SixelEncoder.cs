@@ -0,0 +1,604 @@
+using System.Buffers;
+using System.Diagnostics.CodeAnalysis;
+using System.Numerics;
+using System.Text;
+
+namespace Hex1b;
+
+/// <summary>
+/// Encodes RGBA pixels to Sixel format for display with <see cref="Widgets.SixelWidget"/>.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Images with no more colors than <see cref="SixelEncoderOptions.MaxColors"/> - charts, diagrams
+/// and most UI graphics - keep their exact colors. Others are reduced with median-cut quantization
+/// over a 15-bit color histogram and can optionally be dithered.
+/// </para>
+/// <para>
+/// Each band of six pixel rows is packed a color at a time, comparing a vector of pixels against
+/// the color per row, so encoding cost follows the number of colors actually used in each band.
+/// </para>
+/// <para>
+/// To avoid re-encoding an image that has not changed, use a <see cref="SixelEncoderCache"/>.
+/// </para>
+/// </remarks>
+[Experimental("HEX1B_SIXEL", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/sixel.md")]
+public static class SixelEncoder
+{
+    /// <summary>
+    /// The palette index marking a transparent pixel.
+    /// </summary>
+    private const byte Transparent = 255;
+
+    /// <summary>
+    /// Bits kept per channel in the quantization histogram.
+    /// </summary>
+    private const int HistogramBits = 5;
+
+    private const int HistogramSize = 1 << (HistogramBits * 3);
+    private const int HistogramMax = (1 << HistogramBits) - 1;
+
+    /// <summary>
+    /// The 4x4 Bayer threshold matrix used for ordered dithering.
+    /// </summary>
+    private static readonly int[] BayerMatrix = [0, 8, 2, 10, 12, 4, 14, 6, 3, 11, 1, 9, 15, 7, 13, 5];
+
+    /// <summary>
+    /// Encodes RGBA pixel data to a complete Sixel DCS sequence.
+    /// </summary>
+    /// <param name="rgba">The pixels, 4 bytes (R, G, B, A) per pixel, row by row.</param>
+    /// <param name="width">The image width in pixels.</param>
+    /// <param name="height">The image height in pixels.</param>
+    /// <param name="options">Encoding options, or null for <see cref="SixelEncoderOptions.Default"/>.</param>
+    /// <returns>The Sixel sequence (ESC P ... ESC \) ready for terminal output.</returns>
+    public static string Encode(ReadOnlySpan<byte> rgba, int width, int height, SixelEncoderOptions? options = null)
+    {
+        ValidateImage(rgba, width, height);
+        return EncodeCore(rgba, width, height, options ?? SixelEncoderOptions.Default, 0, 0);
+    }
+
+    /// <summary>
+    /// Encodes RGBA pixel data to a <see cref="SixelImageHandle"/>.
+    /// </summary>
+    /// <param name="rgba">The pixels, 4 bytes (R, G, B, A) per pixel, row by row.</param>
+    /// <param name="width">The image width in pixels.</param>
+    /// <param name="height">The image height in pixels.</param>
+    /// <param name="options">Encoding options, or null for <see cref="SixelEncoderOptions.Default"/>.</param>
+    public static SixelImageHandle EncodeImage(ReadOnlySpan<byte> rgba, int width, int height, SixelEncoderOptions? options = null)
+        => SixelImageHandle.Create(Encode(rgba, width, height, options));
+
+    /// <summary>
+    /// Encodes RGBA pixel data to a <see cref="SixelImageHandle"/> made of cell-aligned tiles.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The image is split into tiles of <see cref="SixelEncoderOptions.TileWidthInCells"/> by
+    /// <see cref="SixelEncoderOptions.TileHeightInCells"/> cells, each encoded as its own Sixel
+    /// sequence with its own palette. <see cref="Nodes.SixelNode"/> draws each tile at its cell, and
+    /// <see cref="Terminal.Hex1bAppRenderOptimizationFilter"/> drops tiles the terminal already shows,
+    /// so when a new image differs from the last in a few places only those tiles are sent.
+    /// </para>
+    /// <para>
+    /// Render the pixels at the terminal's cell size (<see cref="Terminal.TerminalCapabilities.CellPixelWidth"/>
+    /// and <see cref="Terminal.TerminalCapabilities.CellPixelHeight"/>) so tiles line up with cells.
+    /// </para>
+    /// </remarks>
+    /// <param name="rgba">The pixels, 4 bytes (R, G, B, A) per pixel, row by row.</param>
+    /// <param name="width">The image width in pixels.</param>
+    /// <param name="height">The image height in pixels.</param>
+    /// <param name="cellWidth">The width of a terminal cell in pixels.</param>
+    /// <param name="cellHeight">The height of a terminal cell in pixels.</param>
+    /// <param name="options">Encoding options, or null for <see cref="SixelEncoderOptions.Default"/>.</param>
+    public static SixelImageHandle EncodeTiledImage(
+        ReadOnlySpan<byte> rgba,
+        int width,
+        int height,
+        int cellWidth,
+        int cellHeight,
+        SixelEncoderOptions? options = null)
+    {
+        ValidateImage(rgba, width, height);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(cellWidth);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(cellHeight);
+
+        options ??= SixelEncoderOptions.Default;
+        var tileColumns = Math.Max(1, options.TileWidthInCells);
+        var tileRows = Math.Max(1, options.TileHeightInCells);
+        var tilePixelWidth = tileColumns * cellWidth;
+        var tilePixelHeight = tileRows * cellHeight;
+
+        var tiles = new List<SixelTile>();
+        var buffer = ArrayPool<byte>.Shared.Rent(Math.Min(tilePixelWidth, width) * Math.Min(tilePixelHeight, height) * 4);
+        try
+        {
+            for (var y = 0; y < height; y += tilePixelHeight)
+            {
+                for (var x = 0; x < width; x += tilePixelWidth)
+                {
+                    var w = Math.Min(tilePixelWidth, width - x);
+                    var h = Math.Min(tilePixelHeight, height - y);
+
+                    var tilePixels = buffer.AsSpan(0, w * h * 4);
+                    for (var row = 0; row < h; row++)
+                    {
+                        rgba.Slice(((y + row) * width + x) * 4, w * 4).CopyTo(tilePixels.Slice(row * w * 4));
+                    }
+
+                    // Every tile is kept, even a transparent one, so it replaces what was there
+                    tiles.Add(new SixelTile(
+                        x / cellWidth,
+                        y / cellHeight,
+                        (w + cellWidth - 1) / cellWidth,
+                        (h + cellHeight - 1) / cellHeight,
+                        EncodeCore(tilePixels, w, h, options, x, y)));
+                }
+            }
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+
+        // The whole image as one sequence is only built if something asks for it
+        var pixels = rgba[..(width * height * 4)].ToArray();
+        return SixelImageHandle.CreateTiled(tiles, () => EncodeCore(pixels, width, height, options, 0, 0));
+    }
+
+    private static void ValidateImage(ReadOnlySpan<byte> rgba, int width, int height)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(width);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(height);
+
+        var pixelCount = (long)width * height;
+        if (pixelCount > Array.MaxLength / 4)
+            throw new ArgumentOutOfRangeException(nameof(width), $"A {width}x{height} image is too large to encode.");
+        if (rgba.Length < pixelCount * 4)
+            throw new ArgumentException($"Expected {pixelCount * 4} bytes of RGBA data for a {width}x{height} image.", nameof(rgba));
+    }
+
+    /// <summary>
+    /// Encodes a validated image. <paramref name="ditherX"/> and <paramref name="ditherY"/> place
+    /// the image within a larger one, so tiles share one dither pattern.
+    /// </summary>
+    private static string EncodeCore(ReadOnlySpan<byte> rgba, int width, int height, SixelEncoderOptions options, int ditherX, int ditherY)
+    {
+        var pixelCount = width * height;
+        var maxColors = Math.Clamp(options.MaxColors, 2, SixelEncoderOptions.MaxPaletteSize);
+
+        var buffer = ArrayPool<byte>.Shared.Rent(pixelCount);
+        try
+        {
+            var indices = buffer.AsSpan(0, pixelCount);
+            var palette = TryBuildExactPalette(rgba, indices, maxColors, options.AlphaThreshold)
+                ?? Quantize(rgba, indices, width, maxColors, options, ditherX, ditherY);
+
+            return Write(indices, width, height, palette);
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+    }
+
+    /// <summary>
+    /// Indexes the pixels by their exact colors, or returns null if there are more than
+    /// <paramref name="maxColors"/> of them.
+    /// </summary>
+    private static int[]? TryBuildExactPalette(ReadOnlySpan<byte> rgba, Span<byte> indices, int maxColors, byte alphaThreshold)
+    {
+        var colorToIndex = new Dictionary<int, byte>();
+        var palette = new int[maxColors];
+        var lastColor = -1;
+        byte lastIndex = 0;
+
+        for (var i = 0; i < indices.Length; i++)
+        {
+            var p = i * 4;
+            if (rgba[p + 3] < alphaThreshold)
+            {
+                indices[i] = Transparent;
+                continue;
+            }
+
+            // Neighbouring pixels are usually the same color, so skip the lookup for them
+            var color = rgba[p] << 16 | rgba[p + 1] << 8 | rgba[p + 2];
+            if (color != lastColor)
+            {
+                if (!colorToIndex.TryGetValue(color, out lastIndex))
+                {
+                    if (colorToIndex.Count == maxColors)
+                        return null;
+
+                    lastIndex = (byte)colorToIndex.Count;
+                    colorToIndex.Add(color, lastIndex);
+                    palette[lastIndex] = color;
+                }
+                lastColor = color;
+            }
+
+            indices[i] = lastIndex;
+        }
+
+        return palette[..colorToIndex.Count];
+    }
+
+    /// <summary>
+    /// Builds a median-cut palette for the pixels and maps each pixel to its nearest entry.
+    /// </summary>
+    private static int[] Quantize(
+        ReadOnlySpan<byte> rgba,
+        Span<byte> indices,
+        int width,
+        int maxColors,
+        SixelEncoderOptions options,
+        int ditherX,
+        int ditherY)
+    {
+        var histogram = new int[HistogramSize];
+        for (var i = 0; i < indices.Length; i++)
+        {
+            var p = i * 4;
+            if (rgba[p + 3] >= options.AlphaThreshold)
+            {
+                histogram[Bin(rgba[p], rgba[p + 1], rgba[p + 2])]++;
+            }
+        }
+
+        var palette = MedianCut(histogram, maxColors);
+
+        // Nearest palette entries are found once per histogram bin
+        var lookup = new short[HistogramSize];
+        lookup.AsSpan().Fill(-1);
+
+        var spread = options.Dither ? GetDitherSpread(palette.Length) : 0;
+
+        for (var i = 0; i < indices.Length; i++)
+        {
+            var p = i * 4;
+            if (rgba[p + 3] < options.AlphaThreshold)
+            {
+                indices[i] = Transparent;
+                continue;
+            }
+
+            int r = rgba[p], g = rgba[p + 1], b = rgba[p + 2];
+            if (spread != 0)
+            {
+                var x = ditherX + i % width;
+                var y = ditherY + i / width;
+                var offset = (BayerMatrix[(y & 3) * 4 + (x & 3)] * 2 - 15) * spread / 32;
+                r = Math.Clamp(r + offset, 0, 255);
+                g = Math.Clamp(g + offset, 0, 255);
+                b = Math.Clamp(b + offset, 0, 255);
+            }
+
+            var bin = Bin(r, g, b);
+            var index = lookup[bin];
+            if (index < 0)
+            {
+                lookup[bin] = index = (short)FindNearest(palette, bin);
+            }
+
+            indices[i] = (byte)index;
+        }
+
+        return palette;
+    }
+
+    /// <summary>
+    /// Gets the dither amplitude for a palette: roughly the distance between neighbouring
+    /// palette colors on each channel.
+    /// </summary>
+    private static int GetDitherSpread(int paletteSize)
+        => 256 / Math.Max(2, (int)Math.Round(Math.Cbrt(paletteSize)));
+
+    /// <summary>
+    /// Splits the histogram's color space into at most <paramref name="maxColors"/> boxes,
+    /// always halving the most populous box along its longest side, and returns each box's
+    /// average color.
+    /// </summary>
+    private static int[] MedianCut(int[] histogram, int maxColors)
+    {
+        var boxes = new List<ColorBox>(maxColors);
+        var all = Shrink(histogram, new ColorBox(0, HistogramMax, 0, HistogramMax, 0, HistogramMax, 0));
+        if (all.Count == 0)
+            return [0];
+
+        boxes.Add(all);
+        while (boxes.Count < maxColors)
+        {
+            var best = -1;
+            for (var i = 0; i < boxes.Count; i++)
+            {
+                if (boxes[i].IsSplittable && (best < 0 || boxes[i].Count > boxes[best].Count))
+                    best = i;
+            }
+
+            if (best < 0)
+                break;
+
+            var (low, high) = Split(histogram, boxes[best]);
+            boxes[best] = low;
+            boxes.Add(high);
+        }
+
+        var palette = new int[boxes.Count];
+        for (var i = 0; i < boxes.Count; i++)
+        {
+            palette[i] = Average(histogram, boxes[i]);
+        }
+
+        return palette;
+    }
+
+    /// <summary>
+    /// Splits a box at the median of its longest side. Both halves are non-empty because the
+    /// box's bounds are tight.
+    /// </summary>
+    private static (ColorBox Low, ColorBox High) Split(int[] histogram, ColorBox box)
+    {
+        var rSide = box.R1 - box.R0;
+        var gSide = box.G1 - box.G0;
+        var bSide = box.B1 - box.B0;
+        var axis = rSide >= gSide && rSide >= bSide ? 0 : gSide >= bSide ? 1 : 2;
+        var (min, max) = axis switch
+        {
+            0 => (box.R0, box.R1),
+            1 => (box.G0, box.G1),
+            _ => (box.B0, box.B1),
+        };
+
+        Span<int> slices = stackalloc int[HistogramMax + 1];
+        for (var r = box.R0; r <= box.R1; r++)
+        for (var g = box.G0; g <= box.G1; g++)
+        for (var b = box.B0; b <= box.B1; b++)
+        {
+            var count = histogram[r << (HistogramBits * 2) | g << HistogramBits | b];
+            slices[axis switch { 0 => r, 1 => g, _ => b }] += count;
+        }
+
+        var cut = min;
+        var total = 0;
+        for (; cut < max - 1; cut++)
+        {
+            total += slices[cut];
+            if (total * 2 >= box.Count)
+                break;
+        }
+
+        var low = axis switch
+        {
+            0 => box with { R1 = cut },
+            1 => box with { G1 = cut },
+            _ => box with { B1 = cut },
+        };
+        var high = axis switch
+        {
+            0 => box with { R0 = cut + 1 },
+            1 => box with { G0 = cut + 1 },
+            _ => box with { B0 = cut + 1 },
+        };
+
+        return (Shrink(histogram, low), Shrink(histogram, high));
+    }
+
+    /// <summary>
+    /// Shrinks a box to the bins within it that hold pixels, and counts those pixels.
+    /// </summary>
+    private static ColorBox Shrink(int[] histogram, ColorBox box)
+    {
+        int r0 = HistogramMax, r1 = 0, g0 = HistogramMax, g1 = 0, b0 = HistogramMax, b1 = 0;
+        var total = 0;
+
+        for (var r = box.R0; r <= box.R1; r++)
+        for (var g = box.G0; g <= box.G1; g++)
+        for (var b = box.B0; b <= box.B1; b++)
+        {
+            var count = histogram[r << (HistogramBits * 2) | g << HistogramBits | b];
+            if (count == 0)
+                continue;
+
+            total += count;
+            r0 = Math.Min(r0, r); r1 = Math.Max(r1, r);
+            g0 = Math.Min(g0, g); g1 = Math.Max(g1, g);
+            b0 = Math.Min(b0, b); b1 = Math.Max(b1, b);
+        }
+
+        return total == 0 ? box with { Count = 0 } : new ColorBox(r0, r1, g0, g1, b0, b1, total);
+    }
+
+    /// <summary>
+    /// Gets the pixel-weighted average color of a box.
+    /// </summary>
+    private static int Average(int[] histogram, ColorBox box)
+    {
+        long rSum = 0, gSum = 0, bSum = 0, total = 0;
+
+        for (var r = box.R0; r <= box.R1; r++)
+        for (var g = box.G0; g <= box.G1; g++)
+        for (var b = box.B0; b <= box.B1; b++)
+        {
+            long count = histogram[r << (HistogramBits * 2) | g << HistogramBits | b];
+            rSum += Expand(r) * count;
+            gSum += Expand(g) * count;
+            bSum += Expand(b) * count;
+            total += count;
+        }
+
+        return (int)(rSum / total) << 16 | (int)(gSum / total) << 8 | (int)(bSum / total);
+    }
+
+    private static int FindNearest(int[] palette, int bin)
+    {
+        var r = Expand(bin >> (HistogramBits * 2));
+        var g = Expand((bin >> HistogramBits) & HistogramMax);
+        var b = Expand(bin & HistogramMax);
+
+        var nearest = 0;
+        var nearestDistance = int.MaxValue;
+        for (var i = 0; i < palette.Length; i++)
+        {
+            var dr = r - (palette[i] >> 16);
+            var dg = g - ((palette[i] >> 8) & 0xFF);
+            var db = b - (palette[i] & 0xFF);
+            var distance = dr * dr + dg * dg + db * db;
+            if (distance < nearestDistance)
+            {
+                nearestDistance = distance;
+                nearest = i;
+            }
+        }
+
+        return nearest;
+    }
+
+    private static int Bin(int r, int g, int b)
+        => (r >> (8 - HistogramBits)) << (HistogramBits * 2)
+            | (g >> (8 - HistogramBits)) << HistogramBits
+            | (b >> (8 - HistogramBits));
+
+    /// <summary>
+    /// Expands a histogram channel value back to 8 bits.
+    /// </summary>
+    private static int Expand(int value) => value << (8 - HistogramBits) | value >> (2 * HistogramBits - 8);
+
+    /// <summary>
+    /// Writes the palette and the indexed pixels as a Sixel DCS sequence.
+    /// </summary>
+    private static string Write(ReadOnlySpan<byte> indices, int width, int height, int[] palette)
+    {
+        var sb = new StringBuilder(32 + palette.Length * 16 + indices.Length / 4);
+
+        // DCS introducer, then raster attributes Pan;Pad;Ph;Pv, where Ph is the width and Pv
+        // the height in pixels, so terminals can size the image up front
+        sb.Append("\x1bPq\"1;1;").Append(width).Append(';').Append(height);
+
+        // Color definitions: #Pc;2;R;G;B with RGB in percent
+        for (var i = 0; i < palette.Length; i++)
+        {
+            sb.Append('#').Append(i).Append(";2;")
+                .Append(ToPercent(palette[i] >> 16)).Append(';')
+                .Append(ToPercent((palette[i] >> 8) & 0xFF)).Append(';')
+                .Append(ToPercent(palette[i] & 0xFF));
+        }
+
+        var packed = ArrayPool<byte>.Shared.Rent(width);
+        Span<bool> used = stackalloc bool[256];
+        try
+        {
+            for (var bandStart = 0; bandStart < height; bandStart += 6)
+            {
+                var rows = Math.Min(6, height - bandStart);
+                var band = indices.Slice(bandStart * width, rows * width);
+
+                used.Clear();
+                foreach (var index in band)
+                {
+                    used[index] = true;
+                }
+
+                // Each color used in the band is drawn over the band, returning to its start
+                // with '$' before the next color
+                var first = true;
+                for (var color = 0; color < palette.Length; color++)
+                {
+                    if (!used[color])
+                        continue;
+
+                    var columns = PackBand(band, width, rows, (byte)color, packed.AsSpan(0, width));
+                    if (!first)
+                        sb.Append('$');
+                    first = false;
+
+                    sb.Append('#').Append(color);
+                    AppendRuns(sb, packed.AsSpan(0, columns));
+                }
+
+                if (bandStart + 6 < height)
+                {
+                    sb.Append('-'); // Graphics new line - next band
+                }
+            }
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(packed);
+        }
+
+        sb.Append("\x1b\\");
+        return sb.ToString();
+    }
+
+    /// <summary>
+    /// Packs the pixels of one color in a band into sixel values, one per column, and returns
+    /// the number of columns up to the last one the color appears in.
+    /// </summary>
+    private static int PackBand(ReadOnlySpan<byte> band, int width, int rows, byte color, Span<byte> packed)
+    {
+        var x = 0;
+
+        if (Vector.IsHardwareAccelerated)
+        {
+            var target = new Vector<byte>(color);
+            for (; x <= width - Vector<byte>.Count; x += Vector<byte>.Count)
+            {
+                var bits = Vector<byte>.Zero;
+                for (var row = 0; row < rows; row++)
+                {
+                    var pixels = new Vector<byte>(band.Slice(row * width + x, Vector<byte>.Count));
+                    bits |= Vector.Equals(pixels, target) & new Vector<byte>((byte)(1 << row));
+                }
+
+                bits.CopyTo(packed.Slice(x));
+            }
+        }
+
+        for (; x < width; x++)
+        {
+            var bits = 0;
+            for (var row = 0; row < rows; row++)
+            {
+                if (band[row * width + x] == color)
+                    bits |= 1 << row;
+            }
+
+            packed[x] = (byte)bits;
+        }
+
+        // Empty columns after the last pixel need not be written
+        return packed.LastIndexOfAnyExcept((byte)0) + 1;
+    }
+
+    /// <summary>
+    /// Appends sixel values, using the repeat introducer (!count) for runs longer than three.
+    /// </summary>
+    private static void AppendRuns(StringBuilder sb, ReadOnlySpan<byte> packed)
+    {
+        var i = 0;
+        while (i < packed.Length)
+        {
+            var value = packed[i];
+            var next = packed[(i + 1)..].IndexOfAnyExcept(value);
+            var run = next < 0 ? packed.Length - i : next + 1;
+
+            // Sixel character is '?' plus the 6-bit value
+            var sixel = (char)('?' + value);
+            if (run > 3)
+                sb.Append('!').Append(run).Append(sixel);
+            else
+                sb.Append(sixel, run);
+
+            i += run;
+        }
+    }
+
+    private static int ToPercent(int value) => (value * 100 + 127) / 255;
+
+    /// <summary>
+    /// A box of histogram bins, inclusive on each side, and the number of pixels in it.
+    /// </summary>
+    private readonly record struct ColorBox(int R0, int R1, int G0, int G1, int B0, int B1, int Count)
+    {
+        public bool IsSplittable => Count > 0 && (R0 < R1 || G0 < G1 || B0 < B1);
+    }
+}
@@ -0,0 +1,157 @@
+using System.Diagnostics.CodeAnalysis;
+
+namespace Hex1b;
+
+/// <summary>
+/// Caches encoded sixel images by image identity and cell size, so an image that is redrawn
+/// every frame is encoded once.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The image key identifies the content, for example a chart's data version. The cell size
+/// is part of the key because images are usually rendered to fill a number of cells at the
+/// terminal's cell pixel size; when either changes the image is encoded again.
+/// </para>
+/// <para>
+/// The cache holds a fixed number of images and evicts the least recently used. It is safe
+/// to use from multiple threads.
+/// </para>
+/// <example>
+/// <code>
+/// var images = new SixelEncoderCache();
+/// // Every frame:
+/// if (!images.TryGet(chart.Version, cellWidth, cellHeight, out var image))
+/// {
+///     var (width, height) = (widthCells * cellWidth, heightCells * cellHeight);
+///     var pixels = chart.Render(width, height);
+///     image = images.GetOrEncode(chart.Version, cellWidth, cellHeight, pixels, width, height);
+/// }
+/// ctx.Sixel(image, "[chart]", widthCells, heightCells);
+/// </code>
+/// </example>
+/// </remarks>
+[Experimental("HEX1B_SIXEL", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/sixel.md")]
+public sealed class SixelEncoderCache
+{
+    private readonly Dictionary<(object Key, int CellWidth, int CellHeight), LinkedListNode<Entry>> _entries = new();
+    private readonly LinkedList<Entry> _recent = new();
+    private readonly object _lock = new();
+
+    /// <summary>
+    /// Creates a cache.
+    /// </summary>
+    /// <param name="capacity">The number of encoded images to keep.</param>
+    /// <param name="options">The options images are encoded with, or null for <see cref="SixelEncoderOptions.Default"/>.</param>
+    public SixelEncoderCache(int capacity = 64, SixelEncoderOptions? options = null)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(capacity);
+        Capacity = capacity;
+        Options = options ?? SixelEncoderOptions.Default;
+    }
+
+    /// <summary>
+    /// Gets the number of encoded images the cache keeps.
+    /// </summary>
+    public int Capacity { get; }
+
+    /// <summary>
+    /// Gets the options images are encoded with.
+    /// </summary>
+    public SixelEncoderOptions Options { get; }
+
+    /// <summary>
+    /// Gets the number of cached images.
+    /// </summary>
+    public int Count
+    {
+        get
+        {
+            lock (_lock)
+            {
+                return _entries.Count;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets a cached image.
+    /// </summary>
+    /// <param name="imageKey">The image's identity.</param>
+    /// <param name="cellWidth">The cell width in pixels the image was rendered for.</param>
+    /// <param name="cellHeight">The cell height in pixels the image was rendered for.</param>
+    /// <param name="image">The cached image, if found.</param>
+    public bool TryGet(object imageKey, int cellWidth, int cellHeight, [NotNullWhen(true)] out SixelImageHandle? image)
+    {
+        ArgumentNullException.ThrowIfNull(imageKey);
+
+        lock (_lock)
+        {
+            if (_entries.TryGetValue((imageKey, cellWidth, cellHeight), out var node))
+            {
+                _recent.Remove(node);
+                _recent.AddFirst(node);
+                image = node.Value.Image;
+                return true;
+            }
+        }
+
+        image = null;
+        return false;
+    }
+
+    /// <summary>
+    /// Gets a cached image, or encodes <paramref name="rgba"/> and caches it.
+    /// </summary>
+    /// <param name="imageKey">The image's identity.</param>
+    /// <param name="cellWidth">The cell width in pixels the image was rendered for.</param>
+    /// <param name="cellHeight">The cell height in pixels the image was rendered for.</param>
+    /// <param name="rgba">The pixels, 4 bytes (R, G, B, A) per pixel, used if the image is not cached.</param>
+    /// <param name="width">The image width in pixels.</param>
+    /// <param name="height">The image height in pixels.</param>
+    public SixelImageHandle GetOrEncode(
+        object imageKey,
+        int cellWidth,
+        int cellHeight,
+        ReadOnlySpan<byte> rgba,
+        int width,
+        int height)
+    {
+        if (TryGet(imageKey, cellWidth, cellHeight, out var cached))
+            return cached;
+
+        // Encode outside the lock; if another thread cached the image meanwhile, keep theirs
+        var image = SixelEncoder.EncodeImage(rgba, width, height, Options);
+        var key = (imageKey, cellWidth, cellHeight);
+
+        lock (_lock)
+        {
+            if (_entries.TryGetValue(key, out var existing))
+                return existing.Value.Image;
+
+            _entries[key] = _recent.AddFirst(new Entry(key, image));
+
+            while (_entries.Count > Capacity)
+            {
+                var oldest = _recent.Last!;
+                _recent.RemoveLast();
+                _entries.Remove(oldest.Value.Key);
+            }
+        }
+
+        return image;
+    }
+
+    /// <summary>
+    /// Removes all cached images.
+    /// </summary>
+    public void Clear()
+    {
+        lock (_lock)
+        {
+            _entries.Clear();
+            _recent.Clear();
+        }
+    }
+
+    private sealed record Entry((object Key, int CellWidth, int CellHeight) Key, SixelImageHandle Image);
+}
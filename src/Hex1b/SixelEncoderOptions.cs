@@ -0,0 +1,56 @@
+using System.Diagnostics.CodeAnalysis;
+
+namespace Hex1b;
+
+/// <summary>
+/// Options for encoding pixels with <see cref="SixelEncoder"/>.
+/// </summary>
+[Experimental("HEX1B_SIXEL", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/sixel.md")]
+public sealed record SixelEncoderOptions
+{
+    /// <summary>
+    /// The largest palette the encoder produces. Sixel terminals commonly support 256
+    /// registers; one index is reserved for transparent pixels, so the limit is 255.
+    /// </summary>
+    public const int MaxPaletteSize = 255;
+
+    /// <summary>
+    /// Gets the default options: up to 255 colors, no dithering.
+    /// </summary>
+    public static SixelEncoderOptions Default { get; } = new();
+
+    /// <summary>
+    /// Gets the maximum number of colors in the palette, between 2 and
+    /// <see cref="MaxPaletteSize"/>.
+    /// </summary>
+    /// <remarks>
+    /// Images with no more distinct colors than this are encoded with their exact colors.
+    /// Larger images are reduced with median-cut quantization.
+    /// </remarks>
+    public int MaxColors { get; init; } = MaxPaletteSize;
+
+    /// <summary>
+    /// Gets whether quantized images are dithered with an ordered (Bayer) pattern, which
+    /// hides banding in gradients. Images encoded with their exact colors are never dithered.
+    /// </summary>
+    public bool Dither { get; init; }
+
+    /// <summary>
+    /// Gets the alpha value below which a pixel is left transparent.
+    /// </summary>
+    public byte AlphaThreshold { get; init; } = 128;
+
+    /// <summary>
+    /// Gets the width in cells of the tiles made by <see cref="SixelEncoder.EncodeTiledImage"/>.
+    /// </summary>
+    /// <remarks>
+    /// Smaller tiles send less when a small part of an image changes, but each tile carries its
+    /// own Sixel header and palette.
+    /// </remarks>
+    public int TileWidthInCells { get; init; } = 4;
+
+    /// <summary>
+    /// Gets the height in cells of the tiles made by <see cref="SixelEncoder.EncodeTiledImage"/>.
+    /// </summary>
+    public int TileHeightInCells { get; init; } = 2;
+}
@@ -91,4 +91,38 @@ public static class SixelExtensions
             width,
             height);
     }
+
+    /// <summary>
+    /// Creates a SixelWidget for a prepared image with the specified fallback widget.
+    /// </summary>
+    /// <param name="ctx">The widget context.</param>
+    /// <param name="image">The image, created once with <see cref="SixelImageHandle.Create"/>.</param>
+    /// <param name="fallback">A widget to display if Sixel is not supported.</param>
+    /// <param name="width">Optional width in character cells.</param>
+    /// <param name="height">Optional height in character cells.</param>
+    public static SixelWidget Sixel<TParent>(
+        this WidgetContext<TParent> ctx,
+        SixelImageHandle image,
+        Hex1bWidget fallback,
+        int? width = null,
+        int? height = null)
+        where TParent : Hex1bWidget
+        => new(image, fallback, width, height);
+
+    /// <summary>
+    /// Creates a SixelWidget for a prepared image with a text fallback.
+    /// </summary>
+    /// <param name="ctx">The widget context.</param>
+    /// <param name="image">The image, created once with <see cref="SixelImageHandle.Create"/>.</param>
+    /// <param name="fallbackText">Text to display if Sixel is not supported.</param>
+    /// <param name="width">Optional width in character cells.</param>
+    /// <param name="height">Optional height in character cells.</param>
+    public static SixelWidget Sixel<TParent>(
+        this WidgetContext<TParent> ctx,
+        SixelImageHandle image,
+        string fallbackText,
+        int? width = null,
+        int? height = null)
+        where TParent : Hex1bWidget
+        => new(image, new TextBlockWidget(fallbackText), width, height);
 }
@@ -0,0 +1,156 @@
+using System.Diagnostics.CodeAnalysis;
+using System.Runtime.InteropServices;
+using Hex1b.Terminal;
+
+namespace Hex1b;
+
+/// <summary>
+/// A sixel image prepared once for display with <see cref="Widgets.SixelWidget"/>.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Creating a handle wraps the image in its DCS sequence and hashes it a single time. Widgets
+/// built from the same handle every frame are recognized by <see cref="Id"/>, without comparing
+/// or re-wrapping the image data, so an unchanged image costs nothing to reconcile.
+/// </para>
+/// <para>
+/// Create a handle when an image is produced and keep it for as long as the image is shown.
+/// </para>
+/// <example>
+/// <code>
+/// var chart = SixelImageHandle.Create(RenderChart());
+/// // Every frame:
+/// ctx.Sixel(chart, "[chart]", width: 40, height: 10);
+/// </code>
+/// </example>
+/// </remarks>
+[Experimental("HEX1B_SIXEL", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/sixel.md")]
+public sealed class SixelImageHandle
+{
+    /// <summary>
+    /// Start of Sixel data (DCS - Device Control String).
+    /// </summary>
+    private const string SixelStart = "\x1bPq";
+
+    /// <summary>
+    /// End of Sixel data (ST - String Terminator).
+    /// </summary>
+    private const string SixelEnd = "\x1b\\";
+
+    private static long _nextId;
+
+    private readonly string? _imageData;
+    private readonly string? _payload;
+    private readonly Lazy<string>? _tiledPayload;
+
+    private SixelImageHandle(long id, string imageData, string payload)
+    {
+        Id = id;
+        _imageData = imageData;
+        _payload = payload;
+        ContentHash = SixelData.ComputeHash(payload);
+    }
+
+    private SixelImageHandle(long id, IReadOnlyList<SixelTile> tiles, Func<string> createPayload)
+    {
+        Id = id;
+        Tiles = tiles;
+        _tiledPayload = new Lazy<string>(createPayload);
+
+        // The image hash is built from the tiles' hashes and positions
+        var parts = new ulong[tiles.Count * 3];
+        for (var i = 0; i < tiles.Count; i++)
+        {
+            var tile = tiles[i];
+            parts[i * 3] = tile.ContentHash;
+            parts[i * 3 + 1] = (ulong)(uint)tile.Column << 32 | (uint)tile.Row;
+            parts[i * 3 + 2] = (ulong)(uint)tile.WidthInCells << 32 | (uint)tile.HeightInCells;
+        }
+        ContentHash = XxHash64.Hash(MemoryMarshal.AsBytes(parts.AsSpan()));
+    }
+
+    /// <summary>
+    /// Gets the handle's ID, unique within the process.
+    /// </summary>
+    public long Id { get; }
+
+    /// <summary>
+    /// Gets the image data the handle was created from.
+    /// </summary>
+    /// <remarks>
+    /// For a tiled image this is the whole image as one Sixel sequence, encoded the first time
+    /// it is asked for.
+    /// </remarks>
+    public string ImageData => _imageData ?? _tiledPayload!.Value;
+
+    /// <summary>
+    /// Gets the complete Sixel DCS sequence (ESC P ... ESC \) written to the terminal.
+    /// </summary>
+    /// <remarks>
+    /// For a tiled image this is the whole image as one Sixel sequence, encoded the first time
+    /// it is asked for; <see cref="Nodes.SixelNode"/> writes the <see cref="Tiles"/> instead.
+    /// </remarks>
+    public string Payload => _payload ?? _tiledPayload!.Value;
+
+    /// <summary>
+    /// Gets the image's cell-aligned tiles, or null if the image is a single Sixel sequence.
+    /// </summary>
+    /// <seealso cref="SixelEncoder.EncodeTiledImage"/>
+    public IReadOnlyList<SixelTile>? Tiles { get; }
+
+    /// <summary>
+    /// Gets the payload's content hash, computed once when the handle was created.
+    /// </summary>
+    internal ulong ContentHash { get; }
+
+    /// <summary>
+    /// Creates a handle for a sixel image.
+    /// </summary>
+    /// <param name="imageData">
+    /// The Sixel-encoded image, either a complete DCS sequence or the sixel data alone, which
+    /// is wrapped in one.
+    /// </param>
+    public static SixelImageHandle Create(string imageData)
+    {
+        ArgumentNullException.ThrowIfNull(imageData);
+
+        // Use explicit character comparison instead of StartsWith to avoid escape char issues
+        var startsWithEscP = imageData.Length >= 2 && imageData[0] == '\x1b' && imageData[1] == 'P';
+        var startsWithDCS = imageData.Length >= 1 && imageData[0] == '\x90';
+        var payload = startsWithEscP || startsWithDCS ? imageData : $"{SixelStart}{imageData}{SixelEnd}";
+
+        return new SixelImageHandle(Interlocked.Increment(ref _nextId), imageData, payload);
+    }
+
+    /// <summary>
+    /// Creates a handle for an image made of tiles.
+    /// </summary>
+    /// <param name="tiles">The tiles, each drawn at its cell offset from the image's origin.</param>
+    /// <param name="createPayload">Encodes the whole image as one sequence, if it is asked for.</param>
+    internal static SixelImageHandle CreateTiled(IReadOnlyList<SixelTile> tiles, Func<string> createPayload)
+        => new(Interlocked.Increment(ref _nextId), tiles, createPayload);
+
+    /// <summary>
+    /// Determines whether this handle and <paramref name="other"/> are for the same image,
+    /// comparing hashes before payloads. A tiled image and a single sequence are never the same,
+    /// since they are drawn differently.
+    /// </summary>
+    internal bool HasSameContent(SixelImageHandle other)
+    {
+        if (ReferenceEquals(this, other))
+            return true;
+        if (ContentHash != other.ContentHash || (Tiles == null) != (other.Tiles == null))
+            return false;
+        if (Tiles == null)
+            return string.Equals(Payload, other.Payload, StringComparison.Ordinal);
+        if (Tiles.Count != other.Tiles!.Count)
+            return false;
+
+        for (var i = 0; i < Tiles.Count; i++)
+        {
+            if (!Tiles[i].HasSameContent(other.Tiles[i]))
+                return false;
+        }
+        return true;
+    }
+}
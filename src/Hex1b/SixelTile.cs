@@ -0,0 +1,62 @@
+using System.Diagnostics.CodeAnalysis;
+using Hex1b.Terminal;
+
+namespace Hex1b;
+
+/// <summary>
+/// A cell-aligned piece of a tiled <see cref="SixelImageHandle"/>, drawn as its own Sixel sequence.
+/// </summary>
+[Experimental("HEX1B_SIXEL", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/sixel.md")]
+public sealed class SixelTile
+{
+    internal SixelTile(int column, int row, int widthInCells, int heightInCells, string payload)
+    {
+        Column = column;
+        Row = row;
+        WidthInCells = widthInCells;
+        HeightInCells = heightInCells;
+        Payload = payload;
+        ContentHash = SixelData.ComputeHash(payload);
+    }
+
+    /// <summary>
+    /// Gets the tile's column, in cells from the image's left edge.
+    /// </summary>
+    public int Column { get; }
+
+    /// <summary>
+    /// Gets the tile's row, in cells from the image's top edge.
+    /// </summary>
+    public int Row { get; }
+
+    /// <summary>
+    /// Gets the width of the tile in cells.
+    /// </summary>
+    public int WidthInCells { get; }
+
+    /// <summary>
+    /// Gets the height of the tile in cells.
+    /// </summary>
+    public int HeightInCells { get; }
+
+    /// <summary>
+    /// Gets the tile's complete Sixel DCS sequence (ESC P ... ESC \).
+    /// </summary>
+    public string Payload { get; }
+
+    /// <summary>
+    /// Gets the payload's content hash.
+    /// </summary>
+    internal ulong ContentHash { get; }
+
+    /// <summary>
+    /// Determines whether this tile and <paramref name="other"/> cover the same cells with the same image.
+    /// </summary>
+    internal bool HasSameContent(SixelTile other)
+        => Column == other.Column
+            && Row == other.Row
+            && WidthInCells == other.WidthInCells
+            && HeightInCells == other.HeightInCells
+            && ContentHash == other.ContentHash
+            && string.Equals(Payload, other.Payload, StringComparison.Ordinal);
+}
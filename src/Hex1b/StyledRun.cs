@@ -0,0 +1,60 @@
+using Hex1b.Terminal;
+
+namespace Hex1b;
+
+/// <summary>
+/// A slice of plain text drawn with a single <see cref="TextStyle"/>.
+/// </summary>
+/// <remarks>
+/// Nodes pass lines to <see cref="Hex1bRenderContext.WriteClipped(int, int, ReadOnlySpan{StyledRun})"/>
+/// as a sequence of runs instead of a string with embedded ANSI escapes. The display width of
+/// each run is measured once when the run is created, so clipping a line is arithmetic on run
+/// widths and only the runs that straddle a clip edge are segmented into grapheme clusters.
+/// The text must not contain escape sequences; the style carries all formatting.
+/// </remarks>
+public readonly struct StyledRun
+{
+    /// <summary>
+    /// Creates a run covering all of <paramref name="text"/>.
+    /// </summary>
+    public StyledRun(string text, TextStyle style = default)
+        : this(text, 0, text.Length, style)
+    {
+    }
+
+    /// <summary>
+    /// Creates a run covering <paramref name="length"/> chars of <paramref name="text"/>
+    /// starting at <paramref name="start"/>.
+    /// </summary>
+    public StyledRun(string text, int start, int length, TextStyle style = default)
+    {
+        ArgumentNullException.ThrowIfNull(text);
+        ArgumentOutOfRangeException.ThrowIfNegative(start);
+        ArgumentOutOfRangeException.ThrowIfNegative(length);
+        ArgumentOutOfRangeException.ThrowIfGreaterThan(start + length, text.Length, nameof(length));
+
+        Text = text;
+        Start = start;
+        Length = length;
+        Style = style;
+        Width = DisplayWidth.GetStringWidth(text.AsSpan(start, length));
+    }
+
+    /// <summary>The string the run slices.</summary>
+    public string Text { get; }
+
+    /// <summary>The index of the first char of the run within <see cref="Text"/>.</summary>
+    public int Start { get; }
+
+    /// <summary>The number of chars in the run.</summary>
+    public int Length { get; }
+
+    /// <summary>The style applied to the run.</summary>
+    public TextStyle Style { get; }
+
+    /// <summary>The number of terminal columns the run occupies.</summary>
+    public int Width { get; }
+
+    /// <summary>The text of the run.</summary>
+    public ReadOnlySpan<char> Span => Text is null ? default : Text.AsSpan(Start, Length);
+}
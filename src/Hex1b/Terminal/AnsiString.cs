@@ -1,5 +1,3 @@
-using System.Globalization;
-
 namespace Hex1b.Terminal;
 
 internal static class AnsiString
@@ -11,36 +9,21 @@ internal static class AnsiString
         if (string.IsNullOrEmpty(text))
             return 0;
 
-        // Strip ANSI codes first, then calculate display width
-        var stripped = StripAnsiCodes(text);
-        return DisplayWidth.GetStringWidth(stripped);
-    }
-
-    /// <summary>
-    /// Strips all ANSI escape codes (CSI and OSC) from the text.
-    /// </summary>
-    private static string StripAnsiCodes(string text)
-    {
-        if (string.IsNullOrEmpty(text))
-            return "";
-            
-        var result = new System.Text.StringBuilder();
+        // Skip over ANSI codes and sum the display width of everything in between
+        var width = 0;
         for (var i = 0; i < text.Length;)
         {
-            if (TryReadCsi(text, i, out var nextIndex))
+            if (TryReadCsi(text, i, out var nextIndex) || TryReadOsc(text, i, out nextIndex))
             {
                 i = nextIndex;
                 continue;
             }
-            if (TryReadOsc(text, i, out nextIndex))
-            {
-                i = nextIndex;
-                continue;
-            }
-            result.Append(text[i]);
-            i++;
+
+            var cluster = DisplayWidth.GetGraphemeAt(text, i);
+            width += cluster.Width;
+            i = cluster.End;
         }
-        return result.ToString();
+        return width;
     }
 
     public static string SliceByColumns(string text, int startColumn, int lengthColumns)
@@ -68,11 +51,7 @@ internal static class AnsiString
             // Check for ANSI escape sequences first (CSI and OSC)
             if (TryReadCsi(text, i, out var nextIndex))
             {
-                var seq = text.Substring(i, nextIndex - i);
-                if (!started)
-                    prefix.Append(seq);
-                else
-                    output.Append(seq);
+                (started ? output : prefix).Append(text, i, nextIndex - i);
 
                 i = nextIndex;
                 continue;
@@ -80,19 +59,16 @@ internal static class AnsiString
             
             if (TryReadOsc(text, i, out nextIndex))
             {
-                var seq = text.Substring(i, nextIndex - i);
-                if (!started)
-                    prefix.Append(seq);
-                else
-                    output.Append(seq);
+                (started ? output : prefix).Append(text, i, nextIndex - i);
 
                 i = nextIndex;
                 continue;
             }
 
             // Get the grapheme cluster at this position
-            var grapheme = GetGraphemeAt(text, i, out var graphemeLength);
-            var graphemeWidth = DisplayWidth.GetGraphemeWidth(grapheme);
+            var cluster = DisplayWidth.GetGraphemeAt(text, i);
+            var graphemeWidth = cluster.Width;
+            var graphemeLength = cluster.Length;
 
             // Skip graphemes that end before our start column
             if (currentColumn + graphemeWidth <= startColumn)
@@ -129,7 +105,7 @@ internal static class AnsiString
                 started = true;
             }
 
-            output.Append(grapheme);
+            output.Append(text, i, graphemeLength);
             currentColumn += graphemeWidth;
             i += graphemeLength;
         }
@@ -142,13 +118,13 @@ internal static class AnsiString
         {
             if (TryReadCsi(text, i, out var nextIndex))
             {
-                output.Append(text.Substring(i, nextIndex - i));
+                output.Append(text, i, nextIndex - i);
                 i = nextIndex;
                 continue;
             }
             if (TryReadOsc(text, i, out nextIndex))
             {
-                output.Append(text.Substring(i, nextIndex - i));
+                output.Append(text, i, nextIndex - i);
                 i = nextIndex;
                 continue;
             }
@@ -158,45 +134,6 @@ internal static class AnsiString
         return output.ToString();
     }
 
-    /// <summary>
-    /// Gets the grapheme cluster at the specified position in the string.
-    /// </summary>
-    private static string GetGraphemeAt(string text, int index, out int length)
-    {
-        if (index >= text.Length)
-        {
-            length = 0;
-            return "";
-        }
-
-        // Find the grapheme that contains this index
-        var enumerator = StringInfo.GetTextElementEnumerator(text);
-        while (enumerator.MoveNext())
-        {
-            if (enumerator.ElementIndex == index)
-            {
-                var grapheme = (string)enumerator.Current;
-                length = grapheme.Length;
-                return grapheme;
-            }
-            if (enumerator.ElementIndex > index)
-            {
-                // We're past the index - this shouldn't happen if index is at a grapheme boundary
-                break;
-            }
-        }
-
-        // Fallback: return single character
-        if (char.IsHighSurrogate(text[index]) && index + 1 < text.Length && char.IsLowSurrogate(text[index + 1]))
-        {
-            length = 2;
-            return text.Substring(index, 2);
-        }
-        
-        length = 1;
-        return text[index].ToString();
-    }
-
     public static string TrailingEscapeSuffix(string text)
     {
         if (string.IsNullOrEmpty(text))
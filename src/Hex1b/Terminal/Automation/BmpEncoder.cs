@@ -1,3 +1,5 @@
+using System.Buffers;
+
 namespace Hex1b.Terminal.Automation;
 
 /// <summary>
@@ -47,15 +49,68 @@ public static class BmpEncoder
         var pixelDataSize = rowStride * height;
         
         // Total file size: 14 (file header) + 40 (DIB header) + pixel data
-        var fileSize = 14 + 40 + pixelDataSize;
+        var fileSize = HeaderSize + pixelDataSize;
         var bmp = new byte[fileSize];
+        WriteHeader(bmp, width, height, pixelDataSize);
         
+        // Pixel data (bottom-up, BGR order)
+        for (int y = height - 1; y >= 0; y--)
+        {
+            var rowOffset = HeaderSize + (height - 1 - y) * rowStride;
+            ConvertRow(rgbaPixels.AsSpan(y * width * 4, width * 4), bmp.AsSpan(rowOffset, width * 3));
+            
+            // Padding bytes are already zero from array initialization
+        }
+        
+        return bmp;
+    }
+
+    /// <summary>
+    /// Writes RGBA pixel data to a stream as a BMP file, one row at a time, without building
+    /// the whole file in memory.
+    /// </summary>
+    /// <param name="stream">The stream to write to.</param>
+    /// <param name="width">Image width in pixels.</param>
+    /// <param name="height">Image height in pixels.</param>
+    /// <param name="rgbaPixels">RGBA pixel data (4 bytes per pixel).</param>
+    public static void WriteBmp(Stream stream, int width, int height, ReadOnlySpan<byte> rgbaPixels)
+    {
+        var rowStride = (width * 3 + 3) & ~3;
+        var pixelDataSize = rowStride * height;
+
+        Span<byte> header = stackalloc byte[HeaderSize];
+        WriteHeader(header, width, height, pixelDataSize);
+        stream.Write(header);
+
+        var row = ArrayPool<byte>.Shared.Rent(rowStride);
+        try
+        {
+            var rowSpan = row.AsSpan(0, rowStride);
+            rowSpan[(width * 3)..].Clear();
+            for (int y = height - 1; y >= 0; y--)
+            {
+                ConvertRow(rgbaPixels.Slice(y * width * 4, width * 4), rowSpan);
+                stream.Write(rowSpan);
+            }
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(row);
+        }
+    }
+
+    private const int HeaderSize = 14 + 40;
+
+    private static void WriteHeader(Span<byte> bmp, int width, int height, int pixelDataSize)
+    {
+        var fileSize = HeaderSize + pixelDataSize;
+
         // BMP File Header (14 bytes)
         bmp[0] = (byte)'B';
         bmp[1] = (byte)'M';
         WriteInt32LE(bmp, 2, fileSize);      // File size
         WriteInt32LE(bmp, 6, 0);             // Reserved
-        WriteInt32LE(bmp, 10, 54);           // Pixel data offset (14 + 40)
+        WriteInt32LE(bmp, 10, HeaderSize);   // Pixel data offset (14 + 40)
         
         // DIB Header - BITMAPINFOHEADER (40 bytes)
         WriteInt32LE(bmp, 14, 40);           // DIB header size
@@ -69,51 +124,44 @@ public static class BmpEncoder
         WriteInt32LE(bmp, 42, 2835);         // Vertical resolution (72 DPI)
         WriteInt32LE(bmp, 46, 0);            // Colors in palette
         WriteInt32LE(bmp, 50, 0);            // Important colors
-        
-        // Pixel data (bottom-up, BGR order)
-        var pixelOffset = 54;
-        for (int y = height - 1; y >= 0; y--)
+    }
+
+    /// <summary>
+    /// Converts one row of RGBA pixels to BGR, blending transparent pixels with the background.
+    /// </summary>
+    private static void ConvertRow(ReadOnlySpan<byte> rgba, Span<byte> bgr)
+    {
+        for (int srcIndex = 0, dstIndex = 0; srcIndex + 3 < rgba.Length; srcIndex += 4, dstIndex += 3)
         {
-            var rowOffset = pixelOffset + (height - 1 - y) * rowStride;
-            for (int x = 0; x < width; x++)
+            // Read RGBA
+            var r = rgba[srcIndex];
+            var g = rgba[srcIndex + 1];
+            var b = rgba[srcIndex + 2];
+            var a = rgba[srcIndex + 3];
+            
+            // Alpha blend with background if partially transparent
+            if (a < 255)
             {
-                var srcIndex = (y * width + x) * 4;
-                var dstIndex = rowOffset + x * 3;
-                
-                // Read RGBA
-                var r = rgbaPixels[srcIndex];
-                var g = rgbaPixels[srcIndex + 1];
-                var b = rgbaPixels[srcIndex + 2];
-                var a = rgbaPixels[srcIndex + 3];
-                
-                // Alpha blend with background if partially transparent
-                if (a < 255)
-                {
-                    var alpha = a / 255.0;
-                    r = (byte)(r * alpha + TransparentBackground.R * (1 - alpha));
-                    g = (byte)(g * alpha + TransparentBackground.G * (1 - alpha));
-                    b = (byte)(b * alpha + TransparentBackground.B * (1 - alpha));
-                }
-                
-                // Write BGR (BMP uses BGR order)
-                bmp[dstIndex] = b;
-                bmp[dstIndex + 1] = g;
-                bmp[dstIndex + 2] = r;
+                var alpha = a / 255.0;
+                r = (byte)(r * alpha + TransparentBackground.R * (1 - alpha));
+                g = (byte)(g * alpha + TransparentBackground.G * (1 - alpha));
+                b = (byte)(b * alpha + TransparentBackground.B * (1 - alpha));
             }
             
-            // Padding bytes are already zero from array initialization
+            // Write BGR (BMP uses BGR order)
+            bgr[dstIndex] = b;
+            bgr[dstIndex + 1] = g;
+            bgr[dstIndex + 2] = r;
         }
-        
-        return bmp;
     }
 
-    private static void WriteInt16LE(byte[] buffer, int offset, int value)
+    private static void WriteInt16LE(Span<byte> buffer, int offset, int value)
     {
         buffer[offset] = (byte)(value & 0xFF);
         buffer[offset + 1] = (byte)((value >> 8) & 0xFF);
     }
 
-    private static void WriteInt32LE(byte[] buffer, int offset, int value)
+    private static void WriteInt32LE(Span<byte> buffer, int offset, int value)
     {
         buffer[offset] = (byte)(value & 0xFF);
         buffer[offset + 1] = (byte)((value >> 8) & 0xFF);
@@ -1,4 +1,6 @@
-using System.Text.RegularExpressions;
+using System.Buffers;
+using System.Numerics;
+using System.Runtime.InteropServices;
 
 namespace Hex1b.Terminal.Automation;
 
@@ -14,9 +16,21 @@ namespace Hex1b.Terminal.Automation;
 /// This decoder is used to convert sixel data embedded in terminal snapshots
 /// into images that can be embedded in SVG output for visual testing.
 /// </para>
+/// <para>
+/// The payload is decoded in a single pass, straight into a pooled pixel buffer sized from
+/// the raster attributes (<c>"Pan;Pad;Ph;Pv</c>, where Ph is the width and Pv the height).
+/// The buffer grows if the data draws outside them.
+/// </para>
 /// </remarks>
 public static class SixelDecoder
 {
+    // Color registers. Selecting a register outside this range draws transparent pixels.
+    private const int PaletteSize = 256;
+
+    // Pixels drawn further out than this are dropped, so a malformed repeat count can't
+    // allocate an enormous image
+    private const int MaxImageSize = 8192;
+
     /// <summary>
     /// Decodes a Sixel DCS payload to raw RGBA pixel data.
     /// </summary>
@@ -29,24 +43,71 @@ public static class SixelDecoder
         if (string.IsNullOrEmpty(payload))
             return null;
 
-        try
-        {
-            // Strip DCS wrapper if present: ESC P ... q <data> ESC \
-            var sixelData = StripDcsWrapper(payload);
-            if (string.IsNullOrEmpty(sixelData))
-                return null;
+        return Decode(payload.AsSpan(), cellWidth, cellHeight);
+    }
 
-            // Parse the sixel data
-            return ParseSixelData(sixelData, cellWidth, cellHeight);
-        }
-        catch
-        {
-            // If parsing fails, return null (graceful degradation)
+    /// <summary>
+    /// Decodes a Sixel DCS payload to raw RGBA pixel data.
+    /// </summary>
+    /// <param name="payload">The Sixel payload (including or excluding DCS wrapper).</param>
+    /// <param name="cellWidth">The width of a terminal cell in pixels.</param>
+    /// <param name="cellHeight">The height of a terminal cell in pixels.</param>
+    /// <returns>Decoded image with RGBA pixel data, or null if decoding fails.</returns>
+    public static SixelImage? Decode(ReadOnlySpan<char> payload, int cellWidth = 9, int cellHeight = 18)
+    {
+        var data = StripDcsWrapper(payload);
+        if (data.IsEmpty)
             return null;
-        }
+
+        var raster = ReadRasterSize(data);
+        using var canvas = SixelCanvas.CreateGrowable(raster?.Width ?? 0, raster?.Height ?? 0);
+        Parse(data, canvas);
+        return canvas.ToImage(raster);
     }
 
-    private static string StripDcsWrapper(string payload)
+    /// <summary>
+    /// Decodes a Sixel DCS payload scaled down to fit within <paramref name="maxWidth"/> by
+    /// <paramref name="maxHeight"/> pixels, keeping its aspect ratio. Only the pixels that
+    /// are kept are written, so a thumbnail of a large image needs no full-size buffer.
+    /// </summary>
+    /// <param name="payload">The Sixel payload (including or excluding DCS wrapper).</param>
+    /// <param name="maxWidth">The largest width of the decoded image in pixels.</param>
+    /// <param name="maxHeight">The largest height of the decoded image in pixels.</param>
+    /// <returns>
+    /// Decoded image with RGBA pixel data, or null if decoding fails. Images that already fit
+    /// are decoded at full size.
+    /// </returns>
+    /// <remarks>
+    /// Pixels are sampled with nearest neighbour, matching how snapshots draw sixel images.
+    /// Payloads without raster attributes are scanned once first to find their size.
+    /// </remarks>
+    public static SixelImage? DecodeScaled(ReadOnlySpan<char> payload, int maxWidth, int maxHeight)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(maxWidth);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(maxHeight);
+
+        var data = StripDcsWrapper(payload);
+        if (data.IsEmpty)
+            return null;
+
+        var raster = ReadRasterSize(data);
+        var (width, height) = raster ?? Measure(data);
+        if (width == 0 || height == 0)
+            return null;
+
+        if (width <= maxWidth && height <= maxHeight)
+            return Decode(payload);
+
+        var scale = Math.Min((double)maxWidth / width, (double)maxHeight / height);
+        var targetWidth = Math.Clamp((int)(width * scale), 1, maxWidth);
+        var targetHeight = Math.Clamp((int)(height * scale), 1, maxHeight);
+
+        using var canvas = SixelCanvas.CreateScaled(width, height, targetWidth, targetHeight);
+        Parse(data, canvas);
+        return canvas.ToImage(raster: null);
+    }
+
+    private static ReadOnlySpan<char> StripDcsWrapper(ReadOnlySpan<char> payload)
     {
         // DCS starts with ESC P or 0x90, ends with ESC \ or 0x9C
         var start = payload.IndexOf('q');
@@ -56,284 +117,212 @@ public static class SixelDecoder
             return payload;
         }
 
+        var data = payload[(start + 1)..];
+
         // Find the end - ESC \ (0x1B 0x5C) or ST (0x9C)
-        var end = payload.IndexOf("\x1b\\", start, StringComparison.Ordinal);
+        var end = data.IndexOf("\x1b\\", StringComparison.Ordinal);
         if (end < 0)
         {
-            end = payload.IndexOf('\x9C', start);
-        }
-        if (end < 0)
-        {
-            end = payload.Length;
+            end = data.IndexOf('\x9C');
         }
 
-        return payload.Substring(start + 1, end - start - 1);
+        return end < 0 ? data : data[..end];
+    }
+
+    /// <summary>
+    /// Reads the image size from the raster attributes that open the data, if there are any.
+    /// </summary>
+    private static (int Width, int Height)? ReadRasterSize(ReadOnlySpan<char> data)
+    {
+        if (data.IsEmpty || data[0] != '"')
+            return null;
+
+        // "Pan;Pad;Ph;Pv - Ph is the width in pixels, Pv the height
+        var i = 1;
+        ReadNumber(data, ref i, 0);
+        if (!TrySkip(data, ref i, ';'))
+            return null;
+        ReadNumber(data, ref i, 0);
+        if (!TrySkip(data, ref i, ';'))
+            return null;
+        var width = ReadNumber(data, ref i, 0);
+        if (!TrySkip(data, ref i, ';'))
+            return null;
+        var height = ReadNumber(data, ref i, 0);
+
+        if (width <= 0 || height <= 0)
+            return null;
+
+        return (Math.Min(width, MaxImageSize), Math.Min(height, MaxImageSize));
+    }
+
+    /// <summary>
+    /// Finds the size of the image the data draws, without drawing it.
+    /// </summary>
+    private static (int Width, int Height) Measure(ReadOnlySpan<char> data)
+    {
+        using var canvas = SixelCanvas.CreateMeasure();
+        Parse(data, canvas);
+        return (canvas.ColumnExtent, canvas.BandExtent);
     }
 
-    private static SixelImage? ParseSixelData(string data, int cellWidth, int cellHeight)
+    /// <summary>
+    /// Runs the Sixel state machine over <paramref name="data"/>, drawing into <paramref name="canvas"/>.
+    /// </summary>
+    private static void Parse(ReadOnlySpan<char> data, SixelCanvas canvas)
     {
-        // Parse color palette and sixel data
-        var palette = new Dictionary<int, (byte R, byte G, byte B)>();
-        
-        // Default palette (standard 16 colors)
+        Span<uint> palette = stackalloc uint[PaletteSize];
+        palette.Clear();
         InitializeDefaultPalette(palette);
 
-        // Temporary storage for sixel rows
-        // Each sixel represents 6 vertical pixels
-        var rows = new List<List<int>>(); // List of rows, each row is list of color indices
-        var currentRow = new List<int>();
-        var currentX = 0;
-        var maxWidth = 0;
-        var currentColorIndex = 0;
+        var x = 0;
+        var bandY = 0;
+        var color = palette[0];
 
         var i = 0;
         while (i < data.Length)
         {
             var ch = data[i];
 
-            if (ch == '#')
+            if (ch >= '?' && ch <= '~')
             {
-                // Color definition or selection: #<colorIndex>[;<type>;<p1>;<p2>;<p3>]
+                // Sixel character (value = ch - 63): one column of 6 pixels
+                canvas.Draw(x, bandY, ch - '?', 1, color);
+                x++;
                 i++;
-                var colorData = ParseColorCommand(data, ref i);
-                if (colorData.HasValue)
-                {
-                    var (colorIndex, r, g, b, isDefinition) = colorData.Value;
-                    if (isDefinition)
-                    {
-                        palette[colorIndex] = (r, g, b);
-                    }
-                    currentColorIndex = colorIndex;
-                }
+                continue;
             }
-            else if (ch == '!')
+
+            switch (ch)
             {
-                // Repeat: !<count><sixel>
-                i++;
-                var (count, sixelChar) = ParseRepeat(data, ref i);
-                for (int j = 0; j < count; j++)
+                case '#':
                 {
-                    while (rows.Count < 6)
-                        rows.Add([]);
-                    
-                    var sixelValue = sixelChar - '?';
-                    for (int bit = 0; bit < 6; bit++)
+                    // Color definition or selection: #<colorIndex>[;<type>;<p1>;<p2>;<p3>]
+                    i++;
+                    var register = ReadNumber(data, ref i, 0);
+                    if (TrySkip(data, ref i, ';'))
                     {
-                        var row = rows[bit];
-                        while (row.Count <= currentX)
-                            row.Add(-1); // Transparent
-                        
-                        if ((sixelValue & (1 << bit)) != 0)
+                        var type = ReadNumber(data, ref i, 0);
+                        TrySkip(data, ref i, ';');
+                        var p1 = ReadNumber(data, ref i, 0);
+                        TrySkip(data, ref i, ';');
+                        var p2 = ReadNumber(data, ref i, 0);
+                        TrySkip(data, ref i, ';');
+                        var p3 = ReadNumber(data, ref i, 0);
+
+                        if (register < PaletteSize && type is 1 or 2)
                         {
-                            row[currentX] = currentColorIndex;
+                            var (r, g, b) = type == 2
+                                ? (ToByte(p1), ToByte(p2), ToByte(p3))
+                                : HlsToRgb(p1, p2, p3);
+                            palette[register] = Pack(r, g, b);
                         }
                     }
-                    currentX++;
-                    maxWidth = Math.Max(maxWidth, currentX);
+                    color = register < PaletteSize ? palette[register] : 0;
+                    break;
                 }
-            }
-            else if (ch == '$')
-            {
-                // Carriage return - go back to start of current band
-                currentX = 0;
-                i++;
-            }
-            else if (ch == '-')
-            {
-                // Graphics new line - move to next band of 6 rows
-                currentX = 0;
-                // Pad existing rows and start new band
-                for (int j = 0; j < 6; j++)
+
+                case '!':
                 {
-                    rows.Add([]);
-                }
-                i++;
-            }
-            else if (ch == '"')
-            {
-                // Raster attributes: "Pan;Pad;Ph;Pv - skip for now
-                i++;
-                while (i < data.Length && (char.IsDigit(data[i]) || data[i] == ';'))
+                    // Repeat: !<count><sixel>
                     i++;
-            }
-            else if (ch >= '?' && ch <= '~')
-            {
-                // Sixel character (value = ch - 63)
-                while (rows.Count < 6)
-                    rows.Add([]);
-                
-                var sixelValue = ch - '?';
-                for (int bit = 0; bit < 6; bit++)
-                {
-                    var rowIndex = rows.Count - 6 + bit;
-                    if (rowIndex < 0) continue;
-                    
-                    var row = rows[rowIndex];
-                    while (row.Count <= currentX)
-                        row.Add(-1); // Transparent
-                    
-                    if ((sixelValue & (1 << bit)) != 0)
+                    var count = ReadNumber(data, ref i, 1);
+                    var bits = 0;
+                    if (i < data.Length && data[i] >= '?' && data[i] <= '~')
                     {
-                        row[currentX] = currentColorIndex;
+                        bits = data[i] - '?';
+                        i++;
                     }
+                    canvas.Draw(x, bandY, bits, count, color);
+                    x += count;
+                    break;
                 }
-                currentX++;
-                maxWidth = Math.Max(maxWidth, currentX);
-                i++;
-            }
-            else
-            {
-                // Unknown character, skip
-                i++;
-            }
-        }
 
-        if (maxWidth == 0 || rows.Count == 0)
-            return null;
+                case '$':
+                    // Carriage return - go back to start of current band
+                    x = 0;
+                    i++;
+                    break;
 
-        // Convert to RGBA pixels
-        var height = rows.Count;
-        var width = maxWidth;
-        var pixels = new byte[width * height * 4];
+                case '-':
+                    // Graphics new line - move to next band of 6 rows
+                    x = 0;
+                    bandY += 6;
+                    i++;
+                    break;
 
-        for (int y = 0; y < height; y++)
-        {
-            var row = y < rows.Count ? rows[y] : null;
-            for (int x = 0; x < width; x++)
-            {
-                var pixelIndex = (y * width + x) * 4;
-                var colorIndex = (row != null && x < row.Count) ? row[x] : -1;
+                case '"':
+                    // Raster attributes were read before parsing
+                    i++;
+                    while (i < data.Length && (char.IsAsciiDigit(data[i]) || data[i] == ';'))
+                        i++;
+                    break;
 
-                if (colorIndex >= 0 && palette.TryGetValue(colorIndex, out var color))
-                {
-                    pixels[pixelIndex] = color.R;
-                    pixels[pixelIndex + 1] = color.G;
-                    pixels[pixelIndex + 2] = color.B;
-                    pixels[pixelIndex + 3] = 255; // Fully opaque
-                }
-                else
-                {
-                    // Transparent
-                    pixels[pixelIndex] = 0;
-                    pixels[pixelIndex + 1] = 0;
-                    pixels[pixelIndex + 2] = 0;
-                    pixels[pixelIndex + 3] = 0;
-                }
+                default:
+                    // Unknown character, skip
+                    i++;
+                    break;
             }
         }
-
-        return new SixelImage(width, height, pixels);
     }
 
-    private static (int colorIndex, byte r, byte g, byte b, bool isDefinition)? ParseColorCommand(string data, ref int i)
+    /// <summary>
+    /// Reads a decimal parameter, or returns <paramref name="defaultValue"/> if there are no digits.
+    /// </summary>
+    private static int ReadNumber(ReadOnlySpan<char> data, ref int i, int defaultValue)
     {
-        // Parse color index
-        var colorIndexStr = "";
-        while (i < data.Length && char.IsDigit(data[i]))
+        var start = i;
+        var value = 0;
+        while (i < data.Length && char.IsAsciiDigit(data[i]))
         {
-            colorIndexStr += data[i++];
+            // Saturate rather than overflow; anything this large is clipped anyway
+            value = Math.Min(value * 10 + (data[i] - '0'), MaxImageSize * 10);
+            i++;
         }
-
-        if (!int.TryParse(colorIndexStr, out var colorIndex))
-            return null;
-
-        // Check if this is a definition (has semicolons)
-        if (i < data.Length && data[i] == ';')
-        {
-            i++; // Skip first semicolon
-            
-            // Parse color type (1 = HLS, 2 = RGB)
-            var typeStr = "";
-            while (i < data.Length && char.IsDigit(data[i]))
-            {
-                typeStr += data[i++];
-            }
-            
-            if (!int.TryParse(typeStr, out var colorType))
-                return (colorIndex, 0, 0, 0, false); // Just selection
-            
-            if (i < data.Length && data[i] == ';') i++;
-            
-            // Parse color values
-            var values = new List<int>();
-            for (int v = 0; v < 3; v++)
-            {
-                var valStr = "";
-                while (i < data.Length && char.IsDigit(data[i]))
-                {
-                    valStr += data[i++];
-                }
-                if (int.TryParse(valStr, out var val))
-                    values.Add(val);
-                else
-                    values.Add(0);
-                
-                if (i < data.Length && data[i] == ';') i++;
-            }
-
-            if (colorType == 2 && values.Count >= 3)
-            {
-                // RGB: values are 0-100 percentages
-                var r = (byte)(values[0] * 255 / 100);
-                var g = (byte)(values[1] * 255 / 100);
-                var b = (byte)(values[2] * 255 / 100);
-                return (colorIndex, r, g, b, true);
-            }
-            else if (colorType == 1 && values.Count >= 3)
-            {
-                // HLS: convert to RGB
-                var (r, g, b) = HlsToRgb(values[0], values[1], values[2]);
-                return (colorIndex, r, g, b, true);
-            }
-            
-            return (colorIndex, 0, 0, 0, false);
-        }
-
-        return (colorIndex, 0, 0, 0, false); // Just selection, no definition
+        return i == start ? defaultValue : value;
     }
 
-    private static (int count, char sixelChar) ParseRepeat(string data, ref int i)
+    private static bool TrySkip(ReadOnlySpan<char> data, ref int i, char ch)
     {
-        var countStr = "";
-        while (i < data.Length && char.IsDigit(data[i]))
+        if (i < data.Length && data[i] == ch)
         {
-            countStr += data[i++];
+            i++;
+            return true;
         }
+        return false;
+    }
 
-        var count = 1;
-        if (!string.IsNullOrEmpty(countStr))
-        {
-            int.TryParse(countStr, out count);
-        }
+    // RGB color components are percentages
+    private static byte ToByte(int percent) => (byte)(Math.Min(percent, 100) * 255 / 100);
 
-        char sixelChar = '?'; // Default to empty sixel
-        if (i < data.Length && data[i] >= '?' && data[i] <= '~')
-        {
-            sixelChar = data[i++];
-        }
-
-        return (count, sixelChar);
+    /// <summary>
+    /// Packs an opaque color into the layout of one RGBA pixel.
+    /// </summary>
+    private static uint Pack(byte r, byte g, byte b)
+    {
+        ReadOnlySpan<byte> rgba = [r, g, b, 255];
+        return MemoryMarshal.Read<uint>(rgba);
     }
 
-    private static void InitializeDefaultPalette(Dictionary<int, (byte R, byte G, byte B)> palette)
+    private static void InitializeDefaultPalette(Span<uint> palette)
     {
         // VT340 default 16-color palette (approximate)
-        palette[0] = (0, 0, 0);       // Black
-        palette[1] = (51, 51, 255);   // Blue
-        palette[2] = (255, 51, 51);   // Red
-        palette[3] = (51, 255, 51);   // Green
-        palette[4] = (255, 51, 255);  // Magenta
-        palette[5] = (51, 255, 255);  // Cyan
-        palette[6] = (255, 255, 51);  // Yellow
-        palette[7] = (250, 250, 250); // White
-        palette[8] = (128, 128, 128); // Gray
-        palette[9] = (102, 102, 255); // Light blue
-        palette[10] = (255, 102, 102); // Light red
-        palette[11] = (102, 255, 102); // Light green
-        palette[12] = (255, 102, 255); // Light magenta
-        palette[13] = (102, 255, 255); // Light cyan
-        palette[14] = (255, 255, 102); // Light yellow
-        palette[15] = (255, 255, 255); // Bright white
+        palette[0] = Pack(0, 0, 0);         // Black
+        palette[1] = Pack(51, 51, 255);     // Blue
+        palette[2] = Pack(255, 51, 51);     // Red
+        palette[3] = Pack(51, 255, 51);     // Green
+        palette[4] = Pack(255, 51, 255);    // Magenta
+        palette[5] = Pack(51, 255, 255);    // Cyan
+        palette[6] = Pack(255, 255, 51);    // Yellow
+        palette[7] = Pack(250, 250, 250);   // White
+        palette[8] = Pack(128, 128, 128);   // Gray
+        palette[9] = Pack(102, 102, 255);   // Light blue
+        palette[10] = Pack(255, 102, 102);  // Light red
+        palette[11] = Pack(102, 255, 102);  // Light green
+        palette[12] = Pack(255, 102, 255);  // Light magenta
+        palette[13] = Pack(102, 255, 255);  // Light cyan
+        palette[14] = Pack(255, 255, 102);  // Light yellow
+        palette[15] = Pack(255, 255, 255);  // Bright white
     }
 
     private static (byte R, byte G, byte B) HlsToRgb(int h, int l, int s)
@@ -373,6 +362,221 @@ public static class SixelDecoder
         if (t < 2.0 / 3) return p + (q - p) * (2.0 / 3 - t) * 6;
         return p;
     }
+
+    /// <summary>
+    /// Where a payload's pixels are drawn: a pooled buffer that grows to fit, a scaled-down
+    /// target that keeps only the sampled pixels, or nowhere when only measuring.
+    /// </summary>
+    private sealed class SixelCanvas : IDisposable
+    {
+        private readonly bool _draws;
+        private readonly int[]? _columnMap;
+        private readonly int[]? _rowMap;
+        private byte[]? _buffer;
+        private int _stride;
+        private int _rows;
+
+        private SixelCanvas(bool draws, int[]? columnMap = null, int[]? rowMap = null)
+        {
+            _draws = draws;
+            _columnMap = columnMap;
+            _rowMap = rowMap;
+        }
+
+        /// <summary>
+        /// Gets the number of columns the data reaches.
+        /// </summary>
+        public int ColumnExtent { get; private set; }
+
+        /// <summary>
+        /// Gets the height of the bands the data draws in.
+        /// </summary>
+        public int BandExtent { get; private set; }
+
+        /// <summary>
+        /// Gets the number of rows down to the lowest pixel drawn.
+        /// </summary>
+        public int RowExtent { get; private set; }
+
+        public static SixelCanvas CreateGrowable(int width, int height)
+        {
+            var canvas = new SixelCanvas(draws: true);
+            if (width > 0 && height > 0)
+            {
+                // Whole bands, since the last one is drawn six rows high
+                canvas.Resize(width, Math.Min((height + 5) / 6 * 6, MaxImageSize));
+            }
+            return canvas;
+        }
+
+        public static SixelCanvas CreateScaled(int width, int height, int targetWidth, int targetHeight)
+        {
+            var canvas = new SixelCanvas(draws: true, CreateSampleMap(width, targetWidth), CreateSampleMap(height, targetHeight));
+            canvas.Resize(targetWidth, targetHeight);
+            return canvas;
+        }
+
+        public static SixelCanvas CreateMeasure() => new(draws: false);
+
+        /// <summary>
+        /// Draws <paramref name="count"/> columns of the sixel <paramref name="bits"/> from column
+        /// <paramref name="x"/> of the band starting at row <paramref name="bandY"/>.
+        /// </summary>
+        public void Draw(int x, int bandY, int bits, int count, uint color)
+        {
+            count = Math.Min(count, MaxImageSize - x);
+            if (count <= 0)
+                return;
+
+            ColumnExtent = Math.Max(ColumnExtent, x + count);
+            BandExtent = Math.Max(BandExtent, Math.Min(bandY + 6, MaxImageSize));
+            if (bits == 0 || bandY >= MaxImageSize)
+                return;
+
+            RowExtent = Math.Max(RowExtent, Math.Min(bandY + BitOperations.Log2((uint)bits) + 1, MaxImageSize));
+            if (!_draws)
+                return;
+
+            if (_columnMap != null)
+            {
+                DrawScaled(x, bandY, bits, count, color);
+                return;
+            }
+
+            var bottom = Math.Min(bandY + 6, MaxImageSize);
+            if (x + count > _stride || bottom > _rows)
+            {
+                // Grow geometrically so data past the raster attributes doesn't copy every band
+                Resize(
+                    x + count > _stride ? Math.Max(x + count, Math.Min(_stride * 2, MaxImageSize)) : _stride,
+                    bottom > _rows ? Math.Max(bottom, Math.Min(_rows * 2, MaxImageSize)) : _rows);
+            }
+
+            var pixels = MemoryMarshal.Cast<byte, uint>(_buffer.AsSpan(0, _stride * _rows * 4));
+            for (var bit = 0; bit < 6; bit++)
+            {
+                var y = bandY + bit;
+                if (y >= _rows)
+                    break;
+
+                if ((bits & (1 << bit)) != 0)
+                {
+                    pixels.Slice(y * _stride + x, count).Fill(color);
+                }
+            }
+        }
+
+        private void DrawScaled(int x, int bandY, int bits, int count, uint color)
+        {
+            var pixels = MemoryMarshal.Cast<byte, uint>(_buffer.AsSpan(0, _stride * _rows * 4));
+            var end = Math.Min(x + count, _columnMap!.Length);
+
+            for (var bit = 0; bit < 6; bit++)
+            {
+                var y = bandY + bit;
+                if (y >= _rowMap!.Length)
+                    break;
+
+                var targetY = _rowMap[y];
+                if (targetY < 0 || (bits & (1 << bit)) == 0)
+                    continue;
+
+                var row = pixels.Slice(targetY * _stride, _stride);
+                for (var sourceX = x; sourceX < end; sourceX++)
+                {
+                    var targetX = _columnMap[sourceX];
+                    if (targetX >= 0)
+                    {
+                        row[targetX] = color;
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Copies the drawn pixels out of the pooled buffer into an image.
+        /// </summary>
+        /// <param name="raster">
+        /// The size from the raster attributes. The image is at least this size, and bigger if
+        /// the data draws outside it. Without one, the image covers every band drawn in.
+        /// </param>
+        public SixelImage? ToImage((int Width, int Height)? raster)
+        {
+            if (ColumnExtent == 0)
+                return null;
+
+            int width, height;
+            if (_columnMap != null)
+            {
+                (width, height) = (_stride, _rows);
+            }
+            else if (raster is { } size)
+            {
+                (width, height) = (Math.Max(size.Width, ColumnExtent), Math.Max(size.Height, RowExtent));
+            }
+            else
+            {
+                (width, height) = (ColumnExtent, BandExtent);
+            }
+
+            if (width == 0 || height == 0)
+                return null;
+
+            var pixels = new byte[width * height * 4];
+            if (_buffer != null)
+            {
+                var rowBytes = Math.Min(width, _stride) * 4;
+                for (var y = 0; y < Math.Min(height, _rows); y++)
+                {
+                    _buffer.AsSpan(y * _stride * 4, rowBytes).CopyTo(pixels.AsSpan(y * width * 4));
+                }
+            }
+
+            return new SixelImage(width, height, pixels);
+        }
+
+        public void Dispose()
+        {
+            if (_buffer != null)
+            {
+                ArrayPool<byte>.Shared.Return(_buffer);
+                _buffer = null;
+            }
+        }
+
+        private void Resize(int width, int height)
+        {
+            var buffer = ArrayPool<byte>.Shared.Rent(width * height * 4);
+            Array.Clear(buffer, 0, width * height * 4);
+
+            if (_buffer != null)
+            {
+                for (var y = 0; y < _rows; y++)
+                {
+                    _buffer.AsSpan(y * _stride * 4, _stride * 4).CopyTo(buffer.AsSpan(y * width * 4));
+                }
+                ArrayPool<byte>.Shared.Return(_buffer);
+            }
+
+            _buffer = buffer;
+            _stride = width;
+            _rows = height;
+        }
+
+        /// <summary>
+        /// Maps each source position to the target position that samples it, or -1.
+        /// </summary>
+        private static int[] CreateSampleMap(int sourceSize, int targetSize)
+        {
+            var map = new int[sourceSize];
+            map.AsSpan().Fill(-1);
+            for (var target = 0; target < targetSize; target++)
+            {
+                map[(int)((long)target * sourceSize / targetSize)] = target;
+            }
+            return map;
+        }
+    }
 }
 
 /// <summary>
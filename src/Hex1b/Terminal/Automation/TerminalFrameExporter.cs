@@ -0,0 +1,257 @@
+using System.Collections.Concurrent;
+using System.Globalization;
+using System.Text;
+
+namespace Hex1b.Terminal.Automation;
+
+/// <summary>
+/// Renders batches of terminal frames to SVG, HTML or BMP files in parallel.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Frames are rendered across cores and written straight to their files as they are
+/// rendered, without building each document as a string first. Color strings, text styles,
+/// style sheets and decoded sixel images are cached for the whole batch and shared between
+/// frames, so thousands of similar frames pay for each of these once.
+/// </para>
+/// <para>
+/// Frames of a recording are taken with <see cref="Hex1bRecordingPlayer"/>. The requested
+/// times are split into one contiguous run per worker, and each worker plays its own run
+/// forward, so no frame replays more than the output since the previous one or the nearest
+/// keyframe.
+/// </para>
+/// <example>
+/// <code>
+/// var files = await TerminalFrameExporter.ExportRecordingAsync(
+///     "session.hxr",
+///     TimeSpan.FromSeconds(1),
+///     "frames",
+///     new TerminalFrameExportOptions { Format = TerminalFrameFormat.Svg });
+/// </code>
+/// </example>
+/// </remarks>
+public static class TerminalFrameExporter
+{
+    /// <summary>
+    /// Renders snapshots to files in <paramref name="outputDirectory"/>, one per snapshot.
+    /// </summary>
+    /// <param name="snapshots">The frames to render.</param>
+    /// <param name="outputDirectory">Directory for the files, created if it does not exist.</param>
+    /// <param name="options">Export options. If null, defaults are used.</param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <returns>The path of each frame's file, in the order of <paramref name="snapshots"/>.</returns>
+    public static async Task<IReadOnlyList<string>> ExportAsync(
+        IReadOnlyList<Hex1bTerminalSnapshot> snapshots,
+        string outputDirectory,
+        TerminalFrameExportOptions? options = null,
+        CancellationToken ct = default)
+    {
+        ArgumentNullException.ThrowIfNull(snapshots);
+        var batch = new Batch(outputDirectory, options, snapshots.Count);
+
+        await Parallel.ForEachAsync(
+            Enumerable.Range(0, snapshots.Count),
+            batch.CreateParallelOptions(ct),
+            (index, _) =>
+            {
+                batch.Render(index, snapshots[index]);
+                return ValueTask.CompletedTask;
+            });
+
+        return batch.Paths;
+    }
+
+    /// <summary>
+    /// Renders a recording's screen at each of <paramref name="times"/> to files in
+    /// <paramref name="outputDirectory"/>.
+    /// </summary>
+    /// <param name="recordingPath">Path to a <see cref="Hex1bRecorder"/> recording.</param>
+    /// <param name="times">Times since the recording started, in any order.</param>
+    /// <param name="outputDirectory">Directory for the files, created if it does not exist.</param>
+    /// <param name="options">Export options. If null, defaults are used.</param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <returns>The path of each frame's file, in the order of <paramref name="times"/>.</returns>
+    public static async Task<IReadOnlyList<string>> ExportRecordingAsync(
+        string recordingPath,
+        IReadOnlyList<TimeSpan> times,
+        string outputDirectory,
+        TerminalFrameExportOptions? options = null,
+        CancellationToken ct = default)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(recordingPath);
+        ArgumentNullException.ThrowIfNull(times);
+        var batch = new Batch(outputDirectory, options, times.Count);
+
+        // Contiguous runs of sorted times, so each worker's player only ever seeks forward
+        var frames = Enumerable.Range(0, times.Count).OrderBy(i => times[i]).ToArray();
+        var workers = Math.Max(1, Math.Min(batch.MaxDegreeOfParallelism, frames.Length));
+        var runLength = Math.Max(1, (frames.Length + workers - 1) / workers);
+
+        await Parallel.ForEachAsync(
+            frames.Chunk(runLength),
+            batch.CreateParallelOptions(ct),
+            (run, token) =>
+            {
+                using var player = Hex1bRecordingPlayer.Open(recordingPath);
+                foreach (var index in run)
+                {
+                    token.ThrowIfCancellationRequested();
+                    player.Seek(times[index]);
+                    using var snapshot = player.CreateSnapshot();
+                    batch.Render(index, snapshot);
+                }
+                return ValueTask.CompletedTask;
+            });
+
+        return batch.Paths;
+    }
+
+    /// <summary>
+    /// Renders a recording's screen every <paramref name="interval"/>, from the start to the
+    /// end, to files in <paramref name="outputDirectory"/>.
+    /// </summary>
+    /// <param name="recordingPath">Path to a <see cref="Hex1bRecorder"/> recording.</param>
+    /// <param name="interval">Time between frames.</param>
+    /// <param name="outputDirectory">Directory for the files, created if it does not exist.</param>
+    /// <param name="options">Export options. If null, defaults are used.</param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <returns>The path of each frame's file, in time order.</returns>
+    public static Task<IReadOnlyList<string>> ExportRecordingAsync(
+        string recordingPath,
+        TimeSpan interval,
+        string outputDirectory,
+        TerminalFrameExportOptions? options = null,
+        CancellationToken ct = default)
+    {
+        ArgumentOutOfRangeException.ThrowIfLessThanOrEqual(interval, TimeSpan.Zero);
+
+        TimeSpan duration;
+        using (var reader = Hex1bRecordingReader.Open(recordingPath))
+        {
+            duration = reader.Duration;
+        }
+
+        var times = new List<TimeSpan>();
+        for (var time = TimeSpan.Zero; time <= duration; time += interval)
+        {
+            times.Add(time);
+        }
+
+        return ExportRecordingAsync(recordingPath, times, outputDirectory, options, ct);
+    }
+
+    /// <summary>
+    /// State shared by the frames of one export: options, output paths and the render cache.
+    /// </summary>
+    private sealed class Batch
+    {
+        private static readonly UTF8Encoding Utf8NoBom = new(encoderShouldEmitUTF8Identifier: false);
+
+        private readonly TerminalFrameExportOptions _options;
+        private readonly string _directory;
+        private readonly string _extension;
+        private readonly TerminalRenderCache _cache = new();
+        private readonly ConcurrentDictionary<(int CellWidth, int CellHeight), TerminalSvgOptions> _renderOptions = new();
+        private readonly string[] _paths;
+
+        public Batch(string outputDirectory, TerminalFrameExportOptions? options, int count)
+        {
+            ArgumentException.ThrowIfNullOrWhiteSpace(outputDirectory);
+            _options = options ?? new TerminalFrameExportOptions();
+            _directory = outputDirectory;
+            _extension = _options.Format switch
+            {
+                TerminalFrameFormat.Svg => ".svg",
+                TerminalFrameFormat.Html => ".html",
+                TerminalFrameFormat.Bmp => ".bmp",
+                _ => throw new ArgumentOutOfRangeException(nameof(options), _options.Format, "Unknown frame format.")
+            };
+            _paths = new string[count];
+            Directory.CreateDirectory(outputDirectory);
+        }
+
+        /// <summary>
+        /// The path of each frame's file, by index.
+        /// </summary>
+        public IReadOnlyList<string> Paths => _paths;
+
+        public int MaxDegreeOfParallelism => _options.MaxDegreeOfParallelism > 0
+            ? _options.MaxDegreeOfParallelism
+            : Environment.ProcessorCount;
+
+        public ParallelOptions CreateParallelOptions(CancellationToken ct) => new()
+        {
+            MaxDegreeOfParallelism = MaxDegreeOfParallelism,
+            CancellationToken = ct
+        };
+
+        public void Render(int index, Hex1bTerminalSnapshot snapshot)
+        {
+            var path = Path.Combine(_directory, string.Format(CultureInfo.InvariantCulture, _options.FileNameFormat, index) + _extension);
+
+            // Without options, frames use their snapshot's cell size, as ToSvg does
+            var renderOptions = _options.RenderOptions ?? _renderOptions.GetOrAdd(
+                (snapshot.CellPixelWidth, snapshot.CellPixelHeight),
+                static size => new TerminalSvgOptions { CellWidth = size.CellWidth, CellHeight = size.CellHeight });
+
+            using (var stream = new FileStream(path, FileMode.Create, FileAccess.Write, FileShare.None, bufferSize: 64 * 1024))
+            {
+                if (_options.Format == TerminalFrameFormat.Bmp)
+                {
+                    TerminalRegionBmpExtensions.RenderToBmp(snapshot, renderOptions, snapshot.CursorX, snapshot.CursorY, stream, _cache);
+                }
+                else
+                {
+                    using var writer = new StreamWriter(stream, Utf8NoBom, bufferSize: 64 * 1024);
+                    if (_options.Format == TerminalFrameFormat.Html)
+                        TerminalRegionHtmlExtensions.RenderToHtml(snapshot, renderOptions, writer, _cache);
+                    else
+                        TerminalRegionSvgExtensions.RenderToSvg(snapshot, renderOptions, snapshot.CursorX, snapshot.CursorY, writer, _cache);
+                }
+            }
+
+            _paths[index] = path;
+        }
+    }
+}
+
+/// <summary>
+/// File formats <see cref="TerminalFrameExporter"/> can render frames to.
+/// </summary>
+public enum TerminalFrameFormat
+{
+    /// <summary>SVG, as rendered by <see cref="TerminalRegionSvgExtensions.ToSvg(Hex1bTerminalSnapshot, TerminalSvgOptions?)"/>.</summary>
+    Svg,
+
+    /// <summary>The interactive HTML inspector, as rendered by <see cref="TerminalRegionHtmlExtensions.ToHtml(Hex1bTerminalSnapshot, TerminalSvgOptions?)"/>.</summary>
+    Html,
+
+    /// <summary>BMP, as rendered by <see cref="TerminalRegionBmpExtensions.ToBmp(Hex1bTerminalSnapshot, TerminalSvgOptions?)"/>.</summary>
+    Bmp,
+}
+
+/// <summary>
+/// Options for <see cref="TerminalFrameExporter"/>.
+/// </summary>
+public sealed class TerminalFrameExportOptions
+{
+    /// <summary>
+    /// The file format. Default is <see cref="TerminalFrameFormat.Svg"/>.
+    /// </summary>
+    public TerminalFrameFormat Format { get; set; } = TerminalFrameFormat.Svg;
+
+    /// <summary>
+    /// Rendering options for every frame. If null, defaults are used with each snapshot's cell dimensions.
+    /// </summary>
+    public TerminalSvgOptions? RenderOptions { get; set; }
+
+    /// <summary>
+    /// Composite format string for file names, given the frame's index; the format's extension is appended.
+    /// </summary>
+    public string FileNameFormat { get; set; } = "frame-{0:D5}";
+
+    /// <summary>
+    /// Maximum number of frames rendered at once. Zero or less uses one per processor.
+    /// </summary>
+    public int MaxDegreeOfParallelism { get; set; }
+}
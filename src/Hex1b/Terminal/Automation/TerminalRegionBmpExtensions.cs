@@ -0,0 +1,249 @@
+using System.Buffers;
+
+namespace Hex1b.Terminal.Automation;
+
+/// <summary>
+/// Extension methods for rendering terminal regions to BMP images.
+/// </summary>
+/// <remarks>
+/// There is no font rasterizer, so each visible character is drawn as a block of its
+/// foreground color over the cell's background, with underline, strikethrough and overline as
+/// lines. The result shows layout, colors and sixel graphics exactly, which is what visual
+/// audits compare; render to SVG when the text itself must be legible. Grid lines are not drawn.
+/// </remarks>
+public static class TerminalRegionBmpExtensions
+{
+    /// <summary>
+    /// Renders the terminal region to a BMP image.
+    /// </summary>
+    /// <param name="region">The terminal region to render.</param>
+    /// <param name="options">Optional rendering options; cell size and colors are used.</param>
+    /// <returns>The BMP file.</returns>
+    public static byte[] ToBmp(this IHex1bTerminalRegion region, TerminalSvgOptions? options = null)
+    {
+        options ??= TerminalRegionSvgExtensions.DefaultOptions;
+        using var stream = new MemoryStream();
+        RenderToBmp(region, options, cursorX: null, cursorY: null, stream, new TerminalRenderCache());
+        return stream.ToArray();
+    }
+
+    /// <summary>
+    /// Renders the terminal snapshot to a BMP image, including the cursor.
+    /// </summary>
+    /// <param name="snapshot">The terminal snapshot to render.</param>
+    /// <param name="options">Optional rendering options. If null, uses default options with snapshot's cell dimensions.</param>
+    /// <returns>The BMP file.</returns>
+    public static byte[] ToBmp(this Hex1bTerminalSnapshot snapshot, TerminalSvgOptions? options = null)
+    {
+        options ??= new TerminalSvgOptions
+        {
+            CellWidth = snapshot.CellPixelWidth,
+            CellHeight = snapshot.CellPixelHeight
+        };
+        using var stream = new MemoryStream();
+        RenderToBmp(snapshot, options, snapshot.CursorX, snapshot.CursorY, stream, new TerminalRenderCache());
+        return stream.ToArray();
+    }
+
+    /// <summary>
+    /// Writes the region as a BMP image to <paramref name="stream"/>, taking parsed colors and
+    /// decoded sixel images from <paramref name="cache"/>.
+    /// </summary>
+    internal static void RenderToBmp(
+        IHex1bTerminalRegion region,
+        TerminalSvgOptions options,
+        int? cursorX,
+        int? cursorY,
+        Stream stream,
+        TerminalRenderCache cache)
+    {
+        var cellWidth = options.CellWidth;
+        var cellHeight = options.CellHeight;
+        var width = region.Width * cellWidth;
+        var height = region.Height * cellHeight;
+
+        var defaultBackground = cache.GetCssColor(options.DefaultBackground, (0x1e, 0x1e, 0x1e));
+        var defaultForeground = cache.GetCssColor(options.DefaultForeground, (0xd4, 0xd4, 0xd4));
+        var cursorColor = cache.GetCssColor(options.CursorColor, (0xff, 0xff, 0xff));
+
+        var length = width * height * 4;
+        var buffer = ArrayPool<byte>.Shared.Rent(length);
+        try
+        {
+            var canvas = new Canvas(buffer.AsSpan(0, length), width, height);
+            canvas.Fill(0, 0, width, height, defaultBackground, 255);
+
+            // Older writes first so newer content covers what it overlaps, as in SVG
+            var cells = new List<(int X, int Y, TerminalCell Cell)>(region.Width * region.Height);
+            for (int y = 0; y < region.Height; y++)
+            {
+                for (int x = 0; x < region.Width; x++)
+                {
+                    cells.Add((x, y, region.GetCell(x, y)));
+                }
+            }
+            cells.Sort((a, b) => a.Cell.Sequence.CompareTo(b.Cell.Sequence));
+
+            foreach (var (x, y, cell) in cells)
+            {
+                var ch = cell.Character;
+
+                // Continuation cells are covered by the wide character before them
+                if (ch == "")
+                    continue;
+
+                var attrs = cell.Attributes;
+                var foreground = cell.Foreground is { } fg ? (fg.R, fg.G, fg.B) : defaultForeground;
+                var background = cell.Background is { } bg ? (bg.R, bg.G, bg.B) : defaultBackground;
+                if ((attrs & CellAttributes.Reverse) != 0)
+                {
+                    (foreground, background) = (background, foreground);
+                }
+
+                var ownedCells = 1;
+                if (!string.IsNullOrEmpty(ch) && ch != "\0")
+                {
+                    var charWidth = DisplayWidth.GetGraphemeWidth(ch);
+                    for (int i = 1; i < charWidth && (x + i) < region.Width; i++)
+                    {
+                        var contCell = region.GetCell(x + i, y);
+                        if (contCell.Character == "" && contCell.Sequence == cell.Sequence)
+                            ownedCells++;
+                        else
+                            break;
+                    }
+                }
+
+                var left = x * cellWidth;
+                var top = y * cellHeight;
+                var spanWidth = ownedCells * cellWidth;
+                canvas.Fill(left, top, spanWidth, cellHeight, background, 255);
+
+                if ((attrs & CellAttributes.Hidden) != 0)
+                    continue;
+
+                // Dim text is drawn at half strength, as SVG draws it at half opacity
+                var alpha = (attrs & CellAttributes.Dim) != 0 ? (byte)128 : (byte)255;
+
+                if (!string.IsNullOrEmpty(ch) && ch != "\0" && !string.IsNullOrWhiteSpace(ch))
+                {
+                    // Ink block between the x-height and the baseline, inset from the cell edges
+                    var inset = Math.Max(1, cellWidth / 8);
+                    var inkTop = top + cellHeight * 3 / 10;
+                    var inkBottom = top + cellHeight * 3 / 4;
+                    var inkWidth = (attrs & CellAttributes.Bold) != 0 ? spanWidth - inset : spanWidth - inset * 2;
+                    canvas.Fill(left + inset, inkTop, inkWidth, inkBottom - inkTop, foreground, alpha);
+                }
+
+                if ((attrs & CellAttributes.Underline) != 0)
+                    canvas.Fill(left, top + cellHeight * 17 / 20, spanWidth, 1, foreground, alpha);
+                if ((attrs & CellAttributes.Strikethrough) != 0)
+                    canvas.Fill(left, top + cellHeight * 11 / 20, spanWidth, 1, foreground, alpha);
+                if ((attrs & CellAttributes.Overline) != 0)
+                    canvas.Fill(left, top + cellHeight / 10, spanWidth, 1, foreground, alpha);
+            }
+
+            // Sixel graphics, scaled to the cells they cover
+            var renderedSixels = new HashSet<string>();
+            for (int y = 0; y < region.Height; y++)
+            {
+                for (int x = 0; x < region.Width; x++)
+                {
+                    var cell = region.GetCell(x, y);
+                    var sixelData = cell.SixelData;
+                    if (sixelData == null || !cell.IsSixel || !renderedSixels.Add(sixelData.Payload))
+                        continue;
+
+                    var image = cache.GetSixelImage(sixelData.Payload, cellWidth, cellHeight);
+                    if (image == null || image.Width == 0 || image.Height == 0)
+                        continue;
+
+                    canvas.DrawImage(image, x * cellWidth, y * cellHeight, sixelData.WidthInCells * cellWidth, sixelData.HeightInCells * cellHeight);
+                }
+            }
+
+            // Cursor, at the same opacity as in SVG
+            if (cursorX is { } cx && cursorY is { } cy && cx >= 0 && cx < region.Width && cy >= 0 && cy < region.Height)
+            {
+                canvas.Fill(cx * cellWidth, cy * cellHeight, cellWidth, cellHeight, cursorColor, 179);
+            }
+
+            BmpEncoder.WriteBmp(stream, width, height, canvas.Pixels);
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+    }
+
+    /// <summary>
+    /// An opaque RGBA pixel buffer with clipped, alpha-blended drawing.
+    /// </summary>
+    private readonly ref struct Canvas
+    {
+        public readonly Span<byte> Pixels;
+        private readonly int _width;
+        private readonly int _height;
+
+        public Canvas(Span<byte> pixels, int width, int height)
+        {
+            Pixels = pixels;
+            _width = width;
+            _height = height;
+        }
+
+        public void Fill(int left, int top, int fillWidth, int fillHeight, (byte R, byte G, byte B) color, byte alpha)
+        {
+            var x0 = Math.Max(0, left);
+            var y0 = Math.Max(0, top);
+            var x1 = Math.Min(_width, left + fillWidth);
+            var y1 = Math.Min(_height, top + fillHeight);
+
+            for (var y = y0; y < y1; y++)
+            {
+                var row = Pixels.Slice((y * _width + x0) * 4, (x1 - x0) * 4);
+                for (var i = 0; i < row.Length; i += 4)
+                {
+                    Blend(row.Slice(i, 4), color.R, color.G, color.B, alpha);
+                }
+            }
+        }
+
+        public void DrawImage(SixelImage image, int left, int top, int drawWidth, int drawHeight)
+        {
+            var x0 = Math.Max(0, left);
+            var y0 = Math.Max(0, top);
+            var x1 = Math.Min(_width, left + drawWidth);
+            var y1 = Math.Min(_height, top + drawHeight);
+
+            // Nearest neighbour, matching SVG's pixelated image rendering
+            for (var y = y0; y < y1; y++)
+            {
+                var srcY = (int)((long)(y - top) * image.Height / drawHeight);
+                for (var x = x0; x < x1; x++)
+                {
+                    var srcX = (int)((long)(x - left) * image.Width / drawWidth);
+                    var src = image.Pixels.AsSpan((srcY * image.Width + srcX) * 4, 4);
+                    Blend(Pixels.Slice((y * _width + x) * 4, 4), src[0], src[1], src[2], src[3]);
+                }
+            }
+        }
+
+        private static void Blend(Span<byte> pixel, byte r, byte g, byte b, byte alpha)
+        {
+            if (alpha == 255)
+            {
+                pixel[0] = r;
+                pixel[1] = g;
+                pixel[2] = b;
+            }
+            else if (alpha != 0)
+            {
+                pixel[0] = (byte)((r * alpha + pixel[0] * (255 - alpha)) / 255);
+                pixel[1] = (byte)((g * alpha + pixel[1] * (255 - alpha)) / 255);
+                pixel[2] = (byte)((b * alpha + pixel[2] * (255 - alpha)) / 255);
+            }
+            pixel[3] = 255;
+        }
+    }
+}
@@ -18,7 +18,9 @@ public static class TerminalRegionHtmlExtensions
     public static string ToHtml(this IHex1bTerminalRegion region, TerminalSvgOptions? options = null)
     {
         options ??= TerminalRegionSvgExtensions.DefaultOptions;
-        return RenderToHtml(region, options, cursorX: null, cursorY: null);
+        using var writer = new StringWriter();
+        RenderToHtml(region, options, writer, new TerminalRenderCache());
+        return writer.ToString();
     }
 
     /// <summary>
@@ -30,60 +32,16 @@ public static class TerminalRegionHtmlExtensions
     public static string ToHtml(this Hex1bTerminalSnapshot snapshot, TerminalSvgOptions? options = null)
     {
         options ??= TerminalRegionSvgExtensions.DefaultOptions;
-        return RenderToHtml(snapshot, options, snapshot.CursorX, snapshot.CursorY);
+        using var writer = new StringWriter();
+        RenderToHtml(snapshot, options, writer, new TerminalRenderCache());
+        return writer.ToString();
     }
 
-    private static string RenderToHtml(IHex1bTerminalRegion region, TerminalSvgOptions options, int? cursorX, int? cursorY)
+    /// <summary>
+    /// The page up to the title: document head and inspector styles.
+    /// </summary>
+    private static readonly string PageHead = BuildPage(static sb =>
     {
-        var cellWidth = options.CellWidth;
-        var cellHeight = options.CellHeight;
-        var svgWidth = region.Width * cellWidth;
-        var svgHeight = region.Height * cellHeight;
-
-        // Pre-scan cells to identify unique cell groups (e.g., hyperlinks with same ID/URI)
-        // This allows related cells to be highlighted together in the HTML viewer
-        var hyperlinkGroups = new Dictionary<object, string>();
-        var groupId = 0;
-        
-        for (int y = 0; y < region.Height; y++)
-        {
-            for (int x = 0; x < region.Width; x++)
-            {
-                var cell = region.GetCell(x, y);
-                if (cell.TrackedHyperlink is { } trackedLink && !hyperlinkGroups.ContainsKey(trackedLink))
-                {
-                    var groupKey = $"link-{groupId++}";
-                    hyperlinkGroups[trackedLink] = groupKey;
-                }
-            }
-        }
-
-        // Build cell data as JSON for JavaScript (includes group IDs for related cells)
-        var cellData = BuildCellDataJson(region, hyperlinkGroups);
-
-        // For HTML, create options with grids enabled (we'll hide them via CSS initially)
-        var htmlSvgOptions = new TerminalSvgOptions
-        {
-            FontFamily = options.FontFamily,
-            FontSize = options.FontSize,
-            CellWidth = options.CellWidth,
-            CellHeight = options.CellHeight,
-            DefaultBackground = options.DefaultBackground,
-            DefaultForeground = options.DefaultForeground,
-            CursorColor = options.CursorColor,
-            ShowCellGrid = true,  // Include in SVG so it can be toggled via CSS
-            ShowPixelGrid = true, // Include in SVG so it can be toggled via CSS
-            CellGridColor = options.CellGridColor,
-            PixelGridColor = options.PixelGridColor
-        };
-
-        // Get the SVG content with grids included (hidden via CSS initially)
-        var svgContent = region is Hex1bTerminalSnapshot snapshot
-            ? snapshot.ToSvg(htmlSvgOptions)
-            : region.ToSvg(htmlSvgOptions);
-
-        var sb = new StringBuilder();
-
         sb.AppendLine("<!DOCTYPE html>");
         sb.AppendLine("<html lang=\"en\">");
         sb.AppendLine("<head>");
@@ -383,7 +341,13 @@ public static class TerminalRegionHtmlExtensions
         sb.AppendLine("</head>");
         sb.AppendLine("<body>");
         sb.AppendLine("  <h1>Terminal Snapshot Inspector</h1>");
-        sb.AppendLine($"  <div class=\"info-bar\">Size: {region.Width} × {region.Height} cells | Hover over cells to inspect</div>");
+    });
+
+    /// <summary>
+    /// Theme and grid controls, up to the SVG.
+    /// </summary>
+    private static readonly string PageControls = BuildPage(static sb =>
+    {
         sb.AppendLine("  <div class=\"theme-controls\">");
         sb.AppendLine("    <div class=\"theme-presets\">");
         sb.AppendLine("      <button id=\"btn-dark\" class=\"theme-btn active\">Dark Mode</button>");
@@ -402,7 +366,13 @@ public static class TerminalRegionHtmlExtensions
         sb.AppendLine("  </div>");
         sb.AppendLine("  <div class=\"container\">");
         sb.AppendLine("    <div class=\"svg-container\" id=\"svg-container\">");
-        sb.AppendLine(svgContent);
+    });
+
+    /// <summary>
+    /// The cell highlight, tooltip and the start of the inspector script.
+    /// </summary>
+    private static readonly string PageScriptStart = BuildPage(static sb =>
+    {
         sb.AppendLine($"      <div class=\"cell-highlight\" id=\"cell-highlight\"></div>");
         sb.AppendLine("    </div>");
         sb.AppendLine("  </div>");
@@ -422,13 +392,13 @@ public static class TerminalRegionHtmlExtensions
         sb.AppendLine("      }");
         sb.AppendLine("    }");
         sb.AppendLine();
-        sb.AppendLine($"    const BASE_CELL_WIDTH = {cellWidth};");
-        sb.AppendLine($"    const BASE_CELL_HEIGHT = {cellHeight};");
-        sb.AppendLine($"    const SVG_WIDTH = {svgWidth};");
-        sb.AppendLine($"    const SVG_HEIGHT = {svgHeight};");
-        sb.AppendLine($"    const COLS = {region.Width};");
-        sb.AppendLine($"    const ROWS = {region.Height};");
-        sb.AppendLine($"    const cellData = {cellData};");
+    });
+
+    /// <summary>
+    /// The inspector script after the cell data, to the end of the page.
+    /// </summary>
+    private static readonly string PageScriptEnd = BuildPage(static sb =>
+    {
         sb.AppendLine();
         sb.AppendLine("    const container = document.getElementById('svg-container');");
         sb.AppendLine("    const highlight = document.getElementById('cell-highlight');");
@@ -822,32 +792,116 @@ public static class TerminalRegionHtmlExtensions
         sb.AppendLine("  </script>");
         sb.AppendLine("</body>");
         sb.AppendLine("</html>");
+    });
 
+    private static string BuildPage(Action<StringBuilder> build)
+    {
+        var sb = new StringBuilder();
+        build(sb);
         return sb.ToString();
     }
 
-    private static string BuildCellDataJson(IHex1bTerminalRegion region, Dictionary<object, string> hyperlinkGroups)
+    /// <summary>
+    /// Writes the region as an inspector page to <paramref name="writer"/>. The page around the
+    /// SVG is built once; the SVG and cell data are written straight to the writer.
+    /// </summary>
+    internal static void RenderToHtml(
+        IHex1bTerminalRegion region,
+        TerminalSvgOptions options,
+        TextWriter writer,
+        TerminalRenderCache cache)
     {
-        var rows = new List<string>();
+        var cellWidth = options.CellWidth;
+        var cellHeight = options.CellHeight;
+        var svgWidth = region.Width * cellWidth;
+        var svgHeight = region.Height * cellHeight;
 
+        // Pre-scan cells to identify unique cell groups (e.g., hyperlinks with same ID/URI)
+        // This allows related cells to be highlighted together in the HTML viewer
+        var hyperlinkGroups = new Dictionary<object, string>();
+        var groupId = 0;
+        
         for (int y = 0; y < region.Height; y++)
         {
-            var cells = new List<string>();
             for (int x = 0; x < region.Width; x++)
             {
+                var cell = region.GetCell(x, y);
+                if (cell.TrackedHyperlink is { } trackedLink && !hyperlinkGroups.ContainsKey(trackedLink))
+                {
+                    var groupKey = $"link-{groupId++}";
+                    hyperlinkGroups[trackedLink] = groupKey;
+                }
+            }
+        }
+
+        // For HTML, use options with grids enabled (we'll hide them via CSS initially)
+        var htmlSvgOptions = cache.GetDerivedOptions(options, CreateInspectorSvgOptions);
+
+        // The SVG shows the cursor of snapshots, however they were passed in
+        var (svgCursorX, svgCursorY) = region is Hex1bTerminalSnapshot snapshot
+            ? (snapshot.CursorX, snapshot.CursorY)
+            : ((int?)null, (int?)null);
+
+        writer.Write(PageHead);
+        writer.WriteLine($"  <div class=\"info-bar\">Size: {region.Width} × {region.Height} cells | Hover over cells to inspect</div>");
+        writer.Write(PageControls);
+        TerminalRegionSvgExtensions.RenderToSvg(region, htmlSvgOptions, svgCursorX, svgCursorY, writer, cache);
+        writer.WriteLine();
+        writer.Write(PageScriptStart);
+        writer.WriteLine($"    const BASE_CELL_WIDTH = {cellWidth};");
+        writer.WriteLine($"    const BASE_CELL_HEIGHT = {cellHeight};");
+        writer.WriteLine($"    const SVG_WIDTH = {svgWidth};");
+        writer.WriteLine($"    const SVG_HEIGHT = {svgHeight};");
+        writer.WriteLine($"    const COLS = {region.Width};");
+        writer.WriteLine($"    const ROWS = {region.Height};");
+        writer.Write("    const cellData = ");
+        WriteCellDataJson(writer, region, hyperlinkGroups, cache);
+        writer.WriteLine(";");
+        writer.Write(PageScriptEnd);
+    }
+
+    private static TerminalSvgOptions CreateInspectorSvgOptions(TerminalSvgOptions options) => new()
+    {
+        FontFamily = options.FontFamily,
+        FontSize = options.FontSize,
+        CellWidth = options.CellWidth,
+        CellHeight = options.CellHeight,
+        DefaultBackground = options.DefaultBackground,
+        DefaultForeground = options.DefaultForeground,
+        CursorColor = options.CursorColor,
+        ShowCellGrid = true,  // Include in SVG so it can be toggled via CSS
+        ShowPixelGrid = true, // Include in SVG so it can be toggled via CSS
+        CellGridColor = options.CellGridColor,
+        PixelGridColor = options.PixelGridColor
+    };
+
+    private static void WriteCellDataJson(
+        TextWriter writer,
+        IHex1bTerminalRegion region,
+        Dictionary<object, string> hyperlinkGroups,
+        TerminalRenderCache cache)
+    {
+        writer.Write("[\n      ");
+
+        for (int y = 0; y < region.Height; y++)
+        {
+            if (y > 0)
+                writer.Write(",\n      ");
+
+            writer.Write('[');
+            for (int x = 0; x < region.Width; x++)
+            {
+                if (x > 0)
+                    writer.Write(',');
+
                 var cell = region.GetCell(x, y);
                 var ch = cell.Character ?? "";
                 
                 // Escape special JSON characters in the grapheme string
                 var escapedChar = EscapeJsonString(ch);
 
-                var fg = cell.Foreground.HasValue
-                    ? $"{{\"r\":{cell.Foreground.Value.R},\"g\":{cell.Foreground.Value.G},\"b\":{cell.Foreground.Value.B}}}"
-                    : "null";
-
-                var bg = cell.Background.HasValue
-                    ? $"{{\"r\":{cell.Background.Value.R},\"g\":{cell.Background.Value.G},\"b\":{cell.Background.Value.B}}}"
-                    : "null";
+                var fg = cell.Foreground.HasValue ? cache.GetJson(cell.Foreground.Value) : "null";
+                var bg = cell.Background.HasValue ? cache.GetJson(cell.Background.Value) : "null";
 
                 var attrs = (int)cell.Attributes;
                 var seq = cell.Sequence;
@@ -872,12 +926,12 @@ public static class TerminalRegionHtmlExtensions
                     hyperlink = "null";
                 }
 
-                cells.Add($"{{\"c\":\"{escapedChar}\",\"fg\":{fg},\"bg\":{bg},\"a\":{attrs},\"seq\":{seq},\"t\":{writtenAt},\"sixel\":{sixel},\"link\":{hyperlink}}}");
+                writer.Write($"{{\"c\":\"{escapedChar}\",\"fg\":{fg},\"bg\":{bg},\"a\":{attrs},\"seq\":{seq},\"t\":{writtenAt},\"sixel\":{sixel},\"link\":{hyperlink}}}");
             }
-            rows.Add($"[{string.Join(",", cells)}]");
+            writer.Write(']');
         }
 
-        return $"[\n      {string.Join(",\n      ", rows)}\n    ]";
+        writer.Write("\n    ]");
     }
 
     /// <summary>
@@ -1,4 +1,3 @@
-using System.Text;
 using System.Web;
 using Hex1b.Terminal;
 
@@ -23,7 +22,9 @@ public static class TerminalRegionSvgExtensions
     public static string ToSvg(this IHex1bTerminalRegion region, TerminalSvgOptions? options = null)
     {
         options ??= DefaultOptions;
-        return RenderToSvg(region, options, cursorX: null, cursorY: null);
+        using var writer = new StringWriter();
+        RenderToSvg(region, options, cursorX: null, cursorY: null, writer, new TerminalRenderCache());
+        return writer.ToString();
     }
 
     /// <summary>
@@ -40,20 +41,30 @@ public static class TerminalRegionSvgExtensions
             CellWidth = snapshot.CellPixelWidth,
             CellHeight = snapshot.CellPixelHeight
         };
-        return RenderToSvg(snapshot, options, snapshot.CursorX, snapshot.CursorY);
+        using var writer = new StringWriter();
+        RenderToSvg(snapshot, options, snapshot.CursorX, snapshot.CursorY, writer, new TerminalRenderCache());
+        return writer.ToString();
     }
 
-    private static string RenderToSvg(IHex1bTerminalRegion region, TerminalSvgOptions options, int? cursorX, int? cursorY)
+    /// <summary>
+    /// Writes the region as SVG to <paramref name="writer"/>, taking repeated markup and decoded
+    /// images from <paramref name="cache"/> so frames rendered with the same cache share them.
+    /// </summary>
+    internal static void RenderToSvg(
+        IHex1bTerminalRegion region,
+        TerminalSvgOptions options,
+        int? cursorX,
+        int? cursorY,
+        TextWriter writer,
+        TerminalRenderCache cache)
     {
         var cellWidth = options.CellWidth;
         var cellHeight = options.CellHeight;
         var width = region.Width * cellWidth;
         var height = region.Height * cellHeight;
 
-        var sb = new StringBuilder();
-
         // SVG header
-        sb.AppendLine($"""<svg xmlns="http://www.w3.org/2000/svg" width="{width}" height="{height}" viewBox="0 0 {width} {height}">""");
+        writer.WriteLine($"""<svg xmlns="http://www.w3.org/2000/svg" width="{width}" height="{height}" viewBox="0 0 {width} {height}">""");
 
         // Pre-scan cells to identify unique cell groups (e.g., hyperlinks with same ID/URI)
         // This allows related cells to be highlighted together
@@ -67,9 +78,7 @@ public static class TerminalRegionSvgExtensions
                 var cell = region.GetCell(x, y);
                 if (cell.TrackedHyperlink is { } trackedLink && !hyperlinkGroups.ContainsKey(trackedLink))
                 {
-                    // Generate a stable class name based on the hyperlink content
-                    // Use both URI and parameters to create the group (cells with same id= should group together)
-                    var linkData = trackedLink.Data;
+                    // Cells with the same tracked hyperlink (same URI and id=) share a group
                     var groupKey = $"link-{groupId++}";
                     hyperlinkGroups[trackedLink] = groupKey;
                 }
@@ -77,19 +86,8 @@ public static class TerminalRegionSvgExtensions
         }
 
         // Style definitions including blink animation and cell group highlighting
-        sb.AppendLine("  <defs>");
-        sb.AppendLine("    <style>");
-        sb.AppendLine($"      .terminal-text {{ font-family: {options.FontFamily}; font-size: {options.FontSize}px; }}");
-        sb.AppendLine($"      .cursor {{ fill: {options.CursorColor}; opacity: 0.7; }}");
-        sb.AppendLine("      @keyframes blink { 0%, 49% { opacity: 1; } 50%, 100% { opacity: 0.3; } }");
-        sb.AppendLine("      .blink { animation: blink 1s infinite; }");
-        sb.AppendLine($"      .cell-grid {{ stroke: {options.CellGridColor}; stroke-width: 0.5; vector-effect: non-scaling-stroke; }}");
-        sb.AppendLine($"      .pixel-grid {{ stroke: {options.PixelGridColor}; stroke-width: 0.25; vector-effect: non-scaling-stroke; }}");
-        sb.AppendLine("      /* Cell group highlighting for related cells (hyperlinks, etc.) */");
-        sb.AppendLine("      .cell { pointer-events: bounding-box; }");
-        sb.AppendLine("      .cell.highlight > rect.cell-bg { stroke: #ff6b6b; stroke-width: 2; }");
-        sb.AppendLine("      .cell.highlight > text { fill: #ff6b6b !important; }");
-        sb.AppendLine("    </style>");
+        writer.WriteLine("  <defs>");
+        writer.Write(cache.GetStyleSheet(options));
 
         // Pre-generate clip paths for wide character truncation
         // Only create clips for wide characters that have FEWER owned cells than expected
@@ -138,16 +136,16 @@ public static class TerminalRegionSvgExtensions
                         var clipX = x * cellWidth;
                         var clipY = y * cellHeight;
                         var clipW = ownedCells * cellWidth;
-                        sb.AppendLine($"""    <clipPath id="{id}"><rect x="{clipX}" y="{clipY}" width="{clipW}" height="{cellHeight}"/></clipPath>""");
+                        writer.WriteLine($"""    <clipPath id="{id}"><rect x="{clipX}" y="{clipY}" width="{clipW}" height="{cellHeight}"/></clipPath>""");
                     }
                 }
             }
         }
         
-        sb.AppendLine("  </defs>");
+        writer.WriteLine("  </defs>");
 
         // Background rectangle
-        sb.AppendLine($"""  <rect width="{width}" height="{height}" fill="{options.DefaultBackground}"/>""");
+        writer.WriteLine($"""  <rect width="{width}" height="{height}" fill="{options.DefaultBackground}"/>""");
 
         // Collect all cells with their positions for sequence-ordered rendering
         var cells = new List<(int X, int Y, TerminalCell Cell)>();
@@ -163,7 +161,7 @@ public static class TerminalRegionSvgExtensions
         cells.Sort((a, b) => a.Cell.Sequence.CompareTo(b.Cell.Sequence));
 
         // Group for cells
-        sb.AppendLine("  <g class=\"terminal-text\">");
+        writer.WriteLine("  <g class=\"terminal-text\">");
 
         // Render all cells in sequence order (backgrounds first, then text)
         // This allows newer content to naturally overlap/obscure older wide characters
@@ -187,7 +185,7 @@ public static class TerminalRegionSvgExtensions
             }
             
             // Open cell group element with data attributes
-            sb.AppendLine($"""    <g class="cell{groupClass}" data-x="{x}" data-y="{y}">""");
+            writer.WriteLine($"""    <g class="cell{groupClass}" data-x="{x}" data-y="{y}">""");
             
             if (!isContinuationCell)
             {
@@ -200,13 +198,12 @@ public static class TerminalRegionSvgExtensions
                 {
                     // Reverse: use foreground as background (or default foreground)
                     bgColor = cell.Foreground.HasValue 
-                        ? $"rgb({cell.Foreground.Value.R},{cell.Foreground.Value.G},{cell.Foreground.Value.B})"
+                        ? cache.GetRgb(cell.Foreground.Value)
                         : options.DefaultForeground;
                 }
                 else if (cell.Background.HasValue)
                 {
-                    var bg = cell.Background.Value;
-                    bgColor = $"rgb({bg.R},{bg.G},{bg.B})";
+                    bgColor = cache.GetRgb(cell.Background.Value);
                 }
                 else
                 {
@@ -233,12 +230,12 @@ public static class TerminalRegionSvgExtensions
                     bgWidth = ownedCells * cellWidth;
                 }
                 
-                sb.AppendLine($"""      <rect class="cell-bg" x="{rectX}" y="{rectY}" width="{bgWidth}" height="{cellHeight}" fill="{bgColor}"/>""");
+                writer.WriteLine($"""      <rect class="cell-bg" x="{rectX}" y="{rectY}" width="{bgWidth}" height="{cellHeight}" fill="{bgColor}"/>""");
                 
                 // Blink indicator: subtle border/glow around blinking cells
                 if ((attrs & CellAttributes.Blink) != 0)
                 {
-                    sb.AppendLine($"""      <rect x="{rectX}" y="{rectY}" width="{bgWidth}" height="{cellHeight}" fill="none" stroke="#ffcc00" stroke-width="1" stroke-dasharray="2,2" class="blink"/>""");
+                    writer.WriteLine($"""      <rect x="{rectX}" y="{rectY}" width="{bgWidth}" height="{cellHeight}" fill="none" stroke="#ffcc00" stroke-width="1" stroke-dasharray="2,2" class="blink"/>""");
                 }
             }
 
@@ -269,52 +266,24 @@ public static class TerminalRegionSvgExtensions
                     {
                         // Reverse: use background as foreground (or default background)
                         fgColor = cell.Background.HasValue 
-                            ? $"rgb({cell.Background.Value.R},{cell.Background.Value.G},{cell.Background.Value.B})"
+                            ? cache.GetRgb(cell.Background.Value)
                             : options.DefaultBackground;
                     }
                     else if (cell.Foreground.HasValue)
                     {
-                        var fg = cell.Foreground.Value;
-                        fgColor = $"rgb({fg.R},{fg.G},{fg.B})";
+                        fgColor = cache.GetRgb(cell.Foreground.Value);
                     }
                     else
                     {
                         fgColor = options.DefaultForeground;
                     }
 
-                    // Build style attributes based on CellAttributes
-                    var styleBuilder = new StringBuilder();
-                    
-                    // Bold
-                    if ((attrs & CellAttributes.Bold) != 0)
-                        styleBuilder.Append("font-weight:bold;");
-                    
-                    // Dim (reduced opacity)
-                    if ((attrs & CellAttributes.Dim) != 0)
-                        styleBuilder.Append("opacity:0.5;");
-                    
-                    // Italic
-                    if ((attrs & CellAttributes.Italic) != 0)
-                        styleBuilder.Append("font-style:italic;");
-                    
-                    // Text decorations (can be combined)
-                    var decorations = new List<string>();
-                    if ((attrs & CellAttributes.Underline) != 0)
-                        decorations.Add("underline");
-                    if ((attrs & CellAttributes.Strikethrough) != 0)
-                        decorations.Add("line-through");
-                    if ((attrs & CellAttributes.Overline) != 0)
-                        decorations.Add("overline");
-                    
-                    if (decorations.Count > 0)
-                        styleBuilder.Append($"text-decoration:{string.Join(" ", decorations)};");
-
-                    var style = styleBuilder.Length > 0 ? $""" style="{styleBuilder}" """ : "";
-                    var blinkClass = (attrs & CellAttributes.Blink) != 0 ? " blink" : "";
+                    // Style and blink class for the attributes, built once per combination
+                    var textStyle = cache.GetTextStyle(attrs);
 
                     // Use non-breaking space for spaces with text decorations (underline, strikethrough, overline)
                     // Regular spaces don't receive text-decoration in SVG/HTML, but &nbsp; does
-                    var escapedChar = (displayCh == " " && decorations.Count > 0) 
+                    var escapedChar = (displayCh == " " && textStyle.HasDecorations) 
                         ? "&#160;" 
                         : HttpUtility.HtmlEncode(displayCh);
                     
@@ -346,16 +315,15 @@ public static class TerminalRegionSvgExtensions
                         }
                     }
                     
-                    var textClass = string.IsNullOrEmpty(blinkClass) ? "" : $""" class="{blinkClass.Trim()}" """;
-                    sb.AppendLine($"""      <text x="{textX:F1}" y="{textY:F1}" fill="{fgColor}" text-anchor="start"{style}{textClass}{clipAttr}>{escapedChar}</text>""");
+                    writer.WriteLine($"""      <text x="{textX:F1}" y="{textY:F1}" fill="{fgColor}" text-anchor="start"{textStyle.Attributes}{clipAttr}>{escapedChar}</text>""");
                 }
             }
             
             // Close cell group
-            sb.AppendLine("    </g>");
+            writer.WriteLine("    </g>");
         }
 
-        sb.AppendLine("  </g>");
+        writer.WriteLine("  </g>");
 
         // Render Sixel graphics
         // Track which sixel payloads we've already rendered to avoid duplicates
@@ -376,14 +344,11 @@ public static class TerminalRegionSvgExtensions
                 if (!renderedSixels.Add(sixelData.Payload))
                     continue;
                 
-                // Decode sixel to image
-                var image = SixelDecoder.Decode(sixelData.Payload, cellWidth, cellHeight);
-                if (image == null || image.Width == 0 || image.Height == 0)
+                // Decode sixel to a BMP data URI, once per payload
+                var dataUri = cache.GetSixelDataUri(sixelData.Payload, cellWidth, cellHeight);
+                if (dataUri == null)
                     continue;
                 
-                // Encode to BMP data URI
-                var dataUri = BmpEncoder.ToDataUri(image);
-                
                 // Calculate position and size
                 var imgX = x * cellWidth;
                 var imgY = y * cellHeight;
@@ -391,7 +356,7 @@ public static class TerminalRegionSvgExtensions
                 var imgHeight = sixelData.HeightInCells * cellHeight;
                 
                 // Add image element with pixelated rendering to prevent antialiasing
-                sb.AppendLine($"""  <image x="{imgX}" y="{imgY}" width="{imgWidth}" height="{imgHeight}" href="{dataUri}" preserveAspectRatio="none" style="image-rendering: pixelated;"/>""");
+                writer.WriteLine($"""  <image x="{imgX}" y="{imgY}" width="{imgWidth}" height="{imgHeight}" href="{dataUri}" preserveAspectRatio="none" style="image-rendering: pixelated;"/>""");
             }
         }
 
@@ -402,48 +367,46 @@ public static class TerminalRegionSvgExtensions
         {
             var cursorRectX = cursorX.Value * cellWidth;
             var cursorRectY = cursorY.Value * cellHeight;
-            sb.AppendLine($"""  <rect class="cursor" x="{cursorRectX}" y="{cursorRectY}" width="{cellWidth}" height="{cellHeight}"/>""");
+            writer.WriteLine($"""  <rect class="cursor" x="{cursorRectX}" y="{cursorRectY}" width="{cellWidth}" height="{cellHeight}"/>""");
         }
 
         // Render pixel grid lines (shows pixel boundaries within each cell)
         if (options.ShowPixelGrid)
         {
-            sb.AppendLine("  <g class=\"pixel-grid\">");
+            writer.WriteLine("  <g class=\"pixel-grid\">");
             // Vertical pixel lines - one per pixel column
             for (int px = 1; px < width; px++)
             {
-                sb.AppendLine($"""    <line x1="{px}" y1="0" x2="{px}" y2="{height}"/>""");
+                writer.WriteLine($"""    <line x1="{px}" y1="0" x2="{px}" y2="{height}"/>""");
             }
             // Horizontal pixel lines - one per pixel row
             for (int py = 1; py < height; py++)
             {
-                sb.AppendLine($"""    <line x1="0" y1="{py}" x2="{width}" y2="{py}"/>""");
+                writer.WriteLine($"""    <line x1="0" y1="{py}" x2="{width}" y2="{py}"/>""");
             }
-            sb.AppendLine("  </g>");
+            writer.WriteLine("  </g>");
         }
 
         // Render cell grid lines (coarser grid, one line per cell boundary)
         if (options.ShowCellGrid)
         {
-            sb.AppendLine("  <g class=\"cell-grid\">");
+            writer.WriteLine("  <g class=\"cell-grid\">");
             // Vertical cell lines
             for (int col = 1; col < region.Width; col++)
             {
                 var lineX = col * cellWidth;
-                sb.AppendLine($"""    <line x1="{lineX}" y1="0" x2="{lineX}" y2="{height}"/>""");
+                writer.WriteLine($"""    <line x1="{lineX}" y1="0" x2="{lineX}" y2="{height}"/>""");
             }
             // Horizontal cell lines
             for (int row = 1; row < region.Height; row++)
             {
                 var lineY = row * cellHeight;
-                sb.AppendLine($"""    <line x1="0" y1="{lineY}" x2="{width}" y2="{lineY}"/>""");
+                writer.WriteLine($"""    <line x1="0" y1="{lineY}" x2="{width}" y2="{lineY}"/>""");
             }
-            sb.AppendLine("  </g>");
+            writer.WriteLine("  </g>");
         }
 
-        sb.AppendLine("</svg>");
-
-        return sb.ToString();
+        writer.WriteLine("</svg>");
     }
 }
 
@@ -0,0 +1,157 @@
+using System.Collections.Concurrent;
+using System.Globalization;
+using System.Text;
+using Hex1b.Theming;
+
+namespace Hex1b.Terminal.Automation;
+
+/// <summary>
+/// Markup and pixel data that repeats between rendered frames: color strings, text styles,
+/// the SVG style sheet and decoded sixel images. Safe to share between threads, so a batch
+/// of frames rendered in parallel builds each of these once.
+/// </summary>
+internal sealed class TerminalRenderCache
+{
+    private readonly ConcurrentDictionary<(byte R, byte G, byte B), string> _rgb = new();
+    private readonly ConcurrentDictionary<(byte R, byte G, byte B), string> _json = new();
+    private readonly ConcurrentDictionary<CellAttributes, TextStyle> _textStyles = new();
+    private readonly ConcurrentDictionary<TerminalSvgOptions, string> _styleSheets = new(ReferenceEqualityComparer.Instance);
+    private readonly ConcurrentDictionary<TerminalSvgOptions, TerminalSvgOptions> _derivedOptions = new(ReferenceEqualityComparer.Instance);
+    private readonly ConcurrentDictionary<string, (byte R, byte G, byte B)> _cssColors = new();
+    private readonly ConcurrentDictionary<(string Payload, int CellWidth, int CellHeight), Lazy<SixelImage?>> _sixelImages = new();
+    private readonly ConcurrentDictionary<(string Payload, int CellWidth, int CellHeight), Lazy<string?>> _sixelDataUris = new();
+
+    /// <summary>
+    /// Gets the CSS <c>rgb(r,g,b)</c> form of a color.
+    /// </summary>
+    public string GetRgb(Hex1bColor color)
+        => _rgb.GetOrAdd((color.R, color.G, color.B), static c => $"rgb({c.R},{c.G},{c.B})");
+
+    /// <summary>
+    /// Gets the JSON object form of a color used by the HTML inspector's cell data.
+    /// </summary>
+    public string GetJson(Hex1bColor color)
+        => _json.GetOrAdd((color.R, color.G, color.B), static c => $"{{\"r\":{c.R},\"g\":{c.G},\"b\":{c.B}}}");
+
+    /// <summary>
+    /// Gets the SVG style attribute for text with <paramref name="attributes"/>.
+    /// </summary>
+    public TextStyle GetTextStyle(CellAttributes attributes)
+        => _textStyles.GetOrAdd(attributes, CreateTextStyle);
+
+    /// <summary>
+    /// Gets the SVG <c>&lt;style&gt;</c> element for <paramref name="options"/>.
+    /// </summary>
+    public string GetStyleSheet(TerminalSvgOptions options)
+        => _styleSheets.GetOrAdd(options, CreateStyleSheet);
+
+    /// <summary>
+    /// Gets options derived from <paramref name="options"/>, such as the HTML inspector's
+    /// SVG options, creating them once so their style sheet is cached too.
+    /// </summary>
+    public TerminalSvgOptions GetDerivedOptions(TerminalSvgOptions options, Func<TerminalSvgOptions, TerminalSvgOptions> create)
+        => _derivedOptions.GetOrAdd(options, create);
+
+    /// <summary>
+    /// Parses a CSS color in <c>#rgb</c> or <c>#rrggbb</c> form, falling back to
+    /// <paramref name="fallback"/> for anything else.
+    /// </summary>
+    public (byte R, byte G, byte B) GetCssColor(string css, (byte R, byte G, byte B) fallback)
+        => _cssColors.GetOrAdd(css, static (value, fallback) => ParseCssColor(value) ?? fallback, fallback);
+
+    /// <summary>
+    /// Decodes a sixel payload, once per payload and cell size.
+    /// </summary>
+    public SixelImage? GetSixelImage(string payload, int cellWidth, int cellHeight)
+        => _sixelImages.GetOrAdd(
+            (payload, cellWidth, cellHeight),
+            static key => new Lazy<SixelImage?>(() => SixelDecoder.Decode(key.Payload, key.CellWidth, key.CellHeight))).Value;
+
+    /// <summary>
+    /// Gets a sixel payload as a BMP data URI, or null if it does not decode to an image.
+    /// </summary>
+    public string? GetSixelDataUri(string payload, int cellWidth, int cellHeight)
+        => _sixelDataUris.GetOrAdd(
+            (payload, cellWidth, cellHeight),
+            key => new Lazy<string?>(() =>
+            {
+                var image = GetSixelImage(key.Payload, key.CellWidth, key.CellHeight);
+                return image == null || image.Width == 0 || image.Height == 0 ? null : BmpEncoder.ToDataUri(image);
+            })).Value;
+
+    private static TextStyle CreateTextStyle(CellAttributes attrs)
+    {
+        var styleBuilder = new StringBuilder();
+
+        // Bold
+        if ((attrs & CellAttributes.Bold) != 0)
+            styleBuilder.Append("font-weight:bold;");
+
+        // Dim (reduced opacity)
+        if ((attrs & CellAttributes.Dim) != 0)
+            styleBuilder.Append("opacity:0.5;");
+
+        // Italic
+        if ((attrs & CellAttributes.Italic) != 0)
+            styleBuilder.Append("font-style:italic;");
+
+        // Text decorations (can be combined)
+        var decorations = new List<string>();
+        if ((attrs & CellAttributes.Underline) != 0)
+            decorations.Add("underline");
+        if ((attrs & CellAttributes.Strikethrough) != 0)
+            decorations.Add("line-through");
+        if ((attrs & CellAttributes.Overline) != 0)
+            decorations.Add("overline");
+
+        if (decorations.Count > 0)
+            styleBuilder.Append($"text-decoration:{string.Join(" ", decorations)};");
+
+        var style = styleBuilder.Length > 0 ? $""" style="{styleBuilder}" """ : "";
+        var textClass = (attrs & CellAttributes.Blink) != 0 ? """ class="blink" """ : "";
+        return new TextStyle(style + textClass, decorations.Count > 0);
+    }
+
+    private static string CreateStyleSheet(TerminalSvgOptions options)
+    {
+        var sb = new StringBuilder();
+        sb.AppendLine("    <style>");
+        sb.AppendLine($"      .terminal-text {{ font-family: {options.FontFamily}; font-size: {options.FontSize}px; }}");
+        sb.AppendLine($"      .cursor {{ fill: {options.CursorColor}; opacity: 0.7; }}");
+        sb.AppendLine("      @keyframes blink { 0%, 49% { opacity: 1; } 50%, 100% { opacity: 0.3; } }");
+        sb.AppendLine("      .blink { animation: blink 1s infinite; }");
+        sb.AppendLine($"      .cell-grid {{ stroke: {options.CellGridColor}; stroke-width: 0.5; vector-effect: non-scaling-stroke; }}");
+        sb.AppendLine($"      .pixel-grid {{ stroke: {options.PixelGridColor}; stroke-width: 0.25; vector-effect: non-scaling-stroke; }}");
+        sb.AppendLine("      /* Cell group highlighting for related cells (hyperlinks, etc.) */");
+        sb.AppendLine("      .cell { pointer-events: bounding-box; }");
+        sb.AppendLine("      .cell.highlight > rect.cell-bg { stroke: #ff6b6b; stroke-width: 2; }");
+        sb.AppendLine("      .cell.highlight > text { fill: #ff6b6b !important; }");
+        sb.AppendLine("    </style>");
+        return sb.ToString();
+    }
+
+    private static (byte R, byte G, byte B)? ParseCssColor(string css)
+    {
+        var hex = css.AsSpan().Trim();
+        if (hex.Length == 0 || hex[0] != '#')
+            return null;
+        hex = hex[1..];
+
+        if (hex.Length == 3 && int.TryParse(hex, NumberStyles.HexNumber, CultureInfo.InvariantCulture, out var rgb))
+        {
+            return ((byte)(((rgb >> 8) & 0xF) * 0x11), (byte)(((rgb >> 4) & 0xF) * 0x11), (byte)((rgb & 0xF) * 0x11));
+        }
+        if (hex.Length == 6 && int.TryParse(hex, NumberStyles.HexNumber, CultureInfo.InvariantCulture, out var value))
+        {
+            return ((byte)(value >> 16), (byte)(value >> 8), (byte)value);
+        }
+        return null;
+    }
+
+    /// <summary>
+    /// The attributes of an SVG text element for a set of cell attributes.
+    /// </summary>
+    /// <param name="Attributes">The style and class attributes, with their surrounding spaces.</param>
+    /// <param name="HasDecorations">Whether the text is underlined, struck through or overlined.</param>
+    internal readonly record struct TextStyle(string Attributes, bool HasDecorations);
+}
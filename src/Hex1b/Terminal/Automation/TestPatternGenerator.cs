@@ -247,7 +247,7 @@ public static class TestPatternGenerator
         
         // DCS introducer with raster attributes
         sb.Append("\x1bPq");
-        sb.Append($"\"1;1;{height};{width}"); // Raster attributes: Pan;Pad;Ph;Pv
+        sb.Append($"\"1;1;{width};{height}"); // Raster attributes: Pan;Pad;Ph;Pv (Ph is the width)
 
         // Build color palette - quantize to 256 colors max
         var palette = BuildPalette(pixels, width, height, out var indexedPixels);
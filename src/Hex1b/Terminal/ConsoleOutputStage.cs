@@ -0,0 +1,291 @@
+using System.Buffers;
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using System.Threading.Channels;
+
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Collects the output of a frame into pooled segments and hands the whole batch to
+/// <see cref="IConsoleDriver.WriteVectored"/> when flushed.
+/// </summary>
+/// <remarks>
+/// Small payloads are copied into the tail of the current segment, so a frame made of
+/// many short writes becomes a handful of buffers and a single gathered write. With a
+/// writer thread the batch is queued and written off the caller's thread; the queue is
+/// bounded, so a slow terminal still pushes back on the producer. Appending and flushing
+/// must come from one thread at a time.
+/// </remarks>
+internal sealed class ConsoleOutputStage : IDisposable
+{
+    private const int SegmentSize = 16 * 1024;
+    private const int MaxQueuedBatches = 4;
+
+    /// <summary>
+    /// Pending bytes above which callers should flush without waiting for a frame boundary.
+    /// </summary>
+    public const int MaxPendingBytes = 256 * 1024;
+
+    private readonly IConsoleDriver _driver;
+    private readonly Channel<Batch>? _queue;
+    private readonly Thread? _writerThread;
+    private readonly ConcurrentQueue<Batch> _freeBatches = new();
+    private readonly object _idleLock = new();
+    private readonly ManualResetEventSlim _idle = new(initialState: true);
+    private int _inFlight;
+    private Batch _current = new();
+    private volatile Exception? _writerError; // Set by the writer thread, read by producers
+    private bool _disposed;
+
+    private long _batches;
+    private long _bytes;
+    private long _totalStallTicks;
+    private long _maxStallTicks;
+
+    public ConsoleOutputStage(IConsoleDriver driver, bool useWriterThread = false)
+    {
+        _driver = driver;
+
+        if (useWriterThread)
+        {
+            _queue = Channel.CreateBounded<Batch>(new BoundedChannelOptions(MaxQueuedBatches)
+            {
+                SingleReader = true,
+                SingleWriter = true,
+                FullMode = BoundedChannelFullMode.Wait
+            });
+
+            _writerThread = new Thread(WriterLoop)
+            {
+                IsBackground = true,
+                Name = "Hex1b console output"
+            };
+            _writerThread.Start();
+        }
+    }
+
+    /// <summary>
+    /// Bytes appended since the last flush.
+    /// </summary>
+    public int PendingBytes => _current.Length;
+
+    /// <summary>
+    /// Copies <paramref name="data"/> into the pending batch.
+    /// </summary>
+    public void Append(ReadOnlySpan<byte> data)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+
+        var batch = _current;
+        while (!data.IsEmpty)
+        {
+            var count = batch.Segments.Count;
+            var tail = count > 0 ? batch.Buffers[count - 1] : null;
+            var used = count > 0 ? batch.Segments[count - 1].Length : 0;
+
+            if (tail == null || used == tail.Length)
+            {
+                // Large payloads get one segment of their own rather than many small ones
+                tail = ArrayPool<byte>.Shared.Rent(Math.Max(SegmentSize, data.Length));
+                used = 0;
+                batch.Buffers.Add(tail);
+                batch.Segments.Add(ReadOnlyMemory<byte>.Empty);
+                count++;
+            }
+
+            var copy = Math.Min(tail.Length - used, data.Length);
+            data[..copy].CopyTo(tail.AsSpan(used));
+            batch.Segments[count - 1] = tail.AsMemory(0, used + copy);
+            batch.Length += copy;
+            data = data[copy..];
+        }
+    }
+
+    /// <summary>
+    /// Writes the pending batch, or queues it for the writer thread.
+    /// </summary>
+    public ValueTask FlushAsync(CancellationToken ct = default)
+    {
+        ThrowIfWriterFaulted();
+
+        if (_disposed || _current.Length == 0)
+            return ValueTask.CompletedTask;
+
+        var batch = _current;
+        _current = RentBatch();
+
+        if (_queue == null)
+        {
+            WriteBatch(batch);
+            return ValueTask.CompletedTask;
+        }
+
+        lock (_idleLock)
+        {
+            _inFlight++;
+            _idle.Reset();
+        }
+
+        if (_queue.Writer.TryWrite(batch))
+            return ValueTask.CompletedTask;
+
+        return EnqueueSlowAsync(batch, ct);
+    }
+
+    /// <summary>
+    /// Flushes the pending batch and blocks until everything queued has been written.
+    /// </summary>
+    public void Drain()
+    {
+        var flush = FlushAsync();
+        if (!flush.IsCompletedSuccessfully)
+        {
+            flush.AsTask().GetAwaiter().GetResult();
+        }
+
+        _idle.Wait();
+        ThrowIfWriterFaulted();
+    }
+
+    /// <summary>
+    /// Gets a snapshot of the counters collected so far.
+    /// </summary>
+    public ConsoleOutputStatistics GetStatistics() => new(
+        Interlocked.Read(ref _batches),
+        Interlocked.Read(ref _bytes),
+        TimeSpan.FromTicks(StopwatchToTimeSpanTicks(Interlocked.Read(ref _totalStallTicks))),
+        TimeSpan.FromTicks(StopwatchToTimeSpanTicks(Interlocked.Read(ref _maxStallTicks))));
+
+    public void Dispose()
+    {
+        if (_disposed) return;
+        _disposed = true;
+
+        if (_queue != null)
+        {
+            _queue.Writer.TryComplete();
+            _writerThread!.Join();
+        }
+
+        ReturnBuffers(_current);
+        while (_freeBatches.TryDequeue(out _)) { }
+        _idle.Dispose();
+    }
+
+    private async ValueTask EnqueueSlowAsync(Batch batch, CancellationToken ct)
+    {
+        try
+        {
+            await _queue!.Writer.WriteAsync(batch, ct);
+        }
+        catch
+        {
+            ReturnBuffers(batch);
+            MarkWritten();
+            throw;
+        }
+    }
+
+    private void WriterLoop()
+    {
+        var reader = _queue!.Reader;
+        while (reader.WaitToReadAsync().AsTask().GetAwaiter().GetResult())
+        {
+            while (reader.TryRead(out var batch))
+            {
+                try
+                {
+                    if (_writerError == null)
+                    {
+                        WriteBatch(batch);
+                    }
+                    else
+                    {
+                        // The terminal is gone; drop output instead of failing on every batch
+                        ReturnBuffers(batch);
+                    }
+                }
+                catch (Exception ex)
+                {
+                    // WriteBatch has already returned the batch, which the producer may be reusing
+                    _writerError = ex;
+                }
+                finally
+                {
+                    MarkWritten();
+                }
+            }
+        }
+    }
+
+    private void WriteBatch(Batch batch)
+    {
+        try
+        {
+            var start = Stopwatch.GetTimestamp();
+            _driver.WriteVectored(CollectionsMarshal.AsSpan(batch.Segments));
+            var stall = Stopwatch.GetTimestamp() - start;
+
+            Interlocked.Increment(ref _batches);
+            Interlocked.Add(ref _bytes, batch.Length);
+            Interlocked.Add(ref _totalStallTicks, stall);
+
+            var max = Interlocked.Read(ref _maxStallTicks);
+            while (stall > max)
+            {
+                var observed = Interlocked.CompareExchange(ref _maxStallTicks, stall, max);
+                if (observed == max) break;
+                max = observed;
+            }
+        }
+        finally
+        {
+            ReturnBuffers(batch);
+            _freeBatches.Enqueue(batch);
+        }
+    }
+
+    private void MarkWritten()
+    {
+        lock (_idleLock)
+        {
+            if (--_inFlight == 0)
+            {
+                _idle.Set();
+            }
+        }
+    }
+
+    private void ThrowIfWriterFaulted()
+    {
+        var error = _writerError;
+        if (error != null)
+        {
+            throw new IOException("Writing to the console failed.", error);
+        }
+    }
+
+    private Batch RentBatch() => _freeBatches.TryDequeue(out var batch) ? batch : new Batch();
+
+    private static void ReturnBuffers(Batch batch)
+    {
+        foreach (var buffer in batch.Buffers)
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+        batch.Buffers.Clear();
+        batch.Segments.Clear();
+        batch.Length = 0;
+    }
+
+    private static long StopwatchToTimeSpanTicks(long stopwatchTicks) =>
+        (long)(stopwatchTicks * ((double)TimeSpan.TicksPerSecond / Stopwatch.Frequency));
+
+    private sealed class Batch
+    {
+        public readonly List<byte[]> Buffers = [];
+        public readonly List<ReadOnlyMemory<byte>> Segments = [];
+        public int Length;
+    }
+}
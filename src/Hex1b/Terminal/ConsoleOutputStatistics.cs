@@ -0,0 +1,14 @@
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Counters for the output written by a <see cref="ConsolePresentationAdapter"/>.
+/// </summary>
+/// <param name="Batches">Number of batched writes issued to the console.</param>
+/// <param name="Bytes">Total bytes written.</param>
+/// <param name="TotalWriteStall">Total time spent blocked in console writes.</param>
+/// <param name="MaxWriteStall">Longest single console write.</param>
+public sealed record ConsoleOutputStatistics(
+    long Batches,
+    long Bytes,
+    TimeSpan TotalWriteStall,
+    TimeSpan MaxWriteStall);
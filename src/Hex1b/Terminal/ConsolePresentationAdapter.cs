@@ -9,10 +9,13 @@ namespace Hex1b.Terminal;
 /// <remarks>
 /// This adapter uses raw terminal mode (termios on Unix, SetConsoleMode on Windows)
 /// to properly capture mouse events, escape sequences, and control characters.
+/// Output is staged until <see cref="FlushAsync"/> and then written as one gathered
+/// write per frame, optionally from a dedicated writer thread.
 /// </remarks>
 public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapter
 {
     private readonly IConsoleDriver _driver;
+    private readonly ConsoleOutputStage _output;
     private readonly bool _enableMouse;
     private readonly CancellationTokenSource _disposeCts = new();
     private bool _disposed;
@@ -29,10 +32,14 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
     /// Creates a new console presentation adapter with raw mode support.
     /// </summary>
     /// <param name="enableMouse">Whether to enable mouse tracking.</param>
+    /// <param name="useOutputThread">
+    /// Whether flushed frames are written by a dedicated thread, so a slow terminal
+    /// doesn't block the caller until the output queue is full.
+    /// </param>
     /// <exception cref="PlatformNotSupportedException">
     /// Thrown if raw mode is not supported on the current platform.
     /// </exception>
-    public ConsolePresentationAdapter(bool enableMouse = false)
+    public ConsolePresentationAdapter(bool enableMouse = false, bool useOutputThread = false)
     {
         _enableMouse = enableMouse;
         
@@ -51,6 +58,8 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
                 $"Platform {Environment.OSVersion} is not supported.");
         }
         
+        _output = new ConsoleOutputStage(_driver, useOutputThread);
+        
         // Wire up resize events
         _driver.Resized += (w, h) => Resized?.Invoke(w, h);
     }
@@ -71,6 +80,11 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
         SupportsBracketedPaste = true  // Raw mode can handle this
     };
 
+    /// <summary>
+    /// Gets the number of batched writes, bytes written and time spent blocked on the console.
+    /// </summary>
+    public ConsoleOutputStatistics OutputStatistics => _output.GetStatistics();
+
     /// <inheritdoc />
     public event Action<int, int>? Resized;
 
@@ -82,7 +96,14 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
     {
         if (_disposed) return ValueTask.CompletedTask;
 
-        _driver.Write(data.Span);
+        _output.Append(data.Span);
+        
+        // Don't let a runaway frame grow the batch without bound
+        if (_output.PendingBytes >= ConsoleOutputStage.MaxPendingBytes)
+        {
+            return _output.FlushAsync(ct);
+        }
+        
         return ValueTask.CompletedTask;
     }
 
@@ -114,10 +135,12 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
     }
 
     /// <inheritdoc />
-    public ValueTask FlushAsync(CancellationToken ct = default)
+    public async ValueTask FlushAsync(CancellationToken ct = default)
     {
+        if (_disposed) return;
+
+        await _output.FlushAsync(ct);
         _driver.Flush();
-        return ValueTask.CompletedTask;
     }
 
     /// <inheritdoc />
@@ -140,8 +163,7 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
         escapes.Append(ClearScreen);
         escapes.Append(MoveCursorHome);
 
-        _driver.Write(Encoding.UTF8.GetBytes(escapes.ToString()));
-        _driver.Flush();
+        WriteNow(escapes.ToString());
 
         return ValueTask.CompletedTask;
     }
@@ -155,8 +177,7 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
         // First, disable mouse tracking to stop new events from being sent
         if (_enableMouse)
         {
-            _driver.Write(Encoding.UTF8.GetBytes(MouseParser.DisableMouseTracking));
-            _driver.Flush();
+            WriteNow(MouseParser.DisableMouseTracking);
             
             // Drain input multiple times with delays to catch any in-flight mouse events
             // Mouse events can still be arriving from the terminal after we send disable
@@ -172,8 +193,7 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
         escapes.Append(ShowCursor);
         escapes.Append(ExitAlternateBuffer);
 
-        _driver.Write(Encoding.UTF8.GetBytes(escapes.ToString()));
-        _driver.Flush();
+        WriteNow(escapes.ToString());
 
         // Exit raw mode last
         _driver.ExitRawMode();
@@ -196,6 +216,18 @@ public sealed class ConsolePresentationAdapter : IHex1bTerminalPresentationAdapt
 
         _disposeCts.Cancel();
         _disposeCts.Dispose();
+        _output.Dispose();
         _driver.Dispose();
     }
+
+    /// <summary>
+    /// Writes mode-switch sequences behind any staged or queued frame output and waits
+    /// until they reach the terminal.
+    /// </summary>
+    private void WriteNow(string sequence)
+    {
+        _output.Append(Encoding.UTF8.GetBytes(sequence));
+        _output.Drain();
+        _driver.Flush();
+    }
 }
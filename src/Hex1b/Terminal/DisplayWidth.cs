@@ -1,4 +1,5 @@
 using System.Globalization;
+using System.Runtime.CompilerServices;
 using System.Text;
 
 namespace Hex1b.Terminal;
@@ -12,28 +13,22 @@ namespace Hex1b.Terminal;
 /// the previous character.
 /// 
 /// This is based on the Unicode East Asian Width property and wcwidth behavior.
+/// The per code point data lives in a two-level lookup table generated at build
+/// time from the Unicode data files in eng/unicode (see <see cref="UnicodeVersion"/>).
 /// </summary>
-public static class DisplayWidth
+public static partial class DisplayWidth
 {
+    // Layout of the per code point entries in the generated Stage2 table.
+    private const byte WidthMask = 0b011;
+    private const byte EmojiPresentationFlag = 0b100;
+
     /// <summary>
     /// Gets the terminal display width of a single Unicode code point.
-    /// Returns 0 for combining characters, 2 for wide characters, 1 for others.
+    /// Returns 0 for control, format and combining characters, 2 for wide characters, 1 for others.
     /// </summary>
     public static int GetCodePointWidth(int codePoint)
     {
-        // Control characters and null
-        if (codePoint < 32 || codePoint == 0x7F)
-            return 0;
-
-        // Combining characters have zero width
-        if (IsCombiningCharacter(codePoint))
-            return 0;
-
-        // Wide characters (East Asian Wide/Fullwidth, most emoji, etc.)
-        if (IsWideCharacter(codePoint))
-            return 2;
-
-        return 1;
+        return GetProperties(codePoint) & WidthMask;
     }
 
     /// <summary>
@@ -50,27 +45,26 @@ public static class DisplayWidth
     /// </summary>
     public static int GetGraphemeWidth(string grapheme)
     {
-        if (string.IsNullOrEmpty(grapheme))
-            return 0;
+        return GetGraphemeWidth(grapheme.AsSpan());
+    }
 
+    /// <summary>
+    /// Gets the terminal display width of a grapheme cluster held in a span.
+    /// </summary>
+    public static int GetGraphemeWidth(ReadOnlySpan<char> grapheme)
+    {
         // Most grapheme clusters display as a single unit.
         // Emoji sequences (ZWJ, skin tones, flags) typically display as 2 cells.
         // Combining sequences display as the width of their base character.
-        
-        // Check for special combining characters that force width 2:
-        // - U+20E3 (combining enclosing keycap) - makes keycap sequences like 1️⃣
-        // - U+FE0F (variation selector-16) - forces emoji presentation (width 2)
-        foreach (var rune in grapheme.EnumerateRunes())
-        {
-            if (rune.Value == 0x20E3) // Combining enclosing keycap
-                return 2;
-            if (rune.Value == 0xFE0F) // Variation selector-16 (emoji presentation)
-                return 2;
-        }
-        
         int width = 0;
         foreach (var rune in grapheme.EnumerateRunes())
         {
+            // Special combining characters that force width 2:
+            // - U+20E3 (combining enclosing keycap) - makes keycap sequences like 1️⃣
+            // - U+FE0F (variation selector-16) - forces emoji presentation (width 2)
+            if (rune.Value == 0x20E3 || rune.Value == 0xFE0F)
+                return 2;
+
             var runeWidth = GetRuneWidth(rune);
             if (runeWidth > 0)
             {
@@ -96,17 +90,54 @@ public static class DisplayWidth
         if (string.IsNullOrEmpty(text))
             return 0;
 
+        return GetStringWidth(text.AsSpan());
+    }
+
+    /// <summary>
+    /// Gets the total terminal display width of a span of text, respecting grapheme clusters.
+    /// </summary>
+    public static int GetStringWidth(ReadOnlySpan<char> text)
+    {
         int totalWidth = 0;
-        var enumerator = StringInfo.GetTextElementEnumerator(text);
-        while (enumerator.MoveNext())
+        foreach (var cluster in EnumerateGraphemes(text))
         {
-            var grapheme = (string)enumerator.Current;
-            totalWidth += GetGraphemeWidth(grapheme);
+            totalWidth += cluster.Width;
         }
         
         return totalWidth;
     }
 
+    /// <summary>
+    /// Enumerates the grapheme clusters in a span of text along with their display widths.
+    /// Nothing is allocated; each cluster is reported as a position within <paramref name="text"/>.
+    /// </summary>
+    public static GraphemeEnumerator EnumerateGraphemes(ReadOnlySpan<char> text)
+    {
+        return new GraphemeEnumerator(text);
+    }
+
+    /// <summary>
+    /// Gets the grapheme cluster that starts at <paramref name="index"/>.
+    /// </summary>
+    /// <param name="text">The text to segment.</param>
+    /// <param name="index">The index of the first char of the cluster. Must be a cluster boundary.</param>
+    /// <returns>The cluster's position and display width, or an empty cluster at the end of the text.</returns>
+    public static GraphemeCluster GetGraphemeAt(ReadOnlySpan<char> text, int index)
+    {
+        if ((uint)index >= (uint)text.Length)
+            return new GraphemeCluster(index, 0, 0);
+
+        // Fast path: nothing below U+0300 extends a cluster, so a lone char in that
+        // range (other than CR, which pairs with LF) is a cluster on its own.
+        var c = text[index];
+        if (c < 0x300 && c != '\r' && (index + 1 == text.Length || text[index + 1] < 0x300))
+            return new GraphemeCluster(index, 1, GetCodePointWidth(c));
+
+        var remaining = text[index..];
+        var length = StringInfo.GetNextTextElementLength(remaining);
+        return new GraphemeCluster(index, length, GetGraphemeWidth(remaining[..length]));
+    }
+
     /// <summary>
     /// Slices a string by display width columns, returning the substring that fits.
     /// </summary>
@@ -123,17 +154,16 @@ public static class DisplayWidth
         if (string.IsNullOrEmpty(text) || maxColumns <= 0)
             return ("", 0, 0, 0);
 
-        var result = new System.Text.StringBuilder();
         int currentColumn = 0;
         int columnsUsed = 0;
         int paddingBefore = 0;
         int paddingAfter = 0;
+        int sliceStart = -1;
+        int sliceEnd = 0;
         
-        var enumerator = StringInfo.GetTextElementEnumerator(text);
-        while (enumerator.MoveNext())
+        foreach (var cluster in EnumerateGraphemes(text))
         {
-            var grapheme = (string)enumerator.Current;
-            var graphemeWidth = GetGraphemeWidth(grapheme);
+            var graphemeWidth = cluster.Width;
             
             // Skip graphemes before start column
             if (currentColumn + graphemeWidth <= startColumn)
@@ -163,12 +193,16 @@ public static class DisplayWidth
                 break;
             }
             
-            result.Append(grapheme);
+            // Included graphemes are always contiguous, so the result is a single substring
+            if (sliceStart < 0)
+                sliceStart = cluster.Start;
+            sliceEnd = cluster.End;
             columnsUsed += graphemeWidth;
             currentColumn += graphemeWidth;
         }
         
-        return (result.ToString(), columnsUsed, paddingBefore, paddingAfter);
+        var result = sliceStart < 0 ? "" : text.Substring(sliceStart, sliceEnd - sliceStart);
+        return (result, columnsUsed, paddingBefore, paddingAfter);
     }
 
     /// <summary>
@@ -199,73 +233,24 @@ public static class DisplayWidth
         int i = 0;
         while (i < text.Length)
         {
-            // Check for ANSI escape sequence (ESC [ ... final byte) - CSI sequences
-            if (text[i] == '\x1b' && i + 1 < text.Length && text[i + 1] == '[')
+            // Escape sequences are carried through without taking any columns
+            if (TryReadEscapeSequence(text, i, out var nextIndex))
             {
-                // Find the end of the CSI sequence
-                var seqStart = i;
-                i += 2; // Skip ESC [
-                while (i < text.Length)
-                {
-                    var c = text[i];
-                    if (c >= '@' && c <= '~')
-                    {
-                        i++; // Include final byte
-                        break;
-                    }
-                    i++;
-                }
-                var seq = text.Substring(seqStart, i - seqStart);
-                
-                // Add to prefix or result depending on whether we've started
-                if (!started)
-                    prefix.Append(seq);
-                else
-                    result.Append(seq);
-                continue;
-            }
-            
-            // Check for OSC escape sequence (ESC ] ... ST) - OSC sequences like OSC 8 hyperlinks
-            // ST (String Terminator) can be ESC \ or BEL (\x07)
-            if (text[i] == '\x1b' && i + 1 < text.Length && text[i + 1] == ']')
-            {
-                var seqStart = i;
-                i += 2; // Skip ESC ]
-                while (i < text.Length)
-                {
-                    // Check for ST = ESC \ (two characters)
-                    if (text[i] == '\x1b' && i + 1 < text.Length && text[i + 1] == '\\')
-                    {
-                        i += 2; // Include ESC \
-                        break;
-                    }
-                    // Check for ST = BEL (single character \x07)
-                    if (text[i] == '\x07')
-                    {
-                        i++; // Include BEL
-                        break;
-                    }
-                    i++;
-                }
-                var seq = text.Substring(seqStart, i - seqStart);
-                
                 // Add to prefix or result depending on whether we've started
-                if (!started)
-                    prefix.Append(seq);
-                else
-                    result.Append(seq);
+                (started ? result : prefix).Append(text, i, nextIndex - i);
+                i = nextIndex;
                 continue;
             }
 
             // Get the grapheme cluster at this position
-            var grapheme = GetGraphemeAtIndex(text, i, out var graphemeLength);
-            var graphemeWidth = GetGraphemeWidth(grapheme);
+            var cluster = GetGraphemeAt(text, i);
+            var graphemeWidth = cluster.Width;
 
             // Skip graphemes before start column
             if (currentColumn + graphemeWidth <= startColumn)
             {
                 currentColumn += graphemeWidth;
-                i += graphemeLength;
+                i = cluster.End;
                 continue;
             }
 
@@ -275,7 +260,7 @@ public static class DisplayWidth
                 // We're cutting into a wide character - need padding
                 paddingBefore = graphemeWidth - (startColumn - currentColumn);
                 currentColumn += graphemeWidth;
-                i += graphemeLength;
+                i = cluster.End;
                 continue;
             }
 
@@ -297,53 +282,19 @@ public static class DisplayWidth
                 started = true;
             }
 
-            result.Append(grapheme);
+            result.Append(text, cluster.Start, cluster.Length);
             columnsUsed += graphemeWidth;
             currentColumn += graphemeWidth;
-            i += graphemeLength;
+            i = cluster.End;
         }
 
         // Collect any trailing ANSI sequences (CSI and OSC)
         while (i < text.Length)
         {
-            // CSI sequences
-            if (text[i] == '\x1b' && i + 1 < text.Length && text[i + 1] == '[')
+            if (TryReadEscapeSequence(text, i, out var nextIndex))
             {
-                var seqStart = i;
-                i += 2;
-                while (i < text.Length)
-                {
-                    var c = text[i];
-                    if (c >= '@' && c <= '~')
-                    {
-                        i++;
-                        break;
-                    }
-                    i++;
-                }
-                result.Append(text.Substring(seqStart, i - seqStart));
-                continue;
-            }
-            // OSC sequences
-            if (text[i] == '\x1b' && i + 1 < text.Length && text[i + 1] == ']')
-            {
-                var seqStart = i;
-                i += 2;
-                while (i < text.Length)
-                {
-                    if (text[i] == '\x1b' && i + 1 < text.Length && text[i + 1] == '\\')
-                    {
-                        i += 2;
-                        break;
-                    }
-                    if (text[i] == '\x07')
-                    {
-                        i++;
-                        break;
-                    }
-                    i++;
-                }
-                result.Append(text.Substring(seqStart, i - seqStart));
+                result.Append(text, i, nextIndex - i);
+                i = nextIndex;
                 continue;
             }
             break;
@@ -353,242 +304,70 @@ public static class DisplayWidth
     }
 
     /// <summary>
-    /// Gets the grapheme cluster at the specified index in a string.
+    /// Reads a CSI sequence (ESC [ ... final byte) or an OSC sequence such as an OSC 8
+    /// hyperlink (ESC ] ... ST, where ST is ESC \ or BEL) starting at <paramref name="index"/>.
+    /// An unterminated sequence runs to the end of the text.
     /// </summary>
-    private static string GetGraphemeAtIndex(string text, int index, out int length)
+    private static bool TryReadEscapeSequence(string text, int index, out int nextIndex)
     {
-        if (index >= text.Length)
+        nextIndex = index;
+        if (text[index] != '\x1b' || index + 1 >= text.Length)
+            return false;
+
+        var i = index + 2;
+        if (text[index + 1] == '[')
         {
-            length = 0;
-            return "";
+            while (i < text.Length && !(text[i] >= '@' && text[i] <= '~'))
+                i++;
+            nextIndex = Math.Min(i + 1, text.Length); // Include final byte
+            return true;
         }
 
-        // Use StringInfo to find the grapheme at this position
-        var enumerator = StringInfo.GetTextElementEnumerator(text);
-        while (enumerator.MoveNext())
+        if (text[index + 1] == ']')
         {
-            if (enumerator.ElementIndex == index)
-            {
-                var grapheme = (string)enumerator.Current;
-                length = grapheme.Length;
-                return grapheme;
-            }
-            if (enumerator.ElementIndex > index)
+            while (i < text.Length)
             {
-                // Index is in the middle of a grapheme - shouldn't happen with proper navigation
-                break;
+                if (text[i] == '\x1b' && i + 1 < text.Length && text[i + 1] == '\\')
+                {
+                    nextIndex = i + 2; // Include ESC \
+                    return true;
+                }
+                if (text[i] == '\x07')
+                {
+                    nextIndex = i + 1; // Include BEL
+                    return true;
+                }
+                i++;
             }
+            nextIndex = text.Length;
+            return true;
         }
 
-        // Fallback: handle surrogate pairs
-        if (char.IsHighSurrogate(text[index]) && index + 1 < text.Length && char.IsLowSurrogate(text[index + 1]))
-        {
-            length = 2;
-            return text.Substring(index, 2);
-        }
-
-        length = 1;
-        return text[index].ToString();
-    }
-
-    /// <summary>
-    /// Checks if a code point is a combining character (zero-width).
-    /// </summary>
-    private static bool IsCombiningCharacter(int codePoint)
-    {
-        // Unicode combining character ranges
-        // Combining Diacritical Marks: U+0300-U+036F
-        if (codePoint >= 0x0300 && codePoint <= 0x036F)
-            return true;
-        // Combining Diacritical Marks Extended: U+1AB0-U+1AFF
-        if (codePoint >= 0x1AB0 && codePoint <= 0x1AFF)
-            return true;
-        // Combining Diacritical Marks Supplement: U+1DC0-U+1DFF
-        if (codePoint >= 0x1DC0 && codePoint <= 0x1DFF)
-            return true;
-        // Combining Diacritical Marks for Symbols: U+20D0-U+20FF
-        if (codePoint >= 0x20D0 && codePoint <= 0x20FF)
-            return true;
-        // Combining Half Marks: U+FE20-U+FE2F
-        if (codePoint >= 0xFE20 && codePoint <= 0xFE2F)
-            return true;
-        // Zero Width Joiner and Zero Width Non-Joiner
-        if (codePoint == 0x200D || codePoint == 0x200C)
-            return true;
-        // Variation selectors
-        if (codePoint >= 0xFE00 && codePoint <= 0xFE0F)
-            return true;
-        // Skin tone modifiers (Fitzpatrick modifiers)
-        if (codePoint >= 0x1F3FB && codePoint <= 0x1F3FF)
-            return true;
-            
         return false;
     }
 
     /// <summary>
-    /// Checks if a code point is a wide character (2 cells in terminal).
+    /// Looks up the packed width/emoji flags for a code point in the generated tables.
+    /// Latin-1 is always the first Stage2 block, so it is indexed directly.
     /// </summary>
-    private static bool IsWideCharacter(int codePoint)
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static byte GetProperties(int codePoint)
     {
-        // CJK Unified Ideographs and related
-        if (codePoint >= 0x4E00 && codePoint <= 0x9FFF)
-            return true;
-        if (codePoint >= 0x3400 && codePoint <= 0x4DBF) // CJK Extension A
-            return true;
-        if (codePoint >= 0x20000 && codePoint <= 0x2A6DF) // CJK Extension B
-            return true;
-        if (codePoint >= 0x2A700 && codePoint <= 0x2B73F) // CJK Extension C
-            return true;
-        if (codePoint >= 0x2B740 && codePoint <= 0x2B81F) // CJK Extension D
-            return true;
-        if (codePoint >= 0x2B820 && codePoint <= 0x2CEAF) // CJK Extension E
-            return true;
-        if (codePoint >= 0x2CEB0 && codePoint <= 0x2EBEF) // CJK Extension F
-            return true;
-        if (codePoint >= 0x30000 && codePoint <= 0x3134F) // CJK Extension G
-            return true;
-            
-        // CJK Compatibility Ideographs
-        if (codePoint >= 0xF900 && codePoint <= 0xFAFF)
-            return true;
-        if (codePoint >= 0x2F800 && codePoint <= 0x2FA1F)
-            return true;
-            
-        // Hangul Syllables
-        if (codePoint >= 0xAC00 && codePoint <= 0xD7AF)
-            return true;
-            
-        // Hangul Jamo Extended
-        if (codePoint >= 0xA960 && codePoint <= 0xA97F)
-            return true;
-        if (codePoint >= 0xD7B0 && codePoint <= 0xD7FF)
-            return true;
-            
-        // Katakana and Hiragana
-        if (codePoint >= 0x3040 && codePoint <= 0x30FF)
-            return true;
-        if (codePoint >= 0x31F0 && codePoint <= 0x31FF) // Katakana Phonetic Extensions
-            return true;
-            
-        // Fullwidth Forms
-        if (codePoint >= 0xFF00 && codePoint <= 0xFF60)
-            return true;
-        if (codePoint >= 0xFFE0 && codePoint <= 0xFFE6)
-            return true;
-            
-        // Most emoji are wide
-        if (IsEmojiPresentation(codePoint))
-            return true;
-            
-        return false;
+        if ((uint)codePoint < 0x100)
+            return Stage2[codePoint];
+
+        if ((uint)codePoint > 0x10FFFF)
+            return 0;
+
+        return Stage2[(Stage1[codePoint >> 8] << 8) | (codePoint & 0xFF)];
     }
 
     /// <summary>
-    /// Checks if a code point is an emoji that typically displays as 2 cells.
-    /// This uses a comprehensive approach covering all known emoji blocks.
+    /// Checks if a code point has the Unicode Emoji_Presentation property, i.e. it
+    /// displays as a 2-cell emoji without a variation selector.
     /// </summary>
     private static bool IsEmojiPresentation(int codePoint)
     {
-        // SMP Emoji Blocks (U+1F000 - U+1FFFF range)
-        // Using broader ranges to be more future-proof
-        
-        // Mahjong Tiles and Domino Tiles
-        if (codePoint >= 0x1F000 && codePoint <= 0x1F0FF)
-            return true;
-        // Playing Cards
-        if (codePoint >= 0x1F0A0 && codePoint <= 0x1F0FF)
-            return true;
-        // Enclosed Alphanumeric Supplement (some emoji like 🅰️🅱️)
-        if (codePoint >= 0x1F100 && codePoint <= 0x1F1FF)
-            return true;
-        // Enclosed Ideographic Supplement
-        if (codePoint >= 0x1F200 && codePoint <= 0x1F2FF)
-            return true;
-        // Miscellaneous Symbols and Pictographs
-        if (codePoint >= 0x1F300 && codePoint <= 0x1F5FF)
-            return true;
-        // Emoticons
-        if (codePoint >= 0x1F600 && codePoint <= 0x1F64F)
-            return true;
-        // Ornamental Dingbats
-        if (codePoint >= 0x1F650 && codePoint <= 0x1F67F)
-            return true;
-        // Transport and Map Symbols
-        if (codePoint >= 0x1F680 && codePoint <= 0x1F6FF)
-            return true;
-        // Alchemical Symbols - skip (U+1F700-1F77F, not emoji)
-        // Geometric Shapes Extended (colored circles, squares like 🟠🟡🟢🔵)
-        if (codePoint >= 0x1F780 && codePoint <= 0x1F7FF)
-            return true;
-        // Supplemental Arrows-C
-        if (codePoint >= 0x1F800 && codePoint <= 0x1F8FF)
-            return true;
-        // Supplemental Symbols and Pictographs
-        if (codePoint >= 0x1F900 && codePoint <= 0x1F9FF)
-            return true;
-        // Chess Symbols, Symbols and Pictographs Extended-A/B
-        if (codePoint >= 0x1FA00 && codePoint <= 0x1FAFF)
-            return true;
-        
-        // BMP Emoji Blocks
-        
-        // Miscellaneous Symbols (☀️⚡⚠️ etc)
-        if (codePoint >= 0x2600 && codePoint <= 0x26FF)
-            return true;
-        // Dingbats (✂️✈️✉️ etc)
-        if (codePoint >= 0x2700 && codePoint <= 0x27BF)
-            return true;
-        // Supplemental Arrows-B (some arrow emoji)
-        if (codePoint >= 0x2900 && codePoint <= 0x297F)
-            return true;
-        // Miscellaneous Symbols and Arrows
-        if (codePoint >= 0x2B00 && codePoint <= 0x2BFF)
-            return true;
-        // CJK Symbols (some emoji like ㊗️㊙️)
-        if (codePoint >= 0x3200 && codePoint <= 0x32FF)
-            return true;
-        // Enclosed CJK Letters and Months
-        if (codePoint >= 0x3300 && codePoint <= 0x33FF)
-            return true;
-            
-        // Specific standalone emoji characters
-        // Copyright, Registered, Trademark
-        if (codePoint == 0x00A9 || codePoint == 0x00AE || codePoint == 0x2122)
-            return true;
-        // Information source (ℹ️)
-        if (codePoint == 0x2139)
-            return true;
-        // Left/right arrows (↩️↪️)
-        if (codePoint == 0x21A9 || codePoint == 0x21AA)
-            return true;
-        // Watch and hourglass
-        if (codePoint == 0x231A || codePoint == 0x231B)
-            return true;
-        // Keyboard (⌨️)
-        if (codePoint == 0x2328)
-            return true;
-        // Eject symbol (⏏️)
-        if (codePoint >= 0x23CF && codePoint <= 0x23F3)
-            return true;
-        // Media control symbols (⏩⏪⏫⏬ etc)
-        if (codePoint >= 0x23E9 && codePoint <= 0x23F3)
-            return true;
-        // Alarm clock, stopwatch, timer
-        if (codePoint >= 0x23F0 && codePoint <= 0x23F3)
-            return true;
-        // Additional media controls
-        if (codePoint >= 0x23F8 && codePoint <= 0x23FA)
-            return true;
-        // Scales, alembic, etc
-        if (codePoint == 0x2696 || codePoint == 0x2697 || codePoint == 0x2699)
-            return true;
-        // Black and white circles/squares as emoji
-        if (codePoint == 0x25AA || codePoint == 0x25AB || codePoint == 0x25B6 || codePoint == 0x25C0)
-            return true;
-        // Larger geometric shapes  
-        if (codePoint >= 0x25FB && codePoint <= 0x25FE)
-            return true;
-            
-        return false;
+        return (GetProperties(codePoint) & EmojiPresentationFlag) != 0;
     }
 }
@@ -0,0 +1,16 @@
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// A grapheme cluster located within a span of text, as produced by
+/// <see cref="DisplayWidth.EnumerateGraphemes(ReadOnlySpan{char})"/>.
+/// </summary>
+/// <param name="Start">The index of the first char of the cluster.</param>
+/// <param name="Length">The number of chars (UTF-16 code units) in the cluster.</param>
+/// <param name="Width">The terminal display width of the cluster in cells.</param>
+public readonly record struct GraphemeCluster(int Start, int Length, int Width)
+{
+    /// <summary>
+    /// Gets the index just past the last char of the cluster.
+    /// </summary>
+    public int End => Start + Length;
+}
@@ -0,0 +1,46 @@
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Walks a span of text one grapheme cluster at a time without allocating.
+/// </summary>
+/// <remarks>
+/// Obtain an instance from <see cref="DisplayWidth.EnumerateGraphemes(ReadOnlySpan{char})"/>
+/// and consume it with <c>foreach</c>. Each <see cref="GraphemeCluster"/> reports the
+/// cluster's position within the span and its display width, so callers can slice the
+/// original text themselves only when they actually need the characters.
+/// </remarks>
+public ref struct GraphemeEnumerator
+{
+    private readonly ReadOnlySpan<char> _text;
+    private int _next;
+
+    internal GraphemeEnumerator(ReadOnlySpan<char> text)
+    {
+        _text = text;
+        _next = 0;
+        Current = default;
+    }
+
+    /// <summary>
+    /// Gets the cluster at the current position of the enumerator.
+    /// </summary>
+    public GraphemeCluster Current { get; private set; }
+
+    /// <summary>
+    /// Advances to the next grapheme cluster.
+    /// </summary>
+    public bool MoveNext()
+    {
+        if (_next >= _text.Length)
+            return false;
+
+        Current = DisplayWidth.GetGraphemeAt(_text, _next);
+        _next = Current.End;
+        return true;
+    }
+
+    /// <summary>
+    /// Returns this enumerator so it can be used directly in a <c>foreach</c> statement.
+    /// </summary>
+    public readonly GraphemeEnumerator GetEnumerator() => this;
+}
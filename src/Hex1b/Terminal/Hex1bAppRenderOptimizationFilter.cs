@@ -1,4 +1,3 @@
-using Hex1b.Theming;
 using Hex1b.Tokens;
 
 namespace Hex1b.Terminal;
@@ -21,6 +20,18 @@ namespace Hex1b.Terminal;
 /// intermediate states (like clear-then-render) that cause flicker.
 /// </para>
 /// <para>
+/// While the presentation is still writing earlier output, the terminal defers the filter:
+/// frames keep updating the pending buffer but nothing is emitted. When the write completes,
+/// the pending buffer is diffed against the committed buffer (what the presentation last
+/// received), so a slow client gets one diff for the latest frame rather than every frame.
+/// </para>
+/// <para>
+/// Sixel images are tracked by the cell they are drawn at. An image drawn again unchanged at
+/// the same cell is dropped, so an image split into tiles (see <c>SixelEncoder.EncodeTiledImage</c>)
+/// only sends the tiles that changed. Images are sent after the frame's cell changes, and one
+/// the terminal shows is forgotten - and its cells rewritten - once text is written over it.
+/// </para>
+/// <para>
 /// Benefits:
 /// <list type="bullet">
 ///   <item>Reduces bandwidth for remote terminal connections</item>
@@ -30,8 +41,17 @@ namespace Hex1b.Terminal;
 /// </list>
 /// </para>
 /// </remarks>
-public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentationFilter
+public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalFrameSkippingFilter
 {
+    // Control tokens kept while deferred; beyond this the oldest are dropped so a stalled
+    // client can't grow the list without bound. Kitty graphics commands, and the cursor moves
+    // that position kitty placements, are never dropped.
+    private const int MaxDeferredControlTokens = 256;
+
+    // Synchronized output (DEC mode 2026) brackets each frame. Skipped frames' brackets are
+    // dropped and the deferred diff gets a bracket of its own.
+    private const int SynchronizedOutputMode = 2026;
+
     // Lock to protect all mutable state from concurrent access
     // This filter is accessed concurrently by the output pump thread (OnOutputAsync)
     // and the input/resize thread (OnResizeAsync)
@@ -50,29 +70,24 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
     // Frame buffering state
     private bool _isBuffering;
     private List<AnsiToken>? _bufferedControlTokens;
+    
+    // Frame skipping state: set while the presentation is busy with earlier output
+    private bool _deferring;
+    private bool _hasDeferredChanges;
+    private bool _deferredSynchronizedOutput;
+    private List<AnsiToken>? _deferredControlTokens;
 
-    /// <summary>
-    /// Represents a cell in the shadow buffer, containing only the visual properties needed for comparison.
-    /// </summary>
-    private readonly record struct ShadowCell(
-        string Character,
-        Hex1bColor? Foreground,
-        Hex1bColor? Background,
-        CellAttributes Attributes)
-    {
-        public static readonly ShadowCell Empty = new(" ", null, null, CellAttributes.None);
+    // Kitty uploads and deletes from output discarded by a resize, sent before the full refresh
+    private List<AnsiToken>? _kittyUploadsBeforeRefresh;
 
-        /// <summary>
-        /// Creates a ShadowCell from a TerminalCell, extracting only the visual properties.
-        /// </summary>
-        public static ShadowCell FromTerminalCell(TerminalCell cell)
-            => new(cell.Character, cell.Foreground, cell.Background, cell.Attributes);
-    }
+    // Sixel images the presentation last received, by origin cell
+    private readonly Dictionary<(int X, int Y), SixelPlacement> _committedSixels = new();
 
-    /// <summary>
-    /// Represents a changed cell with its position and new state.
-    /// </summary>
-    private readonly record struct ChangedCell(int X, int Y, ShadowCell Cell);
+    // Sixel images drawn since the last commit, by origin cell
+    private readonly Dictionary<(int X, int Y), SixelPlacement> _pendingSixels = new();
+
+    // Cells written since the last commit, to find images whose region was redrawn without them
+    private bool[,]? _writtenCells;
 
     /// <inheritdoc />
     public ValueTask OnSessionStartAsync(int width, int height, DateTimeOffset timestamp, CancellationToken ct = default)
@@ -126,10 +141,25 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
                 // We have real content - consume the force refresh flag
                 _forceFullRefresh = false;
             
+                // Buffers released by ReleaseBuffers are rebuilt at the current size
+                if (_pendingBuffer is null && _width > 0)
+                {
+                    InitializeBuffers(_width, _height);
+                }
+            
                 // Update both buffers with all impacts, then pass through tokens
-                // (excluding internal frame boundary tokens)
+                // (excluding internal frame boundary tokens). Sixel images are tracked
+                // separately from the cells they cover.
+                _committedSixels.Clear();
+                _pendingSixels.Clear();
                 foreach (var appliedToken in appliedTokens)
                 {
+                    if (TryGetSixelPlacement(appliedToken, out var sixel))
+                    {
+                        RecordCommittedSixel(sixel);
+                        continue;
+                    }
+
                     foreach (var impact in appliedToken.CellImpacts)
                     {
                         if (impact.X >= 0 && impact.X < _width && impact.Y >= 0 && impact.Y < _height)
@@ -145,11 +175,15 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
                 // The terminal's buffer may have old content in newly expanded areas that our
                 // shadow buffers don't know about. 
                 // IMPORTANT: Reset SGR BEFORE clearing, so the clear uses default colors.
-                var result = new List<AnsiToken> 
-                { 
-                    new SgrToken("0"),                     // Reset attributes first!
-                    new ClearScreenToken(ClearMode.All),   // Clear entire terminal buffer (uses current bg)
-                };
+                var result = new List<AnsiToken>();
+                if (_kittyUploadsBeforeRefresh != null)
+                {
+                    // Images the refresh may place were uploaded in output a resize discarded
+                    result.AddRange(_kittyUploadsBeforeRefresh);
+                    _kittyUploadsBeforeRefresh = null;
+                }
+                result.Add(new SgrToken("0"));                   // Reset attributes first!
+                result.Add(new ClearScreenToken(ClearMode.All)); // Clear entire terminal buffer (uses current bg)
                 result.AddRange(appliedTokens
                     .Select(at => at.Token)
                     .Where(t => t is not FrameBeginToken and not FrameEndToken));
@@ -169,7 +203,11 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
                 {
                     case FrameBeginToken:
                         // If already buffering, flush previous frame first (handles unmatched begin)
-                        if (_isBuffering)
+                        if (_isBuffering && _deferring)
+                        {
+                            DeferFrame();
+                        }
+                        else if (_isBuffering)
                         {
                             var flushed = CommitFrame();
                             if (flushed.Count > 0)
@@ -183,7 +221,11 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
                         continue;
                     
                     case FrameEndToken:
-                        if (_isBuffering)
+                        if (_isBuffering && _deferring)
+                        {
+                            DeferFrame();
+                        }
+                        else if (_isBuffering)
                         {
                             _isBuffering = false;
                             var frameOutput = CommitFrame();
@@ -203,7 +245,13 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
                 // Handle tokens based on whether we're buffering
                 if (_isBuffering)
                 {
-                    ProcessTokenBuffered(appliedToken);
+                    ProcessTokenBuffered(appliedToken, _bufferedControlTokens);
+                }
+                else if (_deferring)
+                {
+                    // Output between frames is collapsed too while the presentation is busy
+                    ProcessTokenBuffered(appliedToken, null);
+                    _hasDeferredChanges = true;
                 }
                 else
                 {
@@ -230,15 +278,43 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
     /// <summary>
     /// Processes a token in buffered mode - updates pending buffer but doesn't emit.
     /// </summary>
-    private void ProcessTokenBuffered(AppliedToken appliedToken)
+    /// <param name="appliedToken">The token and its cell impacts.</param>
+    /// <param name="controlTokens">
+    /// Where control tokens are collected, or null to add them to the deferred control tokens.
+    /// </param>
+    private void ProcessTokenBuffered(AppliedToken appliedToken, List<AnsiToken>? controlTokens)
     {
         var token = appliedToken.Token;
+
+        // Sixel images are sent at commit, unless the presentation already shows them
+        if (TryGetSixelPlacement(appliedToken, out var sixel))
+        {
+            _pendingSixels[(sixel.X, sixel.Y)] = sixel;
+            return;
+        }
+
+        // A kitty placement draws at the cursor, so it keeps an explicit cursor move in front
+        // of it; the cursor moves around it may be collapsed away
+        if (token is KittyGraphicsToken { Action: 'p' })
+        {
+            AddControlToken(controlTokens, new CursorPositionToken(appliedToken.CursorYBefore + 1, appliedToken.CursorXBefore + 1));
+            AddControlToken(controlTokens, token);
+            return;
+        }
         
         switch (token)
         {
             case ClearScreenToken clearToken:
                 // Clear only the pending buffer (committed will be updated on frame end)
                 ClearBuffer(_pendingBuffer, clearToken.Mode);
+                // Images not drawn again after the clear are cleared too
+                for (int y = 0; y < _height; y++)
+                {
+                    for (int x = 0; x < _width; x++)
+                    {
+                        _writtenCells![y, x] = true;
+                    }
+                }
                 // Don't buffer ClearScreenToken - we'll handle via cell diffs
                 return;
                 
@@ -250,13 +326,14 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
             case ScrollRegionToken:
             case OscToken:
             case DcsToken:
+            case KittyGraphicsToken:
                 // Buffer control tokens to emit at frame end
-                _bufferedControlTokens?.Add(token);
+                AddControlToken(controlTokens, token);
                 return;
                 
             case CursorPositionToken when appliedToken.CellImpacts.Count == 0:
                 // Standalone cursor positioning - buffer it
-                _bufferedControlTokens?.Add(token);
+                AddControlToken(controlTokens, token);
                 return;
         }
         
@@ -268,6 +345,7 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
 
             var newCell = ShadowCell.FromTerminalCell(impact.Cell);
             _pendingBuffer![impact.Y, impact.X] = newCell;
+            _writtenCells![impact.Y, impact.X] = true;
         }
     }
     
@@ -278,6 +356,14 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
     {
         var token = appliedToken.Token;
         var changedCells = new List<ChangedCell>();
+
+        if (TryGetSixelPlacement(appliedToken, out var sixel))
+        {
+            _pendingSixels[(sixel.X, sixel.Y)] = sixel;
+            var sixelOutput = new List<AnsiToken>();
+            CommitSixels(sixelOutput);
+            return sixelOutput;
+        }
         
         switch (token)
         {
@@ -285,6 +371,7 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
                 // Clear both buffers and pass through
                 ClearBuffer(_pendingBuffer, clearToken.Mode);
                 ClearBuffer(_committedBuffer, clearToken.Mode);
+                _committedSixels.Clear();
                 return [token];
                 
             case ClearLineToken:
@@ -295,6 +382,7 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
             case ScrollRegionToken:
             case OscToken:
             case DcsToken:
+            case KittyGraphicsToken:
                 // Pass through control tokens
                 return [token];
                 
@@ -309,6 +397,12 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
             if (impact.X < 0 || impact.X >= _width || impact.Y < 0 || impact.Y >= _height)
                 continue;
 
+            // Text written over a sixel image replaces it, so the image's cells are all rewritten
+            if (_committedSixels.Count > 0)
+            {
+                InvalidateCommittedSixelsAt(impact.X, impact.Y);
+            }
+
             var newCell = ShadowCell.FromTerminalCell(impact.Cell);
             var currentCommitted = _committedBuffer![impact.Y, impact.X];
 
@@ -323,7 +417,7 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
         
         if (changedCells.Count > 0)
         {
-            return GenerateTokens(changedCells);
+            return ShadowCell.GenerateTokens(changedCells);
         }
         
         return [];
@@ -333,10 +427,21 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
     /// Commits the current frame by comparing pending vs committed buffers.
     /// Returns the tokens needed to update the terminal to the pending state.
     /// </summary>
-    private IReadOnlyList<AnsiToken> CommitFrame()
+    private IReadOnlyList<AnsiToken> CommitFrame() => CommitFrame(_bufferedControlTokens);
+
+    /// <summary>
+    /// Commits the pending buffer, emitting <paramref name="controlTokens"/> before the cell changes.
+    /// </summary>
+    private IReadOnlyList<AnsiToken> CommitFrame(List<AnsiToken>? controlTokens)
     {
         if (_pendingBuffer is null || _committedBuffer is null)
             return [];
+
+        if (_committedSixels.Count > 0)
+        {
+            DamageCommittedSixels();
+        }
+        Array.Clear(_writtenCells!);
             
         var changedCells = new List<ChangedCell>();
         
@@ -360,19 +465,385 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
         // Build output: buffered control tokens first, then cell changes
         var output = new List<AnsiToken>();
         
-        if (_bufferedControlTokens is { Count: > 0 })
+        if (controlTokens is { Count: > 0 })
         {
-            output.AddRange(_bufferedControlTokens);
+            output.AddRange(controlTokens);
         }
         
         if (changedCells.Count > 0)
         {
-            output.AddRange(GenerateTokens(changedCells));
+            output.AddRange(ShadowCell.GenerateTokens(changedCells));
         }
+
+        // Images go last: they were drawn over the cells they cover
+        CommitSixels(output);
         
         return output;
     }
 
+    /// <summary>
+    /// Finds the images the presentation shows that the pending frame writes over. An image
+    /// whose cells changed is forgotten, so it is sent again if it is redrawn. An image whose
+    /// cells were written without an image being drawn over them again - its region was
+    /// cleared - is forgotten and its cells are rewritten, so the terminal stops showing it.
+    /// </summary>
+    private void DamageCommittedSixels()
+    {
+        List<(SixelPlacement Sixel, bool Replaced)>? damaged = null;
+
+        foreach (var (origin, sixel) in _committedSixels)
+        {
+            var replaced = _pendingSixels.TryGetValue(origin, out var pending) && pending.Covers(sixel);
+            var changed = false;
+            var written = false;
+
+            for (var y = sixel.Y; y < sixel.Y + sixel.Height && y < _height; y++)
+            {
+                for (var x = sixel.X; x < sixel.X + sixel.Width && x < _width; x++)
+                {
+                    changed |= _pendingBuffer![y, x] != _committedBuffer![y, x];
+                    written |= _writtenCells![y, x];
+                }
+            }
+
+            if (changed || (written && !replaced))
+            {
+                damaged ??= [];
+                damaged.Add((sixel, replaced));
+            }
+        }
+
+        if (damaged == null)
+            return;
+
+        foreach (var (sixel, replaced) in damaged)
+        {
+            if (replaced)
+            {
+                // The image drawn at its origin is sent after the cell changes
+                _committedSixels.Remove((sixel.X, sixel.Y));
+            }
+            else
+            {
+                InvalidateCommittedSixel(sixel);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Adds the pending images the presentation doesn't already show to <paramref name="output"/>,
+    /// each positioned at its origin cell.
+    /// </summary>
+    private void CommitSixels(List<AnsiToken> output)
+    {
+        if (_pendingSixels.Count == 0)
+            return;
+
+        foreach (var sixel in _pendingSixels.Values)
+        {
+            if (_committedSixels.TryGetValue((sixel.X, sixel.Y), out var committed) && committed.HasSameImage(sixel))
+                continue;
+
+            // ANSI cursor position is 1-based
+            output.Add(new CursorPositionToken(sixel.Y + 1, sixel.X + 1));
+            output.Add(sixel.Token);
+            RecordCommittedSixel(sixel);
+        }
+
+        _pendingSixels.Clear();
+    }
+
+    /// <summary>
+    /// Records an image sent to the presentation, forgetting any it was drawn over.
+    /// </summary>
+    private void RecordCommittedSixel(SixelPlacement sixel)
+    {
+        if (_committedSixels.Count > 0)
+        {
+            List<(int X, int Y)>? covered = null;
+            foreach (var (origin, committed) in _committedSixels)
+            {
+                if (committed.Overlaps(sixel))
+                {
+                    covered ??= [];
+                    covered.Add(origin);
+                }
+            }
+
+            if (covered != null)
+            {
+                foreach (var origin in covered)
+                {
+                    _committedSixels.Remove(origin);
+                }
+            }
+        }
+
+        _committedSixels[(sixel.X, sixel.Y)] = sixel;
+    }
+
+    /// <summary>
+    /// Forgets the images the presentation shows at a cell, marking their cells for rewriting.
+    /// </summary>
+    private void InvalidateCommittedSixelsAt(int x, int y)
+    {
+        List<SixelPlacement>? hit = null;
+        foreach (var sixel in _committedSixels.Values)
+        {
+            if (sixel.Contains(x, y))
+            {
+                hit ??= [];
+                hit.Add(sixel);
+            }
+        }
+
+        if (hit != null)
+        {
+            foreach (var sixel in hit)
+            {
+                InvalidateCommittedSixel(sixel);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Forgets an image the presentation shows. Its cells' committed state becomes unknown, so
+    /// the next diff rewrites every one of them over the image.
+    /// </summary>
+    private void InvalidateCommittedSixel(SixelPlacement sixel)
+    {
+        _committedSixels.Remove((sixel.X, sixel.Y));
+
+        for (var y = sixel.Y; y < sixel.Y + sixel.Height && y < _height; y++)
+        {
+            for (var x = sixel.X; x < sixel.X + sixel.Width && x < _width; x++)
+            {
+                _committedBuffer![y, x] = default;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets where a token draws a sixel image: the cells the terminal marked as covered by it.
+    /// </summary>
+    private bool TryGetSixelPlacement(AppliedToken appliedToken, out SixelPlacement placement)
+    {
+        placement = default;
+        if (appliedToken.Token is not DcsToken dcs || appliedToken.CellImpacts.Count == 0)
+            return false;
+
+        int minX = int.MaxValue, minY = int.MaxValue, maxX = -1, maxY = -1;
+        foreach (var impact in appliedToken.CellImpacts)
+        {
+            if (!impact.Cell.IsSixel || impact.X < 0 || impact.X >= _width || impact.Y < 0 || impact.Y >= _height)
+                continue;
+
+            minX = Math.Min(minX, impact.X);
+            minY = Math.Min(minY, impact.Y);
+            maxX = Math.Max(maxX, impact.X);
+            maxY = Math.Max(maxY, impact.Y);
+        }
+
+        if (maxX < 0)
+            return false;
+
+        placement = new SixelPlacement(minX, minY, maxX - minX + 1, maxY - minY + 1, dcs);
+        return true;
+    }
+
+    /// <inheritdoc />
+    void IHex1bTerminalFrameSkippingFilter.BeginDeferral()
+    {
+        lock (_lock)
+        {
+            _deferring = true;
+            _deferredControlTokens ??= [];
+        }
+    }
+
+    /// <inheritdoc />
+    DeferredFrameStatus IHex1bTerminalFrameSkippingFilter.TakeDeferredFrame(out IReadOnlyList<AnsiToken> tokens)
+    {
+        lock (_lock)
+        {
+            tokens = [];
+
+            if (!_deferring)
+                return DeferredFrameStatus.Resumed;
+
+            // Don't send a half-rendered frame; the frame end will be along shortly
+            if (_isBuffering)
+                return DeferredFrameStatus.InProgress;
+
+            if (!_hasDeferredChanges)
+            {
+                _deferring = false;
+                _deferredControlTokens = null;
+                return DeferredFrameStatus.Resumed;
+            }
+
+            var frame = CommitFrame(_deferredControlTokens);
+            if (_deferredSynchronizedOutput && frame.Count > 0)
+            {
+                var synchronized = new List<AnsiToken>(frame.Count + 2) { new PrivateModeToken(SynchronizedOutputMode, true) };
+                synchronized.AddRange(frame);
+                synchronized.Add(new PrivateModeToken(SynchronizedOutputMode, false));
+                frame = synchronized;
+            }
+
+            tokens = frame;
+            _deferredControlTokens!.Clear();
+            _hasDeferredChanges = false;
+            _deferredSynchronizedOutput = false;
+            return DeferredFrameStatus.Ready;
+        }
+    }
+
+    /// <summary>
+    /// Ends a frame while deferred: its cells stay in the pending buffer and its control
+    /// tokens join the deferred ones.
+    /// </summary>
+    private void DeferFrame()
+    {
+        if (_bufferedControlTokens is { Count: > 0 })
+        {
+            foreach (var token in _bufferedControlTokens)
+            {
+                AddControlToken(null, token);
+            }
+        }
+
+        _isBuffering = false;
+        _bufferedControlTokens = null;
+        _hasDeferredChanges = true;
+    }
+
+    /// <summary>
+    /// Adds a control token to a frame's list, or to the deferred list when <paramref name="controlTokens"/>
+    /// is null. Deferred tokens are collapsed so only state the presentation still needs is kept.
+    /// </summary>
+    private void AddControlToken(List<AnsiToken>? controlTokens, AnsiToken token)
+    {
+        if (controlTokens != null)
+        {
+            controlTokens.Add(token);
+            return;
+        }
+
+        var deferred = _deferredControlTokens;
+        if (deferred == null)
+            return;
+
+        switch (token)
+        {
+            case PrivateModeToken { Mode: SynchronizedOutputMode }:
+                _deferredSynchronizedOutput = true;
+                return;
+            case PrivateModeToken mode:
+                deferred.RemoveAll(t => t is PrivateModeToken other && other.Mode == mode.Mode);
+                break;
+            case CursorPositionToken:
+                RemoveDeferredCursorMoves(deferred);
+                break;
+            case CursorShapeToken:
+                deferred.RemoveAll(t => t is CursorShapeToken);
+                break;
+            case KittyGraphicsToken { Action: 'p' } placement when placement.GetNumber('p') != 0:
+                // Only where a placement ends up matters
+                RemoveDeferredPlacements(deferred, placement.GetNumber('i'), placement.GetNumber('p'));
+                break;
+            case KittyGraphicsToken:
+                // Image uploads are never dropped: a missing chunk would corrupt the image
+                deferred.Add(token);
+                return;
+        }
+
+        if (deferred.Count >= MaxDeferredControlTokens)
+        {
+            for (var i = 0; i < deferred.Count; i++)
+            {
+                if (deferred[i] is not KittyGraphicsToken && !IsPlacementCursorMove(deferred, i, token))
+                {
+                    deferred.RemoveAt(i);
+                    break;
+                }
+            }
+        }
+        deferred.Add(token);
+    }
+
+    /// <summary>
+    /// Removes the deferred cursor moves, except those that position a kitty placement.
+    /// </summary>
+    private static void RemoveDeferredCursorMoves(List<AnsiToken> deferred)
+    {
+        var kept = 0;
+        for (var i = 0; i < deferred.Count; i++)
+        {
+            var token = deferred[i];
+            if (token is CursorPositionToken && !IsPlacementCursorMove(deferred, i, next: null))
+                continue;
+
+            deferred[kept++] = token;
+        }
+        deferred.RemoveRange(kept, deferred.Count - kept);
+    }
+
+    /// <summary>
+    /// Removes deferred kitty placements with the given IDs, along with their cursor moves.
+    /// </summary>
+    private static void RemoveDeferredPlacements(List<AnsiToken> deferred, uint imageId, uint placementId)
+    {
+        for (var i = deferred.Count - 1; i >= 0; i--)
+        {
+            if (deferred[i] is not KittyGraphicsToken { Action: 'p' } other
+                || other.GetNumber('i') != imageId
+                || other.GetNumber('p') != placementId)
+            {
+                continue;
+            }
+
+            deferred.RemoveAt(i);
+            if (i > 0 && deferred[i - 1] is CursorPositionToken)
+            {
+                deferred.RemoveAt(--i);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets whether the deferred token at <paramref name="index"/> is the cursor move in front
+    /// of a kitty placement. <paramref name="next"/> is the token about to be added after the list.
+    /// </summary>
+    private static bool IsPlacementCursorMove(List<AnsiToken> deferred, int index, AnsiToken? next)
+    {
+        if (deferred[index] is not CursorPositionToken)
+            return false;
+
+        var following = index + 1 < deferred.Count ? deferred[index + 1] : next;
+        return following is KittyGraphicsToken { Action: 'p' };
+    }
+
+    /// <summary>
+    /// Keeps the kitty graphics commands other than placements from a discarded control token
+    /// list, to be sent ahead of the next full refresh. Placements are drawn again by the
+    /// refresh, but an image is uploaded only once.
+    /// </summary>
+    private void KeepKittyUploads(List<AnsiToken>? controlTokens)
+    {
+        if (controlTokens == null)
+            return;
+
+        foreach (var token in controlTokens)
+        {
+            if (token is KittyGraphicsToken { Action: not 'p' })
+            {
+                _kittyUploadsBeforeRefresh ??= [];
+                _kittyUploadsBeforeRefresh.Add(token);
+            }
+        }
+    }
+
     /// <inheritdoc />
     public ValueTask OnInputAsync(ReadOnlyMemory<byte> data, TimeSpan elapsed, CancellationToken ct = default)
     {
@@ -394,8 +865,17 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
             // 1. The buffers have been reinitialized to the new size
             // 2. The pending content was for the old terminal dimensions
             // The next frame will be a full refresh due to _forceFullRefresh = true
+            KeepKittyUploads(_deferredControlTokens);
+            KeepKittyUploads(_bufferedControlTokens);
             _isBuffering = false;
             _bufferedControlTokens = null;
+            
+            // Deferred changes are superseded by the full refresh; stay deferred until
+            // the in-flight write completes.
+            _hasDeferredChanges = false;
+            _deferredSynchronizedOutput = false;
+            _deferredControlTokens?.Clear();
+            _pendingSixels.Clear();
         }
         
         return ValueTask.CompletedTask;
@@ -413,26 +893,48 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
             _forceFullRefresh = false;
             _isBuffering = false;
             _bufferedControlTokens = null;
+            _deferring = false;
+            _hasDeferredChanges = false;
+            _deferredSynchronizedOutput = false;
+            _deferredControlTokens = null;
+            _kittyUploadsBeforeRefresh = null;
+            _committedSixels.Clear();
+            _pendingSixels.Clear();
+            _writtenCells = null;
         }
         return ValueTask.CompletedTask;
     }
 
+    /// <summary>
+    /// Drops the shadow buffers while the session is idle. The next frame is sent in full and
+    /// rebuilds them.
+    /// </summary>
+    /// <returns>False if a frame is being collected or deferred and the buffers were kept.</returns>
+    internal bool ReleaseBuffers()
+    {
+        lock (_lock)
+        {
+            if (_isBuffering || _deferring)
+                return false;
+
+            _pendingBuffer = null;
+            _committedBuffer = null;
+            _writtenCells = null;
+            _committedSixels.Clear();
+            _pendingSixels.Clear();
+            _forceFullRefresh = _width > 0;
+            return true;
+        }
+    }
+
     private void InitializeBuffers(int width, int height)
     {
         _width = width;
         _height = height;
-        _pendingBuffer = new ShadowCell[height, width];
-        _committedBuffer = new ShadowCell[height, width];
-
-        // Initialize both buffers with empty cells
-        for (int y = 0; y < height; y++)
-        {
-            for (int x = 0; x < width; x++)
-            {
-                _pendingBuffer[y, x] = ShadowCell.Empty;
-                _committedBuffer[y, x] = ShadowCell.Empty;
-            }
-        }
+        _pendingBuffer = ShadowCell.CreateBuffer(width, height);
+        _committedBuffer = ShadowCell.CreateBuffer(width, height);
+        _writtenCells = new bool[height, width];
+        _committedSixels.Clear();
     }
 
     /// <summary>
@@ -454,144 +956,22 @@ public sealed class Hex1bAppRenderOptimizationFilter : IHex1bTerminalPresentatio
     }
 
     /// <summary>
-    /// Generates an optimized token stream for the changed cells.
+    /// A sixel image and the cells it covers.
     /// </summary>
-    /// <remarks>
-    /// Strategy:
-    /// 1. Sort cells by position (row-major order) for optimal cursor movement
-    /// 2. Group contiguous cells on the same row to minimize cursor repositioning
-    /// 3. Track current SGR state to avoid redundant attribute sequences
-    /// </remarks>
-    private IReadOnlyList<AnsiToken> GenerateTokens(List<ChangedCell> changedCells)
+    private readonly record struct SixelPlacement(int X, int Y, int Width, int Height, DcsToken Token)
     {
-        if (changedCells.Count == 0)
-            return Array.Empty<AnsiToken>();
-
-        var tokens = new List<AnsiToken>();
-
-        // Sort by Y, then X for optimal cursor movement
-        changedCells.Sort((a, b) =>
-        {
-            var yCompare = a.Y.CompareTo(b.Y);
-            return yCompare != 0 ? yCompare : a.X.CompareTo(b.X);
-        });
-
-        // Track current state to minimize redundant tokens
-        int cursorX = -1;
-        int cursorY = -1;
-        Hex1bColor? currentFg = null;
-        Hex1bColor? currentBg = null;
-        CellAttributes currentAttrs = CellAttributes.None;
-        bool stateUnknown = true; // Start with unknown state - need to emit reset first
-
-        foreach (var cell in changedCells)
-        {
-            // Position cursor if needed
-            if (cell.Y != cursorY || cell.X != cursorX)
-            {
-                // ANSI cursor position is 1-based
-                tokens.Add(new CursorPositionToken(cell.Y + 1, cell.X + 1));
-                cursorY = cell.Y;
-                cursorX = cell.X;
-            }
+        public bool Contains(int x, int y)
+            => x >= X && x < X + Width && y >= Y && y < Y + Height;
 
-            // Generate SGR if attributes changed or state is unknown
-            var needsSgr = stateUnknown ||
-                           !Equals(cell.Cell.Foreground, currentFg) ||
-                           !Equals(cell.Cell.Background, currentBg) ||
-                           cell.Cell.Attributes != currentAttrs;
+        public bool Covers(SixelPlacement other)
+            => X <= other.X && Y <= other.Y && X + Width >= other.X + other.Width && Y + Height >= other.Y + other.Height;
 
-            if (needsSgr)
-            {
-                var sgrParams = BuildSgrParameters(cell.Cell, stateUnknown, ref currentFg, ref currentBg, ref currentAttrs);
-                tokens.Add(new SgrToken(sgrParams));
-                stateUnknown = false;
-            }
-
-            // Output the character
-            tokens.Add(new TextToken(cell.Cell.Character));
-            cursorX++; // Cursor advances after text output
-        }
-
-        return tokens;
-    }
+        public bool Overlaps(SixelPlacement other)
+            => X < other.X + other.Width && other.X < X + Width && Y < other.Y + other.Height && other.Y < Y + Height;
 
-    /// <summary>
-    /// Builds SGR parameters for transitioning to the target cell's attributes.
-    /// </summary>
-    private static string BuildSgrParameters(
-        ShadowCell targetCell,
-        bool stateUnknown,
-        ref Hex1bColor? currentFg,
-        ref Hex1bColor? currentBg,
-        ref CellAttributes currentAttrs)
-    {
-        var parts = new List<string>();
-
-        // Check if we need a reset first
-        // Reset if: state is unknown, OR turning OFF any attributes, OR clearing colors
-        var turnedOff = currentAttrs & ~targetCell.Attributes;
-        bool needsReset = stateUnknown ||
-                         turnedOff != CellAttributes.None ||
-                         (currentFg is not null && targetCell.Foreground is null) ||
-                         (currentBg is not null && targetCell.Background is null);
-
-        if (needsReset)
-        {
-            parts.Add("0"); // Reset to defaults
-            currentAttrs = CellAttributes.None;
-            currentFg = null;
-            currentBg = null;
-        }
-
-        // Add attributes that need to be turned on
-        var toTurnOn = targetCell.Attributes & ~currentAttrs;
-
-        if ((toTurnOn & CellAttributes.Bold) != 0)
-            parts.Add("1");
-        if ((toTurnOn & CellAttributes.Dim) != 0)
-            parts.Add("2");
-        if ((toTurnOn & CellAttributes.Italic) != 0)
-            parts.Add("3");
-        if ((toTurnOn & CellAttributes.Underline) != 0)
-            parts.Add("4");
-        if ((toTurnOn & CellAttributes.Blink) != 0)
-            parts.Add("5");
-        if ((toTurnOn & CellAttributes.Reverse) != 0)
-            parts.Add("7");
-        if ((toTurnOn & CellAttributes.Hidden) != 0)
-            parts.Add("8");
-        if ((toTurnOn & CellAttributes.Strikethrough) != 0)
-            parts.Add("9");
-        if ((toTurnOn & CellAttributes.Overline) != 0)
-            parts.Add("53");
-
-        // Add foreground color if different
-        if (!Equals(targetCell.Foreground, currentFg) && targetCell.Foreground is not null)
-        {
-            parts.Add(BuildColorSgr(targetCell.Foreground.Value, isForeground: true));
-        }
-
-        // Add background color if different
-        if (!Equals(targetCell.Background, currentBg) && targetCell.Background is not null)
-        {
-            parts.Add(BuildColorSgr(targetCell.Background.Value, isForeground: false));
-        }
-        // Update tracked state
-        currentAttrs = targetCell.Attributes;
-        currentFg = targetCell.Foreground;
-        currentBg = targetCell.Background;
-
-        return string.Join(";", parts);
-    }
-
-    /// <summary>
-    /// Builds the SGR parameter string for a color.
-    /// </summary>
-    private static string BuildColorSgr(Hex1bColor color, bool isForeground)
-    {
-        // Use 24-bit color (SGR 38;2;r;g;b for foreground, 48;2;r;g;b for background)
-        var prefix = isForeground ? "38;2" : "48;2";
-        return $"{prefix};{color.R};{color.G};{color.B}";
+        public bool HasSameImage(SixelPlacement other)
+            => Width == other.Width
+                && Height == other.Height
+                && string.Equals(Token.Payload, other.Token.Payload, StringComparison.Ordinal);
     }
 }
@@ -61,6 +61,7 @@ public sealed class Hex1bAppWorkloadAdapter : IHex1bAppTerminalWorkloadAdapter,
             SupportsMouse = true,
             Supports256Colors = true,
             SupportsTrueColor = true,
+            SupportsBracketedPaste = true,
         };
 
         _outputChannel = Channel.CreateUnbounded<byte[]>(new UnboundedChannelOptions
@@ -139,6 +140,12 @@ public sealed class Hex1bAppWorkloadAdapter : IHex1bAppTerminalWorkloadAdapter,
     /// </summary>
     public int OutputQueueDepth => _outputQueueDepth;
 
+    /// <summary>
+    /// Scheduler that apps running on this adapter ask before rendering a frame.
+    /// Set by <see cref="Hex1bSessionHost"/> for the sessions it hosts.
+    /// </summary>
+    internal IHex1bAppFrameScheduler? FrameScheduler { get; set; }
+
     /// <summary>
     /// Enter TUI mode. Writes standard ANSI sequences for alternate screen, hide cursor, enable mouse.
     /// </summary>
@@ -156,6 +163,11 @@ public sealed class Hex1bAppWorkloadAdapter : IHex1bAppTerminalWorkloadAdapter,
             sb.Append("\x1b[?1003h");  // Enable mouse tracking
             sb.Append("\x1b[?1006h");  // SGR mouse mode
         }
+        if (Capabilities.SupportsBracketedPaste)
+        {
+            // Pastes arrive wrapped in ESC [ 200 ~ ... ESC [ 201 ~ and reach the app as one event
+            sb.Append("\x1b[?2004h");
+        }
         Write(sb.ToString());
     }
 
@@ -168,6 +180,10 @@ public sealed class Hex1bAppWorkloadAdapter : IHex1bAppTerminalWorkloadAdapter,
         _inTuiMode = false;
 
         var sb = new StringBuilder();
+        if (Capabilities.SupportsBracketedPaste)
+        {
+            sb.Append("\x1b[?2004l");  // Disable bracketed paste
+        }
         if (Capabilities.SupportsMouse)
         {
             sb.Append("\x1b[?1006l");  // Disable SGR mouse mode
@@ -276,6 +292,22 @@ public sealed class Hex1bAppWorkloadAdapter : IHex1bAppTerminalWorkloadAdapter,
         return _inputChannel.Writer.WriteAsync(evt, ct);
     }
 
+    /// <summary>
+    /// Writes a batch of parsed input events in order (used by Hex1bTerminal after decoding
+    /// a chunk of input).
+    /// </summary>
+    internal void WriteInputEvents(List<Hex1bEvent> events)
+    {
+        if (_disposed) return;
+
+        // The channel is unbounded, so writes only fail once it has been completed
+        foreach (var evt in events)
+        {
+            if (!_inputChannel.Writer.TryWrite(evt))
+                return;
+        }
+    }
+
     /// <summary>
     /// Write a parsed input event directly (synchronous).
     /// </summary>
@@ -338,6 +370,14 @@ public sealed class Hex1bAppWorkloadAdapter : IHex1bAppTerminalWorkloadAdapter,
         _inputChannel.Writer.TryWrite(evt);
     }
 
+    /// <summary>
+    /// Injects a bracketed paste as a single event (for testing).
+    /// </summary>
+    public void SendPaste(string text)
+    {
+        _inputChannel.Writer.TryWrite(new Hex1bPasteEvent(text));
+    }
+
     /// <summary>
     /// Types a string of characters (for testing).
     /// </summary>
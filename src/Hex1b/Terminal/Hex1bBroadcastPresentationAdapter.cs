@@ -0,0 +1,597 @@
+using System.Text;
+using Hex1b.Tokens;
+
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// A presentation that shows one terminal to any number of read-only viewers.
+/// </summary>
+/// <example>
+/// <para>Render a dashboard once and stream it to every WebSocket that connects:</para>
+/// <code>
+/// var options = new Hex1bTerminalOptions { WorkloadAdapter = workload };
+/// var broadcast = options.AddBroadcast(120, 40);
+/// var terminal = new Hex1bTerminal(options);
+///
+/// // Per connection; returns when the viewer disconnects
+/// await using var viewer = new WebSocketPresentationAdapter(webSocket, 120, 40);
+/// await broadcast.RunViewerAsync(viewer, ct);
+/// </code>
+/// </example>
+/// <remarks>
+/// <para>
+/// The adapter is both the terminal's presentation and its first presentation filter, so it
+/// sees every frame's cell changes. Each frame is diffed and encoded once, and the same bytes
+/// are written to every viewer that is up to date, so rendering and encoding cost does not
+/// grow with the number of viewers.
+/// </para>
+/// <para>
+/// Every viewer keeps its own committed shadow buffer of what it was last sent. A viewer that
+/// joins late gets a full paint, and a viewer still writing an earlier frame skips the frames
+/// published meanwhile and then gets one diff from its buffer to the latest frame. A slow
+/// viewer never holds up the terminal or the other viewers.
+/// </para>
+/// <para>
+/// Viewers are read-only: their input is read only to notice when they disconnect, and their
+/// size is ignored. The broadcast size is set with <see cref="Resize"/>. Sixel graphics and
+/// other control sequences reach viewers that are up to date when they are drawn, but are not
+/// replayed for viewers that join or catch up later.
+/// </para>
+/// </remarks>
+public sealed class Hex1bBroadcastPresentationAdapter : IHex1bTerminalPresentationAdapter, IHex1bTerminalPresentationFilter
+{
+    // Synchronized output (DEC mode 2026) brackets every frame sent to a viewer
+    private const int SynchronizedOutputMode = 2026;
+
+    // Guards everything below; frames come from the terminal's output pump, viewers from their own tasks
+    private readonly object _lock = new();
+    private readonly List<Viewer> _viewers = [];
+    private readonly TaskCompletionSource _disposed = new(TaskCreationOptions.RunContinuationsAsynchronously);
+    private readonly CancellationTokenSource _disposeCts = new();
+
+    // Current holds the terminal as of the latest token; published is the last complete frame
+    private ShadowCell[,]? _current;
+    private ShadowCell[,]? _published;
+    private readonly List<(int X, int Y)> _dirtyCells = [];
+    private readonly List<AnsiToken> _frameControlTokens = [];
+    private bool _inFrame;
+    private long _version;
+
+    // Modes and cursor of the published frame, replayed to viewers that join or catch up
+    private readonly Dictionary<int, PrivateModeToken> _modes = [];
+    private CursorShapeToken? _cursorShape;
+    private CursorPositionToken? _cursorPosition;
+
+    private int _width;
+    private int _height;
+    private long _framesEncoded;
+    private bool _isDisposed;
+
+    /// <summary>
+    /// Creates a broadcast presentation of the given size.
+    /// </summary>
+    /// <param name="width">Broadcast width in columns.</param>
+    /// <param name="height">Broadcast height in rows.</param>
+    /// <param name="capabilities">Capabilities reported to the terminal. Defaults to <see cref="TerminalCapabilities.Modern"/>.</param>
+    public Hex1bBroadcastPresentationAdapter(int width = 80, int height = 24, TerminalCapabilities? capabilities = null)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(width);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(height);
+        _width = width;
+        _height = height;
+        Capabilities = capabilities ?? TerminalCapabilities.Modern;
+    }
+
+    /// <inheritdoc />
+    public int Width => _width;
+
+    /// <inheritdoc />
+    public int Height => _height;
+
+    /// <inheritdoc />
+    public TerminalCapabilities Capabilities { get; }
+
+    /// <summary>
+    /// Number of viewers currently attached.
+    /// </summary>
+    public int ViewerCount
+    {
+        get { lock (_lock) return _viewers.Count; }
+    }
+
+    /// <summary>
+    /// Number of frames diffed and encoded for up-to-date viewers. Independent of the number of viewers.
+    /// </summary>
+    internal long FramesEncoded => Interlocked.Read(ref _framesEncoded);
+
+    /// <inheritdoc />
+    public event Action<int, int>? Resized;
+
+#pragma warning disable CS0067 // Event is never used - the broadcast ends by disposal
+    /// <inheritdoc />
+    public event Action? Disconnected;
+#pragma warning restore CS0067
+
+    /// <summary>
+    /// Changes the broadcast size. Every viewer gets a full paint of the next frame.
+    /// </summary>
+    /// <remarks>
+    /// Frames keep the old size until the terminal has resized in response to
+    /// <see cref="Resized"/>; viewers that join or catch up meanwhile are sent the old size.
+    /// </remarks>
+    /// <param name="width">New width in columns.</param>
+    /// <param name="height">New height in rows.</param>
+    public void Resize(int width, int height)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(width);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(height);
+        lock (_lock)
+        {
+            if (width == _width && height == _height) return;
+
+            _width = width;
+            _height = height;
+        }
+        Resized?.Invoke(width, height);
+    }
+
+    /// <summary>
+    /// Shows the broadcast on <paramref name="viewer"/> until it disconnects or
+    /// <paramref name="cancellationToken"/> is cancelled.
+    /// </summary>
+    /// <param name="viewer">The viewer's presentation adapter. The caller keeps ownership and disposes it.</param>
+    /// <param name="cancellationToken">Detaches the viewer.</param>
+    public async Task RunViewerAsync(IHex1bTerminalPresentationAdapter viewer, CancellationToken cancellationToken = default)
+    {
+        ArgumentNullException.ThrowIfNull(viewer);
+
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken, _disposeCts.Token);
+        var ct = cts.Token;
+        void OnDisconnected() => cts.Cancel();
+        viewer.Disconnected += OnDisconnected;
+
+        var entry = new Viewer(viewer, cts);
+        try
+        {
+            await viewer.EnterTuiModeAsync(ct);
+
+            lock (_lock)
+            {
+                ObjectDisposedException.ThrowIf(_isDisposed, this);
+                _viewers.Add(entry);
+                StartSend(entry, null);
+            }
+
+            // Input is discarded; reading it is how a disconnect is noticed
+            while (!ct.IsCancellationRequested)
+            {
+                var data = await viewer.ReadInputAsync(ct);
+                if (data.IsEmpty)
+                    break;
+            }
+        }
+        catch (OperationCanceledException) when (ct.IsCancellationRequested)
+        {
+            // Detached or disconnected
+        }
+        finally
+        {
+            viewer.Disconnected -= OnDisconnected;
+
+            Task? sending;
+            lock (_lock)
+            {
+                _viewers.Remove(entry);
+                entry.Detached = true;
+                sending = entry.SendTask;
+            }
+
+            if (sending != null)
+            {
+                await sending;
+            }
+        }
+
+        if (!entry.Faulted)
+        {
+            try
+            {
+                await viewer.ExitTuiModeAsync(CancellationToken.None);
+            }
+            catch
+            {
+                // The viewer is already gone
+            }
+        }
+    }
+
+    // === Presentation filter: collects frames ===
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalPresentationFilter.OnSessionStartAsync(int width, int height, DateTimeOffset timestamp, CancellationToken ct)
+    {
+        lock (_lock)
+        {
+            ResetBuffers(width, height);
+        }
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    ValueTask<IReadOnlyList<AnsiToken>> IHex1bTerminalPresentationFilter.OnOutputAsync(
+        IReadOnlyList<AppliedToken> appliedTokens,
+        TimeSpan elapsed,
+        CancellationToken ct)
+    {
+        lock (_lock)
+        {
+            if (_current is null)
+                return ValueTask.FromResult<IReadOnlyList<AnsiToken>>([]);
+
+            // The buffers' size, which only changes when the terminal resizes them
+            var height = _current.GetLength(0);
+            var width = _current.GetLength(1);
+
+            foreach (var appliedToken in appliedTokens)
+            {
+                switch (appliedToken.Token)
+                {
+                    case FrameBeginToken:
+                        // An unmatched begin ends the previous frame
+                        if (_inFrame)
+                        {
+                            PublishFrame();
+                        }
+                        _inFrame = true;
+                        continue;
+
+                    case FrameEndToken:
+                        if (_inFrame)
+                        {
+                            _inFrame = false;
+                            PublishFrame();
+                        }
+                        continue;
+
+                    case PrivateModeToken { Mode: SynchronizedOutputMode }:
+                    case ClearScreenToken:
+                    case ClearLineToken:
+                        // Frames are always synchronized, and clears arrive as cell impacts
+                        break;
+
+                    case PrivateModeToken:
+                    case CursorShapeToken:
+                    case SaveCursorToken:
+                    case RestoreCursorToken:
+                    case ScrollRegionToken:
+                    case OscToken:
+                    case DcsToken:
+                    case KittyGraphicsToken:
+                        _frameControlTokens.Add(appliedToken.Token);
+                        break;
+
+                    case CursorPositionToken when appliedToken.CellImpacts.Count == 0:
+                        _frameControlTokens.Add(appliedToken.Token);
+                        break;
+                }
+
+                foreach (var impact in appliedToken.CellImpacts)
+                {
+                    if (impact.X < 0 || impact.X >= width || impact.Y < 0 || impact.Y >= height)
+                        continue;
+
+                    _current[impact.Y, impact.X] = ShadowCell.FromTerminalCell(impact.Cell);
+                    _dirtyCells.Add((impact.X, impact.Y));
+                }
+            }
+
+            // Output outside app frames is published as it arrives
+            if (!_inFrame)
+            {
+                PublishFrame();
+            }
+        }
+
+        // Nothing goes to the terminal's own presentation; viewers are written directly
+        return ValueTask.FromResult<IReadOnlyList<AnsiToken>>([]);
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalPresentationFilter.OnInputAsync(ReadOnlyMemory<byte> data, TimeSpan elapsed, CancellationToken ct)
+        => ValueTask.CompletedTask;
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalPresentationFilter.OnResizeAsync(int width, int height, TimeSpan elapsed, CancellationToken ct)
+    {
+        lock (_lock)
+        {
+            ResetBuffers(width, height);
+
+            // The frame in progress was for the old size; the app redraws after a resize
+            _inFrame = false;
+            _frameControlTokens.Clear();
+
+            foreach (var viewer in _viewers)
+            {
+                viewer.Committed = null;
+            }
+        }
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalPresentationFilter.OnSessionEndAsync(TimeSpan elapsed, CancellationToken ct)
+    {
+        lock (_lock)
+        {
+            _current = null;
+            _published = null;
+            _dirtyCells.Clear();
+            _frameControlTokens.Clear();
+            _inFrame = false;
+        }
+        return ValueTask.CompletedTask;
+    }
+
+    /// <summary>
+    /// Diffs the current frame against the published one, encodes it once and sends it to
+    /// every viewer that is up to date. Viewers that are behind catch up on their own.
+    /// </summary>
+    private void PublishFrame()
+    {
+        var changedCells = new List<ChangedCell>();
+        foreach (var (x, y) in _dirtyCells)
+        {
+            var cell = _current![y, x];
+            if (cell != _published![y, x])
+            {
+                _published[y, x] = cell;
+                changedCells.Add(new ChangedCell(x, y, cell));
+            }
+        }
+        _dirtyCells.Clear();
+
+        if (changedCells.Count == 0 && _frameControlTokens.Count == 0)
+            return;
+
+        foreach (var token in _frameControlTokens)
+        {
+            TrackState(token);
+        }
+
+        var previousVersion = _version++;
+        byte[]? frame = null;
+
+        foreach (var viewer in _viewers)
+        {
+            if (viewer.SendTask != null)
+                continue; // Catches up when its current write completes
+
+            if (viewer.Committed is null || viewer.Version != previousVersion)
+            {
+                StartSend(viewer, null);
+                continue;
+            }
+
+            if (frame == null)
+            {
+                var tokens = new List<AnsiToken>(_frameControlTokens.Count + changedCells.Count * 3 + 2)
+                {
+                    new PrivateModeToken(SynchronizedOutputMode, true)
+                };
+                tokens.AddRange(_frameControlTokens);
+                tokens.AddRange(ShadowCell.GenerateTokens(changedCells));
+                tokens.Add(new PrivateModeToken(SynchronizedOutputMode, false));
+                frame = Encoding.UTF8.GetBytes(AnsiTokenSerializer.Serialize(tokens));
+                _framesEncoded++;
+            }
+
+            foreach (var changed in changedCells)
+            {
+                viewer.Committed[changed.Y, changed.X] = changed.Cell;
+            }
+            viewer.Version = _version;
+            StartSend(viewer, frame);
+        }
+
+        _frameControlTokens.Clear();
+    }
+
+    /// <summary>
+    /// Records the modes and cursor a viewer needs when it is sent a frame from its own buffer.
+    /// </summary>
+    private void TrackState(AnsiToken token)
+    {
+        switch (token)
+        {
+            case PrivateModeToken mode:
+                _modes[mode.Mode] = mode;
+                break;
+            case CursorShapeToken shape:
+                _cursorShape = shape;
+                break;
+            case CursorPositionToken position:
+                _cursorPosition = position;
+                break;
+        }
+    }
+
+    /// <summary>
+    /// Brings a viewer's committed buffer up to the published frame and returns the output that
+    /// does the same on screen: a full paint if it has no buffer yet, otherwise the net diff.
+    /// </summary>
+    private byte[] CatchUp(Viewer viewer)
+    {
+        var tokens = new List<AnsiToken> { new PrivateModeToken(SynchronizedOutputMode, true) };
+
+        // Sized like the published frame, which lags a Resize until the terminal follows it
+        var height = _published?.GetLength(0) ?? _height;
+        var width = _published?.GetLength(1) ?? _width;
+
+        if (viewer.Committed is null || viewer.Committed.GetLength(0) != height || viewer.Committed.GetLength(1) != width)
+        {
+            viewer.Committed = ShadowCell.CreateBuffer(width, height);
+            tokens.Add(new SgrToken("0"));
+            tokens.Add(new ClearScreenToken(ClearMode.All));
+        }
+
+        tokens.AddRange(_modes.Values);
+        if (_cursorShape != null)
+        {
+            tokens.Add(_cursorShape);
+        }
+
+        var changedCells = new List<ChangedCell>();
+        if (_published != null)
+        {
+            for (int y = 0; y < height; y++)
+            {
+                for (int x = 0; x < width; x++)
+                {
+                    var cell = _published[y, x];
+                    if (cell != viewer.Committed[y, x])
+                    {
+                        viewer.Committed[y, x] = cell;
+                        changedCells.Add(new ChangedCell(x, y, cell));
+                    }
+                }
+            }
+        }
+        tokens.AddRange(ShadowCell.GenerateTokens(changedCells));
+
+        if (_cursorPosition != null)
+        {
+            tokens.Add(_cursorPosition);
+        }
+        tokens.Add(new PrivateModeToken(SynchronizedOutputMode, false));
+
+        viewer.Version = _version;
+        return Encoding.UTF8.GetBytes(AnsiTokenSerializer.Serialize(tokens));
+    }
+
+    /// <summary>
+    /// Starts a viewer's send loop with <paramref name="frame"/>, or with a catch-up when null.
+    /// </summary>
+    private void StartSend(Viewer viewer, byte[]? frame)
+    {
+        frame ??= CatchUp(viewer);
+        viewer.SendTask = Task.Run(() => SendLoopAsync(viewer, frame));
+    }
+
+    private async Task SendLoopAsync(Viewer viewer, byte[] frame)
+    {
+        var ct = viewer.Cancellation.Token;
+        try
+        {
+            while (true)
+            {
+                await viewer.Adapter.WriteOutputAsync(frame, ct);
+                await viewer.Adapter.FlushAsync(ct);
+
+                lock (_lock)
+                {
+                    // Frames published during the write are collapsed into one diff
+                    if (viewer.Detached || (viewer.Committed != null && viewer.Version == _version))
+                    {
+                        viewer.SendTask = null;
+                        return;
+                    }
+
+                    frame = CatchUp(viewer);
+                }
+            }
+        }
+        catch (OperationCanceledException) when (ct.IsCancellationRequested)
+        {
+            lock (_lock)
+            {
+                viewer.SendTask = null;
+            }
+        }
+        catch (Exception)
+        {
+            // A failed viewer is dropped and its RunViewerAsync returns
+            lock (_lock)
+            {
+                _viewers.Remove(viewer);
+                viewer.Detached = true;
+                viewer.Faulted = true;
+                viewer.SendTask = null;
+            }
+
+            viewer.Cancellation.Cancel();
+        }
+    }
+
+    private void ResetBuffers(int width, int height)
+    {
+        _current = ShadowCell.CreateBuffer(width, height);
+        _published = ShadowCell.CreateBuffer(width, height);
+        _dirtyCells.Clear();
+    }
+
+    // === Presentation adapter: the terminal's side ===
+
+    /// <inheritdoc />
+    public ValueTask WriteOutputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
+    {
+        // Output reaches viewers through the filter
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    public async ValueTask<ReadOnlyMemory<byte>> ReadInputAsync(CancellationToken ct = default)
+    {
+        // Viewers are read-only, so the terminal gets no input until the broadcast ends
+        try
+        {
+            await _disposed.Task.WaitAsync(ct);
+        }
+        catch (OperationCanceledException)
+        {
+        }
+        return ReadOnlyMemory<byte>.Empty;
+    }
+
+    /// <inheritdoc />
+    public ValueTask FlushAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+
+    /// <inheritdoc />
+    public ValueTask EnterTuiModeAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+
+    /// <inheritdoc />
+    public ValueTask ExitTuiModeAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+
+    /// <summary>
+    /// Detaches every viewer and ends the broadcast.
+    /// </summary>
+    public async ValueTask DisposeAsync()
+    {
+        Task[] sending;
+        lock (_lock)
+        {
+            if (_isDisposed) return;
+            _isDisposed = true;
+
+            sending = _viewers.Select(v => v.SendTask).OfType<Task>().ToArray();
+        }
+
+        _disposeCts.Cancel();
+        _disposed.TrySetResult();
+        await Task.WhenAll(sending);
+    }
+
+    private sealed class Viewer(IHex1bTerminalPresentationAdapter adapter, CancellationTokenSource cancellation)
+    {
+        public IHex1bTerminalPresentationAdapter Adapter { get; } = adapter;
+        public CancellationTokenSource Cancellation { get; } = cancellation;
+
+        // What the viewer was last sent, and the published frame it matches
+        public ShadowCell[,]? Committed { get; set; }
+        public long Version { get; set; }
+
+        public Task? SendTask { get; set; }
+        public bool Detached { get; set; }
+        public bool Faulted { get; set; }
+    }
+}
@@ -0,0 +1,488 @@
+using System.Buffers;
+using System.Buffers.Binary;
+using System.Text;
+using System.Threading.Channels;
+using Hex1b.Tokens;
+
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Records terminal sessions in a compact, seekable binary format.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Unlike <see cref="AsciinemaRecorder"/>, which serializes every event as a JSON line, this
+/// recorder keeps workload output as the raw bytes the terminal read, with varint timestamps,
+/// and adds periodic keyframes holding the full screen state plus an index of them, so a
+/// player can seek without replaying the whole session. The format is described on
+/// <see cref="Hex1bRecordingFormat"/>; read recordings with <see cref="Hex1bRecordingReader"/>
+/// and convert to and from asciicast v2 with <see cref="Hex1bRecordingConverter"/>.
+/// </para>
+/// <para>
+/// Events are appended to a pooled buffer without awaiting. Full buffers, and partly filled
+/// ones every <see cref="Hex1bRecorderOptions.FlushInterval"/>, are handed to a background
+/// task that writes them to the file, so recording never waits on the disk.
+/// </para>
+/// <example>
+/// <code>
+/// var options = new Hex1bTerminalOptions { ... };
+/// var recorder = options.AddHex1bRecorder("session.hxr");
+/// var terminal = new Hex1bTerminal(options);
+/// // ... run application ...
+/// // The index is written when the recorder is disposed
+/// </code>
+/// </example>
+/// </remarks>
+public sealed class Hex1bRecorder : IHex1bTerminalRecordingFilter, IAsyncDisposable, IDisposable
+{
+    private readonly Hex1bRecorderOptions _options;
+    private readonly string _filePath;
+    private readonly object _lock = new();
+    private readonly Channel<Segment> _segments = Channel.CreateUnbounded<Segment>(new UnboundedChannelOptions { SingleReader = true });
+    private readonly List<(long Time, long Offset)> _keyframes = [];
+    private Hex1bTerminal? _terminal;
+    private Task? _writeTask;
+    private Exception? _writeError;
+
+    // The buffer being filled; _position is the file offset of its first byte
+    private byte[]? _buffer;
+    private int _length;
+    private long _position;
+
+    private DateTimeOffset _timestamp;
+    private long _lastTime;
+    private long _lastKeyframeTime;
+    private long _lastHandoffTime;
+    private bool _outputSinceKeyframe;
+    private bool _started;
+    private bool _disposed;
+
+    /// <summary>
+    /// Creates a recorder that writes to the specified file.
+    /// </summary>
+    /// <param name="filePath">Path to the output file (typically with .hxr extension).</param>
+    /// <param name="options">Recording options. If null, defaults are used.</param>
+    public Hex1bRecorder(string filePath, Hex1bRecorderOptions? options = null)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(filePath);
+        _filePath = filePath;
+        _options = options ?? new Hex1bRecorderOptions();
+        ArgumentOutOfRangeException.ThrowIfLessThan(_options.BufferSize, 1024, nameof(options));
+    }
+
+    /// <summary>
+    /// Gets the recording options.
+    /// </summary>
+    public Hex1bRecorderOptions Options => _options;
+
+    /// <summary>
+    /// Gets the file path being written to.
+    /// </summary>
+    public string FilePath => _filePath;
+
+    /// <summary>
+    /// Gets the number of bytes recorded so far, including those not yet written to the file.
+    /// </summary>
+    public long BytesRecorded
+    {
+        get { lock (_lock) return _position + _length; }
+    }
+
+    /// <summary>
+    /// Gets the number of keyframes recorded so far.
+    /// </summary>
+    public int KeyframeCount
+    {
+        get { lock (_lock) return _keyframes.Count; }
+    }
+
+    /// <summary>
+    /// Adds a marker event at the current time.
+    /// </summary>
+    /// <param name="label">Optional label for the marker.</param>
+    /// <param name="elapsed">Time elapsed since session start.</param>
+    public void AddMarker(string label = "", TimeSpan? elapsed = null)
+    {
+        lock (_lock)
+        {
+            if (!_started) return;
+            var time = elapsed ?? DateTimeOffset.UtcNow - _timestamp;
+            var length = Encoding.UTF8.GetByteCount(label);
+            var payload = BeginRecord(Hex1bRecordingFormat.RecordMarker, time, length);
+            Encoding.UTF8.GetBytes(label, payload);
+            EndRecord(length);
+        }
+    }
+
+    /// <inheritdoc />
+    void IHex1bTerminalRecordingFilter.AttachTerminal(Hex1bTerminal terminal) => _terminal = terminal;
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalWorkloadFilter.OnSessionStartAsync(int width, int height, DateTimeOffset timestamp, CancellationToken ct)
+    {
+        Start(width, height, timestamp);
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalRecordingFilter.OnRawOutputAsync(ReadOnlyMemory<byte> data, TimeSpan elapsed, CancellationToken ct)
+    {
+        RecordOutput(data.Span, elapsed);
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalWorkloadFilter.OnOutputAsync(IReadOnlyList<AnsiToken> tokens, TimeSpan elapsed, CancellationToken ct)
+    {
+        // Only reached when the recorder is driven outside a terminal
+        if (tokens.Count > 0)
+        {
+            RecordOutput(Encoding.UTF8.GetBytes(AnsiTokenSerializer.Serialize(tokens)), elapsed);
+        }
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalWorkloadFilter.OnFrameCompleteAsync(TimeSpan elapsed, CancellationToken ct)
+    {
+        OnFrameComplete(elapsed);
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalWorkloadFilter.OnInputAsync(ReadOnlyMemory<byte> data, TimeSpan elapsed, CancellationToken ct)
+    {
+        // Only record input if explicitly enabled, as for Asciinema
+        if (_options.CaptureInput && !data.IsEmpty)
+        {
+            RecordInput(data.Span, elapsed);
+        }
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalWorkloadFilter.OnResizeAsync(int width, int height, TimeSpan elapsed, CancellationToken ct)
+    {
+        RecordResize(width, height, elapsed);
+        return ValueTask.CompletedTask;
+    }
+
+    /// <inheritdoc />
+    ValueTask IHex1bTerminalWorkloadFilter.OnSessionEndAsync(TimeSpan elapsed, CancellationToken ct)
+    {
+        // The index is written on dispose, when nothing more can be recorded
+        return ValueTask.CompletedTask;
+    }
+
+    internal void Start(int width, int height, DateTimeOffset timestamp)
+    {
+        lock (_lock)
+        {
+            if (_started || _disposed) return;
+            _started = true;
+            _timestamp = timestamp;
+
+            var title = _options.Title ?? "";
+            var titleLength = Encoding.UTF8.GetByteCount(title);
+            var span = Reserve(Hex1bRecordingFormat.Magic.Length + 1 + Hex1bRecordingFormat.MaxVarintLength * 4 + titleLength);
+            Hex1bRecordingFormat.Magic.CopyTo(span);
+            var i = Hex1bRecordingFormat.Magic.Length;
+            span[i++] = Hex1bRecordingFormat.Version;
+            i += Hex1bRecordingFormat.WriteVarint(span[i..], (ulong)width);
+            i += Hex1bRecordingFormat.WriteVarint(span[i..], (ulong)height);
+            i += Hex1bRecordingFormat.WriteVarint(span[i..], (ulong)Math.Max(0, timestamp.ToUnixTimeMilliseconds()));
+            i += Hex1bRecordingFormat.WriteVarint(span[i..], (ulong)titleLength);
+            i += Encoding.UTF8.GetBytes(title, span[i..]);
+            _length += i;
+
+            // A keyframe at the start means there is always one at or before any seek target
+            RecordKeyframe(0);
+        }
+    }
+
+    internal void RecordOutput(ReadOnlySpan<byte> data, TimeSpan elapsed)
+    {
+        if (data.IsEmpty) return;
+        lock (_lock)
+        {
+            if (!_started || _disposed) return;
+            data.CopyTo(BeginRecord(Hex1bRecordingFormat.RecordOutput, elapsed, data.Length));
+            EndRecord(data.Length);
+            _outputSinceKeyframe = true;
+        }
+    }
+
+    internal void RecordInput(ReadOnlySpan<byte> data, TimeSpan elapsed)
+    {
+        lock (_lock)
+        {
+            if (!_started || _disposed) return;
+            data.CopyTo(BeginRecord(Hex1bRecordingFormat.RecordInput, elapsed, data.Length));
+            EndRecord(data.Length);
+        }
+    }
+
+    internal void RecordResize(int width, int height, TimeSpan elapsed)
+    {
+        lock (_lock)
+        {
+            if (!_started || _disposed) return;
+            var length = Hex1bRecordingFormat.GetVarintLength((ulong)width) + Hex1bRecordingFormat.GetVarintLength((ulong)height);
+            var payload = BeginRecord(Hex1bRecordingFormat.RecordResize, elapsed, length);
+            var i = Hex1bRecordingFormat.WriteVarint(payload, (ulong)width);
+            Hex1bRecordingFormat.WriteVarint(payload[i..], (ulong)height);
+            EndRecord(length);
+            _outputSinceKeyframe = true;
+        }
+    }
+
+    /// <summary>
+    /// Called once output up to <paramref name="elapsed"/> has been applied to the terminal:
+    /// adds a keyframe when one is due and hands the buffer to the writer when it is due.
+    /// </summary>
+    internal void OnFrameComplete(TimeSpan elapsed)
+    {
+        lock (_lock)
+        {
+            if (!_started || _disposed) return;
+
+            var time = Math.Max(_lastTime, Hex1bRecordingFormat.ToMicroseconds(elapsed));
+            if (_outputSinceKeyframe
+                && _terminal != null
+                && time - _lastKeyframeTime >= Hex1bRecordingFormat.ToMicroseconds(_options.KeyframeInterval))
+            {
+                RecordKeyframe(time);
+            }
+
+            if (_length > 0 && time - _lastHandoffTime >= Hex1bRecordingFormat.ToMicroseconds(_options.FlushInterval))
+            {
+                HandOff(null);
+                _lastHandoffTime = time;
+            }
+        }
+    }
+
+    private void RecordKeyframe(long time)
+    {
+        if (_terminal == null) return;
+
+        var state = _terminal.CaptureState();
+        var offset = _position + _length;
+        state.CopyTo(BeginRecord(Hex1bRecordingFormat.RecordKeyframe, Hex1bRecordingFormat.FromMicroseconds(time), state.Length));
+        EndRecord(state.Length);
+
+        _keyframes.Add((_lastTime, offset));
+        _lastKeyframeTime = _lastTime;
+        _outputSinceKeyframe = false;
+    }
+
+    /// <summary>
+    /// Writes a record's type, time delta and length, and returns the span for its payload.
+    /// </summary>
+    private Span<byte> BeginRecord(byte type, TimeSpan elapsed, int length)
+    {
+        // Timestamps never go backwards, so deltas stay unsigned
+        var time = Math.Max(_lastTime, Hex1bRecordingFormat.ToMicroseconds(elapsed));
+        var span = Reserve(Hex1bRecordingFormat.MaxRecordHeaderSize + length);
+        span[0] = type;
+        var i = 1;
+        i += Hex1bRecordingFormat.WriteVarint(span[i..], (ulong)(time - _lastTime));
+        i += Hex1bRecordingFormat.WriteVarint(span[i..], (ulong)length);
+        _length += i;
+        _lastTime = time;
+        return span.Slice(i, length);
+    }
+
+    private void EndRecord(int length) => _length += length;
+
+    /// <summary>
+    /// Gets room for <paramref name="size"/> bytes at the end of the buffer, handing a buffer
+    /// without room to the writer. Records are never split across buffers.
+    /// </summary>
+    private Span<byte> Reserve(int size)
+    {
+        if (_buffer != null && _buffer.Length - _length < size)
+        {
+            HandOff(null);
+        }
+
+        _buffer ??= ArrayPool<byte>.Shared.Rent(Math.Max(_options.BufferSize, size));
+        return _buffer.AsSpan(_length);
+    }
+
+    /// <summary>
+    /// Queues the buffer for writing, with <paramref name="flushed"/> completed once it and
+    /// everything before it is on disk.
+    /// </summary>
+    private void HandOff(TaskCompletionSource? flushed)
+    {
+        if (_writeTask == null)
+        {
+            var stream = new FileStream(_filePath, FileMode.Create, FileAccess.Write, FileShare.Read, bufferSize: 1, useAsync: true);
+            _writeTask = Task.Run(() => WriteLoopAsync(stream));
+        }
+
+        if (_buffer != null && _length > 0)
+        {
+            _segments.Writer.TryWrite(new Segment(_buffer, _length, flushed));
+            _position += _length;
+            _buffer = null;
+            _length = 0;
+        }
+        else if (flushed != null)
+        {
+            _segments.Writer.TryWrite(new Segment(null, 0, flushed));
+        }
+    }
+
+    private async Task WriteLoopAsync(FileStream stream)
+    {
+        await using (stream)
+        {
+            await foreach (var segment in _segments.Reader.ReadAllAsync())
+            {
+                try
+                {
+                    if (segment.Buffer != null && _writeError == null)
+                    {
+                        await stream.WriteAsync(segment.Buffer.AsMemory(0, segment.Length));
+                    }
+
+                    if (segment.Flushed != null && _writeError == null)
+                    {
+                        await stream.FlushAsync();
+                    }
+                }
+                catch (Exception ex)
+                {
+                    // Later segments are dropped; flushes report the failure
+                    _writeError ??= ex;
+                }
+                finally
+                {
+                    if (segment.Buffer != null)
+                    {
+                        ArrayPool<byte>.Shared.Return(segment.Buffer);
+                    }
+                }
+
+                if (segment.Flushed != null)
+                {
+                    if (_writeError != null)
+                        segment.Flushed.TrySetException(_writeError);
+                    else
+                        segment.Flushed.TrySetResult();
+                }
+            }
+        }
+    }
+
+    /// <summary>
+    /// Writes everything recorded so far to the file.
+    /// </summary>
+    /// <param name="ct">Cancellation token.</param>
+    public Task FlushAsync(CancellationToken ct = default)
+    {
+        var flushed = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        lock (_lock)
+        {
+            if (!_started || _disposed)
+                return Task.CompletedTask;
+            HandOff(flushed);
+        }
+        return flushed.Task.WaitAsync(ct);
+    }
+
+    /// <inheritdoc />
+    public async ValueTask DisposeAsync()
+    {
+        Task? writeTask;
+        lock (_lock)
+        {
+            if (_disposed) return;
+            _disposed = true;
+
+            if (_started)
+            {
+                WriteIndex();
+                HandOff(null);
+            }
+
+            _segments.Writer.TryComplete();
+            writeTask = _writeTask;
+        }
+
+        if (writeTask != null)
+        {
+            await writeTask;
+        }
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        if (_disposed) return;
+        DisposeAsync().AsTask().GetAwaiter().GetResult();
+    }
+
+    private void WriteIndex()
+    {
+        var length = Hex1bRecordingFormat.GetVarintLength((ulong)_lastTime)
+            + Hex1bRecordingFormat.GetVarintLength((ulong)_keyframes.Count);
+        foreach (var (time, offset) in _keyframes)
+        {
+            length += Hex1bRecordingFormat.GetVarintLength((ulong)time) + Hex1bRecordingFormat.GetVarintLength((ulong)offset);
+        }
+
+        var indexOffset = _position + _length;
+        var payload = BeginRecord(Hex1bRecordingFormat.RecordIndex, Hex1bRecordingFormat.FromMicroseconds(_lastTime), length);
+        var i = Hex1bRecordingFormat.WriteVarint(payload, (ulong)_lastTime);
+        i += Hex1bRecordingFormat.WriteVarint(payload[i..], (ulong)_keyframes.Count);
+        foreach (var (time, offset) in _keyframes)
+        {
+            i += Hex1bRecordingFormat.WriteVarint(payload[i..], (ulong)time);
+            i += Hex1bRecordingFormat.WriteVarint(payload[i..], (ulong)offset);
+        }
+        EndRecord(length);
+
+        var trailer = Reserve(Hex1bRecordingFormat.TrailerSize);
+        BinaryPrimitives.WriteInt64LittleEndian(trailer, indexOffset);
+        Hex1bRecordingFormat.TrailerMagic.CopyTo(trailer[8..]);
+        _length += Hex1bRecordingFormat.TrailerSize;
+    }
+
+    private readonly record struct Segment(byte[]? Buffer, int Length, TaskCompletionSource? Flushed);
+}
+
+/// <summary>
+/// Options for configuring the <see cref="Hex1bRecorder"/>.
+/// </summary>
+public sealed class Hex1bRecorderOptions
+{
+    /// <summary>
+    /// Title of the recording.
+    /// </summary>
+    public string? Title { get; set; }
+
+    /// <summary>
+    /// Whether to capture keyboard input. Off by default, as for Asciinema.
+    /// </summary>
+    public bool CaptureInput { get; set; }
+
+    /// <summary>
+    /// Minimum time between keyframes. A keyframe is only added after output has changed the
+    /// screen, at the end of a frame. Shorter intervals make seeking faster and files larger.
+    /// </summary>
+    public TimeSpan KeyframeInterval { get; set; } = TimeSpan.FromSeconds(10);
+
+    /// <summary>
+    /// Size of the pooled buffers events are collected in before they are written.
+    /// </summary>
+    public int BufferSize { get; set; } = 64 * 1024;
+
+    /// <summary>
+    /// How often a partly filled buffer is handed to the writer, bounding how much recent
+    /// output a crash can lose.
+    /// </summary>
+    public TimeSpan FlushInterval { get; set; } = TimeSpan.FromSeconds(1);
+}
@@ -0,0 +1,157 @@
+using System.Text;
+using System.Text.Json;
+using Hex1b.Tokens;
+
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Converts between <see cref="Hex1bRecorder"/> recordings and asciicast v2 files.
+/// </summary>
+/// <seealso href="https://docs.asciinema.org/manual/asciicast/v2/"/>
+public static class Hex1bRecordingConverter
+{
+    /// <summary>
+    /// Writes a recording as an asciicast v2 file for the Asciinema player and ecosystem.
+    /// </summary>
+    /// <remarks>
+    /// Output, input, resize and marker events are kept; keyframes have no asciicast equivalent
+    /// and are dropped.
+    /// </remarks>
+    /// <param name="recordingPath">Path to the recording.</param>
+    /// <param name="asciicastPath">Path to the asciicast file to create.</param>
+    /// <param name="ct">Cancellation token.</param>
+    public static async Task ToAsciicastAsync(string recordingPath, string asciicastPath, CancellationToken ct = default)
+    {
+        using var reader = Hex1bRecordingReader.Open(recordingPath);
+        await using var writer = new StreamWriter(asciicastPath, append: false, new UTF8Encoding(encoderShouldEmitUTF8Identifier: false));
+
+        var header = new AsciinemaHeader
+        {
+            Version = 2,
+            Width = reader.Width,
+            Height = reader.Height,
+            Timestamp = reader.StartTime.ToUnixTimeSeconds(),
+            Title = reader.Title
+        };
+        await writer.WriteLineAsync(JsonSerializer.Serialize(header, AsciinemaJsonContext.Default.AsciinemaHeader));
+
+        // Raw chunks can split a UTF-8 sequence, so each stream keeps its own decoder state
+        var outputDecoder = Encoding.UTF8.GetDecoder();
+        var inputDecoder = Encoding.UTF8.GetDecoder();
+
+        foreach (var evt in reader.ReadEvents())
+        {
+            ct.ThrowIfCancellationRequested();
+
+            var asciicastEvent = evt.Kind switch
+            {
+                Hex1bRecordingEventKind.Output => new AsciinemaEvent(evt.Time.TotalSeconds, "o", Decode(outputDecoder, evt.Data.Span)),
+                Hex1bRecordingEventKind.Input => new AsciinemaEvent(evt.Time.TotalSeconds, "i", Decode(inputDecoder, evt.Data.Span)),
+                Hex1bRecordingEventKind.Resize => new AsciinemaEvent(evt.Time.TotalSeconds, "r", FormatSize(evt.GetSize())),
+                Hex1bRecordingEventKind.Marker => new AsciinemaEvent(evt.Time.TotalSeconds, "m", evt.GetText()),
+                _ => (AsciinemaEvent?)null
+            };
+
+            if (asciicastEvent is { } value && (value.Data.Length > 0 || value.Code == "m"))
+            {
+                await writer.WriteLineAsync(JsonSerializer.Serialize(value, AsciinemaJsonContext.Default.AsciinemaEvent));
+            }
+        }
+
+        await writer.FlushAsync(ct);
+
+        static string Decode(Decoder decoder, ReadOnlySpan<byte> bytes)
+        {
+            var chars = new char[decoder.GetCharCount(bytes, flush: false)];
+            var count = decoder.GetChars(bytes, chars, flush: false);
+            return new string(chars, 0, count);
+        }
+
+        static string FormatSize((int Width, int Height) size) => $"{size.Width}x{size.Height}";
+    }
+
+    /// <summary>
+    /// Converts an asciicast v2 file to a recording.
+    /// </summary>
+    /// <remarks>
+    /// The output is replayed through a headless terminal to build keyframes, so the result
+    /// seeks like a recording made live.
+    /// </remarks>
+    /// <param name="asciicastPath">Path to the asciicast file.</param>
+    /// <param name="recordingPath">Path to the recording to create.</param>
+    /// <param name="options">Recording options. By default the title comes from the asciicast header and input is kept.</param>
+    /// <param name="ct">Cancellation token.</param>
+    /// <exception cref="InvalidDataException">The file is not asciicast v2.</exception>
+    public static async Task FromAsciicastAsync(
+        string asciicastPath,
+        string recordingPath,
+        Hex1bRecorderOptions? options = null,
+        CancellationToken ct = default)
+    {
+        using var input = new StreamReader(asciicastPath, Encoding.UTF8);
+
+        var headerLine = await input.ReadLineAsync(ct);
+        var header = headerLine != null
+            ? JsonSerializer.Deserialize(headerLine, AsciinemaJsonContext.Default.AsciinemaHeader)
+            : null;
+        if (header is not { Version: 2, Width: > 0, Height: > 0 })
+            throw new InvalidDataException("Not an asciicast v2 file.");
+
+        options ??= new Hex1bRecorderOptions { Title = header.Title, CaptureInput = true };
+
+        await using var recorder = new Hex1bRecorder(recordingPath, options);
+        await using var terminal = new Hex1bTerminal(new Hex1bAppWorkloadAdapter(), header.Width, header.Height);
+        ((IHex1bTerminalRecordingFilter)recorder).AttachTerminal(terminal);
+        recorder.Start(header.Width, header.Height, DateTimeOffset.FromUnixTimeSeconds(header.Timestamp));
+
+        while (await input.ReadLineAsync(ct) is { } line)
+        {
+            if (string.IsNullOrWhiteSpace(line))
+                continue;
+
+            AsciinemaEvent evt;
+            try
+            {
+                evt = JsonSerializer.Deserialize(line, AsciinemaJsonContext.Default.AsciinemaEvent);
+            }
+            catch (Exception ex) when (ex is JsonException or InvalidOperationException)
+            {
+                throw new InvalidDataException("Invalid asciicast event.", ex);
+            }
+
+            var time = TimeSpan.FromSeconds(evt.Time);
+            switch (evt.Code)
+            {
+                case "o":
+                    recorder.RecordOutput(Encoding.UTF8.GetBytes(evt.Data), time);
+                    terminal.ApplyTokens(AnsiTokenizer.Tokenize(evt.Data));
+                    recorder.OnFrameComplete(time);
+                    break;
+
+                case "i" when options.CaptureInput:
+                    recorder.RecordInput(Encoding.UTF8.GetBytes(evt.Data), time);
+                    break;
+
+                case "r" when TryParseSize(evt.Data, out var width, out var height):
+                    terminal.Resize(width, height);
+                    recorder.RecordResize(width, height, time);
+                    break;
+
+                case "m":
+                    recorder.AddMarker(evt.Data, time);
+                    break;
+            }
+        }
+    }
+
+    private static bool TryParseSize(string value, out int width, out int height)
+    {
+        width = height = 0;
+        var separator = value.IndexOf('x');
+        return separator > 0
+            && int.TryParse(value.AsSpan(0, separator), out width)
+            && int.TryParse(value.AsSpan(separator + 1), out height)
+            && width > 0
+            && height > 0;
+    }
+}
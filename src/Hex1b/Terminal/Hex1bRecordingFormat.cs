@@ -0,0 +1,94 @@
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Layout of the binary recordings written by <see cref="Hex1bRecorder"/>.
+/// </summary>
+/// <remarks>
+/// <para>
+/// A recording starts with a header: the magic <c>HXRC</c>, a version byte, then varint width,
+/// height and start time (Unix milliseconds) and a length-prefixed UTF-8 title.
+/// </para>
+/// <para>
+/// Records follow, each a type byte, a varint time delta in microseconds since the previous
+/// record, a varint payload length and the payload. Output and input payloads are the raw
+/// bytes, resize is varint width and height, a marker is its UTF-8 label and a keyframe is a
+/// <see cref="Hex1bTerminal.SaveState"/> snapshot of the screen after every earlier record.
+/// </para>
+/// <para>
+/// A finished recording ends with an index record holding the duration and each keyframe's
+/// absolute time and file offset, then a trailer: the index record's offset as a little-endian
+/// 64-bit integer and the magic <c>HXRI</c>. A recording without a trailer, such as one cut
+/// short by a crash, is read by scanning its records instead.
+/// </para>
+/// </remarks>
+internal static class Hex1bRecordingFormat
+{
+    public static ReadOnlySpan<byte> Magic => "HXRC"u8;
+    public static ReadOnlySpan<byte> TrailerMagic => "HXRI"u8;
+    public const byte Version = 1;
+
+    public const byte RecordOutput = 1;
+    public const byte RecordInput = 2;
+    public const byte RecordResize = 3;
+    public const byte RecordMarker = 4;
+    public const byte RecordKeyframe = 5;
+    public const byte RecordIndex = 0x7F;
+
+    public const int TrailerSize = 12;
+    public const int MaxVarintLength = 10;
+
+    // Type byte plus the time delta and length varints
+    public const int MaxRecordHeaderSize = 1 + MaxVarintLength * 2;
+
+    public static int WriteVarint(Span<byte> destination, ulong value)
+    {
+        var i = 0;
+        while (value >= 0x80)
+        {
+            destination[i++] = (byte)(value | 0x80);
+            value >>= 7;
+        }
+        destination[i++] = (byte)value;
+        return i;
+    }
+
+    public static int GetVarintLength(ulong value)
+    {
+        var length = 1;
+        while (value >= 0x80)
+        {
+            value >>= 7;
+            length++;
+        }
+        return length;
+    }
+
+    /// <summary>
+    /// Reads a varint, returning false if <paramref name="source"/> ends first.
+    /// </summary>
+    /// <exception cref="InvalidDataException">The varint is longer than 64 bits.</exception>
+    public static bool TryReadVarint(ReadOnlySpan<byte> source, out ulong value, out int consumed)
+    {
+        value = 0;
+        for (var i = 0; i < source.Length; i++)
+        {
+            if (i == MaxVarintLength)
+                throw new InvalidDataException("Recording is corrupt.");
+
+            var b = source[i];
+            value |= (ulong)(b & 0x7F) << (7 * i);
+            if (b < 0x80)
+            {
+                consumed = i + 1;
+                return true;
+            }
+        }
+
+        consumed = 0;
+        return false;
+    }
+
+    public static long ToMicroseconds(TimeSpan time) => time.Ticks / (TimeSpan.TicksPerMillisecond / 1000);
+
+    public static TimeSpan FromMicroseconds(long microseconds) => TimeSpan.FromTicks(microseconds * (TimeSpan.TicksPerMillisecond / 1000));
+}
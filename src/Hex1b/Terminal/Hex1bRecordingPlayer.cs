@@ -0,0 +1,311 @@
+using System.Text;
+using Hex1b.Terminal.Automation;
+using Hex1b.Tokens;
+
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Replays a <see cref="Hex1bRecorder"/> recording and seeks to any point in it.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The screen at a given time is rebuilt by restoring the nearest keyframe at or before it and
+/// applying only the output recorded after that keyframe, so a seek costs at most one
+/// keyframe interval of output however long the recording is. Seeking forward from the
+/// current position continues from where the last seek stopped.
+/// </para>
+/// <para>
+/// The recording's own keyframes are used where there are any. Where they are further apart
+/// than <see cref="Hex1bRecordingPlayerOptions.KeyframeInterval"/>, as in an unfinished
+/// recording, the player keeps keyframes of its own in memory as it plays through the gap.
+/// Call <see cref="BuildIndex"/> to fill every gap up front.
+/// </para>
+/// <example>
+/// <code>
+/// using var player = Hex1bRecordingPlayer.Open("session.hxr");
+/// player.Seek(TimeSpan.FromMinutes(42));
+/// using var snapshot = player.CreateSnapshot();
+/// Console.WriteLine(snapshot.GetScreenText());
+/// </code>
+/// </example>
+/// </remarks>
+public sealed class Hex1bRecordingPlayer : IDisposable
+{
+    private readonly Hex1bRecordingReader _reader;
+    private readonly bool _ownsReader;
+    private readonly Hex1bRecordingPlayerOptions _options;
+    private readonly Hex1bTerminal _terminal;
+    private readonly object _lock = new();
+
+    // Keyframes in time order: the recording's, the empty screen at the start and our own
+    private readonly List<Keyframe> _keyframes = [];
+
+    private TimeSpan _position;
+
+    // Where playback continues: the next record and the time of the one before it, or for a
+    // recording keyframe still to be restored, its own time. Null once the end has been applied.
+    private Resume? _resume;
+    private bool _changedSinceKeyframe;
+    private bool _disposed;
+
+    /// <summary>
+    /// Opens a recording file for replay.
+    /// </summary>
+    /// <param name="filePath">Path to the recording.</param>
+    /// <param name="options">Replay options. If null, defaults are used.</param>
+    /// <exception cref="InvalidDataException">The file is not a recording.</exception>
+    public static Hex1bRecordingPlayer Open(string filePath, Hex1bRecordingPlayerOptions? options = null)
+    {
+        var reader = Hex1bRecordingReader.Open(filePath);
+        return new Hex1bRecordingPlayer(reader, options, ownsReader: true);
+    }
+
+    /// <summary>
+    /// Creates a player for an open recording. The reader is not disposed with the player.
+    /// </summary>
+    /// <param name="reader">The recording.</param>
+    /// <param name="options">Replay options. If null, defaults are used.</param>
+    public Hex1bRecordingPlayer(Hex1bRecordingReader reader, Hex1bRecordingPlayerOptions? options = null)
+        : this(reader, options, ownsReader: false)
+    {
+    }
+
+    private Hex1bRecordingPlayer(Hex1bRecordingReader reader, Hex1bRecordingPlayerOptions? options, bool ownsReader)
+    {
+        ArgumentNullException.ThrowIfNull(reader);
+        _reader = reader;
+        _ownsReader = ownsReader;
+        _options = options ?? new Hex1bRecordingPlayerOptions();
+        ArgumentOutOfRangeException.ThrowIfLessThanOrEqual(_options.KeyframeInterval, TimeSpan.Zero, nameof(options));
+
+        _terminal = new Hex1bTerminal(new Hex1bAppWorkloadAdapter(), reader.Width, reader.Height);
+
+        // The empty screen covers the start of a recording cut short before its first keyframe
+        _keyframes.Add(new Keyframe(TimeSpan.Zero, reader.DataStart, _terminal.CaptureState()));
+        foreach (var keyframe in reader.Keyframes)
+        {
+            Insert(new Keyframe(keyframe.Time, keyframe.Offset, State: null));
+        }
+
+        _resume = new Resume(reader.DataStart, TimeSpan.Zero, AtRecordingKeyframe: false);
+    }
+
+    /// <summary>
+    /// Gets the replay options.
+    /// </summary>
+    public Hex1bRecordingPlayerOptions Options => _options;
+
+    /// <summary>
+    /// Gets the recording's duration.
+    /// </summary>
+    public TimeSpan Duration => _reader.Duration;
+
+    /// <summary>
+    /// Gets the time the screen currently shows: every event up to and including it has been applied.
+    /// </summary>
+    public TimeSpan Position
+    {
+        get { lock (_lock) return _position; }
+    }
+
+    /// <summary>
+    /// Gets the number of keyframes available for seeking, including those the player keeps in memory.
+    /// </summary>
+    public int KeyframeCount
+    {
+        get { lock (_lock) return _keyframes.Count; }
+    }
+
+    /// <summary>
+    /// Moves to <paramref name="time"/>, leaving the screen as it was after every event up to
+    /// and including that time.
+    /// </summary>
+    /// <param name="time">Time since the recording started. Negative times seek to the start.</param>
+    public void Seek(TimeSpan time)
+    {
+        if (time < TimeSpan.Zero) time = TimeSpan.Zero;
+
+        lock (_lock)
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+
+            var keyframe = _keyframes[FindKeyframe(time)];
+
+            // Carry on from the current position unless a keyframe gets closer
+            if (time < _position || keyframe.Time > _position)
+            {
+                Restore(keyframe);
+            }
+
+            Play(time);
+        }
+    }
+
+    /// <summary>
+    /// Plays through the whole recording, keeping keyframes in memory wherever the recording's
+    /// own are further apart than <see cref="Hex1bRecordingPlayerOptions.KeyframeInterval"/>,
+    /// so later seeks are fast everywhere. Leaves the player at the end of the recording.
+    /// </summary>
+    public void BuildIndex()
+    {
+        lock (_lock)
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            Restore(_keyframes[0]);
+            Play(TimeSpan.MaxValue);
+        }
+    }
+
+    /// <summary>
+    /// Creates a snapshot of the screen at the current <see cref="Position"/>.
+    /// </summary>
+    public Hex1bTerminalSnapshot CreateSnapshot()
+    {
+        lock (_lock)
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            return _terminal.CreateSnapshot();
+        }
+    }
+
+    private void Restore(Keyframe keyframe)
+    {
+        // A recording keyframe's snapshot is the first record read from its offset
+        if (keyframe.State != null)
+        {
+            _terminal.RestoreStateAtRecordedSize(keyframe.State);
+        }
+        _resume = new Resume(keyframe.Offset, keyframe.Time, AtRecordingKeyframe: keyframe.State == null);
+
+        _position = keyframe.Time;
+        _changedSinceKeyframe = false;
+    }
+
+    /// <summary>
+    /// Applies the events from <see cref="_resume"/> up to and including <paramref name="time"/>.
+    /// </summary>
+    private void Play(TimeSpan time)
+    {
+        if (_resume is not { } resume)
+        {
+            _position = time > _position ? time : _position;
+            return;
+        }
+
+        var previousTime = resume.Time;
+        foreach (var evt in _reader.ReadEvents(resume.Offset, resume.Time, relativeFirst: !resume.AtRecordingKeyframe))
+        {
+            if (evt.Time > time)
+            {
+                _resume = new Resume(evt.Offset, previousTime, AtRecordingKeyframe: false);
+                _position = time;
+                return;
+            }
+
+            // Keep a keyframe before this event when the nearest one is too far behind
+            if (_changedSinceKeyframe
+                && evt.Kind != Hex1bRecordingEventKind.Keyframe
+                && previousTime - _keyframes[FindKeyframe(previousTime)].Time >= _options.KeyframeInterval)
+            {
+                Insert(new Keyframe(previousTime, evt.Offset, _terminal.CaptureState()));
+                _changedSinceKeyframe = false;
+            }
+
+            switch (evt.Kind)
+            {
+                case Hex1bRecordingEventKind.Output:
+                    // Decoded per chunk, as the terminal decodes what it reads
+                    _terminal.ApplyTokens(AnsiTokenizer.Tokenize(Encoding.UTF8.GetString(evt.Data.Span)));
+                    _changedSinceKeyframe = true;
+                    break;
+
+                case Hex1bRecordingEventKind.Resize:
+                    var (width, height) = evt.GetSize();
+                    _terminal.Resize(width, height);
+                    _changedSinceKeyframe = true;
+                    break;
+
+                case Hex1bRecordingEventKind.Keyframe:
+                    // Matches the screen when played into, so only needed when restoring it
+                    if (resume.AtRecordingKeyframe && evt.Offset == resume.Offset)
+                    {
+                        _terminal.RestoreStateAtRecordedSize(evt.Data.Span);
+                    }
+                    _changedSinceKeyframe = false;
+                    break;
+            }
+
+            previousTime = evt.Time;
+        }
+
+        _resume = null;
+        _position = time == TimeSpan.MaxValue ? previousTime : time;
+    }
+
+    /// <summary>
+    /// Finds the index of the last keyframe at or before <paramref name="time"/>.
+    /// </summary>
+    private int FindKeyframe(TimeSpan time)
+    {
+        var lo = 0;
+        var hi = _keyframes.Count - 1;
+        var found = 0;
+        while (lo <= hi)
+        {
+            var mid = (lo + hi) >>> 1;
+            if (_keyframes[mid].Time <= time)
+            {
+                found = mid;
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+        return found;
+    }
+
+    private void Insert(Keyframe keyframe)
+    {
+        var index = FindKeyframe(keyframe.Time) + 1;
+        _keyframes.Insert(index, keyframe);
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        lock (_lock)
+        {
+            if (_disposed) return;
+            _disposed = true;
+        }
+
+        _terminal.Dispose();
+        if (_ownsReader)
+        {
+            _reader.Dispose();
+        }
+    }
+
+    /// <summary>
+    /// A point playback can start from: <see cref="State"/> is the screen at <see cref="Time"/>,
+    /// and playback continues with the record at <see cref="Offset"/>. Recording keyframes
+    /// have no state here, as it is the first record read from their offset.
+    /// </summary>
+    private sealed record Keyframe(TimeSpan Time, long Offset, byte[]? State);
+
+    private readonly record struct Resume(long Offset, TimeSpan Time, bool AtRecordingKeyframe);
+}
+
+/// <summary>
+/// Options for configuring the <see cref="Hex1bRecordingPlayer"/>.
+/// </summary>
+public sealed class Hex1bRecordingPlayerOptions
+{
+    /// <summary>
+    /// Longest stretch of recording the player will replay from one keyframe before keeping a
+    /// keyframe of its own, bounding how long a seek takes. Shorter intervals use more memory.
+    /// </summary>
+    public TimeSpan KeyframeInterval { get; set; } = TimeSpan.FromSeconds(10);
+}
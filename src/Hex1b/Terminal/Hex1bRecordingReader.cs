@@ -0,0 +1,382 @@
+using System.Buffers.Binary;
+using System.Text;
+
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Reads recordings written by <see cref="Hex1bRecorder"/>.
+/// </summary>
+/// <remarks>
+/// The keyframe index is read from the end of the file. Recordings that were not finished,
+/// such as one cut short by a crash, are scanned instead, and their events are read up to the
+/// last complete record.
+/// </remarks>
+public sealed class Hex1bRecordingReader : IDisposable
+{
+    private readonly Stream _stream;
+    private readonly bool _leaveOpen;
+    private readonly long _dataStart;
+    private readonly long _dataEnd;
+    private readonly List<Hex1bRecordingKeyframe> _keyframes = [];
+
+    /// <summary>
+    /// Opens a recording file.
+    /// </summary>
+    /// <param name="filePath">Path to the recording.</param>
+    /// <exception cref="InvalidDataException">The file is not a recording.</exception>
+    public static Hex1bRecordingReader Open(string filePath)
+    {
+        var stream = new FileStream(filePath, FileMode.Open, FileAccess.Read, FileShare.ReadWrite, bufferSize: 64 * 1024);
+        try
+        {
+            return new Hex1bRecordingReader(stream);
+        }
+        catch
+        {
+            stream.Dispose();
+            throw;
+        }
+    }
+
+    /// <summary>
+    /// Reads a recording from a seekable stream.
+    /// </summary>
+    /// <param name="stream">The recording. Must support seeking.</param>
+    /// <param name="leaveOpen">Whether to leave the stream open when the reader is disposed.</param>
+    /// <exception cref="InvalidDataException">The stream is not a recording.</exception>
+    public Hex1bRecordingReader(Stream stream, bool leaveOpen = false)
+    {
+        ArgumentNullException.ThrowIfNull(stream);
+        if (!stream.CanSeek)
+            throw new ArgumentException("The recording stream must support seeking.", nameof(stream));
+
+        _stream = stream;
+        _leaveOpen = leaveOpen;
+
+        stream.Position = 0;
+        Span<byte> magic = stackalloc byte[Hex1bRecordingFormat.Magic.Length + 1];
+        if (stream.ReadAtLeast(magic, magic.Length, throwOnEndOfStream: false) < magic.Length
+            || !magic[..^1].SequenceEqual(Hex1bRecordingFormat.Magic))
+            throw new InvalidDataException("Not a Hex1b recording.");
+        if (magic[^1] != Hex1bRecordingFormat.Version)
+            throw new InvalidDataException($"Unsupported recording version {magic[^1]}.");
+
+        Width = (int)ReadHeaderVarint();
+        Height = (int)ReadHeaderVarint();
+        StartTime = DateTimeOffset.FromUnixTimeMilliseconds((long)ReadHeaderVarint());
+        var titleLength = (int)ReadHeaderVarint();
+        var title = new byte[titleLength];
+        stream.ReadExactly(title);
+        Title = titleLength > 0 ? Encoding.UTF8.GetString(title) : null;
+        _dataStart = stream.Position;
+
+        if (TryReadIndex(out var indexOffset, out var duration))
+        {
+            _dataEnd = indexOffset;
+            Duration = duration;
+            IsComplete = true;
+        }
+        else
+        {
+            _dataEnd = stream.Length;
+        }
+
+        if (!IsComplete)
+        {
+            // Scan for keyframes; the last event's time is the duration
+            foreach (var evt in ReadEvents())
+            {
+                if (evt.Kind == Hex1bRecordingEventKind.Keyframe)
+                {
+                    _keyframes.Add(new Hex1bRecordingKeyframe(evt.Time, evt.Offset));
+                }
+                Duration = evt.Time;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Terminal width when the recording started.
+    /// </summary>
+    public int Width { get; }
+
+    /// <summary>
+    /// Terminal height when the recording started.
+    /// </summary>
+    public int Height { get; }
+
+    /// <summary>
+    /// When the recording started, to the millisecond.
+    /// </summary>
+    public DateTimeOffset StartTime { get; }
+
+    /// <summary>
+    /// Title of the recording, if it has one.
+    /// </summary>
+    public string? Title { get; }
+
+    /// <summary>
+    /// Time of the last event.
+    /// </summary>
+    public TimeSpan Duration { get; }
+
+    /// <summary>
+    /// Whether the recording was finished and has its index, rather than being cut short.
+    /// </summary>
+    public bool IsComplete { get; }
+
+    /// <summary>
+    /// The keyframes, in time order. The first is at the start of the recording.
+    /// </summary>
+    public IReadOnlyList<Hex1bRecordingKeyframe> Keyframes => _keyframes;
+
+    /// <summary>
+    /// Finds the last keyframe at or before <paramref name="time"/>.
+    /// </summary>
+    /// <returns>The keyframe, or null if the recording has none that early.</returns>
+    public Hex1bRecordingKeyframe? FindKeyframe(TimeSpan time)
+    {
+        var lo = 0;
+        var hi = _keyframes.Count - 1;
+        Hex1bRecordingKeyframe? found = null;
+        while (lo <= hi)
+        {
+            var mid = (lo + hi) >>> 1;
+            if (_keyframes[mid].Time <= time)
+            {
+                found = _keyframes[mid];
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+        return found;
+    }
+
+    /// <summary>
+    /// Reads the events from the start of the recording.
+    /// </summary>
+    public IEnumerable<Hex1bRecordingEvent> ReadEvents() => ReadEvents(_dataStart, TimeSpan.Zero, relativeFirst: true);
+
+    /// <summary>
+    /// Reads the events starting with <paramref name="keyframe"/> itself.
+    /// </summary>
+    /// <param name="keyframe">A keyframe from <see cref="Keyframes"/>.</param>
+    public IEnumerable<Hex1bRecordingEvent> ReadEvents(Hex1bRecordingKeyframe keyframe)
+    {
+        if (keyframe.Offset < _dataStart || keyframe.Offset >= _dataEnd)
+            throw new ArgumentOutOfRangeException(nameof(keyframe));
+        return ReadEvents(keyframe.Offset, keyframe.Time, relativeFirst: false);
+    }
+
+    /// <summary>
+    /// File offset of the first record.
+    /// </summary>
+    internal long DataStart => _dataStart;
+
+    /// <summary>
+    /// Reads the events starting with the record at <paramref name="offset"/>. The first
+    /// record's time is <paramref name="startTime"/> plus its delta when
+    /// <paramref name="relativeFirst"/> is set, as when <paramref name="startTime"/> is the
+    /// time of the record before it, and <paramref name="startTime"/> itself otherwise.
+    /// </summary>
+    internal IEnumerable<Hex1bRecordingEvent> ReadEvents(long offset, TimeSpan startTime, bool relativeFirst)
+    {
+        var header = new byte[Hex1bRecordingFormat.MaxRecordHeaderSize];
+        var microseconds = Hex1bRecordingFormat.ToMicroseconds(startTime);
+        var first = true;
+
+        while (offset < _dataEnd)
+        {
+            _stream.Position = offset;
+            var headerLength = _stream.ReadAtLeast(header, header.Length, throwOnEndOfStream: false);
+            var span = header.AsSpan(0, (int)Math.Min(headerLength, _dataEnd - offset));
+            if (span.Length < 3)
+                yield break;
+
+            var type = span[0];
+            if (!Hex1bRecordingFormat.TryReadVarint(span[1..], out var delta, out var deltaLength)
+                || !Hex1bRecordingFormat.TryReadVarint(span[(1 + deltaLength)..], out var length, out var lengthLength))
+                yield break;
+
+            var payloadOffset = offset + 1 + deltaLength + lengthLength;
+            if (length > (ulong)(_dataEnd - payloadOffset))
+                yield break; // Cut short
+
+            if (!first || relativeFirst)
+            {
+                microseconds += (long)delta;
+            }
+            first = false;
+
+            var payload = new byte[(int)length];
+            _stream.Position = payloadOffset;
+            _stream.ReadExactly(payload);
+
+            if (type != Hex1bRecordingFormat.RecordIndex)
+            {
+                yield return new Hex1bRecordingEvent(
+                    (Hex1bRecordingEventKind)type,
+                    Hex1bRecordingFormat.FromMicroseconds(microseconds),
+                    offset,
+                    payload);
+            }
+
+            offset = payloadOffset + (long)length;
+        }
+    }
+
+    private ulong ReadHeaderVarint()
+    {
+        Span<byte> bytes = stackalloc byte[Hex1bRecordingFormat.MaxVarintLength];
+        for (var i = 0; i < bytes.Length; i++)
+        {
+            var b = _stream.ReadByte();
+            if (b < 0)
+                throw new InvalidDataException("Recording header is truncated.");
+            bytes[i] = (byte)b;
+            if (b < 0x80)
+            {
+                Hex1bRecordingFormat.TryReadVarint(bytes[..(i + 1)], out var value, out _);
+                return value;
+            }
+        }
+        throw new InvalidDataException("Recording header is corrupt.");
+    }
+
+    private bool TryReadIndex(out long indexOffset, out TimeSpan duration)
+    {
+        indexOffset = 0;
+        duration = TimeSpan.Zero;
+        var length = _stream.Length;
+        if (length - _dataStart < Hex1bRecordingFormat.TrailerSize)
+            return false;
+
+        Span<byte> trailer = stackalloc byte[Hex1bRecordingFormat.TrailerSize];
+        _stream.Position = length - Hex1bRecordingFormat.TrailerSize;
+        _stream.ReadExactly(trailer);
+        if (!trailer[8..].SequenceEqual(Hex1bRecordingFormat.TrailerMagic))
+            return false;
+
+        indexOffset = BinaryPrimitives.ReadInt64LittleEndian(trailer);
+        if (indexOffset < _dataStart || indexOffset >= length - Hex1bRecordingFormat.TrailerSize)
+            return false;
+
+        var indexLength = (int)(length - Hex1bRecordingFormat.TrailerSize - indexOffset);
+        var index = new byte[indexLength];
+        _stream.Position = indexOffset;
+        _stream.ReadExactly(index);
+
+        // Index record: type, time delta and payload length, then the duration and the entries
+        var span = index.AsSpan();
+        if (span[0] != Hex1bRecordingFormat.RecordIndex)
+            return false;
+        span = span[1..];
+        for (var field = 0; field < 2; field++)
+        {
+            if (!Hex1bRecordingFormat.TryReadVarint(span, out _, out var skipped))
+                return false;
+            span = span[skipped..];
+        }
+        if (!Hex1bRecordingFormat.TryReadVarint(span, out var durationMicroseconds, out var consumed))
+            return false;
+        span = span[consumed..];
+        if (!Hex1bRecordingFormat.TryReadVarint(span, out var count, out consumed))
+            return false;
+        span = span[consumed..];
+
+        var keyframes = new List<Hex1bRecordingKeyframe>();
+        for (ulong i = 0; i < count; i++)
+        {
+            if (!Hex1bRecordingFormat.TryReadVarint(span, out var keyframeTime, out consumed))
+                return false;
+            span = span[consumed..];
+            if (!Hex1bRecordingFormat.TryReadVarint(span, out var keyframeOffset, out consumed))
+                return false;
+            span = span[consumed..];
+
+            keyframes.Add(new Hex1bRecordingKeyframe(
+                Hex1bRecordingFormat.FromMicroseconds((long)keyframeTime),
+                (long)keyframeOffset));
+        }
+
+        _keyframes.AddRange(keyframes);
+        duration = Hex1bRecordingFormat.FromMicroseconds((long)durationMicroseconds);
+        return true;
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        if (!_leaveOpen)
+        {
+            _stream.Dispose();
+        }
+    }
+}
+
+/// <summary>
+/// A keyframe in a recording: the full screen state at <see cref="Time"/>.
+/// </summary>
+/// <param name="Time">Time of the keyframe since the recording started.</param>
+/// <param name="Offset">File offset of the keyframe record.</param>
+public readonly record struct Hex1bRecordingKeyframe(TimeSpan Time, long Offset);
+
+/// <summary>
+/// The kinds of event in a recording.
+/// </summary>
+public enum Hex1bRecordingEventKind : byte
+{
+    /// <summary>Raw workload output.</summary>
+    Output = Hex1bRecordingFormat.RecordOutput,
+
+    /// <summary>Raw input sent to the workload.</summary>
+    Input = Hex1bRecordingFormat.RecordInput,
+
+    /// <summary>The terminal was resized; see <see cref="Hex1bRecordingEvent.GetSize"/>.</summary>
+    Resize = Hex1bRecordingFormat.RecordResize,
+
+    /// <summary>A marker; see <see cref="Hex1bRecordingEvent.GetText"/>.</summary>
+    Marker = Hex1bRecordingFormat.RecordMarker,
+
+    /// <summary>A <see cref="Hex1bTerminal.SaveState"/> snapshot of the screen after all earlier events.</summary>
+    Keyframe = Hex1bRecordingFormat.RecordKeyframe,
+}
+
+/// <summary>
+/// An event read from a recording.
+/// </summary>
+/// <param name="Kind">What the event is.</param>
+/// <param name="Time">Time of the event since the recording started.</param>
+/// <param name="Offset">File offset of the event's record.</param>
+/// <param name="Data">The event's payload.</param>
+public readonly record struct Hex1bRecordingEvent(
+    Hex1bRecordingEventKind Kind,
+    TimeSpan Time,
+    long Offset,
+    ReadOnlyMemory<byte> Data)
+{
+    /// <summary>
+    /// Decodes a marker label, or output or input that is known to be complete UTF-8.
+    /// </summary>
+    public string GetText() => Encoding.UTF8.GetString(Data.Span);
+
+    /// <summary>
+    /// Gets the new size of a <see cref="Hex1bRecordingEventKind.Resize"/> event.
+    /// </summary>
+    /// <exception cref="InvalidOperationException">The event is not a resize.</exception>
+    /// <exception cref="InvalidDataException">The payload is corrupt.</exception>
+    public (int Width, int Height) GetSize()
+    {
+        if (Kind != Hex1bRecordingEventKind.Resize)
+            throw new InvalidOperationException("Only resize events have a size.");
+
+        var span = Data.Span;
+        if (!Hex1bRecordingFormat.TryReadVarint(span, out var width, out var consumed)
+            || !Hex1bRecordingFormat.TryReadVarint(span[consumed..], out var height, out _))
+            throw new InvalidDataException("Resize event is corrupt.");
+        return ((int)width, (int)height);
+    }
+}
@@ -1,6 +1,7 @@
 #pragma warning disable HEX1B_SIXEL // Sixel API is experimental - internal usage is allowed
 
-using System.Globalization;
+using System.Buffers;
+using System.IO.Compression;
 using System.Text;
 using System.Threading.Channels;
 using Hex1b.Input;
@@ -71,13 +72,46 @@ public sealed class Hex1bTerminal : IDisposable
     private Hex1bColor? _currentBackground;
     private CellAttributes _currentAttributes;
     private TrackedObject<HyperlinkData>? _currentHyperlink; // Active hyperlink from OSC 8
+    private TrackedObject<HyperlinkData>? _releasedHyperlink; // Released by a run of cells, see ReleaseHyperlink
+    private int _releasedHyperlinkCount;
     private bool _disposed;
     private bool _inAlternateScreen;
     private Task? _inputProcessingTask;
+    private static readonly TimeSpan PendingInputTimeout = TimeSpan.FromMilliseconds(50);
+    private readonly TerminalInputDecoder _inputDecoder = new();
+    private readonly List<Hex1bEvent> _decodedInput = new();
     private Task? _outputProcessingTask;
+    
+    // Frame skipping: when a presentation filter can collapse frames, output is handed to a
+    // separate send loop so the output pump never waits on a slow presentation.
+    private readonly IHex1bTerminalFrameSkippingFilter? _frameSkippingFilter;
+    private readonly int _frameSkippingFilterIndex = -1;
+    private readonly object _presentationOutputLock = new();
+    private ArrayBufferWriter<byte> _presentationOutput = new();
+    private ArrayBufferWriter<byte> _presentationSending = new();
+    private readonly SemaphoreSlim _presentationOutputReady = new(0);
+    private Task? _presentationSendTask;
+    private volatile bool _presentationOutputCompleting; // Set on dispose: drain, then stop
+    private static readonly TimeSpan PresentationDrainTimeout = TimeSpan.FromSeconds(1);
     private long _writeSequence; // Monotonically increasing write order counter
     private int _savedCursorX; // Saved cursor X position for DECSC/DECRC
     private int _savedCursorY; // Saved cursor Y position for DECSC/DECRC
+    
+    // Kitty graphics: placements by image and placement ID, and a chunked upload in progress.
+    // Placements without an ID are each kept separately, under IDs counting down from the top.
+    private readonly Dictionary<(uint ImageId, uint PlacementId), KittyPlacement> _kittyPlacements = new();
+    private KittyTransmission? _kittyTransmission;
+    
+    // Kitty uploads bigger than this are dropped, so workload output can't exhaust memory
+    private const int MaxKittyImageBytes = 64 * 1024 * 1024;
+    private const int MaxKittyTransmissionLength = (MaxKittyImageBytes + 2) / 3 * 4;
+    private uint _nextAnonymousKittyPlacementId = uint.MaxValue;
+    
+    // Hibernation: the screen buffer is released and the state kept as a snapshot,
+    // in memory or in a file, until the terminal is next used
+    private volatile bool _hibernated;
+    private byte[]? _hibernatedState;
+    private string? _hibernationPath;
 
 
 
@@ -132,6 +166,24 @@ public sealed class Hex1bTerminal : IDisposable
         _workloadFilters = workloadFilters?.ToList() ?? [];
         _presentationFilters = presentationFilters?.ToList() ?? [];
         _timeProvider = timeProvider ?? TimeProvider.System;
+        
+        foreach (var filter in _workloadFilters)
+        {
+            if (filter is IHex1bTerminalRecordingFilter recordingFilter)
+            {
+                recordingFilter.AttachTerminal(this);
+            }
+        }
+        
+        for (var i = 0; i < _presentationFilters.Count; i++)
+        {
+            if (_presentationFilters[i] is IHex1bTerminalFrameSkippingFilter frameSkippingFilter)
+            {
+                _frameSkippingFilter = frameSkippingFilter;
+                _frameSkippingFilterIndex = i;
+                break;
+            }
+        }
         _sessionStart = _timeProvider.GetUtcNow();
         
         // Get dimensions from presentation if available, otherwise use provided dimensions
@@ -228,6 +280,12 @@ public sealed class Hex1bTerminal : IDisposable
         {
             _outputProcessingTask = Task.Run(() => PumpWorkloadOutputAsync(_disposeCts.Token));
         }
+
+        // Start the send loop that lets the frame skipping filter collapse frames
+        if (_presentation != null && _frameSkippingFilter != null && _presentationSendTask == null)
+        {
+            _presentationSendTask = Task.Run(() => PumpPresentationOutputAsync(_disposeCts.Token));
+        }
     }
 
     /// <summary>
@@ -243,6 +301,8 @@ public sealed class Hex1bTerminal : IDisposable
     /// </remarks>
     internal void FlushOutput()
     {
+        Wake();
+
         if (_workload is not Hex1bAppWorkloadAdapter appWorkload)
             return;
 
@@ -264,7 +324,7 @@ public sealed class Hex1bTerminal : IDisposable
             var tokens = AnsiTokenizer.Tokenize(text);
             
             // Notify workload filters (fire-and-forget in sync context)
-            _ = NotifyWorkloadFiltersOutputAsync(tokens);
+            _ = NotifyWorkloadFiltersOutputAsync(data, tokens);
             
             // Apply tokens to buffer
             ApplyTokens(tokens);
@@ -282,12 +342,31 @@ public sealed class Hex1bTerminal : IDisposable
         {
             while (!ct.IsCancellationRequested && _presentation != null)
             {
-                var data = await _presentation.ReadInputAsync(ct);
+                var read = _presentation.ReadInputAsync(ct);
+                if (!read.IsCompleted && _inputDecoder.HasPendingInput && !_inputDecoder.InPaste
+                    && _workload is Hex1bAppWorkloadAdapter pendingWorkload)
+                {
+                    // Input ended in a lone ESC (or a partial sequence). If nothing follows
+                    // soon it was the Escape key rather than the start of a split sequence.
+                    // Inside a paste it can only be the start of the end marker, so wait for it.
+                    var readTask = read.AsTask();
+                    if (await Task.WhenAny(readTask, Task.Delay(PendingInputTimeout, _timeProvider, ct)) != readTask)
+                    {
+                        _inputDecoder.Flush(_decodedInput);
+                        DispatchDecodedInput(pendingWorkload);
+                    }
+                    read = new ValueTask<ReadOnlyMemory<byte>>(readTask);
+                }
+
+                var data = await read;
                 if (data.IsEmpty)
                 {
                     break;
                 }
 
+                // Input is the usual sign a hibernated session is wanted again
+                Wake();
+
                 // Notify presentation filters of input FROM presentation
                 await NotifyPresentationFiltersInputAsync(data);
 
@@ -297,7 +376,7 @@ public sealed class Hex1bTerminal : IDisposable
                 // For Hex1bAppWorkloadAdapter, we parse input and send events directly
                 if (_workload is Hex1bAppWorkloadAdapter appWorkload)
                 {
-                    await ParseAndDispatchInputAsync(data, appWorkload, ct);
+                    DecodeAndDispatchInput(data.Span, appWorkload);
                 }
                 else
                 {
@@ -314,6 +393,10 @@ public sealed class Hex1bTerminal : IDisposable
 
     private async Task PumpWorkloadOutputAsync(CancellationToken ct)
     {
+        // Presentation output is flushed once per frame rather than once per chunk, so
+        // adapters that batch (like the console) can emit a whole frame in one write.
+        var presentationDirty = false;
+        
         try
         {
             while (!ct.IsCancellationRequested)
@@ -322,6 +405,16 @@ public sealed class Hex1bTerminal : IDisposable
                 if (data.IsEmpty)
                 {
                     // Channel empty - this is a frame boundary
+                    if (_presentationSendTask != null)
+                    {
+                        SignalPresentationOutput();
+                    }
+                    else if (presentationDirty && _presentation != null)
+                    {
+                        presentationDirty = false;
+                        await _presentation.FlushAsync(ct);
+                    }
+                    
                     await NotifyWorkloadFiltersFrameCompleteAsync();
                     
                     // Small delay to prevent busy-waiting in headless mode
@@ -334,7 +427,7 @@ public sealed class Hex1bTerminal : IDisposable
                 var tokens = AnsiTokenizer.Tokenize(text);
                 
                 // Notify workload filters with tokens
-                await NotifyWorkloadFiltersOutputAsync(tokens);
+                await NotifyWorkloadFiltersOutputAsync(data, tokens);
                 
                 // Apply tokens to our internal buffer and collect cell impacts
                 var appliedTokens = ApplyTokensWithImpacts(tokens);
@@ -345,9 +438,42 @@ public sealed class Hex1bTerminal : IDisposable
                     // Pass through presentation filters, serialize and send
                     var filteredTokens = await NotifyPresentationFiltersOutputAsync(appliedTokens);
                     var filteredText = AnsiTokenSerializer.Serialize(filteredTokens);
-                    var filteredBytes = Encoding.UTF8.GetBytes(filteredText);
                     
-                    await _presentation.WriteOutputAsync(filteredBytes);
+                    if (_presentationSendTask != null)
+                    {
+                        // Queue for the send loop; while it is busy the filter collapses frames,
+                        // so this holds at most the output produced between two sends.
+                        lock (_presentationOutputLock)
+                        {
+                            Encoding.UTF8.GetBytes(filteredText, _presentationOutput);
+                        }
+                        
+                        if (_workload is not IHex1bAppTerminalWorkloadAdapter { OutputQueueDepth: > 0 })
+                        {
+                            SignalPresentationOutput();
+                        }
+                    }
+                    else
+                    {
+                        var filteredBytes = Encoding.UTF8.GetBytes(filteredText);
+                        await _presentation.WriteOutputAsync(filteredBytes);
+                        presentationDirty = true;
+                        
+                        // App workloads block instead of returning empty reads, so treat an
+                        // empty output queue as the end of the frame.
+                        if (_workload is not IHex1bAppTerminalWorkloadAdapter { OutputQueueDepth: > 0 })
+                        {
+                            presentationDirty = false;
+                            await _presentation.FlushAsync(ct);
+                        }
+                    }
+                }
+                
+                // The same frame boundary for workload filters; without it a recorder behind an
+                // app workload would never write keyframes or flush
+                if (_workload is IHex1bAppTerminalWorkloadAdapter { OutputQueueDepth: 0 })
+                {
+                    await NotifyWorkloadFiltersFrameCompleteAsync();
                 }
             }
         }
@@ -357,88 +483,140 @@ public sealed class Hex1bTerminal : IDisposable
         }
     }
 
-    private async Task ParseAndDispatchInputAsync(ReadOnlyMemory<byte> data, Hex1bAppWorkloadAdapter workload, CancellationToken ct)
+    /// <summary>
+    /// Sends queued output to the presentation. Each send defers the frame skipping filter;
+    /// when the send completes, the latest complete frame is sent as a single diff.
+    /// </summary>
+    private async Task PumpPresentationOutputAsync(CancellationToken ct)
     {
-        var message = Encoding.UTF8.GetString(data.Span);
-        var i = 0;
-
-        while (i < message.Length && !ct.IsCancellationRequested)
+        try
         {
-            // Check for DA1 response
-            if (TryParseDA1Response(message, i, out var da1Consumed))
-            {
-                i += da1Consumed;
-                continue;
-            }
-
-            // Check for ANSI escape sequence
-            if (message[i] == '\x1b' && i + 1 < message.Length)
+            while (!ct.IsCancellationRequested)
             {
-                if (message[i + 1] == '[')
-                {
-                    // CSI sequence
-                    if (i + 2 < message.Length && message[i + 2] == '<')
-                    {
-                        var (mouseEvent, mouseConsumed) = ParseSgrMouseSequence(message, i);
-                        if (mouseEvent != null)
-                        {
-                            await workload.WriteInputEventAsync(mouseEvent, ct);
-                            i += mouseConsumed;
-                            continue;
-                        }
-                    }
-
-                    var (csiEvent, csiConsumed) = ParseCsiSequence(message, i);
-                    if (csiEvent != null)
-                    {
-                        await workload.WriteInputEventAsync(csiEvent, ct);
-                    }
-                    i += csiConsumed;
-                }
-                else if (message[i + 1] == 'O')
+                await _presentationOutputReady.WaitAsync(ct);
+                
+                while (await SendPresentationOutputAsync(ct))
                 {
-                    var (ss3Event, ss3Consumed) = ParseSS3Sequence(message, i);
-                    if (ss3Event != null)
-                    {
-                        await workload.WriteInputEventAsync(ss3Event, ct);
-                    }
-                    i += ss3Consumed;
                 }
-                else
+                
+                if (_presentationOutputCompleting)
                 {
-                    // ESC followed by a printable character = Alt+key combination
-                    // For example: ESC f = Alt+F, ESC 1 = Alt+1
-                    var nextChar = message[i + 1];
-                    var altKeyEvent = ParseAltKeyInput(nextChar);
-                    if (altKeyEvent != null)
-                    {
-                        await workload.WriteInputEventAsync(altKeyEvent, ct);
-                        i += 2; // Consume both ESC and the following character
-                    }
-                    else
-                    {
-                        // Unknown escape sequence, just emit Escape
-                        await workload.WriteInputEventAsync(
-                            new Hex1bKeyEvent(Hex1bKey.Escape, '\x1b', Hex1bModifiers.None), ct);
-                        i++;
-                    }
+                    break;
                 }
             }
-            else if (char.IsHighSurrogate(message[i]) && i + 1 < message.Length && char.IsLowSurrogate(message[i + 1]))
-            {
-                var text = message.Substring(i, 2);
-                await workload.WriteInputEventAsync(Hex1bKeyEvent.FromText(text), ct);
-                i += 2;
-            }
-            else
+        }
+        catch (OperationCanceledException)
+        {
+            // Normal shutdown
+        }
+    }
+
+    /// <summary>
+    /// Sends queued output or the deferred frame, if any.
+    /// </summary>
+    /// <returns>True if there may be more to send.</returns>
+    private async ValueTask<bool> SendPresentationOutputAsync(CancellationToken ct)
+    {
+        var filter = _frameSkippingFilter!;
+        
+        lock (_presentationOutputLock)
+        {
+            // Deferred before the swap, so output filtered from here on is collapsed into the
+            // next frame instead of queued behind bytes that are already being sent
+            if (_presentationOutput.WrittenCount > 0)
             {
-                var keyEvent = ParseKeyInput(message[i]);
-                if (keyEvent != null)
-                {
-                    await workload.WriteInputEventAsync(keyEvent, ct);
-                }
-                i++;
+                filter.BeginDeferral();
             }
+            (_presentationOutput, _presentationSending) = (_presentationSending, _presentationOutput);
+        }
+        
+        if (_presentationSending.WrittenCount > 0)
+        {
+            // Queued bytes were produced before the filter was deferred, so they go first
+            await _presentation!.WriteOutputAsync(_presentationSending.WrittenMemory, ct);
+            await _presentation.FlushAsync(ct);
+            _presentationSending.ResetWrittenCount();
+            return true;
+        }
+        
+        if (filter.TakeDeferredFrame(out var tokens) != DeferredFrameStatus.Ready)
+        {
+            return false;
+        }
+        
+        if (tokens.Count > 0)
+        {
+            // Filters after the frame skipping one still see everything that is sent
+            tokens = await NotifyPresentationFiltersOutputAsync(tokens, _frameSkippingFilterIndex + 1, ct);
+            var bytes = Encoding.UTF8.GetBytes(AnsiTokenSerializer.Serialize(tokens));
+            await _presentation!.WriteOutputAsync(bytes, ct);
+            await _presentation.FlushAsync(ct);
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// Lets the send loop write out the queued output and the last deferred frame, then stop,
+    /// so the presentation has the final screen before it leaves TUI mode.
+    /// </summary>
+    private async ValueTask CompletePresentationOutputAsync()
+    {
+        if (_presentationSendTask == null)
+            return;
+
+        _presentationOutputCompleting = true;
+        SignalPresentationOutput();
+        try
+        {
+            await _presentationSendTask.WaitAsync(PresentationDrainTimeout);
+        }
+        catch (Exception)
+        {
+            // A presentation that has failed or stopped reading doesn't hold up disposal
+        }
+    }
+
+    private void CompletePresentationOutput()
+    {
+        if (_presentationSendTask == null)
+            return;
+
+        _presentationOutputCompleting = true;
+        SignalPresentationOutput();
+        try
+        {
+            _presentationSendTask.Wait(PresentationDrainTimeout);
+        }
+        catch (AggregateException)
+        {
+            // A presentation that has failed doesn't hold up disposal
+        }
+    }
+
+    private void SignalPresentationOutput()
+    {
+        // One pending signal is enough; the send loop drains everything it finds
+        if (_presentationOutputReady.CurrentCount == 0)
+        {
+            _presentationOutputReady.Release();
+        }
+    }
+
+    /// <summary>
+    /// Decodes presentation input into events and hands them to the app in one batch.
+    /// </summary>
+    private void DecodeAndDispatchInput(ReadOnlySpan<byte> data, Hex1bAppWorkloadAdapter workload)
+    {
+        _inputDecoder.Decode(data, _decodedInput);
+        DispatchDecodedInput(workload);
+    }
+
+    private void DispatchDecodedInput(Hex1bAppWorkloadAdapter workload)
+    {
+        if (_decodedInput.Count > 0)
+        {
+            workload.WriteInputEvents(_decodedInput);
+            _decodedInput.Clear();
         }
     }
 
@@ -681,6 +859,8 @@ public sealed class Hex1bTerminal : IDisposable
     {
         lock (_bufferLock)
         {
+            WakeLocked();
+            
             var newBuffer = new TerminalCell[newHeight, newWidth];
             
             // Initialize with empty cells
@@ -714,8 +894,10 @@ public sealed class Hex1bTerminal : IDisposable
                         continue;
                         
                     _screenBuffer[y, x].TrackedSixel?.Release();
+                    ReleaseHyperlink(_screenBuffer[y, x].TrackedHyperlink);
                 }
             }
+            EndTrackedObjectBatch();
 
             _screenBuffer = newBuffer;
             _width = newWidth;
@@ -725,35 +907,296 @@ public sealed class Hex1bTerminal : IDisposable
         }
     }
 
+    // === Hibernation ===
+
+    /// <summary>
+    /// Gets whether the terminal is hibernated.
+    /// </summary>
+    public bool IsHibernated => _hibernated;
+
+    /// <summary>
+    /// Captures the screen cells, cursor, modes and the hyperlinks and Sixel images they
+    /// reference as a compact binary snapshot.
+    /// </summary>
+    /// <remarks>
+    /// Cell timestamps are not captured.
+    /// </remarks>
+    public byte[] SaveState()
+    {
+        FlushOutput();
+        return CaptureState();
+    }
+
+    /// <summary>
+    /// Snapshots the state as of the output applied so far, without draining pending output.
+    /// </summary>
+    internal byte[] CaptureState()
+    {
+        lock (_bufferLock)
+        {
+            WakeLocked();
+            var output = new ArrayBufferWriter<byte>();
+            TerminalStateSerializer.Write(output, _screenBuffer, CaptureStateFields());
+            return output.WrittenSpan.ToArray();
+        }
+    }
+
+    /// <summary>
+    /// Replaces the screen state with a snapshot taken by <see cref="SaveState"/>.
+    /// Content that does not fit the terminal's current size is dropped.
+    /// </summary>
+    /// <param name="state">The snapshot.</param>
+    /// <exception cref="InvalidDataException">The snapshot is invalid.</exception>
+    public void RestoreState(ReadOnlySpan<byte> state)
+    {
+        lock (_bufferLock)
+        {
+            DiscardHibernatedState();
+            RestoreStateLocked(state);
+        }
+    }
+
+    /// <summary>
+    /// Replaces the screen state with a snapshot and takes on the snapshot's size, as when
+    /// replaying a recording that was resized.
+    /// </summary>
+    internal void RestoreStateAtRecordedSize(ReadOnlySpan<byte> state)
+    {
+        lock (_bufferLock)
+        {
+            DiscardHibernatedState();
+            RestoreStateLocked(state, keepSize: false);
+        }
+    }
+
+    /// <summary>
+    /// Saves the terminal's state and releases its screen buffer and the tracked objects it
+    /// references. The state is restored the next time the terminal receives input, processes
+    /// output or is read, or when <see cref="Wake"/> is called.
+    /// </summary>
+    /// <param name="path">
+    /// A file to write the snapshot to, so it does not stay in memory. The file is deleted when
+    /// the terminal wakes or is disposed. When null the snapshot is kept in memory.
+    /// </param>
+    public void Hibernate(string? path = null)
+    {
+        FlushOutput();
+        lock (_bufferLock)
+        {
+            if (_hibernated || _disposed)
+                return;
+
+            var output = new ArrayBufferWriter<byte>();
+            TerminalStateSerializer.Write(output, _screenBuffer, CaptureStateFields());
+
+            if (path != null)
+            {
+                using (var file = File.Create(path))
+                {
+                    file.Write(output.WrittenSpan);
+                }
+                _hibernationPath = path;
+            }
+            else
+            {
+                _hibernatedState = output.WrittenSpan.ToArray();
+            }
+
+            ReleaseScreenBuffer();
+            _hibernated = true;
+        }
+    }
+
+    /// <summary>
+    /// Restores a hibernated terminal. Does nothing if the terminal is not hibernated.
+    /// </summary>
+    public void Wake()
+    {
+        if (!_hibernated)
+            return;
+
+        lock (_bufferLock)
+        {
+            WakeLocked();
+        }
+    }
+
+    private void WakeLocked()
+    {
+        if (!_hibernated)
+            return;
+
+        byte[] state;
+        if (_hibernationPath != null)
+        {
+            state = File.ReadAllBytes(_hibernationPath);
+        }
+        else
+        {
+            state = _hibernatedState!;
+        }
+
+        DiscardHibernatedState();
+        RestoreStateLocked(state);
+    }
+
+    private void DiscardHibernatedState()
+    {
+        if (_hibernationPath != null)
+        {
+            try
+            {
+                File.Delete(_hibernationPath);
+            }
+            catch (IOException)
+            {
+                // Best effort - the snapshot is no longer needed
+            }
+            _hibernationPath = null;
+        }
+
+        _hibernatedState = null;
+        _hibernated = false;
+    }
+
+    private void DiscardHibernationOnDispose()
+    {
+        lock (_bufferLock)
+        {
+            if (!_hibernated)
+                return;
+
+            // Nothing will wake the terminal again; leave it empty rather than half-released
+            DiscardHibernatedState();
+            _width = 0;
+            _height = 0;
+        }
+    }
+
+    private TerminalStateFields CaptureStateFields() => new(
+        _cursorX, _cursorY, _savedCursorX, _savedCursorY, _inAlternateScreen,
+        _currentForeground, _currentBackground, _currentAttributes, _currentHyperlink, _writeSequence);
+
+    private void RestoreStateLocked(ReadOnlySpan<byte> state, bool keepSize = true)
+    {
+        var cells = TerminalStateSerializer.Read(state, _trackedObjects, out var fields);
+
+        // Release what the current buffer references before replacing it
+        ReleaseScreenBuffer();
+
+        var (width, height) = (_width, _height);
+        _screenBuffer = cells;
+        _width = cells.GetLength(1);
+        _height = cells.GetLength(0);
+        _cursorX = fields.CursorX;
+        _cursorY = fields.CursorY;
+        _savedCursorX = fields.SavedCursorX;
+        _savedCursorY = fields.SavedCursorY;
+        _inAlternateScreen = fields.InAlternateScreen;
+        _currentForeground = fields.Foreground;
+        _currentBackground = fields.Background;
+        _currentAttributes = fields.Attributes;
+        _currentHyperlink = fields.Hyperlink;
+        _writeSequence = fields.WriteSequence;
+
+        if (keepSize && (_width != width || _height != height))
+        {
+            Resize(width, height);
+        }
+    }
+
+    private void ReleaseScreenBuffer()
+    {
+        foreach (var cell in _screenBuffer)
+        {
+            cell.TrackedSixel?.Release();
+            ReleaseHyperlink(cell.TrackedHyperlink);
+        }
+
+        ReleaseHyperlink(_currentHyperlink);
+        _currentHyperlink = null;
+        _screenBuffer = new TerminalCell[0, 0];
+        EndTrackedObjectBatch();
+    }
+
+    /// <summary>
+    /// Releases a cell's reference to a hyperlink. Releases are batched: consecutive cells
+    /// dropping the same link (a link overwritten or scrolled away) release it with one
+    /// update when the run ends or at <see cref="EndTrackedObjectBatch"/>. Holding on to the
+    /// references a little longer never frees a link early.
+    /// </summary>
+    private void ReleaseHyperlink(TrackedObject<HyperlinkData>? hyperlink)
+    {
+        if (hyperlink is null)
+            return;
+
+        if (!ReferenceEquals(hyperlink, _releasedHyperlink))
+        {
+            ReleasePendingHyperlinkRefs();
+            _releasedHyperlink = hyperlink;
+        }
+        _releasedHyperlinkCount++;
+    }
+
+    private void ReleasePendingHyperlinkRefs()
+    {
+        if (_releasedHyperlink is not null)
+        {
+            _releasedHyperlink.Release(_releasedHyperlinkCount);
+            _releasedHyperlink = null;
+            _releasedHyperlinkCount = 0;
+        }
+    }
+
+    /// <summary>
+    /// Finishes a batch of changes to the screen buffer: applies the batched hyperlink releases
+    /// and lets the store remove the objects no cell references any more.
+    /// </summary>
+    private void EndTrackedObjectBatch()
+    {
+        ReleasePendingHyperlinkRefs();
+        _trackedObjects.Reclaim();
+    }
+
     // === Screen Buffer Parsing ===
 
     /// <summary>
     /// Sets a cell in the screen buffer, properly managing tracked object references.
-    /// Releases the old cell's tracked object (if any) and adds a reference for the new one (if any).
+    /// Releases the old cell's tracked objects (if any). A hyperlink the old cell already held
+    /// carries its reference over to the new cell.
     /// </summary>
     /// <param name="y">The row position (0-based).</param>
     /// <param name="x">The column position (0-based).</param>
     /// <param name="newCell">The new cell value.</param>
     /// <param name="impacts">Optional list to record the cell impact for delta tracking.</param>
-    private void SetCell(int y, int x, TerminalCell newCell, List<CellImpact>? impacts = null)
+    /// <returns>
+    /// True if the new cell's hyperlink needs a reference from the caller: it has one and the
+    /// old cell didn't hold the same one.
+    /// </returns>
+    private bool SetCell(int y, int x, TerminalCell newCell, List<CellImpact>? impacts = null)
     {
         ref var oldCell = ref _screenBuffer[y, x];
         
         // Release old Sixel data reference
         oldCell.TrackedSixel?.Release();
         
-        // Release old hyperlink data reference
-        oldCell.TrackedHyperlink?.Release();
+        // Rewriting a cell with the link it already has (the usual case when a frame is
+        // re-rendered) keeps the reference it holds
+        var linkNeedsRef = false;
+        if (!ReferenceEquals(oldCell.TrackedHyperlink, newCell.TrackedHyperlink))
+        {
+            ReleaseHyperlink(oldCell.TrackedHyperlink);
+            linkNeedsRef = newCell.TrackedHyperlink is not null;
+        }
         
-        // Note: new cell's tracked object already has a reference from GetOrCreateSixel/GetOrCreateHyperlink
-        // or was explicitly AddRef'd by the caller before creating the cell
-        // No need to AddRef here - the caller is responsible for getting the object
-        // with the correct refcount
+        // Note: new cell's Sixel already has a reference from GetOrCreateSixel, and the
+        // caller adds the hyperlink references this reports for a whole run of cells at once
         
         oldCell = newCell;
         
         // Record the impact if tracking is enabled
         impacts?.Add(new CellImpact(x, y, newCell));
+        return linkNeedsRef;
     }
 
     /// <summary>
@@ -775,7 +1218,24 @@ public sealed class Hex1bTerminal : IDisposable
     /// Gets the number of tracked hyperlink objects in the store.
     /// Useful for testing to verify cleanup behavior.
     /// </summary>
-    internal int TrackedHyperlinkCount => _trackedObjects.HyperlinkCount;
+    internal int TrackedHyperlinkCount => _trackedObjects.HyperlinkCount;
+
+    /// <summary>
+    /// Gets the number of kitty graphics images uploaded and not yet freed.
+    /// </summary>
+    internal int KittyImageCount => _trackedObjects.KittyImageCount;
+
+    /// <summary>
+    /// Gets the kitty graphics placements on the screen.
+    /// </summary>
+    internal IReadOnlyList<KittyPlacement> GetKittyPlacements()
+    {
+        FlushOutput();
+        lock (_bufferLock)
+        {
+            return [.. _kittyPlacements.Values];
+        }
+    }
 
     /// <summary>
     /// Gets the Sixel data at the specified cell position, if any.
@@ -886,10 +1346,14 @@ public sealed class Hex1bTerminal : IDisposable
     {
         lock (_bufferLock)
         {
+            WakeLocked();
+            
             foreach (var token in tokens)
             {
                 ApplyToken(token, null);
             }
+            
+            EndTrackedObjectBatch();
         }
     }
 
@@ -907,6 +1371,8 @@ public sealed class Hex1bTerminal : IDisposable
     {
         lock (_bufferLock)
         {
+            WakeLocked();
+            
             var result = new List<AppliedToken>(tokens.Count);
             
             foreach (var token in tokens)
@@ -924,6 +1390,7 @@ public sealed class Hex1bTerminal : IDisposable
                     _cursorX, _cursorY));
             }
             
+            EndTrackedObjectBatch();
             return result;
         }
     }
@@ -980,6 +1447,10 @@ public sealed class Hex1bTerminal : IDisposable
                 ProcessSixelData(dcsToken.Payload, impacts);
                 break;
                 
+            case KittyGraphicsToken kittyToken:
+                ProcessKittyGraphics(kittyToken);
+                break;
+                
             case ScrollRegionToken scrollRegionToken:
                 // Store scroll region for future scroll operations
                 // Not yet implemented in ProcessOutput either
@@ -1008,12 +1479,14 @@ public sealed class Hex1bTerminal : IDisposable
     private void ApplyTextToken(TextToken token, List<CellImpact>? impacts)
     {
         var text = token.Text;
-        int i = 0;
         
-        while (i < text.Length)
+        // Cells newly taking the current hyperlink; referenced once per row instead of per cell.
+        // The terminal's own reference keeps the link alive until then.
+        var linkedCells = 0;
+        
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes(text))
         {
-            var grapheme = GetGraphemeAt(text, i);
-            var graphemeWidth = DisplayWidth.GetGraphemeWidth(grapheme);
+            var graphemeWidth = cluster.Width;
             
             // Scroll if cursor is past the bottom of the screen BEFORE writing
             if (_cursorY >= _height)
@@ -1027,18 +1500,21 @@ public sealed class Hex1bTerminal : IDisposable
                 var sequence = ++_writeSequence;
                 var writtenAt = _timeProvider.GetUtcNow();
                 
-                _currentHyperlink?.AddRef();
-                
-                SetCell(_cursorY, _cursorX, new TerminalCell(
-                    grapheme, _currentForeground, _currentBackground, _currentAttributes,
-                    sequence, writtenAt, TrackedSixel: null, _currentHyperlink), impacts);
+                if (SetCell(_cursorY, _cursorX, new TerminalCell(
+                    GetCellText(text, cluster), _currentForeground, _currentBackground, _currentAttributes,
+                    sequence, writtenAt, TrackedSixel: null, _currentHyperlink), impacts))
+                {
+                    linkedCells++;
+                }
                 
                 for (int w = 1; w < graphemeWidth && _cursorX + w < _width; w++)
                 {
-                    _currentHyperlink?.AddRef();
-                    SetCell(_cursorY, _cursorX + w, new TerminalCell(
+                    if (SetCell(_cursorY, _cursorX + w, new TerminalCell(
                         "", _currentForeground, _currentBackground, _currentAttributes,
-                        sequence, writtenAt, TrackedSixel: null, _currentHyperlink), impacts);
+                        sequence, writtenAt, TrackedSixel: null, _currentHyperlink), impacts))
+                    {
+                        linkedCells++;
+                    }
                 }
                 
                 _cursorX += graphemeWidth;
@@ -1046,9 +1522,20 @@ public sealed class Hex1bTerminal : IDisposable
                 {
                     _cursorX = 0;
                     _cursorY++;
+                    AddLinkedCellRefs(ref linkedCells);
                 }
             }
-            i += grapheme.Length;
+        }
+        
+        AddLinkedCellRefs(ref linkedCells);
+    }
+
+    private void AddLinkedCellRefs(ref int linkedCells)
+    {
+        if (linkedCells > 0)
+        {
+            _currentHyperlink!.AddRefs(linkedCells);
+            linkedCells = 0;
         }
     }
 
@@ -1114,21 +1601,23 @@ public sealed class Hex1bTerminal : IDisposable
     }
 
     /// <summary>
-    /// Gets the grapheme cluster starting at the given position in the text.
+    /// Gets the string stored in a cell for a grapheme cluster of a text token.
+    /// ASCII characters and whole-token clusters reuse existing strings instead of allocating.
     /// </summary>
-    private static string GetGraphemeAt(string text, int index)
+    private static string GetCellText(string text, GraphemeCluster cluster)
     {
-        if (index >= text.Length)
-            return "";
-            
-        var enumerator = StringInfo.GetTextElementEnumerator(text, index);
-        if (enumerator.MoveNext())
-        {
-            return (string)enumerator.Current;
-        }
-        return text[index].ToString();
+        if (cluster.Length == text.Length)
+            return text;
+
+        if (cluster.Length == 1 && text[cluster.Start] < AsciiCellText.Length)
+            return AsciiCellText[text[cluster.Start]];
+
+        return text.Substring(cluster.Start, cluster.Length);
     }
 
+    private static readonly string[] AsciiCellText =
+        Enumerable.Range(0, 128).Select(c => ((char)c).ToString()).ToArray();
+
     private int ProcessAnsiSequence(string text, int start)
     {
         int end = start + 2;
@@ -1398,10 +1887,11 @@ public sealed class Hex1bTerminal : IDisposable
 
     private void ScrollUp()
     {
-        // First, release Sixel data from the top row (being scrolled off)
+        // First, release tracked objects from the top row (being scrolled off)
         for (int x = 0; x < _width; x++)
         {
             _screenBuffer[0, x].TrackedSixel?.Release();
+            ReleaseHyperlink(_screenBuffer[0, x].TrackedHyperlink);
         }
         
         // Shift all rows up (tracked object refs move with them, no AddRef/Release needed)
@@ -1534,6 +2024,254 @@ public sealed class Hex1bTerminal : IDisposable
         }
     }
 
+    // === Kitty Graphics ===
+
+    /// <summary>
+    /// Applies a kitty graphics command: an upload (possibly one chunk of several), a
+    /// placement or a deletion. Queries and animation commands don't change the screen.
+    /// </summary>
+    private void ProcessKittyGraphics(KittyGraphicsToken token)
+    {
+        // Chunks after the first carry only the m key; the first chunk's command applies
+        if (_kittyTransmission is { } transmission)
+        {
+            transmission.Append(token.Payload);
+            if (token.GetNumber('m') == 1)
+                return;
+
+            _kittyTransmission = null;
+            CompleteKittyTransmission(transmission);
+            return;
+        }
+
+        switch (token.Action)
+        {
+            case 't':
+            case 'T':
+                var started = new KittyTransmission(token);
+                started.Append(token.Payload);
+                if (token.GetNumber('m') == 1)
+                {
+                    _kittyTransmission = started;
+                    return;
+                }
+                CompleteKittyTransmission(started);
+                break;
+
+            case 'p':
+                PlaceKittyImage(token, token.GetNumber('i'));
+                break;
+
+            case 'd':
+                DeleteKittyPlacements(token);
+                break;
+        }
+    }
+
+    /// <summary>
+    /// Stores a completely received image, placing it too for a transmit-and-display (a=T).
+    /// </summary>
+    private void CompleteKittyTransmission(KittyTransmission transmission)
+    {
+        var command = transmission.Command;
+        var id = command.GetNumber('i');
+
+        // Only direct transmission (t=d, the default) carries the image in the sequence;
+        // files and shared memory on the application's machine can't be read from here
+        if (id == 0 || transmission.Dropped || (command.GetValue('t') is { } medium && medium != "d"))
+            return;
+
+        byte[] data;
+        try
+        {
+            data = Convert.FromBase64String(transmission.Data.ToString());
+            if (command.GetValue('o') == "z")
+            {
+                // Raw pixels can't be bigger than their size says; PNGs are held to the fixed limit
+                long expected = command.GetNumber('f', 32) switch
+                {
+                    32 => (long)command.GetNumber('s') * command.GetNumber('v') * 4,
+                    24 => (long)command.GetNumber('s') * command.GetNumber('v') * 3,
+                    _ => 0
+                };
+                var limit = expected > 0 ? Math.Min(expected, MaxKittyImageBytes) : MaxKittyImageBytes;
+                if (Inflate(data, limit) is not { } decompressed)
+                    return;
+                data = decompressed;
+            }
+        }
+        catch (Exception ex) when (ex is FormatException or InvalidDataException)
+        {
+            // Malformed uploads are ignored, as the terminal would reject them
+            return;
+        }
+
+        _trackedObjects.AddKittyImage(new KittyImageData(
+            id,
+            command.GetNumber('f', 32),
+            (int)Math.Min(command.GetNumber('s'), int.MaxValue),
+            (int)Math.Min(command.GetNumber('v'), int.MaxValue),
+            data));
+
+        if (command.Action == 'T')
+        {
+            PlaceKittyImage(command, id);
+        }
+    }
+
+    /// <summary>
+    /// Places an uploaded image at the cursor. Placing again with the same image and
+    /// placement IDs moves the placement instead of adding another.
+    /// </summary>
+    private void PlaceKittyImage(KittyGraphicsToken command, uint imageId)
+    {
+        // A terminal with no cells has nowhere to put the image
+        if (_width <= 0 || _height <= 0)
+            return;
+
+        var image = _trackedObjects.GetKittyImage(imageId);
+        if (image == null)
+            return;
+
+        // The size in cells, when not given, comes from the image's size in pixels
+        var columns = (int)Math.Min(command.GetNumber('c'), (uint)_width);
+        var rows = (int)Math.Min(command.GetNumber('r'), (uint)_height);
+        if (columns == 0)
+        {
+            var cellWidth = Capabilities.CellPixelWidth;
+            columns = Math.Clamp((image.Data.PixelWidth + cellWidth - 1) / cellWidth, 1, _width);
+        }
+        if (rows == 0)
+        {
+            var cellHeight = Capabilities.CellPixelHeight;
+            rows = Math.Clamp((image.Data.PixelHeight + cellHeight - 1) / cellHeight, 1, _height);
+        }
+
+        var placementId = command.GetNumber('p');
+        if (placementId == 0)
+        {
+            placementId = _nextAnonymousKittyPlacementId--;
+        }
+
+        if (_kittyPlacements.Remove((imageId, placementId), out var moved))
+        {
+            moved.Image.Release();
+        }
+        _kittyPlacements[(imageId, placementId)] = new KittyPlacement(imageId, placementId, _cursorX, _cursorY, columns, rows, image);
+
+        // Unless told not to (C=1), the cursor moves past the image on its last row
+        if (command.GetNumber('C') != 1)
+        {
+            _cursorX = Math.Min(_cursorX + columns, _width - 1);
+            _cursorY = Math.Min(_cursorY + rows - 1, _height - 1);
+        }
+    }
+
+    /// <summary>
+    /// Deletes placements: all of them (d=a, the default) or an image's (d=i, narrowed to one
+    /// placement with p). The upper-case forms free the images' data as well.
+    /// </summary>
+    private void DeleteKittyPlacements(KittyGraphicsToken command)
+    {
+        var target = command.GetValue('d') is [var d] ? d : 'a';
+        var imageId = command.GetNumber('i');
+        var placementId = command.GetNumber('p');
+        var freeData = char.IsUpper(target);
+
+        List<(uint ImageId, uint PlacementId)>? deleted = null;
+        foreach (var key in _kittyPlacements.Keys)
+        {
+            var matches = char.ToLowerInvariant(target) switch
+            {
+                'a' => true,
+                'i' => key.ImageId == imageId && (placementId == 0 || key.PlacementId == placementId),
+                _ => false,
+            };
+
+            if (matches)
+            {
+                deleted ??= [];
+                deleted.Add(key);
+            }
+        }
+
+        if (deleted != null)
+        {
+            foreach (var key in deleted)
+            {
+                _kittyPlacements.Remove(key, out var placement);
+                placement!.Image.Release();
+                if (freeData)
+                {
+                    _trackedObjects.FreeKittyImage(key.ImageId);
+                }
+            }
+        }
+
+        // An image is freed by ID even when it isn't placed
+        if (target == 'I')
+        {
+            _trackedObjects.FreeKittyImage(imageId);
+        }
+    }
+
+    /// <summary>
+    /// Decompresses zlib data, or returns null if it inflates to more than <paramref name="limit"/> bytes.
+    /// </summary>
+    private static byte[]? Inflate(byte[] data, long limit)
+    {
+        using var zlib = new ZLibStream(new MemoryStream(data), CompressionMode.Decompress);
+        using var decompressed = new MemoryStream();
+        var buffer = ArrayPool<byte>.Shared.Rent(81920);
+        try
+        {
+            int read;
+            while ((read = zlib.Read(buffer)) > 0)
+            {
+                if (decompressed.Length + read > limit)
+                    return null;
+                decompressed.Write(buffer, 0, read);
+            }
+        }
+        finally
+        {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+        return decompressed.ToArray();
+    }
+
+    /// <summary>
+    /// An image upload in progress, gathering its base64 chunks.
+    /// </summary>
+    private sealed class KittyTransmission(KittyGraphicsToken command)
+    {
+        public KittyGraphicsToken Command { get; } = command;
+
+        public StringBuilder Data { get; } = new();
+
+        /// <summary>
+        /// Gets whether the upload grew past the size limit. Its remaining chunks are
+        /// swallowed and the upload is ignored.
+        /// </summary>
+        public bool Dropped { get; private set; }
+
+        public void Append(string payload)
+        {
+            if (Dropped)
+                return;
+
+            if (Data.Length + payload.Length > MaxKittyTransmissionLength)
+            {
+                Dropped = true;
+                Data.Clear();
+                Data.Capacity = 0;
+                return;
+            }
+
+            Data.Append(payload);
+        }
+    }
+
     /// <summary>
     /// Estimates Sixel image dimensions in terminal cells.
     /// </summary>
@@ -1548,7 +2286,7 @@ public sealed class Hex1bTerminal : IDisposable
         var cellHeight = Capabilities.CellPixelHeight;
 
         // Try to find "width;height in the sixel raster attributes
-        // Format: "Pan;Pad;Ph;Pv where Ph = pixel height, Pv = pixel width
+        // Format: "Pan;Pad;Ph;Pv where Ph = pixel width, Pv = pixel height
         // This appears after the 'q' and before the first color definition '#'
         var qIndex = sixelPayload.IndexOf('q');
         var hashIndex = sixelPayload.IndexOf('#');
@@ -1571,13 +2309,13 @@ public sealed class Hex1bTerminal : IDisposable
                 var parts = attrStr.Split(';');
                 if (parts.Length >= 4)
                 {
-                    // Ph = pixel height, Pv = pixel width
+                    // Ph = pixel width, Pv = pixel height
                     if (int.TryParse(parts[2], out var ph) && int.TryParse(parts[3], out var pv))
                     {
                         // Convert pixels to cells using actual cell dimensions
                         // Round up to ensure the image doesn't get cut off
-                        width = Math.Max(1, (pv + cellWidth - 1) / cellWidth);
-                        height = Math.Max(1, (ph + cellHeight - 1) / cellHeight);
+                        width = Math.Max(1, (ph + cellWidth - 1) / cellWidth);
+                        height = Math.Max(1, (pv + cellHeight - 1) / cellHeight);
                     }
                 }
             }
@@ -1688,20 +2426,20 @@ public sealed class Hex1bTerminal : IDisposable
             if (string.IsNullOrEmpty(payload))
             {
                 // Release current hyperlink if any
-                if (_currentHyperlink is not null)
-                {
-                    _currentHyperlink.Release();
-                    _currentHyperlink = null;
-                }
+                ReleaseHyperlink(_currentHyperlink);
+                _currentHyperlink = null;
+            }
+            else if (_currentHyperlink is { } current
+                && string.Equals(current.Data.Uri, payload, StringComparison.Ordinal)
+                && string.Equals(current.Data.Parameters, parameters, StringComparison.Ordinal))
+            {
+                // Reopening the active link (e.g. a link written in several styled runs) keeps it
             }
             else
             {
                 // Start a new hyperlink
                 // Release any previous hyperlink first
-                if (_currentHyperlink is not null)
-                {
-                    _currentHyperlink.Release();
-                }
+                ReleaseHyperlink(_currentHyperlink);
                 
                 // Create or get existing hyperlink
                 _currentHyperlink = _trackedObjects.GetOrCreateHyperlink(payload, parameters);
@@ -1710,238 +2448,6 @@ public sealed class Hex1bTerminal : IDisposable
         // Other OSC commands can be added here in the future
     }
 
-    // === Static Input Parsing Helpers ===
-
-    private static bool TryParseDA1Response(string message, int start, out int consumed)
-    {
-        consumed = 0;
-        
-        if (start + 3 < message.Length && 
-            message[start] == '\x1b' && 
-            message[start + 1] == '[' && 
-            message[start + 2] == '?')
-        {
-            for (var j = start + 3; j < message.Length; j++)
-            {
-                if (message[j] == 'c')
-                {
-                    // DA1 response format: ESC [ ? {params} c
-                    // We consume it but capabilities are now provided via TerminalCapabilities
-                    // rather than runtime detection
-                    consumed = j - start + 1;
-                    return true;
-                }
-            }
-        }
-        
-        return false;
-    }
-
-    private static Hex1bKeyEvent? ParseKeyInput(char c)
-    {
-        return c switch
-        {
-            '\r' or '\n' => new Hex1bKeyEvent(Hex1bKey.Enter, c, Hex1bModifiers.None),
-            '\t' => new Hex1bKeyEvent(Hex1bKey.Tab, c, Hex1bModifiers.None),
-            '\x1b' => new Hex1bKeyEvent(Hex1bKey.Escape, c, Hex1bModifiers.None),
-            '\x7f' or '\b' => new Hex1bKeyEvent(Hex1bKey.Backspace, c, Hex1bModifiers.None),
-            ' ' => new Hex1bKeyEvent(Hex1bKey.Spacebar, c, Hex1bModifiers.None),
-            >= 'a' and <= 'z' => new Hex1bKeyEvent(
-                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.A + (c - 'a'))), c, Hex1bModifiers.None),
-            >= 'A' and <= 'Z' => new Hex1bKeyEvent(
-                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.A + (c - 'A'))), c, Hex1bModifiers.Shift),
-            >= '0' and <= '9' => new Hex1bKeyEvent(
-                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.D0 + (c - '0'))), c, Hex1bModifiers.None),
-            >= '\x01' and <= '\x1a' => new Hex1bKeyEvent(
-                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.A + (c - '\x01'))), c, Hex1bModifiers.Control),
-            _ when !char.IsControl(c) => new Hex1bKeyEvent(Hex1bKey.None, c, Hex1bModifiers.None),
-            _ => null
-        };
-    }
-
-    /// <summary>
-    /// Parses an Alt+key combination (ESC followed by a character).
-    /// Returns null if the character cannot be an Alt+key combination.
-    /// </summary>
-    private static Hex1bKeyEvent? ParseAltKeyInput(char c)
-    {
-        // Alt+letter (lowercase: Alt+F sends ESC f)
-        if (c >= 'a' && c <= 'z')
-        {
-            return new Hex1bKeyEvent(
-                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.A + (c - 'a'))), c, Hex1bModifiers.Alt);
-        }
-        
-        // Alt+letter (uppercase: Alt+Shift+F sends ESC F)
-        if (c >= 'A' && c <= 'Z')
-        {
-            return new Hex1bKeyEvent(
-                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.A + (c - 'A'))), c, Hex1bModifiers.Alt | Hex1bModifiers.Shift);
-        }
-        
-        // Alt+number (Alt+1 sends ESC 1)
-        if (c >= '0' && c <= '9')
-        {
-            return new Hex1bKeyEvent(
-                KeyMapper.ToHex1bKey((ConsoleKey)((int)ConsoleKey.D0 + (c - '0'))), c, Hex1bModifiers.Alt);
-        }
-        
-        // Unknown - don't treat as Alt+key
-        return null;
-    }
-
-    private static (Hex1bKeyEvent? Event, int Consumed) ParseCsiSequence(string message, int start)
-    {
-        if (start + 2 >= message.Length)
-            return (null, 1);
-
-        var i = start + 2;
-        var param1 = 0;
-        var param2 = 0;
-        var hasParam2 = false;
-
-        while (i < message.Length && char.IsDigit(message[i]))
-        {
-            param1 = param1 * 10 + (message[i] - '0');
-            i++;
-        }
-
-        if (i < message.Length && message[i] == ';')
-        {
-            i++;
-            while (i < message.Length && char.IsDigit(message[i]))
-            {
-                param2 = param2 * 10 + (message[i] - '0');
-                hasParam2 = true;
-                i++;
-            }
-        }
-
-        if (i >= message.Length)
-            return (null, i - start);
-
-        var finalChar = message[i];
-        i++;
-
-        var modifiers = Hex1bModifiers.None;
-        if (hasParam2 && param2 >= 2)
-        {
-            var modifierBits = param2 - 1;
-            if ((modifierBits & 1) != 0) modifiers |= Hex1bModifiers.Shift;
-            if ((modifierBits & 2) != 0) modifiers |= Hex1bModifiers.Alt;
-            if ((modifierBits & 4) != 0) modifiers |= Hex1bModifiers.Control;
-        }
-
-        var key = finalChar switch
-        {
-            'A' => Hex1bKey.UpArrow,
-            'B' => Hex1bKey.DownArrow,
-            'C' => Hex1bKey.RightArrow,
-            'D' => Hex1bKey.LeftArrow,
-            'H' => Hex1bKey.Home,
-            'F' => Hex1bKey.End,
-            'Z' => Hex1bKey.Tab,
-            '~' => ParseTildeSequence(param1),
-            _ => Hex1bKey.None
-        };
-
-        if (key == Hex1bKey.None)
-            return (null, i - start);
-
-        if (finalChar == 'Z')
-            modifiers |= Hex1bModifiers.Shift;
-
-        return (new Hex1bKeyEvent(key, '\0', modifiers), i - start);
-    }
-
-    private static Hex1bKey ParseTildeSequence(int param)
-    {
-        return param switch
-        {
-            1 => Hex1bKey.Home,
-            2 => Hex1bKey.Insert,
-            3 => Hex1bKey.Delete,
-            4 => Hex1bKey.End,
-            5 => Hex1bKey.PageUp,
-            6 => Hex1bKey.PageDown,
-            _ => Hex1bKey.None
-        };
-    }
-
-    private static (Hex1bKeyEvent? Event, int Consumed) ParseSS3Sequence(string message, int start)
-    {
-        if (start + 2 >= message.Length)
-            return (null, 1);
-
-        var finalChar = message[start + 2];
-
-        var key = finalChar switch
-        {
-            'A' => Hex1bKey.UpArrow,
-            'B' => Hex1bKey.DownArrow,
-            'C' => Hex1bKey.RightArrow,
-            'D' => Hex1bKey.LeftArrow,
-            'H' => Hex1bKey.Home,
-            'F' => Hex1bKey.End,
-            'P' => Hex1bKey.F1,
-            'Q' => Hex1bKey.F2,
-            'R' => Hex1bKey.F3,
-            'S' => Hex1bKey.F4,
-            _ => Hex1bKey.None
-        };
-
-        if (key == Hex1bKey.None)
-            return (null, 3);
-
-        return (new Hex1bKeyEvent(key, '\0', Hex1bModifiers.None), 3);
-    }
-
-    private static (Hex1bMouseEvent? Event, int Consumed) ParseSgrMouseSequence(string message, int start)
-    {
-        if (start + 8 >= message.Length)
-            return (null, 3);
-
-        var i = start + 3;
-
-        var terminatorIdx = -1;
-        for (var j = i; j < message.Length; j++)
-        {
-            if (message[j] == 'M' || message[j] == 'm')
-            {
-                terminatorIdx = j;
-                break;
-            }
-            if (!char.IsDigit(message[j]) && message[j] != ';')
-            {
-                return (null, 3);
-            }
-        }
-
-        if (terminatorIdx < 0)
-            return (null, 3);
-
-        var sgrPart = message.Substring(i, terminatorIdx - i + 1);
-        if (MouseParser.TryParseSgr(sgrPart, out var mouseEvent))
-        {
-            return (mouseEvent, terminatorIdx - start + 1);
-        }
-
-        return (null, 3);
-    }
-
-    private static ConsoleKey CharToConsoleKey(char c)
-    {
-        return char.ToUpperInvariant(c) switch
-        {
-            >= 'A' and <= 'Z' => (ConsoleKey)(c - 'a' + (int)ConsoleKey.A),
-            >= '0' and <= '9' => (ConsoleKey)(c - '0' + (int)ConsoleKey.D0),
-            ' ' => ConsoleKey.Spacebar,
-            '\t' => ConsoleKey.Tab,
-            '\n' or '\r' => ConsoleKey.Enter,
-            _ => ConsoleKey.NoName
-        };
-    }
-
     private static Hex1bColor StandardColorFromCode(int code) => code switch
     {
         0 => Hex1bColor.FromRgb(0, 0, 0),
@@ -1995,14 +2501,18 @@ public sealed class Hex1bTerminal : IDisposable
         if (_disposed) return;
         _disposed = true;
 
+        DiscardHibernationOnDispose();
+
         // Notify filters of session end (fire-and-forget from sync Dispose)
         var elapsed = _timeProvider.GetUtcNow() - _sessionStart;
         _ = NotifyWorkloadFiltersSessionEndAsync(elapsed);
         _ = NotifyPresentationFiltersSessionEndAsync(elapsed);
 
-        // Exit TUI mode before disposing
+        // Exit TUI mode before disposing, once the last frame has been sent
         if (_presentation != null)
         {
+            CompletePresentationOutput();
+            
             // Fire and forget - ExitTuiModeAsync is typically synchronous for console
             _ = _presentation.ExitTuiModeAsync();
             _presentation.Resized -= OnPresentationResized;
@@ -2018,6 +2528,8 @@ public sealed class Hex1bTerminal : IDisposable
         if (_disposed) return;
         _disposed = true;
 
+        DiscardHibernationOnDispose();
+
         // Notify filters of session end
         var elapsed = _timeProvider.GetUtcNow() - _sessionStart;
         await NotifyWorkloadFiltersSessionEndAsync(elapsed);
@@ -2025,7 +2537,8 @@ public sealed class Hex1bTerminal : IDisposable
 
         if (_presentation != null)
         {
-            // Exit TUI mode before disposing
+            // Exit TUI mode before disposing, once the last frame has been sent
+            await CompletePresentationOutputAsync();
             await _presentation.ExitTuiModeAsync();
             _presentation.Resized -= OnPresentationResized;
             await _presentation.DisposeAsync();
@@ -2059,14 +2572,22 @@ public sealed class Hex1bTerminal : IDisposable
         }
     }
 
-    private async ValueTask NotifyWorkloadFiltersOutputAsync(IReadOnlyList<AnsiToken> tokens, CancellationToken ct = default)
+    private async ValueTask NotifyWorkloadFiltersOutputAsync(ReadOnlyMemory<byte> data, IReadOnlyList<AnsiToken> tokens, CancellationToken ct = default)
     {
         if (_workloadFilters.Count == 0) return;
         var elapsed = GetElapsed();
         foreach (var filter in _workloadFilters)
         {
             ct.ThrowIfCancellationRequested();
-            await filter.OnOutputAsync(tokens, elapsed, ct);
+            if (filter is IHex1bTerminalRecordingFilter recordingFilter)
+            {
+                // Recorders keep the bytes as read rather than re-serializing the tokens
+                await recordingFilter.OnRawOutputAsync(data, elapsed, ct);
+            }
+            else
+            {
+                await filter.OnOutputAsync(tokens, elapsed, ct);
+            }
         }
     }
 
@@ -2138,6 +2659,23 @@ public sealed class Hex1bTerminal : IDisposable
         return resultTokens;
     }
 
+    /// <summary>
+    /// Passes tokens through the presentation filters starting at <paramref name="firstFilter"/>.
+    /// </summary>
+    private async ValueTask<IReadOnlyList<AnsiToken>> NotifyPresentationFiltersOutputAsync(IReadOnlyList<AnsiToken> tokens, int firstFilter, CancellationToken ct = default)
+    {
+        if (firstFilter >= _presentationFilters.Count) return tokens;
+        var elapsed = GetElapsed();
+        var resultTokens = tokens;
+        for (var i = firstFilter; i < _presentationFilters.Count; i++)
+        {
+            ct.ThrowIfCancellationRequested();
+            var appliedTokens = resultTokens.Select(t => AppliedToken.WithNoCellImpacts(t, 0, 0, 0, 0)).ToList();
+            resultTokens = await _presentationFilters[i].OnOutputAsync(appliedTokens, elapsed, ct);
+        }
+        return resultTokens;
+    }
+
     private async ValueTask NotifyPresentationFiltersInputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
     {
         if (_presentationFilters.Count == 0) return;
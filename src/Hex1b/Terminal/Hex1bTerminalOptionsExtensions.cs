@@ -31,6 +31,31 @@ public static class Hex1bTerminalOptionsExtensions
         return recorder;
     }
 
+    /// <summary>
+    /// Adds a binary recorder, which keeps raw output with keyframes for seeking, to the terminal options.
+    /// </summary>
+    /// <param name="options">The terminal options.</param>
+    /// <param name="filePath">Path to the output file (typically with .hxr extension).</param>
+    /// <param name="recorderOptions">Options for the recorder.</param>
+    /// <returns>The recorder instance, which can be used to flush the recording and add markers.</returns>
+    /// <example>
+    /// <code>
+    /// var options = new Hex1bTerminalOptions { ... };
+    /// var recorder = options.AddHex1bRecorder("session.hxr");
+    /// var terminal = new Hex1bTerminal(options);
+    /// // ... run application, then dispose the recorder to write the index ...
+    /// </code>
+    /// </example>
+    public static Hex1bRecorder AddHex1bRecorder(
+        this Hex1bTerminalOptions options,
+        string filePath,
+        Hex1bRecorderOptions? recorderOptions = null)
+    {
+        var recorder = new Hex1bRecorder(filePath, recorderOptions);
+        options.WorkloadFilters.Add(recorder);
+        return recorder;
+    }
+
     /// <summary>
     /// Adds a Hex1bApp render optimization filter that only transmits cells that have changed.
     /// </summary>
@@ -72,4 +97,37 @@ public static class Hex1bTerminalOptionsExtensions
         options.PresentationFilters.Add(filter);
         return filter;
     }
+
+    /// <summary>
+    /// Presents the terminal to any number of read-only viewers through a broadcast adapter.
+    /// </summary>
+    /// <param name="options">The terminal options.</param>
+    /// <param name="width">Broadcast width in columns.</param>
+    /// <param name="height">Broadcast height in rows.</param>
+    /// <param name="capabilities">Capabilities reported to the terminal. Defaults to <see cref="TerminalCapabilities.Modern"/>.</param>
+    /// <returns>The broadcast adapter, to attach viewers with <see cref="Hex1bBroadcastPresentationAdapter.RunViewerAsync"/>.</returns>
+    /// <remarks>
+    /// The adapter becomes the presentation adapter and the first presentation filter, so it
+    /// sees each frame's cell changes before any other filter rewrites them.
+    /// </remarks>
+    /// <example>
+    /// <code>
+    /// var options = new Hex1bTerminalOptions { WorkloadAdapter = workload };
+    /// var broadcast = options.AddBroadcast(120, 40);
+    /// var terminal = new Hex1bTerminal(options);
+    /// // Per viewer
+    /// await broadcast.RunViewerAsync(viewer, ct);
+    /// </code>
+    /// </example>
+    public static Hex1bBroadcastPresentationAdapter AddBroadcast(
+        this Hex1bTerminalOptions options,
+        int width = 80,
+        int height = 24,
+        TerminalCapabilities? capabilities = null)
+    {
+        var broadcast = new Hex1bBroadcastPresentationAdapter(width, height, capabilities);
+        options.PresentationAdapter = broadcast;
+        options.PresentationFilters.Insert(0, broadcast);
+        return broadcast;
+    }
 }
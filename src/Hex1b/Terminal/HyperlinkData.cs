@@ -1,5 +1,3 @@
-using System.Security.Cryptography;
-
 namespace Hex1b.Terminal;
 
 /// <summary>
@@ -28,36 +26,9 @@ public sealed class HyperlinkData
     /// </summary>
     public string Parameters { get; }
 
-    /// <summary>
-    /// Gets the content hash used for deduplication.
-    /// </summary>
-    internal byte[] ContentHash { get; }
-
-    internal HyperlinkData(
-        string uri,
-        string parameters,
-        byte[] contentHash)
+    internal HyperlinkData(string uri, string parameters)
     {
         Uri = uri;
         Parameters = parameters;
-        ContentHash = contentHash;
-    }
-
-    /// <summary>
-    /// Computes a content hash for a hyperlink based on URI and parameters.
-    /// </summary>
-    internal static byte[] ComputeHash(string uri, string parameters)
-    {
-        // Use SHA256 for robust deduplication
-        var combined = $"{parameters}|{uri}";
-        return SHA256.HashData(System.Text.Encoding.UTF8.GetBytes(combined));
-    }
-
-    /// <summary>
-    /// Checks if two content hashes are equal.
-    /// </summary>
-    internal static bool HashEquals(byte[] a, byte[] b)
-    {
-        return a.AsSpan().SequenceEqual(b.AsSpan());
     }
 }
@@ -41,6 +41,12 @@ internal interface IConsoleDriver : IDisposable
     /// <param name="data">Data to write.</param>
     void Write(ReadOnlySpan<byte> data);
     
+    /// <summary>
+    /// Write several buffers to stdout as one gathered write where the platform supports it.
+    /// </summary>
+    /// <param name="segments">Buffers to write, in order.</param>
+    void WriteVectored(ReadOnlySpan<ReadOnlyMemory<byte>> segments);
+    
     /// <summary>
     /// Flush stdout.
     /// </summary>
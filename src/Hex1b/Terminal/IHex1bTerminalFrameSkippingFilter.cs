@@ -0,0 +1,51 @@
+using Hex1b.Tokens;
+
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// A presentation filter that can collapse frames while the presentation is busy.
+/// </summary>
+/// <remarks>
+/// <para>
+/// When a terminal's presentation filters include one of these, output is sent to the
+/// presentation from a separate loop instead of inline in the output pump. While a write is
+/// in flight the filter is deferred: it keeps tracking the latest screen state but emits
+/// nothing. Once the write completes, <see cref="TakeDeferredFrame"/> yields a single diff
+/// from what the presentation last received to the latest complete frame, so a slow consumer
+/// skips intermediate frames instead of queueing them.
+/// </para>
+/// </remarks>
+internal interface IHex1bTerminalFrameSkippingFilter : IHex1bTerminalPresentationFilter
+{
+    /// <summary>
+    /// Starts collapsing frames instead of emitting them.
+    /// </summary>
+    void BeginDeferral();
+
+    /// <summary>
+    /// Takes the changes collected since <see cref="BeginDeferral"/>.
+    /// </summary>
+    /// <param name="tokens">The tokens that bring the presentation up to date, when <see cref="DeferredFrameStatus.Ready"/>.</param>
+    DeferredFrameStatus TakeDeferredFrame(out IReadOnlyList<AnsiToken> tokens);
+}
+
+/// <summary>
+/// Result of <see cref="IHex1bTerminalFrameSkippingFilter.TakeDeferredFrame"/>.
+/// </summary>
+internal enum DeferredFrameStatus
+{
+    /// <summary>
+    /// Nothing was deferred; the filter emits output directly again.
+    /// </summary>
+    Resumed,
+
+    /// <summary>
+    /// A frame is still being rendered; try again at the next frame boundary.
+    /// </summary>
+    InProgress,
+
+    /// <summary>
+    /// The latest frame's changes were taken. The filter stays deferred until they are sent.
+    /// </summary>
+    Ready
+}
@@ -0,0 +1,25 @@
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// A workload filter that records the raw output bytes and captures keyframes of the terminal state.
+/// </summary>
+/// <remarks>
+/// The terminal attaches itself to these filters when it is created and hands them workload
+/// output as the bytes it read, in place of <see cref="IHex1bTerminalWorkloadFilter.OnOutputAsync"/>,
+/// so recording doesn't pay to serialize the tokens again.
+/// </remarks>
+internal interface IHex1bTerminalRecordingFilter : IHex1bTerminalWorkloadFilter
+{
+    /// <summary>
+    /// Called once by the terminal the filter was added to.
+    /// </summary>
+    void AttachTerminal(Hex1bTerminal terminal);
+
+    /// <summary>
+    /// Called with each chunk of output read from the workload.
+    /// </summary>
+    /// <param name="data">The raw output bytes. Only valid for the duration of the call.</param>
+    /// <param name="elapsed">Time elapsed since session start.</param>
+    /// <param name="ct">Cancellation token.</param>
+    ValueTask OnRawOutputAsync(ReadOnlyMemory<byte> data, TimeSpan elapsed, CancellationToken ct = default);
+}
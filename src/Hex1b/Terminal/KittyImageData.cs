@@ -0,0 +1,65 @@
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// An image uploaded with the kitty graphics protocol.
+/// </summary>
+/// <remarks>
+/// Kitty images are addressed by the ID the application chose, not by content: uploading
+/// another image under the same ID replaces it. Placements hold a reference, so an image
+/// stays alive while it is shown even after it is replaced or freed.
+/// </remarks>
+internal sealed class KittyImageData
+{
+    internal KittyImageData(uint id, uint format, int pixelWidth, int pixelHeight, byte[] data)
+    {
+        Id = id;
+        Format = format;
+        PixelWidth = pixelWidth;
+        PixelHeight = pixelHeight;
+        Data = data;
+    }
+
+    /// <summary>
+    /// Gets the image ID.
+    /// </summary>
+    public uint Id { get; }
+
+    /// <summary>
+    /// Gets the pixel format: 24 (RGB), 32 (RGBA) or 100 (PNG).
+    /// </summary>
+    public uint Format { get; }
+
+    /// <summary>
+    /// Gets the image width in pixels, or 0 if the upload didn't say (PNG).
+    /// </summary>
+    public int PixelWidth { get; }
+
+    /// <summary>
+    /// Gets the image height in pixels, or 0 if the upload didn't say (PNG).
+    /// </summary>
+    public int PixelHeight { get; }
+
+    /// <summary>
+    /// Gets the decoded image data.
+    /// </summary>
+    public byte[] Data { get; }
+}
+
+/// <summary>
+/// Where a kitty image is placed on the screen.
+/// </summary>
+/// <param name="ImageId">The placed image's ID.</param>
+/// <param name="PlacementId">The placement's ID; placing again with the same IDs moves it.</param>
+/// <param name="Column">The left column of the placement.</param>
+/// <param name="Row">The top row of the placement.</param>
+/// <param name="Columns">The placement's width in cells.</param>
+/// <param name="Rows">The placement's height in cells.</param>
+/// <param name="Image">The tracked image, referenced for as long as it is placed.</param>
+internal sealed record KittyPlacement(
+    uint ImageId,
+    uint PlacementId,
+    int Column,
+    int Row,
+    int Columns,
+    int Rows,
+    TrackedObject<KittyImageData> Image);
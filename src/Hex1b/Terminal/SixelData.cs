@@ -1,5 +1,3 @@
-using System.Security.Cryptography;
-
 namespace Hex1b.Terminal;
 
 /// <summary>
@@ -35,13 +33,13 @@ public sealed class SixelData
     /// <summary>
     /// Gets the content hash used for deduplication.
     /// </summary>
-    internal byte[] ContentHash { get; }
+    internal ulong ContentHash { get; }
 
     internal SixelData(
         string payload,
         int widthInCells,
         int heightInCells,
-        byte[] contentHash)
+        ulong contentHash)
     {
         Payload = payload;
         WidthInCells = widthInCells;
@@ -52,17 +50,10 @@ public sealed class SixelData
     /// <summary>
     /// Computes a content hash for a Sixel payload.
     /// </summary>
-    internal static byte[] ComputeHash(string payload)
-    {
-        // Use SHA256 for robust deduplication
-        return SHA256.HashData(System.Text.Encoding.UTF8.GetBytes(payload));
-    }
-
-    /// <summary>
-    /// Checks if two content hashes are equal.
-    /// </summary>
-    internal static bool HashEquals(byte[] a, byte[] b)
-    {
-        return a.AsSpan().SequenceEqual(b.AsSpan());
-    }
+    /// <remarks>
+    /// A fast non-cryptographic hash over the payload's characters, so images redrawn every
+    /// frame are not encoded and hashed with SHA-256 each time. Matches are confirmed by
+    /// comparing payloads.
+    /// </remarks>
+    internal static ulong ComputeHash(string payload) => XxHash64.Hash(payload);
 }
@@ -17,6 +17,12 @@ public record TerminalCapabilities
     /// </summary>
     public bool SupportsSixel { get; init; }
     
+    /// <summary>
+    /// Presentation supports the kitty graphics protocol, which uploads an image once and
+    /// then places it by ID.
+    /// </summary>
+    public bool SupportsKittyGraphics { get; init; }
+    
     /// <summary>
     /// Presentation supports mouse tracking.
     /// </summary>
@@ -0,0 +1,449 @@
+using System.Buffers;
+using System.Text;
+using Hex1b.Theming;
+
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Terminal state that isn't part of the screen cells.
+/// </summary>
+internal readonly record struct TerminalStateFields(
+    int CursorX,
+    int CursorY,
+    int SavedCursorX,
+    int SavedCursorY,
+    bool InAlternateScreen,
+    Hex1bColor? Foreground,
+    Hex1bColor? Background,
+    CellAttributes Attributes,
+    TrackedObject<HyperlinkData>? Hyperlink,
+    long WriteSequence);
+
+/// <summary>
+/// Reads and writes the binary snapshot used by <see cref="Hex1bTerminal.SaveState"/>.
+/// </summary>
+/// <remarks>
+/// <para>
+/// All integers are LEB128 varints and strings are length-prefixed UTF-8. After the header,
+/// fields and the hyperlink and sixel tables, cells follow in row-major order. Each cell starts
+/// with an op byte whose bits say which parts differ from the previous cell, so runs of
+/// same-styled text cost little more than their characters:
+/// </para>
+/// <list type="bullet">
+/// <item><c>0x01</c> character follows.</item>
+/// <item><c>0x02</c> style follows: foreground, background, attributes, sixel and hyperlink table indexes (0 for none).</item>
+/// <item><c>0x04</c> the write sequence is one more than the previous cell's.</item>
+/// <item><c>0x08</c> a zigzag sequence delta follows.</item>
+/// <item><c>0x80</c> alone: the previous cell repeats the number of times that follows.</item>
+/// </list>
+/// <para>
+/// Cell timestamps are not kept; restored cells have a default <see cref="TerminalCell.WrittenAt"/>.
+/// </para>
+/// </remarks>
+internal static class TerminalStateSerializer
+{
+    private static ReadOnlySpan<byte> Magic => "HX1S"u8;
+    private const byte Version = 1;
+
+    private const byte OpCharacter = 0x01;
+    private const byte OpStyle = 0x02;
+    private const byte OpSequenceNext = 0x04;
+    private const byte OpSequenceDelta = 0x08;
+    private const byte OpRepeat = 0x80;
+
+    private const byte ColorNone = 0;
+    private const byte ColorDefault = 1;
+    private const byte ColorRgb = 2;
+
+    public static void Write(IBufferWriter<byte> output, TerminalCell[,] cells, in TerminalStateFields fields)
+    {
+        var height = cells.GetLength(0);
+        var width = cells.GetLength(1);
+
+        // Intern tracked objects so each payload is written once; indexes are 1-based
+        var hyperlinks = new Dictionary<HyperlinkData, int>(ReferenceEqualityComparer.Instance);
+        var hyperlinkTable = new List<HyperlinkData>();
+        var sixels = new Dictionary<SixelData, int>(ReferenceEqualityComparer.Instance);
+        var sixelTable = new List<SixelData>();
+        if (fields.Hyperlink != null)
+        {
+            Intern(hyperlinks, hyperlinkTable, fields.Hyperlink.Data);
+        }
+        foreach (var cell in cells)
+        {
+            if (cell.HyperlinkData is { } hyperlink)
+                Intern(hyperlinks, hyperlinkTable, hyperlink);
+            if (cell.SixelData is { } sixel)
+                Intern(sixels, sixelTable, sixel);
+        }
+
+        var writer = new Writer(output);
+        writer.WriteBytes(Magic);
+        writer.WriteByte(Version);
+        writer.WriteVarint((ulong)width);
+        writer.WriteVarint((ulong)height);
+        writer.WriteVarint((ulong)fields.CursorX);
+        writer.WriteVarint((ulong)fields.CursorY);
+        writer.WriteVarint((ulong)fields.SavedCursorX);
+        writer.WriteVarint((ulong)fields.SavedCursorY);
+        writer.WriteByte(fields.InAlternateScreen ? (byte)1 : (byte)0);
+        writer.WriteColor(fields.Foreground);
+        writer.WriteColor(fields.Background);
+        writer.WriteVarint((ulong)fields.Attributes);
+        writer.WriteVarint(fields.Hyperlink != null ? (ulong)hyperlinks[fields.Hyperlink.Data] : 0);
+        writer.WriteVarint((ulong)fields.WriteSequence);
+
+        writer.WriteVarint((ulong)hyperlinkTable.Count);
+        foreach (var hyperlink in hyperlinkTable)
+        {
+            writer.WriteString(hyperlink.Uri);
+            writer.WriteString(hyperlink.Parameters);
+        }
+
+        writer.WriteVarint((ulong)sixelTable.Count);
+        foreach (var sixel in sixelTable)
+        {
+            writer.WriteString(sixel.Payload);
+            writer.WriteVarint((ulong)sixel.WidthInCells);
+            writer.WriteVarint((ulong)sixel.HeightInCells);
+        }
+
+        var previous = TerminalCell.Empty;
+        var repeat = 0;
+        for (var y = 0; y < height; y++)
+        {
+            for (var x = 0; x < width; x++)
+            {
+                var cell = cells[y, x];
+                if ((y | x) != 0 && IsSameCell(cell, previous))
+                {
+                    repeat++;
+                    continue;
+                }
+
+                if (repeat > 0)
+                {
+                    writer.WriteByte(OpRepeat);
+                    writer.WriteVarint((ulong)repeat);
+                    repeat = 0;
+                }
+
+                var op = (byte)0;
+                if (cell.Character != previous.Character)
+                    op |= OpCharacter;
+                if (!IsSameStyle(cell, previous))
+                    op |= OpStyle;
+                if (cell.Sequence == previous.Sequence + 1)
+                    op |= OpSequenceNext;
+                else if (cell.Sequence != previous.Sequence)
+                    op |= OpSequenceDelta;
+
+                writer.WriteByte(op);
+                if ((op & OpCharacter) != 0)
+                {
+                    writer.WriteString(cell.Character);
+                }
+                if ((op & OpStyle) != 0)
+                {
+                    writer.WriteColor(cell.Foreground);
+                    writer.WriteColor(cell.Background);
+                    writer.WriteVarint((ulong)cell.Attributes);
+                    writer.WriteVarint(cell.SixelData is { } sixel ? (ulong)sixels[sixel] : 0);
+                    writer.WriteVarint(cell.HyperlinkData is { } hyperlink ? (ulong)hyperlinks[hyperlink] : 0);
+                }
+                if ((op & OpSequenceDelta) != 0)
+                {
+                    var delta = cell.Sequence - previous.Sequence;
+                    writer.WriteVarint((ulong)((delta << 1) ^ (delta >> 63)));
+                }
+
+                previous = cell;
+            }
+        }
+
+        if (repeat > 0)
+        {
+            writer.WriteByte(OpRepeat);
+            writer.WriteVarint((ulong)repeat);
+        }
+    }
+
+    /// <summary>
+    /// Reads a snapshot, creating tracked objects in <paramref name="store"/> with one reference per cell.
+    /// </summary>
+    /// <exception cref="InvalidDataException">The data is not a valid snapshot.</exception>
+    public static TerminalCell[,] Read(ReadOnlySpan<byte> data, TrackedObjectStore store, out TerminalStateFields fields)
+    {
+        var reader = new Reader(data);
+        if (!reader.ReadBytes(Magic.Length).SequenceEqual(Magic) || reader.ReadByte() != Version)
+        {
+            throw new InvalidDataException("Not a terminal state snapshot.");
+        }
+
+        var width = reader.ReadInt32();
+        var height = reader.ReadInt32();
+        var cursorX = reader.ReadInt32();
+        var cursorY = reader.ReadInt32();
+        var savedCursorX = reader.ReadInt32();
+        var savedCursorY = reader.ReadInt32();
+        var inAlternateScreen = reader.ReadByte() != 0;
+        var foreground = reader.ReadColor();
+        var background = reader.ReadColor();
+        var attributes = (CellAttributes)reader.ReadVarint();
+        var currentHyperlink = reader.ReadInt32();
+        var writeSequence = (long)reader.ReadVarint();
+
+        var hyperlinkCount = reader.ReadInt32();
+        var hyperlinks = new (string Uri, string Parameters, TrackedObject<HyperlinkData>? Tracked)[hyperlinkCount];
+        for (var i = 0; i < hyperlinkCount; i++)
+        {
+            hyperlinks[i] = (reader.ReadString(), reader.ReadString(), null);
+        }
+
+        var sixelCount = reader.ReadInt32();
+        var sixels = new (string Payload, int Width, int Height, TrackedObject<SixelData>? Tracked)[sixelCount];
+        for (var i = 0; i < sixelCount; i++)
+        {
+            sixels[i] = (reader.ReadString(), reader.ReadInt32(), reader.ReadInt32(), null);
+        }
+
+        if ((long)width * height > Array.MaxLength || currentHyperlink > hyperlinkCount)
+        {
+            throw new InvalidDataException("Terminal state snapshot is corrupt.");
+        }
+
+        var cells = new TerminalCell[height, width];
+        var previous = TerminalCell.Empty;
+        var index = 0;
+        var total = width * height;
+        while (index < total)
+        {
+            var op = reader.ReadByte();
+            if (op == OpRepeat)
+            {
+                var count = reader.ReadInt32();
+                if (index == 0 || count > total - index)
+                    throw new InvalidDataException("Terminal state snapshot is corrupt.");
+
+                for (var i = 0; i < count; i++, index++)
+                {
+                    cells[index / width, index % width] = AddRefs(previous);
+                }
+                continue;
+            }
+
+            var character = (op & OpCharacter) != 0 ? reader.ReadString() : previous.Character;
+            var cell = previous with { Character = character, WrittenAt = default };
+
+            if ((op & OpStyle) != 0)
+            {
+                var cellForeground = reader.ReadColor();
+                var cellBackground = reader.ReadColor();
+                var cellAttributes = (CellAttributes)reader.ReadVarint();
+                var sixel = reader.ReadInt32();
+                var hyperlink = reader.ReadInt32();
+                if (sixel > sixelCount || hyperlink > hyperlinkCount)
+                    throw new InvalidDataException("Terminal state snapshot is corrupt.");
+
+                cell = cell with
+                {
+                    Foreground = cellForeground,
+                    Background = cellBackground,
+                    Attributes = cellAttributes,
+                    TrackedSixel = sixel > 0 ? GetSixel(sixel - 1) : null,
+                    TrackedHyperlink = hyperlink > 0 ? GetHyperlink(hyperlink - 1) : null
+                };
+            }
+            else
+            {
+                cell = AddRefs(cell);
+            }
+
+            if ((op & OpSequenceNext) != 0)
+            {
+                cell = cell with { Sequence = previous.Sequence + 1 };
+            }
+            else if ((op & OpSequenceDelta) != 0)
+            {
+                var zigzag = reader.ReadVarint();
+                cell = cell with { Sequence = previous.Sequence + ((long)(zigzag >> 1) ^ -(long)(zigzag & 1)) };
+            }
+
+            cells[index / width, index % width] = cell;
+            previous = cell;
+            index++;
+        }
+
+        // The current hyperlink holds a reference of its own
+        fields = new TerminalStateFields(
+            cursorX, cursorY, savedCursorX, savedCursorY, inAlternateScreen,
+            foreground, background, attributes,
+            currentHyperlink > 0 ? GetHyperlink(currentHyperlink - 1) : null,
+            writeSequence);
+        return cells;
+
+        // The first cell to use an entry creates it in the store; later cells add references
+        TrackedObject<SixelData> GetSixel(int i)
+        {
+            ref var entry = ref sixels[i];
+            if (entry.Tracked == null)
+            {
+                entry.Tracked = store.GetOrCreateSixel(entry.Payload, entry.Width, entry.Height);
+            }
+            else
+            {
+                entry.Tracked.AddRef();
+            }
+            return entry.Tracked;
+        }
+
+        TrackedObject<HyperlinkData> GetHyperlink(int i)
+        {
+            ref var entry = ref hyperlinks[i];
+            if (entry.Tracked == null)
+            {
+                entry.Tracked = store.GetOrCreateHyperlink(entry.Uri, entry.Parameters);
+            }
+            else
+            {
+                entry.Tracked.AddRef();
+            }
+            return entry.Tracked;
+        }
+
+        static TerminalCell AddRefs(TerminalCell cell)
+        {
+            cell.TrackedSixel?.AddRef();
+            cell.TrackedHyperlink?.AddRef();
+            return cell;
+        }
+    }
+
+    private static void Intern<T>(Dictionary<T, int> indexes, List<T> table, T item) where T : class
+    {
+        if (indexes.TryAdd(item, table.Count + 1))
+        {
+            table.Add(item);
+        }
+    }
+
+    private static bool IsSameStyle(in TerminalCell a, in TerminalCell b) =>
+        Nullable.Equals(a.Foreground, b.Foreground)
+        && Nullable.Equals(a.Background, b.Background)
+        && a.Attributes == b.Attributes
+        && ReferenceEquals(a.SixelData, b.SixelData)
+        && ReferenceEquals(a.HyperlinkData, b.HyperlinkData);
+
+    private static bool IsSameCell(in TerminalCell a, in TerminalCell b) =>
+        a.Character == b.Character && a.Sequence == b.Sequence && IsSameStyle(a, b);
+
+    private ref struct Writer(IBufferWriter<byte> output)
+    {
+        public void WriteByte(byte value)
+        {
+            output.GetSpan(1)[0] = value;
+            output.Advance(1);
+        }
+
+        public void WriteBytes(ReadOnlySpan<byte> value)
+        {
+            value.CopyTo(output.GetSpan(value.Length));
+            output.Advance(value.Length);
+        }
+
+        public void WriteVarint(ulong value)
+        {
+            var span = output.GetSpan(10);
+            var i = 0;
+            while (value >= 0x80)
+            {
+                span[i++] = (byte)(value | 0x80);
+                value >>= 7;
+            }
+            span[i++] = (byte)value;
+            output.Advance(i);
+        }
+
+        public void WriteString(string value)
+        {
+            var length = Encoding.UTF8.GetByteCount(value);
+            WriteVarint((ulong)length);
+            Encoding.UTF8.GetBytes(value, output.GetSpan(length));
+            output.Advance(length);
+        }
+
+        public void WriteColor(Hex1bColor? color)
+        {
+            if (color is not { } value)
+            {
+                WriteByte(ColorNone);
+            }
+            else if (value.IsDefault)
+            {
+                WriteByte(ColorDefault);
+            }
+            else
+            {
+                var span = output.GetSpan(4);
+                span[0] = ColorRgb;
+                span[1] = value.R;
+                span[2] = value.G;
+                span[3] = value.B;
+                output.Advance(4);
+            }
+        }
+    }
+
+    private ref struct Reader(ReadOnlySpan<byte> data)
+    {
+        private readonly ReadOnlySpan<byte> _data = data;
+        private int _position;
+
+        public byte ReadByte()
+        {
+            if (_position >= _data.Length)
+                throw new InvalidDataException("Terminal state snapshot is truncated.");
+            return _data[_position++];
+        }
+
+        public ReadOnlySpan<byte> ReadBytes(int count)
+        {
+            if (count > _data.Length - _position)
+                throw new InvalidDataException("Terminal state snapshot is truncated.");
+            var bytes = _data.Slice(_position, count);
+            _position += count;
+            return bytes;
+        }
+
+        public ulong ReadVarint()
+        {
+            ulong value = 0;
+            for (var shift = 0; shift < 64; shift += 7)
+            {
+                var b = ReadByte();
+                value |= (ulong)(b & 0x7F) << shift;
+                if (b < 0x80)
+                    return value;
+            }
+            throw new InvalidDataException("Terminal state snapshot is corrupt.");
+        }
+
+        public int ReadInt32()
+        {
+            var value = ReadVarint();
+            if (value > int.MaxValue)
+                throw new InvalidDataException("Terminal state snapshot is corrupt.");
+            return (int)value;
+        }
+
+        public string ReadString() => Encoding.UTF8.GetString(ReadBytes(ReadInt32()));
+
+        public Hex1bColor? ReadColor() => ReadByte() switch
+        {
+            ColorNone => null,
+            ColorDefault => Hex1bColor.Default,
+            ColorRgb => Hex1bColor.FromRgb(ReadByte(), ReadByte(), ReadByte()),
+            _ => throw new InvalidDataException("Terminal state snapshot is corrupt.")
+        };
+    }
+}
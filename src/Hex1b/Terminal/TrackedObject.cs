@@ -6,15 +6,19 @@ namespace Hex1b.Terminal;
 /// <typeparam name="T">The type of data being tracked.</typeparam>
 /// <remarks>
 /// <para>
-/// When a tracked object's reference count reaches zero, it automatically
-/// removes itself from its parent store via the removal callback.
+/// When a tracked object's reference count reaches zero, it is retired through the removal
+/// callback. Its store drops it in the next batch of reclamation; until then a lookup can
+/// still find it and add a reference again.
+/// </para>
+/// <para>
+/// Reference counts are updated with interlocked operations, so objects can be shared by
+/// terminals on different threads without locking.
 /// </para>
 /// </remarks>
 public sealed class TrackedObject<T> where T : class
 {
     private readonly Action<TrackedObject<T>> _onZeroRefs;
     private int _refCount;
-    private readonly object _lock = new();
 
     /// <summary>
     /// Gets the tracked data.
@@ -36,57 +40,61 @@ public sealed class TrackedObject<T> where T : class
     /// <summary>
     /// Gets the current reference count.
     /// </summary>
-    public int RefCount
-    {
-        get
-        {
-            lock (_lock)
-            {
-                return _refCount;
-            }
-        }
-    }
+    public int RefCount => Volatile.Read(ref _refCount);
 
     /// <summary>
     /// Adds a reference to this object.
     /// </summary>
     public void AddRef()
     {
-        lock (_lock)
-        {
-            _refCount++;
-        }
+        Interlocked.Increment(ref _refCount);
+    }
+
+    /// <summary>
+    /// Adds <paramref name="count"/> references at once, for a run of cells taking the object.
+    /// </summary>
+    internal void AddRefs(int count)
+    {
+        Interlocked.Add(ref _refCount, count);
     }
 
     /// <summary>
     /// Releases a reference. If refcount reaches zero, invokes the removal callback.
     /// </summary>
-    /// <returns>True if this was the last reference and the object was removed.</returns>
-    public bool Release()
+    /// <returns>True if this was the last reference and the object was retired.</returns>
+    public bool Release() => Release(1);
+
+    /// <summary>
+    /// Releases <paramref name="count"/> references at once, for a run of cells dropping the object.
+    /// If refcount reaches zero, invokes the removal callback.
+    /// </summary>
+    /// <returns>True if these were the last references and the object was retired.</returns>
+    /// <exception cref="InvalidOperationException">More references are released than are held.</exception>
+    internal bool Release(int count)
     {
-        Action<TrackedObject<T>>? callbackToInvoke = null;
-        
-        lock (_lock)
+        int current, updated;
+        do
         {
-            if (_refCount <= 0)
+            current = Volatile.Read(ref _refCount);
+            if (current <= 0)
             {
                 // Already released - shouldn't happen in normal use
                 return false;
             }
 
-            _refCount--;
-            
-            if (_refCount == 0)
+            if (count > current)
             {
-                // Capture callback to invoke outside lock
-                callbackToInvoke = _onZeroRefs;
+                // The cells' counts no longer match the object's; clamping would hide it
+                throw new InvalidOperationException($"Cannot release {count} references; only {current} are held.");
             }
+
+            updated = current - count;
         }
+        while (Interlocked.CompareExchange(ref _refCount, updated, current) != current);
 
-        // Invoke callback outside lock to avoid deadlocks
-        if (callbackToInvoke is not null)
+        if (updated == 0)
         {
-            callbackToInvoke(this);
+            _onZeroRefs(this);
             return true;
         }
 
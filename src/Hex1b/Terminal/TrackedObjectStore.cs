@@ -1,3 +1,5 @@
+using System.Collections.Concurrent;
+
 namespace Hex1b.Terminal;
 
 /// <summary>
@@ -7,7 +9,16 @@ namespace Hex1b.Terminal;
 /// <para>
 /// When cells hold references to objects (like Sixel graphics or hyperlinks),
 /// this store provides content-addressable deduplication and lifecycle management.
-/// Objects are automatically removed when their reference count reaches zero.
+/// Objects are removed once their reference count has reached zero.
+/// </para>
+/// <para>
+/// The store takes no lock, so it can be shared by terminals on different threads. Lookups
+/// read concurrent dictionaries. An object whose last reference is released is only retired:
+/// it stays findable, and a lookup that finds it adds a reference and brings it back. Retired
+/// objects are removed together by <see cref="Reclaim"/>, which terminals call once per batch
+/// of output, so a link or image that is cleared and redrawn in the same frame is reused
+/// rather than dropped and created again. A lookup racing the removal can at worst lose the
+/// sharing of an object, never use one that was dropped; see <see cref="Reclaim"/>.
 /// </para>
 /// <para>
 /// This is internal infrastructure - not exposed to API consumers.
@@ -18,12 +29,17 @@ namespace Hex1b.Terminal;
 internal sealed class TrackedObjectStore
 {
     // Content-addressable storage for Sixel data, keyed by content hash
-    private readonly Dictionary<byte[], TrackedObject<SixelData>> _sixelByHash = new(ByteArrayComparer.Instance);
-    
-    // Content-addressable storage for hyperlink data, keyed by content hash
-    private readonly Dictionary<byte[], TrackedObject<HyperlinkData>> _hyperlinkByHash = new(ByteArrayComparer.Instance);
-    
-    private readonly object _lock = new();
+    private readonly ConcurrentDictionary<ulong, TrackedObject<SixelData>> _sixelByHash = new();
+
+    // Interned hyperlink data, keyed by URI and parameters (compared ordinally)
+    private readonly ConcurrentDictionary<(string Uri, string Parameters), TrackedObject<HyperlinkData>> _hyperlinkByValue = new();
+
+    // Kitty graphics images, keyed by the ID they were uploaded under
+    private readonly ConcurrentDictionary<uint, TrackedObject<KittyImageData>> _kittyImageById = new();
+
+    // Objects whose reference count reached zero, removed by the next Reclaim
+    private readonly ConcurrentQueue<TrackedObject<SixelData>> _retiredSixels = new();
+    private readonly ConcurrentQueue<TrackedObject<HyperlinkData>> _retiredHyperlinks = new();
 
     /// <summary>
     /// Gets the number of tracked Sixel objects currently in the store.
@@ -32,10 +48,8 @@ internal sealed class TrackedObjectStore
     {
         get
         {
-            lock (_lock)
-            {
-                return _sixelByHash.Count;
-            }
+            Reclaim();
+            return _sixelByHash.Count;
         }
     }
 
@@ -46,13 +60,16 @@ internal sealed class TrackedObjectStore
     {
         get
         {
-            lock (_lock)
-            {
-                return _hyperlinkByHash.Count;
-            }
+            Reclaim();
+            return _hyperlinkByValue.Count;
         }
     }
 
+    /// <summary>
+    /// Gets the number of uploaded kitty graphics images currently in the store.
+    /// </summary>
+    public int KittyImageCount => _kittyImageById.Count;
+
     /// <summary>
     /// Gets or creates a tracked Sixel object for the given payload.
     /// If an identical payload already exists, adds a reference and returns it.
@@ -64,28 +81,37 @@ internal sealed class TrackedObjectStore
     /// <returns>A tracked Sixel object (new or existing with added ref).</returns>
     public TrackedObject<SixelData> GetOrCreateSixel(string payload, int widthInCells, int heightInCells)
     {
-        var hash = SixelData.ComputeHash(payload);
+        var contentHash = SixelData.ComputeHash(payload);
 
-        lock (_lock)
+        if (_sixelByHash.TryGetValue(contentHash, out var existing))
         {
-            if (_sixelByHash.TryGetValue(hash, out var existing))
+            // The hash is not cryptographic, so confirm the payloads match
+            if (string.Equals(existing.Data.Payload, payload, StringComparison.Ordinal))
             {
-                // Found existing - add a reference and return it
+                // Found existing (possibly retired) - add a reference and return it
                 existing.AddRef();
                 return existing;
             }
 
-            // Create the data
-            var sixelData = new SixelData(payload, widthInCells, heightInCells, hash);
-            
-            // Create new tracked wrapper with removal callback
-            var tracked = new TrackedObject<SixelData>(
-                sixelData,
-                onZeroRefs: obj => RemoveSixel(obj.Data));
+            // A collision: the image is tracked, but not shared
+            return new TrackedObject<SixelData>(
+                new SixelData(payload, widthInCells, heightInCells, contentHash),
+                onZeroRefs: _retiredSixels.Enqueue);
+        }
+
+        var tracked = new TrackedObject<SixelData>(
+            new SixelData(payload, widthInCells, heightInCells, contentHash),
+            onZeroRefs: _retiredSixels.Enqueue);
 
-            _sixelByHash[hash] = tracked;
-            return tracked;
+        // Another thread may have added the same image since the lookup; share theirs
+        var stored = _sixelByHash.GetOrAdd(contentHash, tracked);
+        if (!ReferenceEquals(stored, tracked) && string.Equals(stored.Data.Payload, payload, StringComparison.Ordinal))
+        {
+            stored.AddRef();
+            return stored;
         }
+
+        return tracked;
     }
 
     /// <summary>
@@ -98,84 +124,137 @@ internal sealed class TrackedObjectStore
     /// <returns>A tracked hyperlink object (new or existing with added ref).</returns>
     public TrackedObject<HyperlinkData> GetOrCreateHyperlink(string uri, string parameters)
     {
-        var hash = HyperlinkData.ComputeHash(uri, parameters);
-
-        lock (_lock)
+        if (_hyperlinkByValue.TryGetValue((uri, parameters), out var existing))
         {
-            if (_hyperlinkByHash.TryGetValue(hash, out var existing))
-            {
-                // Found existing - add a reference and return it
-                existing.AddRef();
-                return existing;
-            }
+            // Found existing (possibly retired) - add a reference and return it
+            existing.AddRef();
+            return existing;
+        }
 
-            // Create the data
-            var hyperlinkData = new HyperlinkData(uri, parameters, hash);
-            
-            // Create new tracked wrapper with removal callback
-            var tracked = new TrackedObject<HyperlinkData>(
-                hyperlinkData,
-                onZeroRefs: obj => RemoveHyperlink(obj.Data));
+        var tracked = new TrackedObject<HyperlinkData>(
+            new HyperlinkData(uri, parameters),
+            onZeroRefs: _retiredHyperlinks.Enqueue);
 
-            _hyperlinkByHash[hash] = tracked;
-            return tracked;
+        // Another thread may have added the same link since the lookup; share theirs
+        var stored = _hyperlinkByValue.GetOrAdd((uri, parameters), tracked);
+        if (!ReferenceEquals(stored, tracked))
+        {
+            stored.AddRef();
         }
+
+        return stored;
     }
 
     /// <summary>
-    /// Clears all tracked objects, resetting the store.
+    /// Stores an uploaded kitty image under its ID. The store holds the upload's reference;
+    /// an image previously uploaded under the ID has its upload reference released.
     /// </summary>
-    /// <remarks>
-    /// This does not decrement reference counts - it's a hard reset.
-    /// Use only when disposing the terminal or in tests.
-    /// </remarks>
-    public void Clear()
+    /// <param name="image">The uploaded image.</param>
+    public void AddKittyImage(KittyImageData image)
     {
-        lock (_lock)
+        // Replaced and freed images are taken out of the map before their upload reference
+        // is released, so there is nothing to remove when the last placement lets go
+        var tracked = new TrackedObject<KittyImageData>(image, onZeroRefs: static _ => { });
+
+        while (true)
         {
-            _sixelByHash.Clear();
-            _hyperlinkByHash.Clear();
+            if (_kittyImageById.TryGetValue(image.Id, out var replaced))
+            {
+                if (_kittyImageById.TryUpdate(image.Id, tracked, replaced))
+                {
+                    // Placements may still hold the old image
+                    replaced.Release();
+                    return;
+                }
+            }
+            else if (_kittyImageById.TryAdd(image.Id, tracked))
+            {
+                return;
+            }
         }
     }
 
-    private void RemoveSixel(SixelData sixel)
+    /// <summary>
+    /// Gets the kitty image uploaded under <paramref name="id"/> with a reference added for
+    /// the caller, or null if there is none.
+    /// </summary>
+    /// <param name="id">The image ID.</param>
+    public TrackedObject<KittyImageData>? GetKittyImage(uint id)
     {
-        lock (_lock)
-        {
-            _sixelByHash.Remove(sixel.ContentHash);
-        }
+        if (!_kittyImageById.TryGetValue(id, out var tracked))
+            return null;
+
+        tracked.AddRef();
+        return tracked;
     }
 
-    private void RemoveHyperlink(HyperlinkData hyperlink)
+    /// <summary>
+    /// Frees the kitty image uploaded under <paramref name="id"/>, releasing the upload's
+    /// reference. Placements still showing it keep it alive until they are deleted.
+    /// </summary>
+    /// <param name="id">The image ID.</param>
+    public void FreeKittyImage(uint id)
     {
-        lock (_lock)
+        if (_kittyImageById.TryRemove(id, out var tracked))
         {
-            _hyperlinkByHash.Remove(hyperlink.ContentHash);
+            tracked.Release();
         }
     }
 
     /// <summary>
-    /// Comparer for byte arrays used as dictionary keys.
+    /// Removes retired objects that nothing has referenced again since they were retired.
     /// </summary>
-    private sealed class ByteArrayComparer : IEqualityComparer<byte[]>
+    /// <remarks>
+    /// <para>
+    /// An entry is only removed if it still maps to the retired object, so a colliding Sixel
+    /// that was never stored, or an object retired twice, leaves the map alone.
+    /// </para>
+    /// <para>
+    /// A lookup on another thread can take a reference between the check and the removal. An
+    /// object referenced again by the time it is removed is put back. One that is found just
+    /// before the removal but referenced just after stays valid for whoever holds it, it is
+    /// only no longer shared: the next lookup creates a new object for the same content.
+    /// </para>
+    /// </remarks>
+    public void Reclaim()
     {
-        public static readonly ByteArrayComparer Instance = new();
-
-        public bool Equals(byte[]? x, byte[]? y)
+        while (_retiredSixels.TryDequeue(out var sixel))
         {
-            if (x is null && y is null) return true;
-            if (x is null || y is null) return false;
-            return x.AsSpan().SequenceEqual(y.AsSpan());
+            var key = sixel.Data.ContentHash;
+            if (sixel.RefCount == 0
+                && _sixelByHash.TryRemove(KeyValuePair.Create(key, sixel))
+                && sixel.RefCount > 0)
+            {
+                // Taken again while it was being removed; unless the key was reused, it goes back
+                _sixelByHash.TryAdd(key, sixel);
+            }
         }
 
-        public int GetHashCode(byte[] obj)
+        while (_retiredHyperlinks.TryDequeue(out var hyperlink))
         {
-            // Use first 4 bytes of hash as the hashcode
-            if (obj.Length >= 4)
+            var key = (hyperlink.Data.Uri, hyperlink.Data.Parameters);
+            if (hyperlink.RefCount == 0
+                && _hyperlinkByValue.TryRemove(KeyValuePair.Create(key, hyperlink))
+                && hyperlink.RefCount > 0)
             {
-                return BitConverter.ToInt32(obj, 0);
+                _hyperlinkByValue.TryAdd(key, hyperlink);
             }
-            return obj.Length > 0 ? obj[0] : 0;
         }
     }
+
+    /// <summary>
+    /// Clears all tracked objects, resetting the store.
+    /// </summary>
+    /// <remarks>
+    /// This does not decrement reference counts - it's a hard reset.
+    /// Use only when disposing the terminal or in tests.
+    /// </remarks>
+    public void Clear()
+    {
+        _sixelByHash.Clear();
+        _hyperlinkByValue.Clear();
+        _kittyImageById.Clear();
+        _retiredSixels.Clear();
+        _retiredHyperlinks.Clear();
+    }
 }
@@ -1,11 +1,18 @@
+using System.Buffers;
 using System.Runtime.InteropServices;
 using System.Runtime.Versioning;
+using System.Threading.Channels;
 
 namespace Hex1b.Terminal;
 
 /// <summary>
 /// Unix (Linux/macOS) console driver using termios for raw mode.
 /// </summary>
+/// <remarks>
+/// While in raw mode a dedicated reader thread blocks in <c>poll()</c> on stdin and a wake pipe.
+/// Each read fills a pooled buffer that is queued to <see cref="ReadAsync"/>, so input is
+/// delivered as soon as <c>read()</c> returns and cancelling a read doesn't wait on a timeout.
+/// </remarks>
 [SupportedOSPlatform("linux")]
 [SupportedOSPlatform("macos")]
 internal sealed class UnixConsoleDriver : IConsoleDriver
@@ -45,6 +52,17 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
     
     // poll() constants
     private const short POLLIN = 0x0001;
+    private const short POLLERR = 0x0008;
+    private const short POLLHUP = 0x0010;
+    
+    // errno values
+    private const int EINTR = 4;
+    private const int EAGAIN_LINUX = 11;
+    private const int EAGAIN_MACOS = 35;
+    
+    // Size of each pooled input buffer, and how many filled buffers may wait for the consumer
+    private const int InputChunkSize = 4096;
+    private const int MaxQueuedInputChunks = 64;
     
     private byte[]? _originalTermios;
     private bool _inRawMode;
@@ -53,6 +71,25 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
     private int _lastHeight;
     private bool _disposed;
     
+    // Reader thread state, live only while in raw mode
+    private Thread? _readerThread;
+    private Channel<InputChunk>? _inputChunks;
+    private int _wakeReadFd = -1;
+    private int _wakeWriteFd = -1;
+    private CancellationTokenSource? _readerStop;
+    
+    // Remainder of a chunk that didn't fit in the caller's buffer
+    private InputChunk _pendingChunk;
+    private int _pendingOffset;
+    
+    /// <summary>
+    /// A pooled buffer filled by the reader thread.
+    /// </summary>
+    private readonly record struct InputChunk(byte[] Buffer, int Count)
+    {
+        public bool IsEmpty => Buffer is null;
+    }
+    
     public UnixConsoleDriver()
     {
         if (!OperatingSystem.IsLinux() && !OperatingSystem.IsMacOS())
@@ -126,12 +163,17 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
         
         // Also disable Ctrl+C handling at .NET level
         Console.TreatControlCAsInput = true;
+        
+        StartReader();
     }
     
     public void ExitRawMode()
     {
         if (!_inRawMode || _originalTermios == null) return;
         
+        // Stop reading before leaving raw mode so cooked-mode input stays with the shell
+        StopReader();
+        
         tcsetattr(STDIN_FILENO, TCSAFLUSH, _originalTermios);
         _inRawMode = false;
         Console.TreatControlCAsInput = false;
@@ -153,6 +195,9 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
         {
             if (!_inRawMode) return false;
             
+            if (!_pendingChunk.IsEmpty || (_inputChunks?.Reader.Count ?? 0) > 0)
+                return true;
+            
             // Use poll() to check if stdin has data
             var pfd = new PollFd { fd = STDIN_FILENO, events = POLLIN, revents = 0 };
             var result = poll(ref pfd, 1, 0); // timeout=0 for non-blocking check
@@ -162,58 +207,206 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
     
     public async ValueTask<int> ReadAsync(Memory<byte> buffer, CancellationToken ct = default)
     {
-        if (!_inRawMode)
+        if (!_inRawMode || _inputChunks == null)
         {
             throw new InvalidOperationException("Must enter raw mode before reading");
         }
         
-        // Use Task.Run to offload the blocking read() call to a thread pool thread
-        // This allows proper cancellation handling
-        return await Task.Run(() =>
+        if (_pendingChunk.IsEmpty)
+        {
+            try
+            {
+                if (!_inputChunks.Reader.TryRead(out _pendingChunk))
+                {
+                    _pendingChunk = await _inputChunks.Reader.ReadAsync(ct);
+                }
+            }
+            catch (OperationCanceledException)
+            {
+                return 0; // Cancelled
+            }
+            catch (ChannelClosedException)
+            {
+                return 0; // EOF or reader stopped
+            }
+            _pendingOffset = 0;
+        }
+        
+        // Hand out as much of the current chunk as fits; keep the rest for the next read
+        var available = _pendingChunk.Count - _pendingOffset;
+        var count = Math.Min(available, buffer.Length);
+        _pendingChunk.Buffer.AsSpan(_pendingOffset, count).CopyTo(buffer.Span);
+        _pendingOffset += count;
+        
+        if (_pendingOffset == _pendingChunk.Count)
         {
-            while (!ct.IsCancellationRequested)
+            ArrayPool<byte>.Shared.Return(_pendingChunk.Buffer);
+            _pendingChunk = default;
+        }
+        
+        return count;
+    }
+    
+    private void StartReader()
+    {
+        unsafe
+        {
+            var fds = stackalloc int[2];
+            if (pipe(fds) != 0)
             {
-                // Poll with a short timeout to allow cancellation checks
-                var pfd = new PollFd { fd = STDIN_FILENO, events = POLLIN, revents = 0 };
-                var pollResult = poll(ref pfd, 1, 100); // 100ms timeout
+                var errno = Marshal.GetLastPInvokeError();
+                throw new InvalidOperationException($"pipe() failed with errno {errno}");
+            }
+            _wakeReadFd = fds[0];
+            _wakeWriteFd = fds[1];
+        }
+        
+        _readerStop = new CancellationTokenSource();
+        _inputChunks = Channel.CreateBounded<InputChunk>(new BoundedChannelOptions(MaxQueuedInputChunks)
+        {
+            SingleReader = false, // DrainInput may discard chunks while a read is pending
+            SingleWriter = true,
+            FullMode = BoundedChannelFullMode.Wait
+        });
+        
+        _readerThread = new Thread(ReaderLoop)
+        {
+            IsBackground = true,
+            Name = "Hex1b stdin reader"
+        };
+        _readerThread.Start((_inputChunks.Writer, _readerStop.Token));
+    }
+    
+    private void StopReader()
+    {
+        if (_readerThread == null) return;
+        
+        _readerStop!.Cancel();
+        WakeReader();
+        _readerThread.Join();
+        _readerThread = null;
+        _readerStop.Dispose();
+        _readerStop = null;
+        
+        // Release anything the consumer never picked up
+        ReturnQueuedInput();
+        
+        close(_wakeReadFd);
+        close(_wakeWriteFd);
+        _wakeReadFd = -1;
+        _wakeWriteFd = -1;
+    }
+    
+    private void WakeReader()
+    {
+        unsafe
+        {
+            byte signal = 1;
+            write(_wakeWriteFd, &signal, 1);
+        }
+    }
+    
+    private void ReaderLoop(object? state)
+    {
+        var (writer, stopToken) = ((ChannelWriter<InputChunk>, CancellationToken))state!;
+        var fds = new PollFd[2];
+        Exception? error = null;
+        
+        try
+        {
+            while (!stopToken.IsCancellationRequested)
+            {
+                fds[0] = new PollFd { fd = STDIN_FILENO, events = POLLIN, revents = 0 };
+                fds[1] = new PollFd { fd = _wakeReadFd, events = POLLIN, revents = 0 };
                 
+                // Block until input arrives or we're woken to stop - no timeout needed
+                var pollResult = poll(ref fds[0], 2, -1);
                 if (pollResult < 0)
                 {
                     var errno = Marshal.GetLastPInvokeError();
-                    if (errno == 4) // EINTR - interrupted, retry
+                    if (errno == EINTR)
                         continue;
                     throw new InvalidOperationException($"poll() failed with errno {errno}");
                 }
                 
-                if (pollResult == 0)
-                {
-                    // Timeout, check cancellation and retry
+                if (stopToken.IsCancellationRequested || (fds[1].revents & POLLIN) != 0)
+                    break;
+                
+                if ((fds[0].revents & (POLLIN | POLLHUP | POLLERR)) == 0)
                     continue;
-                }
                 
-                if ((pfd.revents & POLLIN) != 0)
+                var buffer = ArrayPool<byte>.Shared.Rent(InputChunkSize);
+                nint bytesRead;
+                unsafe
                 {
-                    // Data available, read it
-                    unsafe
+                    fixed (byte* ptr = buffer)
                     {
-                        fixed (byte* ptr = buffer.Span)
-                        {
-                            var bytesRead = read(STDIN_FILENO, ptr, (nuint)buffer.Length);
-                            if (bytesRead < 0)
-                            {
-                                var errno = Marshal.GetLastPInvokeError();
-                                if (errno == 4) // EINTR
-                                    continue;
-                                throw new InvalidOperationException($"read() failed with errno {errno}");
-                            }
-                            return (int)bytesRead;
-                        }
+                        bytesRead = read(STDIN_FILENO, ptr, (nuint)buffer.Length);
                     }
                 }
+                
+                if (bytesRead <= 0)
+                {
+                    ArrayPool<byte>.Shared.Return(buffer);
+                    
+                    if (bytesRead == 0)
+                        break; // EOF
+                    
+                    var errno = Marshal.GetLastPInvokeError();
+                    if (errno == EINTR || errno == EAGAIN_LINUX || errno == EAGAIN_MACOS)
+                        continue;
+                    throw new InvalidOperationException($"read() failed with errno {errno}");
+                }
+                
+                if (!TryEnqueue(writer, new InputChunk(buffer, (int)bytesRead), stopToken))
+                {
+                    ArrayPool<byte>.Shared.Return(buffer);
+                    break;
+                }
             }
-            
-            return 0; // Cancelled
-        }, ct);
+        }
+        catch (Exception ex)
+        {
+            error = ex;
+        }
+        
+        writer.TryComplete(error);
+    }
+    
+    private static bool TryEnqueue(ChannelWriter<InputChunk> writer, InputChunk chunk, CancellationToken stopToken)
+    {
+        // The queue is bounded so a consumer that stops reading eventually
+        // leaves input in the kernel buffer instead of growing without limit.
+        try
+        {
+            while (!writer.TryWrite(chunk))
+            {
+                if (!writer.WaitToWriteAsync(stopToken).AsTask().GetAwaiter().GetResult())
+                    return false;
+            }
+            return true;
+        }
+        catch (OperationCanceledException)
+        {
+            return false;
+        }
+    }
+    
+    private void ReturnQueuedInput()
+    {
+        if (!_pendingChunk.IsEmpty)
+        {
+            ArrayPool<byte>.Shared.Return(_pendingChunk.Buffer);
+            _pendingChunk = default;
+        }
+        
+        if (_inputChunks != null)
+        {
+            while (_inputChunks.Reader.TryRead(out var chunk))
+            {
+                ArrayPool<byte>.Shared.Return(chunk.Buffer);
+            }
+        }
     }
     
     public void Write(ReadOnlySpan<byte> data)
@@ -230,7 +423,7 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
                     if (written < 0)
                     {
                         var errno = Marshal.GetLastPInvokeError();
-                        if (errno == 4) // EINTR
+                        if (errno == EINTR)
                             continue;
                         throw new InvalidOperationException($"write() failed with errno {errno}");
                     }
@@ -241,6 +434,72 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
         }
     }
     
+    public void WriteVectored(ReadOnlySpan<ReadOnlyMemory<byte>> segments)
+    {
+        if (segments.Length == 0) return;
+        if (segments.Length == 1)
+        {
+            Write(segments[0].Span);
+            return;
+        }
+        
+        var handles = new MemoryHandle[segments.Length];
+        try
+        {
+            for (var i = 0; i < segments.Length; i++)
+            {
+                handles[i] = segments[i].Pin();
+            }
+            
+            unsafe
+            {
+                var count = Math.Min(segments.Length, IOV_MAX);
+                var iov = stackalloc IoVec[count];
+                var next = 0; // First segment not yet handed to writev
+                
+                while (next < segments.Length)
+                {
+                    // Fill the iovec array with as many remaining segments as fit
+                    var iovCount = 0;
+                    for (var i = next; i < segments.Length && iovCount < count; i++)
+                    {
+                        iov[iovCount++] = new IoVec { iov_base = handles[i].Pointer, iov_len = (nuint)segments[i].Length };
+                    }
+                    
+                    var written = writev(STDOUT_FILENO, iov, iovCount);
+                    if (written < 0)
+                    {
+                        var errno = Marshal.GetLastPInvokeError();
+                        if (errno == EINTR)
+                            continue;
+                        throw new InvalidOperationException($"writev() failed with errno {errno}");
+                    }
+                    
+                    // Skip fully written segments, then finish a partially written one with write()
+                    var remaining = (long)written;
+                    while (next < segments.Length && remaining >= segments[next].Length)
+                    {
+                        remaining -= segments[next].Length;
+                        next++;
+                    }
+                    
+                    if (remaining > 0)
+                    {
+                        Write(segments[next].Span[(int)remaining..]);
+                        next++;
+                    }
+                }
+            }
+        }
+        finally
+        {
+            foreach (var handle in handles)
+            {
+                handle.Dispose();
+            }
+        }
+    }
+    
     public void Flush()
     {
         // stdout is typically line-buffered or unbuffered when connected to a terminal
@@ -251,6 +510,12 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
     {
         if (!_inRawMode) return;
         
+        // Discard input the reader thread has already queued
+        while (_inputChunks != null && _inputChunks.Reader.TryRead(out var chunk))
+        {
+            ArrayPool<byte>.Shared.Return(chunk.Buffer);
+        }
+        
         // Use poll() to check for and drain any pending input
         var buffer = new byte[256];
         var pfd = new PollFd { fd = STDIN_FILENO, events = POLLIN, revents = 0 };
@@ -304,6 +569,26 @@ internal sealed class UnixConsoleDriver : IConsoleDriver
     [DllImport("libc", SetLastError = true)]
     private static extern unsafe nint write(int fd, byte* buf, nuint count);
     
+    // P/Invoke for writev()
+    private const int IOV_MAX = 1024;
+    
+    [StructLayout(LayoutKind.Sequential)]
+    private unsafe struct IoVec
+    {
+        public void* iov_base;
+        public nuint iov_len;
+    }
+    
+    [DllImport("libc", SetLastError = true)]
+    private static extern unsafe nint writev(int fd, IoVec* iov, int iovcnt);
+    
+    // P/Invoke declarations for the reader thread's wake pipe
+    [DllImport("libc", SetLastError = true)]
+    private static extern unsafe int pipe(int* fds);
+    
+    [DllImport("libc", SetLastError = true)]
+    private static extern int close(int fd);
+    
     // P/Invoke for poll()
     [StructLayout(LayoutKind.Sequential)]
     private struct PollFd
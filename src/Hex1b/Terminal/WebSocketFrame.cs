@@ -0,0 +1,69 @@
+using System.Buffers.Binary;
+
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Message layout for the binary WebSocket protocol described on <see cref="WebSocketPresentationOptions"/>.
+/// </summary>
+internal static class WebSocketFrame
+{
+    public const byte Output = 0x01;
+    public const byte Input = 0x02;
+    public const byte Resize = 0x03;
+    public const byte Ping = 0x04;
+    public const byte Pong = 0x05;
+
+    public const byte FlagCompressed = 0x01;
+
+    /// <summary>Size of the type and flags bytes every message starts with.</summary>
+    public const int HeaderSize = 2;
+
+    /// <summary>Size of the output message header: type, flags and sequence number.</summary>
+    public const int OutputHeaderSize = HeaderSize + sizeof(uint);
+
+    /// <summary>Largest ping payload, matching the WebSocket control frame limit.</summary>
+    public const int MaxPingPayload = 125;
+
+    public static void WriteOutputHeader(Span<byte> destination, uint sequence, bool compressed)
+    {
+        destination[0] = Output;
+        destination[1] = compressed ? FlagCompressed : (byte)0;
+        BinaryPrimitives.WriteUInt32LittleEndian(destination[HeaderSize..], sequence);
+    }
+
+    public static bool TryReadOutputHeader(ReadOnlySpan<byte> message, out uint sequence, out bool compressed)
+    {
+        if (message.Length < OutputHeaderSize || message[0] != Output)
+        {
+            sequence = 0;
+            compressed = false;
+            return false;
+        }
+
+        compressed = (message[1] & FlagCompressed) != 0;
+        sequence = BinaryPrimitives.ReadUInt32LittleEndian(message[HeaderSize..]);
+        return true;
+    }
+
+    public static void WriteResize(Span<byte> destination, int width, int height)
+    {
+        destination[0] = Resize;
+        destination[1] = 0;
+        BinaryPrimitives.WriteUInt16LittleEndian(destination[HeaderSize..], (ushort)width);
+        BinaryPrimitives.WriteUInt16LittleEndian(destination[(HeaderSize + 2)..], (ushort)height);
+    }
+
+    public static bool TryReadResize(ReadOnlySpan<byte> message, out int width, out int height)
+    {
+        if (message.Length < HeaderSize + 4)
+        {
+            width = 0;
+            height = 0;
+            return false;
+        }
+
+        width = BinaryPrimitives.ReadUInt16LittleEndian(message[HeaderSize..]);
+        height = BinaryPrimitives.ReadUInt16LittleEndian(message[(HeaderSize + 2)..]);
+        return width > 0 && height > 0;
+    }
+}
@@ -1,6 +1,9 @@
+using System.Buffers;
+using System.Buffers.Binary;
+using System.Diagnostics;
+using System.IO.Compression;
 using System.Net.WebSockets;
 using System.Text;
-using System.Text.Json;
 using Hex1b.Input;
 
 namespace Hex1b.Terminal;
@@ -12,11 +15,33 @@ namespace Hex1b.Terminal;
 /// This adapter implements <see cref="IHex1bTerminalPresentationAdapter"/> for
 /// WebSocket connections, allowing Hex1b applications to run in web browsers
 /// through xterm.js or similar terminal emulators.
+/// <para>
+/// Clients can opt into the binary protocol described on <see cref="WebSocketPresentationOptions"/>,
+/// which sends each frame as one sequenced (and optionally compressed) message and carries resize
+/// and ping as typed control messages. Input is received into a pooled buffer, so the memory
+/// returned by <see cref="ReadInputAsync"/> is only valid until the next call.
+/// </para>
 /// </remarks>
 public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAdapter
 {
+    private const int InitialReceiveBufferSize = 4096;
+    private const int MaxReceiveMessageSize = 1024 * 1024;
+
     private readonly WebSocket _webSocket;
+    private readonly WebSocketPresentationOptions _options;
+    private readonly SemaphoreSlim _sendLock = new(1, 1);
     private readonly CancellationTokenSource _disposeCts = new();
+    private byte[] _receiveBuffer;
+
+    // Binary protocol output: the frame is assembled after a reserved header
+    private byte[]? _frameBuffer;
+    private int _frameLength = WebSocketFrame.OutputHeaderSize;
+    private uint _sequence;
+    private MemoryStream? _compressedFrame;
+    private DeflateStream? _deflater;
+    private long _pingTimestamp;
+    private TimeSpan? _roundTripTime;
+
     private bool _disposed;
     private bool _inTuiMode;
     private int _width;
@@ -37,12 +62,34 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
     /// <param name="width">Initial terminal width in columns.</param>
     /// <param name="height">Initial terminal height in rows.</param>
     /// <param name="enableMouse">Whether to enable mouse tracking.</param>
-    public WebSocketPresentationAdapter(WebSocket webSocket, int width, int height, bool enableMouse = false)
+    /// <param name="options">
+    /// Protocol options. When null, the protocol is chosen from the subprotocol the connection
+    /// was accepted with (see <see cref="WebSocketPresentationOptions.FromSubProtocol"/>).
+    /// </param>
+    public WebSocketPresentationAdapter(
+        WebSocket webSocket,
+        int width,
+        int height,
+        bool enableMouse = false,
+        WebSocketPresentationOptions? options = null)
     {
         _webSocket = webSocket ?? throw new ArgumentNullException(nameof(webSocket));
         _width = width;
         _height = height;
         _enableMouse = enableMouse;
+        _options = options ?? WebSocketPresentationOptions.FromSubProtocol(webSocket.SubProtocol);
+        _receiveBuffer = ArrayPool<byte>.Shared.Rent(InitialReceiveBufferSize);
+
+        if (_options.UseBinaryFraming)
+        {
+            _frameBuffer = ArrayPool<byte>.Shared.Rent(InitialReceiveBufferSize);
+
+            if (_options.Compression == WebSocketCompression.Deflate)
+            {
+                _compressedFrame = new MemoryStream();
+                _deflater = new DeflateStream(_compressedFrame, CompressionLevel.Fastest, leaveOpen: true);
+            }
+        }
     }
 
     /// <inheritdoc />
@@ -61,6 +108,17 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
         SupportsBracketedPaste = true
     };
 
+    /// <summary>
+    /// Gets whether the connection uses the binary protocol.
+    /// </summary>
+    public bool UsesBinaryFraming => _options.UseBinaryFraming;
+
+    /// <summary>
+    /// Gets the round-trip time measured by the last answered <see cref="SendPingAsync"/>,
+    /// or null if none has been answered.
+    /// </summary>
+    public TimeSpan? RoundTripTime => _roundTripTime;
+
     /// <inheritdoc />
     public event Action<int, int>? Resized;
 
@@ -83,77 +141,98 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
     }
 
     /// <inheritdoc />
-    public async ValueTask WriteOutputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
+    public ValueTask WriteOutputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
     {
         if (_disposed || _webSocket.State != WebSocketState.Open)
-            return;
+            return ValueTask.CompletedTask;
 
-        try
+        if (!_options.UseBinaryFraming)
         {
-            using var linkedCts = CancellationTokenSource.CreateLinkedTokenSource(ct, _disposeCts.Token);
             // Use Text message type since terminal output is UTF-8 and JavaScript expects strings
-            await _webSocket.SendAsync(data, WebSocketMessageType.Text, endOfMessage: true, linkedCts.Token);
+            return SendAsync(data, WebSocketMessageType.Text, ct);
         }
-        catch (WebSocketException)
+
+        // Binary protocol: collect the frame and send it on flush
+        var required = _frameLength + data.Length;
+        if (required > _frameBuffer!.Length)
         {
-            // Connection closed
+            var larger = ArrayPool<byte>.Shared.Rent(Math.Max(required, _frameBuffer.Length * 2));
+            _frameBuffer.AsSpan(0, _frameLength).CopyTo(larger);
+            ArrayPool<byte>.Shared.Return(_frameBuffer);
+            _frameBuffer = larger;
         }
-        catch (OperationCanceledException)
+
+        data.Span.CopyTo(_frameBuffer.AsSpan(_frameLength));
+        _frameLength += data.Length;
+
+        if (_frameLength - WebSocketFrame.OutputHeaderSize >= _options.MaxFrameBytes)
         {
-            // Cancelled
+            return SendFrameAsync(ct);
         }
+
+        return ValueTask.CompletedTask;
     }
 
     /// <inheritdoc />
     public async ValueTask<ReadOnlyMemory<byte>> ReadInputAsync(CancellationToken ct = default)
     {
-        if (_disposed || _webSocket.State != WebSocketState.Open)
-            return ReadOnlyMemory<byte>.Empty;
-
-        var buffer = new byte[4096];
-        
         try
         {
             using var linkedCts = CancellationTokenSource.CreateLinkedTokenSource(ct, _disposeCts.Token);
-            var result = await _webSocket.ReceiveAsync(buffer.AsMemory(), linkedCts.Token);
-            
-            if (result.MessageType == WebSocketMessageType.Close)
-            {
-                return ReadOnlyMemory<byte>.Empty;
-            }
-            
-            // Check for resize message (custom protocol)
-            if (result.MessageType == WebSocketMessageType.Text)
+
+            while (!_disposed && _webSocket.State == WebSocketState.Open)
             {
-                var text = Encoding.UTF8.GetString(buffer, 0, result.Count);
-                
-                // Handle JSON format: {"type":"resize","cols":80,"rows":24}
-                if (text.StartsWith("{") && text.Contains("resize"))
+                var (messageType, count) = await ReceiveMessageAsync(linkedCts.Token);
+                if (messageType == WebSocketMessageType.Close)
+                {
+                    return ReadOnlyMemory<byte>.Empty;
+                }
+
+                var message = _receiveBuffer.AsMemory(0, count);
+
+                if (messageType == WebSocketMessageType.Text)
                 {
-                    if (TryParseJsonResize(text, out var newWidth, out var newHeight))
-                    {
-                        Resize(newWidth, newHeight);
-                        // Return empty for resize messages - not actual input
-                        return await ReadInputAsync(ct);
-                    }
+                    // Resize messages aren't input; wait for the next message
+                    if (TryHandleTextResize(message.Span))
+                        continue;
+
+                    return message;
                 }
-                
-                // Handle legacy format: resize:80,24
-                if (text.StartsWith("resize:"))
+
+                if (!_options.UseBinaryFraming || count < WebSocketFrame.HeaderSize)
                 {
-                    var parts = text[7..].Split(',');
-                    if (parts.Length == 2 && 
-                        int.TryParse(parts[0], out var width) && 
-                        int.TryParse(parts[1], out var height))
-                    {
-                        Resize(width, height);
-                        // Return empty for resize messages - not actual input
-                        return await ReadInputAsync(ct);
-                    }
+                    return message;
+                }
+
+                switch (message.Span[0])
+                {
+                    case WebSocketFrame.Input when count > WebSocketFrame.HeaderSize:
+                        return message[WebSocketFrame.HeaderSize..];
+
+                    case WebSocketFrame.Resize:
+                        if (WebSocketFrame.TryReadResize(message.Span, out var width, out var height))
+                        {
+                            Resize(width, height);
+                        }
+                        break;
+
+                    case WebSocketFrame.Ping when count <= WebSocketFrame.HeaderSize + WebSocketFrame.MaxPingPayload:
+                        // Answer in place: the pong carries the ping's payload back
+                        _receiveBuffer[0] = WebSocketFrame.Pong;
+                        await SendAsync(message, WebSocketMessageType.Binary, linkedCts.Token);
+                        break;
+
+                    case WebSocketFrame.Pong when count == WebSocketFrame.HeaderSize + sizeof(long):
+                        var sent = BinaryPrimitives.ReadInt64LittleEndian(message.Span[WebSocketFrame.HeaderSize..]);
+                        if (sent == Interlocked.Read(ref _pingTimestamp))
+                        {
+                            _roundTripTime = Stopwatch.GetElapsedTime(sent);
+                        }
+                        break;
                 }
             }
-            
-            return buffer.AsMemory(0, result.Count);
+
+            return ReadOnlyMemory<byte>.Empty;
         }
         catch (WebSocketException)
         {
@@ -163,13 +242,38 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
         {
             return ReadOnlyMemory<byte>.Empty;
         }
+        catch (ObjectDisposedException)
+        {
+            return ReadOnlyMemory<byte>.Empty;
+        }
     }
 
     /// <inheritdoc />
     public ValueTask FlushAsync(CancellationToken ct = default)
     {
-        // WebSocket sends are typically already unbuffered
-        return ValueTask.CompletedTask;
+        // Text messages are sent as they are written; binary frames are sent here
+        if (_disposed || !_options.UseBinaryFraming)
+            return ValueTask.CompletedTask;
+
+        return SendFrameAsync(ct);
+    }
+
+    /// <summary>
+    /// Sends a ping to the client. When the pong arrives, <see cref="RoundTripTime"/> is updated.
+    /// Does nothing unless the connection uses the binary protocol.
+    /// </summary>
+    public ValueTask SendPingAsync(CancellationToken ct = default)
+    {
+        if (_disposed || !_options.UseBinaryFraming)
+            return ValueTask.CompletedTask;
+
+        var timestamp = Stopwatch.GetTimestamp();
+        Interlocked.Exchange(ref _pingTimestamp, timestamp);
+
+        var ping = new byte[WebSocketFrame.HeaderSize + sizeof(long)];
+        ping[0] = WebSocketFrame.Ping;
+        BinaryPrimitives.WriteInt64LittleEndian(ping.AsSpan(WebSocketFrame.HeaderSize), timestamp);
+        return SendAsync(ping, WebSocketMessageType.Binary, ct);
     }
 
     /// <inheritdoc />
@@ -189,6 +293,7 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
         escapes.Append(MoveCursorHome);
 
         await WriteOutputAsync(Encoding.UTF8.GetBytes(escapes.ToString()), ct);
+        await FlushAsync(ct);
     }
 
     /// <inheritdoc />
@@ -206,6 +311,7 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
         escapes.Append(ExitAlternateBuffer);
 
         await WriteOutputAsync(Encoding.UTF8.GetBytes(escapes.ToString()), ct);
+        await FlushAsync(ct);
     }
 
     /// <inheritdoc />
@@ -235,6 +341,164 @@ public sealed class WebSocketPresentationAdapter : IHex1bTerminalPresentationAda
                 // Ignore close errors
             }
         }
+
+        _deflater?.Dispose();
+        _compressedFrame?.Dispose();
+        if (_frameBuffer != null)
+        {
+            ArrayPool<byte>.Shared.Return(_frameBuffer);
+            _frameBuffer = null;
+        }
+        ArrayPool<byte>.Shared.Return(_receiveBuffer);
+        _receiveBuffer = [];
+    }
+
+    /// <summary>
+    /// Sends one message. WebSocket allows a single outstanding send, and pongs are sent
+    /// from the input loop while frames are sent from the output pump.
+    /// </summary>
+    private async ValueTask SendAsync(ReadOnlyMemory<byte> message, WebSocketMessageType messageType, CancellationToken ct)
+    {
+        if (_webSocket.State != WebSocketState.Open)
+            return;
+
+        var acquired = false;
+        try
+        {
+            using var linkedCts = CancellationTokenSource.CreateLinkedTokenSource(ct, _disposeCts.Token);
+            await _sendLock.WaitAsync(linkedCts.Token);
+            acquired = true;
+            await _webSocket.SendAsync(message, messageType, endOfMessage: true, linkedCts.Token);
+        }
+        catch (WebSocketException)
+        {
+            // Connection closed
+        }
+        catch (OperationCanceledException)
+        {
+            // Cancelled
+        }
+        catch (ObjectDisposedException)
+        {
+            // Disposed while sending
+        }
+        finally
+        {
+            if (acquired)
+            {
+                _sendLock.Release();
+            }
+        }
+    }
+
+    /// <summary>
+    /// Sends the collected output as one sequenced binary message.
+    /// </summary>
+    private async ValueTask SendFrameAsync(CancellationToken ct)
+    {
+        var payloadLength = _frameLength - WebSocketFrame.OutputHeaderSize;
+        if (payloadLength == 0)
+            return;
+
+        var sequence = _sequence++;
+        ReadOnlyMemory<byte> message;
+
+        if (_deflater != null && payloadLength >= _options.CompressionThreshold)
+        {
+            // One deflate stream per connection, sync-flushed so each message decodes on its own
+            // while later frames still reference earlier ones.
+            var compressed = _compressedFrame!;
+            compressed.SetLength(WebSocketFrame.OutputHeaderSize);
+            compressed.Position = WebSocketFrame.OutputHeaderSize;
+            _deflater.Write(_frameBuffer.AsSpan(WebSocketFrame.OutputHeaderSize, payloadLength));
+            _deflater.Flush();
+
+            var buffer = compressed.GetBuffer();
+            WebSocketFrame.WriteOutputHeader(buffer, sequence, compressed: true);
+            message = buffer.AsMemory(0, (int)compressed.Length);
+        }
+        else
+        {
+            WebSocketFrame.WriteOutputHeader(_frameBuffer, sequence, compressed: false);
+            message = _frameBuffer.AsMemory(0, _frameLength);
+        }
+
+        try
+        {
+            await SendAsync(message, WebSocketMessageType.Binary, ct);
+        }
+        finally
+        {
+            _frameLength = WebSocketFrame.OutputHeaderSize;
+        }
+    }
+
+    /// <summary>
+    /// Receives a complete message into the pooled receive buffer, growing it for fragmented
+    /// or oversized messages.
+    /// </summary>
+    private async ValueTask<(WebSocketMessageType MessageType, int Count)> ReceiveMessageAsync(CancellationToken ct)
+    {
+        var count = 0;
+        while (true)
+        {
+            if (count == _receiveBuffer.Length)
+            {
+                if (count >= MaxReceiveMessageSize)
+                {
+                    await _webSocket.CloseAsync(WebSocketCloseStatus.MessageTooBig, "Message too big", ct);
+                    return (WebSocketMessageType.Close, 0);
+                }
+
+                var larger = ArrayPool<byte>.Shared.Rent(count * 2);
+                _receiveBuffer.AsSpan(0, count).CopyTo(larger);
+                ArrayPool<byte>.Shared.Return(_receiveBuffer);
+                _receiveBuffer = larger;
+            }
+
+            var result = await _webSocket.ReceiveAsync(_receiveBuffer.AsMemory(count), ct);
+            if (result.MessageType == WebSocketMessageType.Close)
+            {
+                return (WebSocketMessageType.Close, 0);
+            }
+
+            count += result.Count;
+            if (result.EndOfMessage)
+            {
+                return (result.MessageType, count);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Handles the text protocol's resize messages. Only messages that start like one are decoded.
+    /// </summary>
+    private bool TryHandleTextResize(ReadOnlySpan<byte> message)
+    {
+        // Handle JSON format: {"type":"resize","cols":80,"rows":24}
+        if (message.Length > 0 && message[0] == (byte)'{' && message.IndexOf("resize"u8) >= 0)
+        {
+            if (TryParseJsonResize(Encoding.UTF8.GetString(message), out var newWidth, out var newHeight))
+            {
+                Resize(newWidth, newHeight);
+                return true;
+            }
+        }
+
+        // Handle legacy format: resize:80,24
+        if (message.StartsWith("resize:"u8))
+        {
+            var parts = Encoding.UTF8.GetString(message[7..]).Split(',');
+            if (parts.Length == 2 &&
+                int.TryParse(parts[0], out var width) &&
+                int.TryParse(parts[1], out var height))
+            {
+                Resize(width, height);
+                return true;
+            }
+        }
+
+        return false;
     }
 
     /// <summary>
@@ -0,0 +1,110 @@
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// Options for the wire protocol used by <see cref="WebSocketPresentationAdapter"/>.
+/// </summary>
+/// <remarks>
+/// <para>
+/// By default output is sent as one Text message per chunk and input arrives as Text
+/// messages, with resize requests sent as JSON. Clients that understand the binary protocol
+/// request it with a WebSocket subprotocol, which the server echoes when accepting:
+/// </para>
+/// <list type="bullet">
+/// <item><see cref="BinarySubProtocol"/> - framed binary messages.</item>
+/// <item><see cref="BinaryDeflateSubProtocol"/> - framed binary messages with deflate-compressed output.</item>
+/// </list>
+/// <para>
+/// Every binary message starts with a type byte and a flags byte:
+/// </para>
+/// <list type="table">
+/// <item><term>0x01 output</term><description>server to client: uint32 LE frame sequence number, then the frame's terminal output.
+/// A whole frame is sent as one message. With flag 0x01 the output is raw deflate data compressed with a
+/// single stream for the whole connection and sync-flushed per message, so the client keeps one inflater.</description></item>
+/// <item><term>0x02 input</term><description>client to server: raw terminal input bytes.</description></item>
+/// <item><term>0x03 resize</term><description>client to server: uint16 LE columns, uint16 LE rows.</description></item>
+/// <item><term>0x04 ping</term><description>either direction: opaque payload of up to 125 bytes, answered by a pong.</description></item>
+/// <item><term>0x05 pong</term><description>either direction: the payload of the ping being answered.</description></item>
+/// </list>
+/// </remarks>
+public sealed class WebSocketPresentationOptions
+{
+    /// <summary>
+    /// Subprotocol for framed binary messages without compression.
+    /// </summary>
+    public const string BinarySubProtocol = "hex1b.v1";
+
+    /// <summary>
+    /// Subprotocol for framed binary messages with deflate-compressed output.
+    /// </summary>
+    public const string BinaryDeflateSubProtocol = "hex1b.v1.deflate";
+
+    /// <summary>
+    /// Whether messages use the framed binary protocol. Off by default.
+    /// </summary>
+    public bool UseBinaryFraming { get; set; }
+
+    /// <summary>
+    /// Compression applied to output frames. Only used with binary framing.
+    /// </summary>
+    public WebSocketCompression Compression { get; set; }
+
+    /// <summary>
+    /// Output frames smaller than this many bytes are sent uncompressed.
+    /// </summary>
+    public int CompressionThreshold { get; set; } = 64;
+
+    /// <summary>
+    /// Buffered output above this many bytes is sent without waiting for the end of the frame.
+    /// </summary>
+    public int MaxFrameBytes { get; set; } = 64 * 1024;
+
+    /// <summary>
+    /// Picks the subprotocol to accept from those a client requested, preferring compression.
+    /// </summary>
+    /// <param name="requestedSubProtocols">The subprotocols offered by the client.</param>
+    /// <returns>The subprotocol to accept, or null to use the default text protocol.</returns>
+    public static string? NegotiateSubProtocol(IEnumerable<string> requestedSubProtocols)
+    {
+        string? selected = null;
+        foreach (var requested in requestedSubProtocols)
+        {
+            if (string.Equals(requested, BinaryDeflateSubProtocol, StringComparison.OrdinalIgnoreCase))
+                return BinaryDeflateSubProtocol;
+
+            if (string.Equals(requested, BinarySubProtocol, StringComparison.OrdinalIgnoreCase))
+                selected = BinarySubProtocol;
+        }
+        return selected;
+    }
+
+    /// <summary>
+    /// Creates options matching an accepted subprotocol.
+    /// </summary>
+    /// <param name="subProtocol">The subprotocol of the WebSocket connection, if any.</param>
+    public static WebSocketPresentationOptions FromSubProtocol(string? subProtocol)
+    {
+        if (string.Equals(subProtocol, BinaryDeflateSubProtocol, StringComparison.OrdinalIgnoreCase))
+            return new() { UseBinaryFraming = true, Compression = WebSocketCompression.Deflate };
+
+        if (string.Equals(subProtocol, BinarySubProtocol, StringComparison.OrdinalIgnoreCase))
+            return new() { UseBinaryFraming = true };
+
+        return new();
+    }
+}
+
+/// <summary>
+/// Compression applied to binary WebSocket output frames.
+/// </summary>
+public enum WebSocketCompression
+{
+    /// <summary>
+    /// Output is sent uncompressed.
+    /// </summary>
+    None,
+
+    /// <summary>
+    /// Output is compressed with raw deflate, sharing one compression context per connection.
+    /// </summary>
+    Deflate
+}
@@ -496,6 +496,16 @@ internal sealed class WindowsConsoleDriver : IConsoleDriver
         }
     }
     
+    public void WriteVectored(ReadOnlySpan<ReadOnlyMemory<byte>> segments)
+    {
+        // WriteFile has no gather form for console handles; the segments are
+        // already batched per frame, so issue them back to back.
+        foreach (var segment in segments)
+        {
+            Write(segment.Span);
+        }
+    }
+    
     public void Flush()
     {
         FlushFileBuffers(_outputHandle);
@@ -0,0 +1,105 @@
+using System.Buffers.Binary;
+using System.Numerics;
+using System.Runtime.InteropServices;
+
+namespace Hex1b.Terminal;
+
+/// <summary>
+/// The XXH64 non-cryptographic hash, for content-addressing large payloads such as sixel
+/// images without the cost of a cryptographic hash. Equal hashes do not prove equal content,
+/// so callers compare the content itself before sharing anything.
+/// </summary>
+internal static class XxHash64
+{
+    private const ulong Prime1 = 11400714785074694791UL;
+    private const ulong Prime2 = 14029467366897019727UL;
+    private const ulong Prime3 = 1609587929392839161UL;
+    private const ulong Prime4 = 9650029242287828579UL;
+    private const ulong Prime5 = 2870177450012600261UL;
+
+    /// <summary>
+    /// Hashes the UTF-16 code units of <paramref name="text"/>, without encoding it first.
+    /// </summary>
+    public static ulong Hash(string text, ulong seed = 0)
+        => Hash(MemoryMarshal.AsBytes(text.AsSpan()), seed);
+
+    /// <summary>
+    /// Hashes <paramref name="data"/>.
+    /// </summary>
+    public static ulong Hash(ReadOnlySpan<byte> data, ulong seed = 0)
+    {
+        var length = data.Length;
+        ulong hash;
+
+        if (length >= 32)
+        {
+            var v1 = seed + Prime1 + Prime2;
+            var v2 = seed + Prime2;
+            var v3 = seed;
+            var v4 = seed - Prime1;
+
+            do
+            {
+                v1 = Round(v1, BinaryPrimitives.ReadUInt64LittleEndian(data));
+                v2 = Round(v2, BinaryPrimitives.ReadUInt64LittleEndian(data[8..]));
+                v3 = Round(v3, BinaryPrimitives.ReadUInt64LittleEndian(data[16..]));
+                v4 = Round(v4, BinaryPrimitives.ReadUInt64LittleEndian(data[24..]));
+                data = data[32..];
+            }
+            while (data.Length >= 32);
+
+            hash = BitOperations.RotateLeft(v1, 1) + BitOperations.RotateLeft(v2, 7)
+                + BitOperations.RotateLeft(v3, 12) + BitOperations.RotateLeft(v4, 18);
+            hash = MergeRound(hash, v1);
+            hash = MergeRound(hash, v2);
+            hash = MergeRound(hash, v3);
+            hash = MergeRound(hash, v4);
+        }
+        else
+        {
+            hash = seed + Prime5;
+        }
+
+        hash += (ulong)length;
+
+        while (data.Length >= 8)
+        {
+            hash ^= Round(0, BinaryPrimitives.ReadUInt64LittleEndian(data));
+            hash = BitOperations.RotateLeft(hash, 27) * Prime1 + Prime4;
+            data = data[8..];
+        }
+
+        if (data.Length >= 4)
+        {
+            hash ^= BinaryPrimitives.ReadUInt32LittleEndian(data) * Prime1;
+            hash = BitOperations.RotateLeft(hash, 23) * Prime2 + Prime3;
+            data = data[4..];
+        }
+
+        foreach (var b in data)
+        {
+            hash ^= b * Prime5;
+            hash = BitOperations.RotateLeft(hash, 11) * Prime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        hash *= Prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    private static ulong Round(ulong accumulator, ulong input)
+    {
+        accumulator += input * Prime2;
+        accumulator = BitOperations.RotateLeft(accumulator, 31);
+        return accumulator * Prime1;
+    }
+
+    private static ulong MergeRound(ulong accumulator, ulong value)
+    {
+        accumulator ^= Round(0, value);
+        return accumulator * Prime1 + Prime4;
+    }
+}
@@ -0,0 +1,86 @@
+#pragma warning disable HEX1B_SIXEL // Sixel API is experimental - internal usage is allowed
+
+using System.Diagnostics.CodeAnalysis;
+
+namespace Hex1b;
+
+/// <summary>
+/// An RGBA image shown with whichever image protocol the terminal supports: kitty graphics,
+/// where it is uploaded once and then placed by ID, or Sixel.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Each protocol's encoding is built the first time it is needed and kept, so an image
+/// shown every frame is encoded once. Create the image when its pixels are produced and
+/// keep it for as long as it is shown; a new image is a new upload.
+/// </para>
+/// <example>
+/// <code>
+/// var chart = new TerminalImage(RenderChartPixels(), 320, 160);
+/// // Every frame:
+/// ctx.Image(chart, "[chart]", width: 32, height: 8);
+/// </code>
+/// </example>
+/// </remarks>
+[Experimental("HEX1B_IMAGES", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/images.md")]
+public sealed class TerminalImage
+{
+    private static uint _nextId;
+
+    private readonly byte[] _pixels;
+    private string? _kittyTransmission;
+    private SixelImageHandle? _sixel;
+
+    /// <summary>
+    /// Creates an image from RGBA pixels, which are copied.
+    /// </summary>
+    /// <param name="rgba">The pixels, 4 bytes (R, G, B, A) per pixel, row by row.</param>
+    /// <param name="width">The image width in pixels.</param>
+    /// <param name="height">The image height in pixels.</param>
+    public TerminalImage(ReadOnlySpan<byte> rgba, int width, int height)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(width);
+        ArgumentOutOfRangeException.ThrowIfNegativeOrZero(height);
+
+        var length = (long)width * height * 4;
+        if (rgba.Length < length)
+        {
+            throw new ArgumentException($"Expected at least {length} bytes of RGBA data for a {width}x{height} image.", nameof(rgba));
+        }
+
+        _pixels = rgba[..(int)length].ToArray();
+        Width = width;
+        Height = height;
+
+        // Kitty image IDs are 32-bit and 0 means none
+        var id = Interlocked.Increment(ref _nextId);
+        Id = id != 0 ? id : Interlocked.Increment(ref _nextId);
+    }
+
+    /// <summary>
+    /// Gets the image width in pixels.
+    /// </summary>
+    public int Width { get; }
+
+    /// <summary>
+    /// Gets the image height in pixels.
+    /// </summary>
+    public int Height { get; }
+
+    /// <summary>
+    /// Gets the ID the image is uploaded under with kitty graphics.
+    /// </summary>
+    public uint Id { get; }
+
+    /// <summary>
+    /// Gets the kitty graphics commands that upload the image.
+    /// </summary>
+    internal string KittyTransmission
+        => LazyInitializer.EnsureInitialized(ref _kittyTransmission, () => KittyGraphics.Transmit(Id, _pixels, Width, Height));
+
+    /// <summary>
+    /// Gets the image encoded as Sixel.
+    /// </summary>
+    internal SixelImageHandle Sixel
+        => LazyInitializer.EnsureInitialized(ref _sixel, () => SixelEncoder.EncodeImage(_pixels, Width, Height));
+}
@@ -0,0 +1,78 @@
+using System.Text;
+using Hex1b.Theming;
+
+namespace Hex1b;
+
+/// <summary>
+/// The style applied to a <see cref="StyledRun"/>: optional colors plus SGR attributes.
+/// A null color leaves whatever color is currently active in place.
+/// </summary>
+/// <param name="Foreground">The foreground color, or null to inherit.</param>
+/// <param name="Background">The background color, or null to inherit.</param>
+/// <param name="Attributes">Text styling attributes (bold, italic, etc.).</param>
+public readonly record struct TextStyle(
+    Hex1bColor? Foreground = null,
+    Hex1bColor? Background = null,
+    CellAttributes Attributes = CellAttributes.None)
+{
+    /// <summary>A style that emits nothing and inherits the active colors and attributes.</summary>
+    public static TextStyle Inherit => default;
+
+    /// <summary>Gets whether applying this style writes any escape sequences.</summary>
+    public bool IsInherited => Foreground is null && Background is null && Attributes == CellAttributes.None;
+
+    /// <summary>
+    /// Appends the SGR sequence that applies this style. Nothing is appended for an inherited style.
+    /// </summary>
+    internal void AppendSgr(StringBuilder builder)
+    {
+        if (Foreground is { } fg)
+            AppendColor(builder, fg, isForeground: true);
+
+        if (Background is { } bg)
+            AppendColor(builder, bg, isForeground: false);
+
+        if (Attributes == CellAttributes.None)
+            return;
+
+        builder.Append("\x1b[");
+        var first = true;
+        AppendAttribute(builder, CellAttributes.Bold, 1, ref first);
+        AppendAttribute(builder, CellAttributes.Dim, 2, ref first);
+        AppendAttribute(builder, CellAttributes.Italic, 3, ref first);
+        AppendAttribute(builder, CellAttributes.Underline, 4, ref first);
+        AppendAttribute(builder, CellAttributes.Blink, 5, ref first);
+        AppendAttribute(builder, CellAttributes.Reverse, 7, ref first);
+        AppendAttribute(builder, CellAttributes.Hidden, 8, ref first);
+        AppendAttribute(builder, CellAttributes.Strikethrough, 9, ref first);
+        AppendAttribute(builder, CellAttributes.Overline, 53, ref first);
+        builder.Append('m');
+    }
+
+    // Same sequences as Hex1bColor.ToForegroundAnsi/ToBackgroundAnsi, written without
+    // allocating an intermediate string per run.
+    private static void AppendColor(StringBuilder builder, Hex1bColor color, bool isForeground)
+    {
+        if (color.IsDefault)
+        {
+            builder.Append(isForeground ? "\x1b[39m" : "\x1b[49m");
+            return;
+        }
+
+        builder.Append(isForeground ? "\x1b[38;2;" : "\x1b[48;2;")
+            .Append(color.R).Append(';')
+            .Append(color.G).Append(';')
+            .Append(color.B).Append('m');
+    }
+
+    private void AppendAttribute(StringBuilder builder, CellAttributes attribute, int code, ref bool first)
+    {
+        if ((Attributes & attribute) == 0)
+            return;
+
+        if (!first)
+            builder.Append(';');
+        builder.Append(code);
+        first = false;
+    }
+}
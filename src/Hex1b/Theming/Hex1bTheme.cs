@@ -3,15 +3,34 @@ namespace Hex1b.Theming;
 /// <summary>
 /// A theme containing values for various UI elements.
 /// </summary>
+/// <remarks>
+/// Values live in a table of typed slots indexed by <see cref="Hex1bThemeElement{T}"/>, so a
+/// lookup is an array index rather than a string-keyed dictionary lookup, and color values
+/// keep their encoded escape sequences between frames. Cloning a locked theme doesn't copy
+/// anything: the clone records its own overrides and falls back to the locked theme.
+/// </remarks>
 public class Hex1bTheme
 {
-    private readonly Dictionary<string, object> _values = new();
+    private ThemeSlot?[] _slots;
+    private readonly Hex1bTheme? _base;
     private readonly string _name;
     private bool _isLocked;
 
+    // Global color codes depend only on this theme and its (immutable) base,
+    // so they are cached until the next Set.
+    private string? _globalColorCodes;
+    private string? _resetToGlobalCodes;
+
     public Hex1bTheme(string name)
+        : this(name, baseTheme: null, slots: [])
+    {
+    }
+
+    private Hex1bTheme(string name, Hex1bTheme? baseTheme, ThemeSlot?[] slots)
     {
         _name = name;
+        _base = baseTheme;
+        _slots = slots;
     }
 
     public string Name => _name;
@@ -33,13 +52,26 @@ public class Hex1bTheme
     /// <summary>
     /// Gets the value for a theme element, or its default if not set.
     /// </summary>
-    public T Get<T>(Hex1bThemeElement<T> element)
+    public T Get<T>(Hex1bThemeElement<T> element) => GetSlot(element).Value;
+
+    /// <summary>
+    /// Gets the escape sequence that applies a color element as the foreground color.
+    /// The sequence is encoded once per theme value instead of on every call.
+    /// </summary>
+    public string GetForegroundAnsi(Hex1bThemeElement<Hex1bColor> element)
     {
-        if (_values.TryGetValue(element.Name, out var value) && value is T typedValue)
-        {
-            return typedValue;
-        }
-        return element.DefaultValue();
+        var slot = GetSlot(element);
+        return slot.GetForegroundAnsi(slot.Value);
+    }
+
+    /// <summary>
+    /// Gets the escape sequence that applies a color element as the background color.
+    /// The sequence is encoded once per theme value instead of on every call.
+    /// </summary>
+    public string GetBackgroundAnsi(Hex1bThemeElement<Hex1bColor> element)
+    {
+        var slot = GetSlot(element);
+        return slot.GetBackgroundAnsi(slot.Value);
     }
 
     /// <summary>
@@ -53,7 +85,16 @@ public class Hex1bTheme
             throw new InvalidOperationException(
                 $"Cannot modify locked theme '{_name}'. Use Clone() to create a modifiable copy first.");
         }
-        _values[element.Name] = value!;
+
+        var index = element.SlotIndex;
+        if (index >= _slots.Length)
+        {
+            Array.Resize(ref _slots, Math.Max(index + 1, ThemeSlotRegistry.Count));
+        }
+
+        _slots[index] = new ThemeSlot<T>(value);
+        _globalColorCodes = null;
+        _resetToGlobalCodes = null;
         return this;
     }
 
@@ -62,11 +103,37 @@ public class Hex1bTheme
     /// </summary>
     public Hex1bTheme Clone(string? newName = null)
     {
-        var clone = new Hex1bTheme(newName ?? _name);
-        foreach (var kvp in _values)
+        // A locked theme can't change underneath the clone, so layer on top of it.
+        if (_isLocked)
+        {
+            return new Hex1bTheme(newName ?? _name, this, []);
+        }
+
+        // Otherwise copy this layer's slots; the base is locked and can be shared.
+        return new Hex1bTheme(newName ?? _name, _base, (ThemeSlot?[])_slots.Clone());
+    }
+
+    /// <summary>
+    /// Gets the ANSI codes that apply the global colors, cached per theme.
+    /// </summary>
+    internal string GlobalColorCodes => _globalColorCodes ??= this.BuildGlobalColorCodes();
+
+    /// <summary>
+    /// Gets the ANSI codes that reset to the global colors, cached per theme.
+    /// </summary>
+    internal string ResetToGlobalCodes => _resetToGlobalCodes ??= this.BuildResetToGlobalCodes();
+
+    private ThemeSlot<T> GetSlot<T>(Hex1bThemeElement<T> element)
+    {
+        var index = element.SlotIndex;
+        for (var theme = this; theme != null; theme = theme._base)
         {
-            clone._values[kvp.Key] = kvp.Value;
+            var slots = theme._slots;
+            if (index < slots.Length && slots[index] is ThemeSlot<T> slot)
+            {
+                return slot;
+            }
         }
-        return clone;
+        return element.DefaultSlot;
     }
 }
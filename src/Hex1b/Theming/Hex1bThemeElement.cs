@@ -5,19 +5,34 @@ namespace Hex1b.Theming;
 /// </summary>
 public class Hex1bThemeElement<T>
 {
+    private ThemeSlot<T>? _defaultSlot;
+
     public string Name { get; }
     public Func<T> DefaultValue { get; }
 
+    /// <summary>
+    /// The index of this element's slot in a theme's value table.
+    /// Elements with the same name share a slot, matching <see cref="Equals(object?)"/>.
+    /// </summary>
+    internal int SlotIndex { get; }
+
     public Hex1bThemeElement(string name, Func<T> defaultValue)
     {
         Name = name;
         DefaultValue = defaultValue;
+        SlotIndex = ThemeSlotRegistry.GetSlotIndex(name);
     }
 
+    /// <summary>
+    /// The resolved default value, evaluated once so repeated lookups of an unset
+    /// element share its cached escape sequences.
+    /// </summary>
+    internal ThemeSlot<T> DefaultSlot => _defaultSlot ??= new ThemeSlot<T>(DefaultValue());
+
     public override string ToString() => Name;
-    
+
     public override int GetHashCode() => Name.GetHashCode();
-    
-    public override bool Equals(object? obj) => 
+
+    public override bool Equals(object? obj) =>
         obj is Hex1bThemeElement<T> other && Name == other.Name;
 }
@@ -21,6 +21,29 @@ public static class Hex1bThemeExtensions
     /// Gets the ANSI codes to apply global colors from the theme, or empty string if default.
     /// </summary>
     public static string GetGlobalColorCodes(this Hex1bTheme theme)
+        => theme.GlobalColorCodes;
+
+    /// <summary>
+    /// Gets the ANSI codes to reset colors back to global theme values (or default if none).
+    /// Use this after applying temporary color changes.
+    /// </summary>
+    public static string GetResetToGlobalCodes(this Hex1bTheme theme)
+        => theme.ResetToGlobalCodes;
+
+    /// <summary>
+    /// Gets the global colors from the theme as a <see cref="TextStyle"/>.
+    /// Colors left at their default are inherited, matching <see cref="GetGlobalColorCodes"/>.
+    /// </summary>
+    public static TextStyle GetGlobalTextStyle(this Hex1bTheme theme)
+    {
+        var fg = theme.GetGlobalForeground();
+        var bg = theme.GetGlobalBackground();
+        return new TextStyle(
+            fg.IsDefault ? null : fg,
+            bg.IsDefault ? null : bg);
+    }
+
+    internal static string BuildGlobalColorCodes(this Hex1bTheme theme)
     {
         var result = "";
         var fg = theme.GetGlobalForeground();
@@ -32,11 +55,7 @@ public static class Hex1bThemeExtensions
         return result;
     }
 
-    /// <summary>
-    /// Gets the ANSI codes to reset colors back to global theme values (or default if none).
-    /// Use this after applying temporary color changes.
-    /// </summary>
-    public static string GetResetToGlobalCodes(this Hex1bTheme theme)
+    internal static string BuildResetToGlobalCodes(this Hex1bTheme theme)
     {
         var fg = theme.GetGlobalForeground();
         var bg = theme.GetGlobalBackground();
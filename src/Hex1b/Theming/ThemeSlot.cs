@@ -0,0 +1,65 @@
+namespace Hex1b.Theming;
+
+/// <summary>
+/// A value stored in a theme's slot table. The typed subclass keeps struct values
+/// such as <see cref="Hex1bColor"/> unboxed.
+/// </summary>
+internal abstract class ThemeSlot
+{
+}
+
+/// <summary>
+/// A typed theme value. Escape sequences for color values are encoded on first use
+/// and reused for as long as the value stays in the theme.
+/// </summary>
+internal sealed class ThemeSlot<T> : ThemeSlot
+{
+    private string? _foregroundAnsi;
+    private string? _backgroundAnsi;
+
+    public ThemeSlot(T value)
+    {
+        Value = value;
+    }
+
+    public T Value { get; }
+
+    public string GetForegroundAnsi(Hex1bColor color) => _foregroundAnsi ??= color.ToForegroundAnsi();
+
+    public string GetBackgroundAnsi(Hex1bColor color) => _backgroundAnsi ??= color.ToBackgroundAnsi();
+}
+
+/// <summary>
+/// Assigns each distinct theme element name a dense slot index.
+/// </summary>
+internal static class ThemeSlotRegistry
+{
+    private static readonly Dictionary<string, int> SlotIndices = new(StringComparer.Ordinal);
+
+    /// <summary>
+    /// The number of slots assigned so far.
+    /// </summary>
+    public static int Count
+    {
+        get
+        {
+            lock (SlotIndices)
+            {
+                return SlotIndices.Count;
+            }
+        }
+    }
+
+    public static int GetSlotIndex(string name)
+    {
+        lock (SlotIndices)
+        {
+            if (!SlotIndices.TryGetValue(name, out var index))
+            {
+                index = SlotIndices.Count;
+                SlotIndices.Add(name, index);
+            }
+            return index;
+        }
+    }
+}
@@ -46,6 +46,7 @@ public static class AnsiTokenSerializer
             DcsToken dcs => SerializeDcs(dcs),
             FrameBeginToken => SerializeApc("HEX1BAPP:FRAME:BEGIN"),
             FrameEndToken => SerializeApc("HEX1BAPP:FRAME:END"),
+            KittyGraphicsToken kitty => SerializeKittyGraphics(kitty),
             UnrecognizedSequenceToken unrec => unrec.Sequence,
             _ => throw new ArgumentException($"Unknown token type: {token.GetType().Name}", nameof(token))
         };
@@ -130,6 +131,14 @@ public static class AnsiTokenSerializer
         return $"\x1bP{token.Payload}\x1b\\";
     }
 
+    private static string SerializeKittyGraphics(KittyGraphicsToken token)
+    {
+        // ESC _ G control ; payload ESC \ - commands without data have no ';'
+        return token.Payload.Length == 0
+            ? SerializeApc($"G{token.Control}")
+            : SerializeApc($"G{token.Control};{token.Payload}");
+    }
+
     private static string SerializeApc(string content)
     {
         // APC (Application Program Command): ESC _ content ESC \
@@ -30,7 +30,7 @@ public static class AnsiTokenizer
                 tokens.Add(new OscToken(oscCommand, oscParams, oscPayload));
                 i += oscConsumed;
             }
-            // Check for APC sequence (ESC _ or 0x9F) - used for frame boundaries
+            // Check for APC sequence (ESC _ or 0x9F) - used for frame boundaries and kitty graphics
             else if (TryParseApcSequence(text, i, out var apcConsumed, out var apcContent))
             {
                 FlushTextToken(text, ref textStart, i, tokens);
@@ -38,6 +38,7 @@ public static class AnsiTokenizer
                 {
                     "HEX1BAPP:FRAME:BEGIN" => (AnsiToken)FrameBeginToken.Instance,
                     "HEX1BAPP:FRAME:END" => FrameEndToken.Instance,
+                    _ when apcContent.StartsWith('G') => CreateKittyGraphicsToken(apcContent),
                     _ => new UnrecognizedSequenceToken($"\x1b_{apcContent}\x1b\\")
                 };
                 tokens.Add(apcToken);
@@ -520,6 +521,17 @@ public static class AnsiTokenizer
         return true;
     }
 
+    /// <summary>
+    /// Splits kitty graphics APC content (G control ; payload) into a token.
+    /// </summary>
+    private static KittyGraphicsToken CreateKittyGraphicsToken(string content)
+    {
+        var separator = content.IndexOf(';');
+        return separator < 0
+            ? new KittyGraphicsToken(content[1..], "")
+            : new KittyGraphicsToken(content[1..separator], content[(separator + 1)..]);
+    }
+
     /// <summary>
     /// Gets the grapheme cluster starting at the given position in the text.
     /// </summary>
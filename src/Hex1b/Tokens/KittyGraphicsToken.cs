@@ -0,0 +1,66 @@
+using System.Globalization;
+
+namespace Hex1b.Tokens;
+
+/// <summary>
+/// Represents a kitty graphics protocol command: ESC _ G control ; payload ST
+/// </summary>
+/// <param name="Control">
+/// The comma-separated <c>key=value</c> control data (e.g., "a=T,f=32,i=1").
+/// </param>
+/// <param name="Payload">The base64-encoded data, or empty for commands that carry none.</param>
+/// <remarks>
+/// <para>
+/// Kitty graphics commands are APC sequences. An image is uploaded once under an ID and
+/// then placed by ID, so drawing it again costs a few bytes. Large images are sent over
+/// several commands, each but the last marked <c>m=1</c>.
+/// </para>
+/// <para>
+/// Keys are single characters. The ones Hex1b uses are <c>a</c> (action: t transmit, T
+/// transmit and place, p place, d delete), <c>i</c> (image ID), <c>p</c> (placement ID),
+/// <c>f</c> (format), <c>s</c>/<c>v</c> (width/height in pixels), <c>c</c>/<c>r</c> (width/height
+/// in cells), <c>m</c> (more chunks follow) and <c>d</c> (what to delete).
+/// </para>
+/// </remarks>
+public sealed record KittyGraphicsToken(string Control, string Payload) : AnsiToken
+{
+    /// <summary>
+    /// Gets the command's action, or 't' (transmit) when the control data doesn't say.
+    /// </summary>
+    public char Action => TryGetValue('a', out var value) && value.Length == 1 ? value[0] : 't';
+
+    /// <summary>
+    /// Gets the value of a control key, or null if the key is absent.
+    /// </summary>
+    /// <param name="key">The single-character key.</param>
+    public string? GetValue(char key)
+        => TryGetValue(key, out var value) ? value.ToString() : null;
+
+    /// <summary>
+    /// Gets a numeric control value, or <paramref name="defaultValue"/> if the key is absent
+    /// or not a number.
+    /// </summary>
+    /// <param name="key">The single-character key.</param>
+    /// <param name="defaultValue">The value to use when the key is absent.</param>
+    public uint GetNumber(char key, uint defaultValue = 0)
+        => TryGetValue(key, out var value) && uint.TryParse(value, NumberStyles.None, CultureInfo.InvariantCulture, out var number)
+            ? number
+            : defaultValue;
+
+    private bool TryGetValue(char key, out ReadOnlySpan<char> value)
+    {
+        var control = Control.AsSpan();
+        foreach (var range in control.Split(','))
+        {
+            var part = control[range];
+            if (part.Length >= 2 && part[0] == key && part[1] == '=')
+            {
+                value = part[2..];
+                return true;
+            }
+        }
+
+        value = default;
+        return false;
+    }
+}
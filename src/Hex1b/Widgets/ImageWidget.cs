@@ -0,0 +1,32 @@
+using System.Diagnostics.CodeAnalysis;
+using Hex1b.Nodes;
+
+namespace Hex1b.Widgets;
+
+/// <summary>
+/// A widget that displays an image with kitty graphics or Sixel, whichever the terminal
+/// supports, otherwise falls back to rendering the fallback widget.
+/// </summary>
+/// <param name="Image">The image to display.</param>
+/// <param name="Fallback">A widget to display if the terminal can't show images.</param>
+/// <param name="Width">The width in character cells for the image. If null, 40 cells.</param>
+/// <param name="Height">The height in character cells for the image. If null, 20 cells.</param>
+[Experimental("HEX1B_IMAGES", UrlFormat = "https://github.com/hex1b/hex1b/blob/main/docs/experimental/images.md")]
+public sealed record ImageWidget(
+    TerminalImage Image,
+    Hex1bWidget Fallback,
+    int? Width = null,
+    int? Height = null) : Hex1bWidget
+{
+    internal override async Task<Hex1bNode> ReconcileAsync(Hex1bNode? existingNode, ReconcileContext context)
+    {
+        var node = existingNode as ImageNode ?? new ImageNode();
+        node.Image = Image;
+        node.RequestedWidth = Width;
+        node.RequestedHeight = Height;
+        node.Fallback = await context.ReconcileChildAsync(node.Fallback, Fallback, node);
+        return node;
+    }
+
+    internal override Type GetExpectedNodeType() => typeof(ImageNode);
+}
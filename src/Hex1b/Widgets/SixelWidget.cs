@@ -18,10 +18,36 @@ public sealed record SixelWidget(
     int? Width = null,
     int? Height = null) : Hex1bWidget
 {
+    /// <summary>
+    /// Creates a SixelWidget for an image prepared with <see cref="SixelImageHandle.Create"/> or
+    /// <see cref="SixelEncoder"/>.
+    /// </summary>
+    /// <remarks>
+    /// For a tiled image, <see cref="ImageData"/> is empty so the whole image is not encoded
+    /// just to build the widget.
+    /// </remarks>
+    /// <param name="image">The image to display.</param>
+    /// <param name="fallback">A widget to display if Sixel is not supported.</param>
+    /// <param name="width">The width in character cells for the image. If null, uses the image's natural width.</param>
+    /// <param name="height">The height in character cells for the image. If null, uses the image's natural height.</param>
+    public SixelWidget(SixelImageHandle image, Hex1bWidget fallback, int? width = null, int? height = null)
+        : this(image.Tiles == null ? image.ImageData : "", fallback, width, height)
+    {
+        Image = image;
+    }
+
+    /// <summary>
+    /// The prepared image, if the widget was created from a <see cref="SixelImageHandle"/>.
+    /// </summary>
+    public SixelImageHandle? Image { get; init; }
+
     internal override async Task<Hex1bNode> ReconcileAsync(Hex1bNode? existingNode, ReconcileContext context)
     {
         var node = existingNode as SixelNode ?? new SixelNode();
-        node.ImageData = ImageData;
+        if (Image != null)
+            node.Image = Image;
+        else
+            node.ImageData = ImageData;
         node.RequestedWidth = Width;
         node.RequestedHeight = Height;
         node.Fallback = await context.ReconcileChildAsync(node.Fallback, Fallback, node);
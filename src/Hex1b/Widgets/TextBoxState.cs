@@ -118,8 +118,10 @@ internal class TextBoxState
                 }
                 else if (_cursorPosition > 0)
                 {
-                    _text = _text.Remove(_cursorPosition - 1, 1);
-                    _cursorPosition--;
+                    // Delete the entire grapheme cluster, not just one char
+                    var clusterStart = GraphemeHelper.GetPreviousClusterBoundary(_text, _cursorPosition);
+                    _text = _text.Remove(clusterStart, _cursorPosition - clusterStart);
+                    _cursorPosition = clusterStart;
                 }
                 return true;
 
@@ -130,7 +132,8 @@ internal class TextBoxState
                 }
                 else if (_cursorPosition < _text.Length)
                 {
-                    _text = _text.Remove(_cursorPosition, 1);
+                    var clusterEnd = GraphemeHelper.GetNextClusterBoundary(_text, _cursorPosition);
+                    _text = _text.Remove(_cursorPosition, clusterEnd - _cursorPosition);
                 }
                 return true;
 
@@ -144,7 +147,7 @@ internal class TextBoxState
                     }
                     if (CursorPosition > 0)
                     {
-                        CursorPosition--;
+                        CursorPosition = GraphemeHelper.GetPreviousClusterBoundary(Text, CursorPosition);
                     }
                 }
                 else
@@ -157,7 +160,8 @@ internal class TextBoxState
                     }
                     else if (CursorPosition > 0)
                     {
-                        CursorPosition--;
+                        // Move by grapheme cluster, not by char
+                        CursorPosition = GraphemeHelper.GetPreviousClusterBoundary(Text, CursorPosition);
                     }
                 }
                 return true;
@@ -172,7 +176,7 @@ internal class TextBoxState
                     }
                     if (CursorPosition < Text.Length)
                     {
-                        CursorPosition++;
+                        CursorPosition = GraphemeHelper.GetNextClusterBoundary(Text, CursorPosition);
                     }
                 }
                 else
@@ -185,7 +189,8 @@ internal class TextBoxState
                     }
                     else if (CursorPosition < Text.Length)
                     {
-                        CursorPosition++;
+                        // Move by grapheme cluster, not by char
+                        CursorPosition = GraphemeHelper.GetNextClusterBoundary(Text, CursorPosition);
                     }
                 }
                 return true;
@@ -75,6 +75,93 @@ public class ConsolePresentationAdapterTests
 #pragma warning restore CA1416
         }
     }
+    
+    [Fact]
+    public async Task OutputStage_CoalescesAppendsIntoOneVectoredWrite()
+    {
+        var driver = new RecordingConsoleDriver();
+        using var stage = new ConsoleOutputStage(driver);
+        
+        for (var i = 0; i < 100; i++)
+        {
+            stage.Append("\x1b[1;1Hx"u8);
+        }
+        
+        Assert.Empty(driver.VectoredWrites);
+        
+        await stage.FlushAsync();
+        
+        var write = Assert.Single(driver.VectoredWrites);
+        Assert.Single(write);
+        Assert.Equal(700, write[0].Length);
+        
+        var stats = stage.GetStatistics();
+        Assert.Equal(1, stats.Batches);
+        Assert.Equal(700, stats.Bytes);
+        Assert.True(stats.MaxWriteStall <= stats.TotalWriteStall);
+    }
+    
+    [Fact]
+    public async Task OutputStage_LargePayload_SplitsIntoSegmentsInOrder()
+    {
+        var driver = new RecordingConsoleDriver();
+        using var stage = new ConsoleOutputStage(driver);
+        
+        stage.Append("head"u8);
+        var payload = new byte[40_000];
+        for (var i = 0; i < payload.Length; i++) payload[i] = (byte)('a' + i % 26);
+        stage.Append(payload);
+        stage.Append("tail"u8);
+        await stage.FlushAsync();
+        
+        var write = Assert.Single(driver.VectoredWrites);
+        Assert.True(write.Count > 1);
+        var combined = write.SelectMany(segment => segment).ToArray();
+        Assert.Equal([.. "head"u8.ToArray(), .. payload, .. "tail"u8.ToArray()], combined);
+    }
+    
+    [Fact]
+    public async Task OutputStage_WriterThread_DrainWaitsForQueuedBatches()
+    {
+        var driver = new RecordingConsoleDriver { WriteDelay = TimeSpan.FromMilliseconds(20) };
+        using var stage = new ConsoleOutputStage(driver, useWriterThread: true);
+        
+        stage.Append("frame1"u8);
+        await stage.FlushAsync();
+        stage.Append("frame2"u8);
+        await stage.FlushAsync();
+        stage.Append("exit"u8);
+        stage.Drain();
+        
+        Assert.Equal(["frame1", "frame2", "exit"], driver.VectoredWrites.Select(w => System.Text.Encoding.ASCII.GetString(w.SelectMany(s => s).ToArray())));
+        Assert.True(stage.GetStatistics().TotalWriteStall >= TimeSpan.FromMilliseconds(40));
+    }
+    
+    private sealed class RecordingConsoleDriver : IConsoleDriver
+    {
+        public List<List<byte[]>> VectoredWrites { get; } = [];
+        public TimeSpan WriteDelay { get; init; }
+        
+        public void WriteVectored(ReadOnlySpan<ReadOnlyMemory<byte>> segments)
+        {
+            if (WriteDelay > TimeSpan.Zero) Thread.Sleep(WriteDelay);
+            var copy = new List<byte[]>();
+            foreach (var segment in segments) copy.Add(segment.ToArray());
+            lock (VectoredWrites) VectoredWrites.Add(copy);
+        }
+        
+        public void Write(ReadOnlySpan<byte> data) => WriteVectored(new[] { new ReadOnlyMemory<byte>(data.ToArray()) });
+        public void EnterRawMode() { }
+        public void ExitRawMode() { }
+        public bool DataAvailable => false;
+        public ValueTask<int> ReadAsync(Memory<byte> buffer, CancellationToken ct = default) => ValueTask.FromResult(0);
+        public void Flush() { }
+        public void DrainInput() { }
+        public int Width => 80;
+        public int Height => 24;
+        public event Action<int, int>? Resized { add { } remove { } }
+        public void Dispose() { }
+    }
 }
 
 public class Hex1bTerminalTests_Workload
@@ -168,6 +168,55 @@ public class DisplayWidthTests
 
     #endregion
 
+    #region Code Point Width
+
+    [Fact]
+    public void GetCodePointWidth_Latin1_UsesControlAndPrintableWidths()
+    {
+        Assert.Equal(0, DisplayWidth.GetCodePointWidth(0x00));
+        Assert.Equal(0, DisplayWidth.GetCodePointWidth('\t'));
+        Assert.Equal(0, DisplayWidth.GetCodePointWidth(0x7F));
+        Assert.Equal(0, DisplayWidth.GetCodePointWidth(0x85)); // C1 control
+        Assert.Equal(1, DisplayWidth.GetCodePointWidth('A'));
+        Assert.Equal(1, DisplayWidth.GetCodePointWidth(0xAD)); // Soft hyphen is visible
+        Assert.Equal(1, DisplayWidth.GetCodePointWidth(0xE9)); // é
+    }
+
+    [Theory]
+    [InlineData(0x0301, 0)]  // Combining acute accent (Mn)
+    [InlineData(0x0903, 1)]  // Devanagari sign visarga (Mc)
+    [InlineData(0x200D, 0)]  // Zero width joiner (Cf)
+    [InlineData(0xFE0F, 0)]  // Variation selector-16
+    [InlineData(0x1160, 0)]  // Hangul Jungseong filler
+    [InlineData(0x1100, 2)]  // Hangul Choseong kiyeok
+    [InlineData(0x3000, 2)]  // Ideographic space (F)
+    [InlineData(0xFF21, 2)]  // Fullwidth Latin A
+    [InlineData(0x2713, 1)]  // Check mark (text presentation)
+    [InlineData(0x26A1, 2)]  // High voltage (emoji presentation)
+    [InlineData(0x1F600, 2)] // Grinning face
+    [InlineData(0x1F3FB, 0)] // Fitzpatrick modifier folds into its base
+    [InlineData(0x20000, 2)] // CJK Extension B
+    [InlineData(0x110000, 0)] // Beyond the Unicode range
+    public void GetCodePointWidth_UsesUnicodeTables(int codePoint, int expected)
+    {
+        Assert.Equal(expected, DisplayWidth.GetCodePointWidth(codePoint));
+    }
+
+    [Fact]
+    public void GetGraphemeWidth_TextPresentationSymbolWithVariationSelector_ReturnsTwo()
+    {
+        Assert.Equal(1, DisplayWidth.GetGraphemeWidth("❤"));
+        Assert.Equal(2, DisplayWidth.GetGraphemeWidth("❤️"));
+    }
+
+    [Fact]
+    public void UnicodeVersion_MatchesGeneratedTables()
+    {
+        Assert.Equal("14.0.0", DisplayWidth.UnicodeVersion);
+    }
+
+    #endregion
+
     #region Slice By Display Width
 
     [Fact]
@@ -229,6 +278,59 @@ public class DisplayWidthTests
 
     #endregion
 
+    #region Grapheme Enumeration
+
+    [Fact]
+    public void EnumerateGraphemes_ReportsStartLengthAndWidth()
+    {
+        var clusters = new List<GraphemeCluster>();
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes("A😀e\u0301👨‍👩‍👧中"))
+        {
+            clusters.Add(cluster);
+        }
+
+        Assert.Equal(
+            [
+                new GraphemeCluster(0, 1, 1),
+                new GraphemeCluster(1, 2, 2),
+                new GraphemeCluster(3, 2, 1),
+                new GraphemeCluster(5, 8, 2),
+                new GraphemeCluster(13, 1, 2),
+            ],
+            clusters);
+    }
+
+    [Fact]
+    public void EnumerateGraphemes_CarriageReturnLineFeed_IsOneCluster()
+    {
+        var count = 0;
+        foreach (var cluster in DisplayWidth.EnumerateGraphemes("a\r\nb"))
+        {
+            if (count == 1)
+                Assert.Equal(new GraphemeCluster(1, 2, 0), cluster);
+            count++;
+        }
+
+        Assert.Equal(3, count);
+    }
+
+    [Fact]
+    public void GetGraphemeAt_ReturnsClusterStartingAtIndex()
+    {
+        Assert.Equal(new GraphemeCluster(2, 4, 2), DisplayWidth.GetGraphemeAt("ab🇺🇸c", 2));
+        Assert.Equal(new GraphemeCluster(7, 0, 0), DisplayWidth.GetGraphemeAt("ab🇺🇸c", 7));
+    }
+
+    [Fact]
+    public void SliceByDisplayWidthWithAnsi_KeepsEscapesAroundSlicedGraphemes()
+    {
+        var (text, columns, _, _) = DisplayWidth.SliceByDisplayWidthWithAnsi("\x1b[31mA😀B\x1b[0m", 1, 2);
+        Assert.Equal("\x1b[31m😀", text);
+        Assert.Equal(2, columns);
+    }
+
+    #endregion
+
     #region Integration with GraphemeHelper
 
     [Fact]
@@ -773,4 +773,149 @@ public class Hex1bAppRenderOptimizationFilterIntegrationTests
         Assert.False(afterToggle.ContainsText("Line 5"), 
             $"Line 5 should be cleared after toggle. Buffer:\n{afterToggle}");
     }
+
+    /// <summary>
+    /// A presentation adapter whose first write blocks until released, simulating a slow client.
+    /// </summary>
+    private sealed class GatedPresentationAdapter : IHex1bTerminalPresentationAdapter
+    {
+        private readonly TaskCompletionSource _firstWriteStarted = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        private readonly TaskCompletionSource _release = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        private readonly object _lock = new();
+        private readonly System.Text.StringBuilder _received = new();
+
+        public int Writes { get; private set; }
+        public string? ReceivedAtExit { get; private set; }
+        public Task FirstWriteStarted => _firstWriteStarted.Task;
+        public void Release() => _release.TrySetResult();
+
+        public string Received
+        {
+            get { lock (_lock) return _received.ToString(); }
+        }
+
+        public int Width => 20;
+        public int Height => 3;
+        public TerminalCapabilities Capabilities => TerminalCapabilities.Minimal;
+#pragma warning disable CS0067 // Event is never used - required by interface
+        public event Action<int, int>? Resized;
+        public event Action? Disconnected;
+#pragma warning restore CS0067
+
+        public async ValueTask WriteOutputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
+        {
+            lock (_lock)
+            {
+                Writes++;
+                _received.Append(System.Text.Encoding.UTF8.GetString(data.Span));
+            }
+            _firstWriteStarted.TrySetResult();
+            await _release.Task.WaitAsync(ct);
+        }
+
+        public async ValueTask<ReadOnlyMemory<byte>> ReadInputAsync(CancellationToken ct = default)
+        {
+            try
+            {
+                await Task.Delay(Timeout.Infinite, ct);
+            }
+            catch (OperationCanceledException) { }
+            return ReadOnlyMemory<byte>.Empty;
+        }
+
+        public ValueTask FlushAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask EnterTuiModeAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask ExitTuiModeAsync(CancellationToken ct = default)
+        {
+            ReceivedAtExit = Received;
+            return ValueTask.CompletedTask;
+        }
+
+        public ValueTask DisposeAsync() => ValueTask.CompletedTask;
+    }
+
+    [Fact]
+    public async Task DeltaFilter_SlowPresentation_SkipsIntermediateFrames()
+    {
+        // Arrange
+        using var workload = new Hex1bAppWorkloadAdapter();
+        var presentation = new GatedPresentationAdapter();
+        var terminalOptions = new Hex1bTerminalOptions
+        {
+            WorkloadAdapter = workload,
+            PresentationAdapter = presentation
+        };
+        terminalOptions.AddHex1bAppRenderOptimization();
+        using var terminal = new Hex1bTerminal(terminalOptions);
+
+        static string Frame(int n) =>
+            $"\x1b_HEX1BAPP:FRAME:BEGIN\x1b\\\x1b[1;1HFrame {n,4}\x1b_HEX1BAPP:FRAME:END\x1b\\";
+
+        // Act - the first frame blocks in the presentation, then many more frames render
+        workload.Write(Frame(0));
+        await presentation.FirstWriteStarted.WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+
+        for (var i = 1; i <= 200; i++)
+        {
+            workload.Write(Frame(i));
+        }
+
+        // The workload queue drains even though the presentation is stuck
+        var deadline = DateTime.UtcNow.AddSeconds(5);
+        while (workload.OutputQueueDepth > 0 && DateTime.UtcNow < deadline)
+        {
+            await Task.Delay(10, TestContext.Current.CancellationToken);
+        }
+        Assert.Equal(0, workload.OutputQueueDepth);
+
+        presentation.Release();
+        deadline = DateTime.UtcNow.AddSeconds(5);
+        while (presentation.Writes < 2 && DateTime.UtcNow < deadline)
+        {
+            await Task.Delay(10, TestContext.Current.CancellationToken);
+        }
+        await Task.Delay(50, TestContext.Current.CancellationToken);
+
+        // Assert - one diff from frame 0 straight to frame 200 ("   0" -> " 200" changes two cells)
+        Assert.Equal(2, presentation.Writes);
+        Assert.EndsWith("20", presentation.Received);
+        Assert.Equal("Frame  200", terminal.CreateSnapshot().GetLineTrimmed(0));
+    }
+
+    [Fact]
+    public async Task DeltaFilter_DisposeAsync_SendsLastFrameBeforeExitingTuiMode()
+    {
+        // Arrange
+        using var workload = new Hex1bAppWorkloadAdapter();
+        var presentation = new GatedPresentationAdapter();
+        var terminalOptions = new Hex1bTerminalOptions
+        {
+            WorkloadAdapter = workload,
+            PresentationAdapter = presentation
+        };
+        terminalOptions.AddHex1bAppRenderOptimization();
+        var terminal = new Hex1bTerminal(terminalOptions);
+
+        static string Frame(int n) =>
+            $"\x1b_HEX1BAPP:FRAME:BEGIN\x1b\\\x1b[1;1HFrame {n,4}\x1b_HEX1BAPP:FRAME:END\x1b\\";
+
+        // Act - the last frame is deferred behind the blocked first write when disposal starts
+        workload.Write(Frame(0));
+        await presentation.FirstWriteStarted.WaitAsync(TimeSpan.FromSeconds(5), TestContext.Current.CancellationToken);
+        workload.Write(Frame(7));
+
+        var deadline = DateTime.UtcNow.AddSeconds(5);
+        while (workload.OutputQueueDepth > 0 && DateTime.UtcNow < deadline)
+        {
+            await Task.Delay(10, TestContext.Current.CancellationToken);
+        }
+        await Task.Delay(50, TestContext.Current.CancellationToken);
+
+        presentation.Release();
+        await terminal.DisposeAsync();
+
+        // Assert
+        Assert.NotNull(presentation.ReceivedAtExit);
+        Assert.EndsWith("7", presentation.ReceivedAtExit);
+    }
 }
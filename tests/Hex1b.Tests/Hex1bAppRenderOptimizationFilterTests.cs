@@ -754,4 +754,210 @@ public class Hex1bAppRenderOptimizationFilterTests
             .ToList();
         Assert.Single(syncEnd);
     }
+
+    [Fact]
+    public async Task FrameSkipping_DeferredFrames_CollapseIntoLatestDiff()
+    {
+        // Arrange
+        var filter = new Hex1bAppRenderOptimizationFilter();
+        IHex1bTerminalFrameSkippingFilter skipping = filter;
+        await filter.OnSessionStartAsync(10, 5, DateTimeOffset.Now);
+        await filter.OnOutputAsync([new AppliedToken(new TextToken("X"), [new CellImpact(9, 4, new TerminalCell { Character = "X" })], 0, 0, 0, 0)], TimeSpan.Zero);
+
+        // Act - three frames render while the presentation is busy
+        skipping.BeginDeferral();
+        foreach (var character in new[] { "A", "B", "C" })
+        {
+            var result = await filter.OnOutputAsync(
+            [
+                new AppliedToken(new PrivateModeToken(2026, true), [], 0, 0, 0, 0),
+                new AppliedToken(FrameBeginToken.Instance, [], 0, 0, 0, 0),
+                new AppliedToken(new TextToken(character), [new CellImpact(0, 0, new TerminalCell { Character = character })], 0, 0, 0, 0),
+                new AppliedToken(FrameEndToken.Instance, [], 0, 0, 0, 0),
+                new AppliedToken(new PrivateModeToken(2026, false), [], 0, 0, 0, 0),
+            ], TimeSpan.Zero);
+            Assert.Empty(result);
+        }
+
+        // Assert - one synchronized diff with only the latest content
+        Assert.Equal(DeferredFrameStatus.Ready, skipping.TakeDeferredFrame(out var tokens));
+        var text = string.Concat(tokens.OfType<TextToken>().Select(t => t.Text));
+        Assert.Equal("C", text);
+        Assert.Equal(new PrivateModeToken(2026, true), tokens[0]);
+        Assert.Equal(new PrivateModeToken(2026, false), tokens[^1]);
+        Assert.Single(tokens, t => t is PrivateModeToken { Mode: 2026, Enable: true });
+
+        // Nothing else deferred - the filter resumes emitting directly
+        Assert.Equal(DeferredFrameStatus.Resumed, skipping.TakeDeferredFrame(out _));
+        var next = await filter.OnOutputAsync([new AppliedToken(new TextToken("D"), [new CellImpact(1, 0, new TerminalCell { Character = "D" })], 0, 0, 0, 0)], TimeSpan.Zero);
+        Assert.Contains(next, t => t is TextToken { Text: "D" });
+    }
+
+    [Fact]
+    public async Task FrameSkipping_MidFrame_ReportsInProgress()
+    {
+        // Arrange
+        var filter = new Hex1bAppRenderOptimizationFilter();
+        IHex1bTerminalFrameSkippingFilter skipping = filter;
+        await filter.OnSessionStartAsync(10, 5, DateTimeOffset.Now);
+        await filter.OnOutputAsync([new AppliedToken(new TextToken("X"), [new CellImpact(9, 4, new TerminalCell { Character = "X" })], 0, 0, 0, 0)], TimeSpan.Zero);
+
+        // Act - a frame is still being rendered when the presentation frees up
+        skipping.BeginDeferral();
+        await filter.OnOutputAsync(
+        [
+            new AppliedToken(FrameBeginToken.Instance, [], 0, 0, 0, 0),
+            new AppliedToken(new TextToken("A"), [new CellImpact(0, 0, new TerminalCell { Character = "A" })], 0, 0, 0, 0),
+        ], TimeSpan.Zero);
+
+        // Assert - the partial frame isn't sent
+        Assert.Equal(DeferredFrameStatus.InProgress, skipping.TakeDeferredFrame(out _));
+
+        await filter.OnOutputAsync([new AppliedToken(FrameEndToken.Instance, [], 0, 0, 0, 0)], TimeSpan.Zero);
+        Assert.Equal(DeferredFrameStatus.Ready, skipping.TakeDeferredFrame(out var tokens));
+        Assert.Contains(tokens, t => t is TextToken { Text: "A" });
+    }
+
+    [Fact]
+    public async Task FrameSkipping_DeferredControlTokens_KeepOnlyLatestCursorPosition()
+    {
+        // Arrange
+        var filter = new Hex1bAppRenderOptimizationFilter();
+        IHex1bTerminalFrameSkippingFilter skipping = filter;
+        await filter.OnSessionStartAsync(10, 5, DateTimeOffset.Now);
+        await filter.OnOutputAsync([new AppliedToken(new TextToken("X"), [new CellImpact(9, 4, new TerminalCell { Character = "X" })], 0, 0, 0, 0)], TimeSpan.Zero);
+
+        // Act
+        skipping.BeginDeferral();
+        for (var row = 1; row <= 50; row++)
+        {
+            await filter.OnOutputAsync([new AppliedToken(new CursorPositionToken(row % 5 + 1, 1), [], 0, 0, 0, 0)], TimeSpan.Zero);
+        }
+
+        // Assert
+        Assert.Equal(DeferredFrameStatus.Ready, skipping.TakeDeferredFrame(out var tokens));
+        Assert.Equal(new CursorPositionToken(1, 1), Assert.Single(tokens));
+    }
+
+    [Fact]
+    public async Task FrameSkipping_DeferredKittyPlacement_KeepsItsCursorPosition()
+    {
+        // Arrange
+        var filter = new Hex1bAppRenderOptimizationFilter();
+        IHex1bTerminalFrameSkippingFilter skipping = filter;
+        await filter.OnSessionStartAsync(10, 5, DateTimeOffset.Now);
+        await filter.OnOutputAsync([new AppliedToken(new TextToken("X"), [new CellImpact(9, 4, new TerminalCell { Character = "X" })], 0, 0, 0, 0)], TimeSpan.Zero);
+        var placement = new KittyGraphicsToken("a=p,i=1,p=1,c=2,r=1", "");
+
+        // Act - the image is placed at (2, 1), then text is drawn elsewhere in the same frame
+        skipping.BeginDeferral();
+        await filter.OnOutputAsync(Frame(
+            new AppliedToken(new CursorPositionToken(2, 3), [], 0, 0, 2, 1),
+            new AppliedToken(placement, [], 2, 1, 4, 1),
+            new AppliedToken(new CursorPositionToken(4, 1), [], 4, 1, 0, 3),
+            new AppliedToken(new TextToken("A"), [new CellImpact(0, 3, new TerminalCell { Character = "A" })], 0, 3, 1, 3)), TimeSpan.Zero);
+
+        // Assert - the placement is still sent right after a move to its cell
+        Assert.Equal(DeferredFrameStatus.Ready, skipping.TakeDeferredFrame(out var tokens));
+        var index = tokens.ToList().IndexOf(placement);
+        Assert.True(index > 0);
+        Assert.Equal(new CursorPositionToken(2, 3), tokens[index - 1]);
+        Assert.Contains(tokens, t => t is TextToken { Text: "A" });
+    }
+
+    [Fact]
+    public async Task FrameSkipping_ResizeWhileDeferred_KeepsKittyUploads()
+    {
+        // Arrange
+        var filter = new Hex1bAppRenderOptimizationFilter();
+        IHex1bTerminalFrameSkippingFilter skipping = filter;
+        await filter.OnSessionStartAsync(10, 5, DateTimeOffset.Now);
+        await filter.OnOutputAsync([new AppliedToken(new TextToken("X"), [new CellImpact(9, 4, new TerminalCell { Character = "X" })], 0, 0, 0, 0)], TimeSpan.Zero);
+        var upload = new KittyGraphicsToken("a=t,i=1,f=32,s=1,v=1", "AAAAAA==");
+
+        // Act - an upload is deferred, then a resize discards the deferred output
+        skipping.BeginDeferral();
+        await filter.OnOutputAsync(Frame(new AppliedToken(upload, [], 0, 0, 0, 0)), TimeSpan.Zero);
+        await filter.OnResizeAsync(12, 6, TimeSpan.Zero);
+        var refresh = await filter.OnOutputAsync([new AppliedToken(new TextToken("Y"), [new CellImpact(0, 0, new TerminalCell { Character = "Y" })], 0, 0, 1, 0)], TimeSpan.Zero);
+
+        // Assert - the upload goes out ahead of the full refresh that places the image again
+        Assert.Equal(upload, refresh[0]);
+        Assert.Contains(refresh, t => t is ClearScreenToken);
+    }
+
+    private static AppliedToken SixelTile(int x, int y, int width, int height, string data)
+    {
+        var impacts = new List<CellImpact>();
+        for (var dy = 0; dy < height; dy++)
+        {
+            for (var dx = 0; dx < width; dx++)
+            {
+                impacts.Add(new CellImpact(x + dx, y + dy, new TerminalCell { Character = " ", Attributes = CellAttributes.Sixel }));
+            }
+        }
+        return new AppliedToken(new DcsToken($"\x1bPq{data}\x1b\\"), impacts, x, y, x, y);
+    }
+
+    private static List<AppliedToken> Frame(params AppliedToken[] tokens)
+        => [new AppliedToken(FrameBeginToken.Instance, [], 0, 0, 0, 0), .. tokens, new AppliedToken(FrameEndToken.Instance, [], 0, 0, 0, 0)];
+
+    [Fact]
+    public async Task SixelTiles_UnchangedTiles_AreNotResent()
+    {
+        // Arrange
+        var filter = new Hex1bAppRenderOptimizationFilter();
+        await filter.OnSessionStartAsync(20, 10, DateTimeOffset.Now);
+        await filter.OnOutputAsync([new AppliedToken(new TextToken("X"), [new CellImpact(19, 9, new TerminalCell { Character = "X" })], 0, 0, 0, 0)], TimeSpan.Zero);
+
+        var first = await filter.OnOutputAsync(Frame(SixelTile(0, 0, 4, 2, "A"), SixelTile(4, 0, 4, 2, "B")), TimeSpan.Zero);
+
+        // Act - the second tile changes
+        var second = await filter.OnOutputAsync(Frame(SixelTile(0, 0, 4, 2, "A"), SixelTile(4, 0, 4, 2, "C")), TimeSpan.Zero);
+
+        // Assert - only the changed tile is sent, positioned at its origin
+        Assert.Equal(2, first.OfType<DcsToken>().Count());
+        var dcs = Assert.Single(second.OfType<DcsToken>());
+        Assert.Equal("\x1bPqC\x1b\\", dcs.Payload);
+        var index = second.ToList().IndexOf(dcs);
+        Assert.Equal(new CursorPositionToken(1, 5), second[index - 1]);
+    }
+
+    [Fact]
+    public async Task SixelTiles_SameFrameTwice_SendsNothing()
+    {
+        // Arrange
+        var filter = new Hex1bAppRenderOptimizationFilter();
+        await filter.OnSessionStartAsync(20, 10, DateTimeOffset.Now);
+        await filter.OnOutputAsync([new AppliedToken(new TextToken("X"), [new CellImpact(19, 9, new TerminalCell { Character = "X" })], 0, 0, 0, 0)], TimeSpan.Zero);
+        await filter.OnOutputAsync(Frame(SixelTile(2, 1, 4, 2, "A")), TimeSpan.Zero);
+
+        // Act
+        var result = await filter.OnOutputAsync(Frame(SixelTile(2, 1, 4, 2, "A")), TimeSpan.Zero);
+
+        // Assert
+        Assert.DoesNotContain(result, t => t is DcsToken or TextToken);
+    }
+
+    [Fact]
+    public async Task SixelTiles_OverwrittenWithoutRedraw_RewritesCellsAndResendsLater()
+    {
+        // Arrange
+        var filter = new Hex1bAppRenderOptimizationFilter();
+        await filter.OnSessionStartAsync(20, 10, DateTimeOffset.Now);
+        await filter.OnOutputAsync([new AppliedToken(new TextToken("X"), [new CellImpact(19, 9, new TerminalCell { Character = "X" })], 0, 0, 0, 0)], TimeSpan.Zero);
+        await filter.OnOutputAsync(Frame(SixelTile(0, 0, 2, 1, "A")), TimeSpan.Zero);
+
+        // Act - the image's cells are cleared with blanks that match the shadow buffer
+        var cleared = await filter.OnOutputAsync(Frame(new AppliedToken(
+            new TextToken("  "),
+            [new CellImpact(0, 0, new TerminalCell { Character = " " }), new CellImpact(1, 0, new TerminalCell { Character = " " })],
+            0, 0, 2, 0)), TimeSpan.Zero);
+        var redrawn = await filter.OnOutputAsync(Frame(SixelTile(0, 0, 2, 1, "A")), TimeSpan.Zero);
+
+        // Assert - the blanks are still written so they cover the image, and the image is sent again
+        Assert.DoesNotContain(cleared, t => t is DcsToken);
+        Assert.Equal(2, cleared.OfType<TextToken>().Count());
+        Assert.Single(redrawn.OfType<DcsToken>());
+    }
 }
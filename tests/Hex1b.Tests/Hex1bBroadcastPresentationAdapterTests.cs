@@ -0,0 +1,225 @@
+using System.Text;
+using Hex1b.Terminal;
+using Hex1b.Widgets;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for showing one terminal to many viewers through <see cref="Hex1bBroadcastPresentationAdapter"/>.
+/// </summary>
+public class Hex1bBroadcastPresentationAdapterTests
+{
+    #region Fan-out Tests
+
+    [Fact]
+    public async Task UpToDateViewers_ShareOneEncodedFrame()
+    {
+        var label = "Hello";
+        await using var broadcast = await StartAsync(() => label);
+        var viewerA = new CapturingViewer();
+        var viewerB = new CapturingViewer();
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+        var runA = broadcast.Adapter.RunViewerAsync(viewerA, cts.Token);
+        var runB = broadcast.Adapter.RunViewerAsync(viewerB, cts.Token);
+
+        await TestWaitHelper.WaitUntilAsync(() => viewerA.Output.Contains("Hello") && viewerB.Output.Contains("Hello"));
+        // Let both finish their sends so they are up to date for the next frame
+        await Task.Delay(100, TestContext.Current.CancellationToken);
+
+        var encoded = broadcast.Adapter.FramesEncoded;
+        label = "Abcde";
+        broadcast.App.Invalidate();
+        await TestWaitHelper.WaitUntilAsync(() => viewerA.Output.Contains("Abcde") && viewerB.Output.Contains("Abcde"));
+
+        Assert.Equal(encoded + 1, broadcast.Adapter.FramesEncoded);
+        Assert.Equal(viewerA.LastWrite, viewerB.LastWrite);
+        Assert.Equal(2, broadcast.Adapter.ViewerCount);
+
+        cts.Cancel();
+        await Task.WhenAll(runA, runB);
+        Assert.Equal(0, broadcast.Adapter.ViewerCount);
+    }
+
+    [Fact]
+    public async Task LateViewer_GetsFullPaint()
+    {
+        await using var broadcast = await StartAsync(() => "Dashboard");
+        await TestWaitHelper.WaitUntilAsync(() => broadcast.Terminal.ContainsText("Dashboard"));
+
+        var viewer = new CapturingViewer();
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+        var run = broadcast.Adapter.RunViewerAsync(viewer, cts.Token);
+
+        await TestWaitHelper.WaitUntilAsync(() => viewer.Output.Contains("Dashboard"));
+        Assert.Contains("\x1b[2J", viewer.Output);
+
+        cts.Cancel();
+        await run;
+    }
+
+    [Fact]
+    public async Task SlowViewer_SkipsFramesPublishedDuringWrite()
+    {
+        var counter = 0;
+        await using var broadcast = await StartAsync(() => $"Count{counter}");
+        var slow = new CapturingViewer { WriteGate = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously) };
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+        var run = broadcast.Adapter.RunViewerAsync(slow, cts.Token);
+        await TestWaitHelper.WaitUntilAsync(() => slow.WriteCount == 1);
+
+        for (var i = 1; i <= 5; i++)
+        {
+            counter = i;
+            broadcast.App.Invalidate();
+            await TestWaitHelper.WaitUntilAsync(() => broadcast.Terminal.ContainsText($"Count{i}"));
+        }
+
+        slow.WriteGate.SetResult();
+        await TestWaitHelper.WaitUntilAsync(() => slow.WriteCount == 2);
+        await Task.Delay(100, TestContext.Current.CancellationToken);
+
+        // The write in progress, then one diff to the latest frame
+        Assert.Equal(2, slow.WriteCount);
+        Assert.Contains("5", slow.LastWrite);
+
+        cts.Cancel();
+        await run;
+    }
+
+    [Fact]
+    public async Task DisconnectedViewer_IsRemoved()
+    {
+        await using var broadcast = await StartAsync(() => "Hello");
+        var viewer = new CapturingViewer();
+        var run = broadcast.Adapter.RunViewerAsync(viewer, TestContext.Current.CancellationToken);
+        await TestWaitHelper.WaitUntilAsync(() => broadcast.Adapter.ViewerCount == 1);
+
+        viewer.Disconnect();
+        await run;
+
+        Assert.Equal(0, broadcast.Adapter.ViewerCount);
+    }
+
+    [Fact]
+    public async Task ViewerJoiningBeforeTerminalResizes_GetsOldSize()
+    {
+        await using var adapter = new Hex1bBroadcastPresentationAdapter(40, 5);
+        IHex1bTerminalPresentationFilter filter = adapter;
+        await filter.OnSessionStartAsync(40, 5, DateTimeOffset.UtcNow, TestContext.Current.CancellationToken);
+
+        // No terminal follows the resize, so the frames stay 40x5
+        adapter.Resize(80, 10);
+
+        var viewer = new CapturingViewer();
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+        var run = adapter.RunViewerAsync(viewer, cts.Token);
+        await TestWaitHelper.WaitUntilAsync(() => viewer.WriteCount == 1);
+
+        Assert.Equal(1, adapter.ViewerCount);
+        Assert.Equal(80, adapter.Width);
+
+        cts.Cancel();
+        await run;
+    }
+
+    #endregion
+
+    private static async Task<Broadcast> StartAsync(Func<string> text)
+    {
+        var workload = new Hex1bAppWorkloadAdapter(TerminalCapabilities.Modern);
+        var options = new Hex1bTerminalOptions { WorkloadAdapter = workload };
+        var adapter = options.AddBroadcast(40, 5);
+        var terminal = new Hex1bTerminal(options);
+        var app = new Hex1bApp(
+            ctx => Task.FromResult<Hex1bWidget>(ctx.Text(text())),
+            new Hex1bAppOptions { WorkloadAdapter = workload });
+
+        var cts = new CancellationTokenSource();
+        var runTask = app.RunAsync(cts.Token);
+        await Task.Yield();
+        return new Broadcast(adapter, terminal, app, cts, runTask);
+    }
+
+    private sealed record Broadcast(
+        Hex1bBroadcastPresentationAdapter Adapter,
+        Hex1bTerminal Terminal,
+        Hex1bApp App,
+        CancellationTokenSource Cancellation,
+        Task RunTask) : IAsyncDisposable
+    {
+        public async ValueTask DisposeAsync()
+        {
+            Cancellation.Cancel();
+            await RunTask;
+            await App.DisposeAsync();
+            await Terminal.DisposeAsync();
+            Cancellation.Dispose();
+        }
+    }
+
+    private sealed class CapturingViewer : IHex1bTerminalPresentationAdapter
+    {
+        private readonly StringBuilder _output = new();
+        private readonly TaskCompletionSource _disconnected = new(TaskCreationOptions.RunContinuationsAsynchronously);
+        private string _lastWrite = "";
+        private int _writeCount;
+
+        /// <summary>
+        /// When set, writes wait for it after recording their data.
+        /// </summary>
+        public TaskCompletionSource? WriteGate { get; init; }
+
+        public string Output
+        {
+            get { lock (_output) return _output.ToString(); }
+        }
+
+        public string LastWrite
+        {
+            get { lock (_output) return _lastWrite; }
+        }
+
+        public int WriteCount => Volatile.Read(ref _writeCount);
+
+        public void Disconnect() => _disconnected.TrySetResult();
+
+        public int Width => 40;
+        public int Height => 5;
+        public TerminalCapabilities Capabilities => TerminalCapabilities.Modern;
+#pragma warning disable CS0067 // Event is never used - required by interface
+        public event Action<int, int>? Resized;
+        public event Action? Disconnected;
+#pragma warning restore CS0067
+
+        public async ValueTask WriteOutputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
+        {
+            lock (_output)
+            {
+                _lastWrite = Encoding.UTF8.GetString(data.Span);
+                _output.Append(_lastWrite);
+            }
+            Interlocked.Increment(ref _writeCount);
+
+            if (WriteGate != null)
+            {
+                await WriteGate.Task.WaitAsync(ct);
+            }
+        }
+
+        public async ValueTask<ReadOnlyMemory<byte>> ReadInputAsync(CancellationToken ct = default)
+        {
+            await _disconnected.Task.WaitAsync(ct);
+            return ReadOnlyMemory<byte>.Empty;
+        }
+
+        public ValueTask FlushAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask EnterTuiModeAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask ExitTuiModeAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+
+        public ValueTask DisposeAsync()
+        {
+            _disconnected.TrySetResult();
+            return ValueTask.CompletedTask;
+        }
+    }
+}
@@ -0,0 +1,309 @@
+using System.Text;
+using System.Text.Json;
+using Hex1b.Terminal;
+using Microsoft.Extensions.Time.Testing;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for the binary session recording written by <see cref="Hex1bRecorder"/>.
+/// </summary>
+public class Hex1bRecorderTests : IDisposable
+{
+    private readonly List<string> _tempFiles = new();
+
+    private string GetTempFile(string extension = ".hxr")
+    {
+        var path = Path.Combine(Path.GetTempPath(), $"hex1b_test_{Guid.NewGuid()}{extension}");
+        _tempFiles.Add(path);
+        return path;
+    }
+
+    public void Dispose()
+    {
+        foreach (var file in _tempFiles)
+        {
+            try { File.Delete(file); } catch { }
+        }
+    }
+
+    #region Recording Tests
+
+    [Fact]
+    public async Task Recording_ReadsBackHeaderAndRawOutput()
+    {
+        var path = GetTempFile();
+        await RecordAsync(path, new Hex1bRecorderOptions { Title = "Demo" }, (workload, terminal, time, recorder) =>
+        {
+            workload.Write("Hello, ");
+            terminal.FlushOutput();
+            time.Advance(TimeSpan.FromMilliseconds(250));
+            workload.Write("\x1b[31mWorld\x1b[0m");
+            terminal.FlushOutput();
+        });
+
+        using var reader = Hex1bRecordingReader.Open(path);
+
+        Assert.Equal(40, reader.Width);
+        Assert.Equal(10, reader.Height);
+        Assert.Equal("Demo", reader.Title);
+        Assert.True(reader.IsComplete);
+
+        var output = reader.ReadEvents().Where(e => e.Kind == Hex1bRecordingEventKind.Output).ToList();
+        Assert.Equal(2, output.Count);
+        Assert.Equal("Hello, ", output[0].GetText());
+        Assert.Equal("\x1b[31mWorld\x1b[0m", output[1].GetText());
+        Assert.Equal(TimeSpan.FromMilliseconds(250), output[1].Time - output[0].Time);
+        Assert.Equal(output[1].Time, reader.Duration);
+    }
+
+    [Fact]
+    public async Task Recording_AddsKeyframesAfterInterval()
+    {
+        var path = GetTempFile();
+        var options = new Hex1bRecorderOptions { KeyframeInterval = TimeSpan.FromSeconds(1) };
+        await RecordAsync(path, options, (workload, terminal, time, recorder) =>
+        {
+            for (var i = 0; i < 5; i++)
+            {
+                time.Advance(TimeSpan.FromMilliseconds(600));
+                workload.Write($"Line {i}\r\n");
+                terminal.FlushOutput();
+            }
+        });
+
+        using var reader = Hex1bRecordingReader.Open(path);
+
+        // The initial keyframe, then one every other frame
+        Assert.Equal(3, reader.Keyframes.Count);
+        Assert.Equal(TimeSpan.Zero, reader.Keyframes[0].Time);
+
+        var keyframe = reader.FindKeyframe(TimeSpan.FromSeconds(2))!.Value;
+        Assert.Equal(reader.Keyframes[1], keyframe);
+        Assert.Equal(TimeSpan.FromSeconds(1.2), keyframe.Time);
+
+        // Reading from a keyframe starts with the keyframe itself, holding the screen so far
+        var events = reader.ReadEvents(keyframe).ToList();
+        Assert.Equal(Hex1bRecordingEventKind.Keyframe, events[0].Kind);
+        Assert.Equal(keyframe.Time, events[0].Time);
+        Assert.Equal(["Line 2\r\n", "Line 3\r\n", "Line 4\r\n"],
+            events.Where(e => e.Kind == Hex1bRecordingEventKind.Output).Select(e => e.GetText()));
+
+        await using var restored = new Hex1bTerminal(new Hex1bAppWorkloadAdapter(), 40, 10);
+        restored.RestoreState(events[0].Data.ToArray());
+        Assert.True(restored.ContainsText("Line 1"));
+        Assert.False(restored.ContainsText("Line 2"));
+    }
+
+    [Fact]
+    public async Task Recording_KeepsResizeAndMarkerEvents()
+    {
+        var path = GetTempFile();
+        await RecordAsync(path, null, (workload, terminal, time, recorder) =>
+        {
+            // Headless terminals have no presentation to report resizes, so notify the filter directly
+            time.Advance(TimeSpan.FromSeconds(1));
+            _ = ((IHex1bTerminalWorkloadFilter)recorder).OnResizeAsync(60, 20, TimeSpan.FromSeconds(1));
+            recorder.AddMarker("chapter", TimeSpan.FromSeconds(2));
+        });
+
+        using var reader = Hex1bRecordingReader.Open(path);
+        var events = reader.ReadEvents().ToList();
+
+        var resize = Assert.Single(events, e => e.Kind == Hex1bRecordingEventKind.Resize);
+        Assert.Equal((60, 20), resize.GetSize());
+        var marker = Assert.Single(events, e => e.Kind == Hex1bRecordingEventKind.Marker);
+        Assert.Equal("chapter", marker.GetText());
+        Assert.Equal(TimeSpan.FromSeconds(2), marker.Time);
+    }
+
+    [Fact]
+    public async Task TruncatedRecording_IsScannedUpToLastCompleteRecord()
+    {
+        var path = GetTempFile();
+        var options = new Hex1bRecorderOptions { KeyframeInterval = TimeSpan.FromSeconds(1) };
+        await RecordAsync(path, options, (workload, terminal, time, recorder) =>
+        {
+            for (var i = 0; i < 3; i++)
+            {
+                time.Advance(TimeSpan.FromSeconds(1));
+                workload.Write($"Line {i}\r\n");
+                terminal.FlushOutput();
+            }
+        });
+
+        int keyframes;
+        using (var complete = Hex1bRecordingReader.Open(path))
+        {
+            keyframes = complete.Keyframes.Count;
+        }
+
+        // Drop the trailer, the index and a few bytes of the last record
+        var bytes = await File.ReadAllBytesAsync(path, TestContext.Current.CancellationToken);
+        using var truncated = new MemoryStream(bytes[..^40]);
+        using var reader = new Hex1bRecordingReader(truncated);
+
+        Assert.False(reader.IsComplete);
+        Assert.InRange(reader.Keyframes.Count, 1, keyframes);
+        Assert.Equal(TimeSpan.Zero, reader.Keyframes[0].Time);
+        Assert.Contains(reader.ReadEvents(), e => e.Kind == Hex1bRecordingEventKind.Output && e.GetText() == "Line 0\r\n");
+    }
+
+    [Fact]
+    public async Task Recording_ThroughOutputPump_AddsKeyframes()
+    {
+        var path = GetTempFile();
+        var time = new FakeTimeProvider(DateTimeOffset.UnixEpoch.AddYears(50));
+        var workload = new Hex1bAppWorkloadAdapter();
+        var options = new Hex1bTerminalOptions
+        {
+            Width = 40,
+            Height = 10,
+            WorkloadAdapter = workload,
+            PresentationAdapter = new NullPresentationAdapter(40, 10),
+            TimeProvider = time
+        };
+        await using var recorder = options.AddHex1bRecorder(path, new Hex1bRecorderOptions { KeyframeInterval = TimeSpan.FromSeconds(1) });
+        await using var terminal = new Hex1bTerminal(options);
+
+        workload.Write("First\r\n");
+        await TestWaitHelper.WaitUntilAsync(() => terminal.ContainsText("First"));
+        time.Advance(TimeSpan.FromSeconds(2));
+        workload.Write("Second\r\n");
+
+        // App workloads never return empty reads, so the keyframe comes from the pump
+        // treating an empty output queue as the end of the frame
+        await TestWaitHelper.WaitUntilAsync(() => recorder.KeyframeCount == 2);
+    }
+
+    [Fact]
+    public void Reader_RejectsOtherFiles()
+    {
+        using var stream = new MemoryStream("{\"version\": 2}"u8.ToArray());
+        Assert.Throws<InvalidDataException>(() => new Hex1bRecordingReader(stream));
+    }
+
+    #endregion
+
+    #region Conversion Tests
+
+    [Fact]
+    public async Task ToAsciicast_WritesOutputResizeAndMarkers()
+    {
+        var path = GetTempFile();
+        var castPath = GetTempFile(".cast");
+        await RecordAsync(path, new Hex1bRecorderOptions { Title = "Demo" }, (workload, terminal, time, recorder) =>
+        {
+            // A multi-byte character split across two reads
+            var bytes = Encoding.UTF8.GetBytes("é!");
+            workload.Write(bytes.AsSpan(0, 1).ToArray());
+            terminal.FlushOutput();
+            time.Advance(TimeSpan.FromSeconds(1));
+            workload.Write(bytes.AsSpan(1).ToArray());
+            terminal.FlushOutput();
+            _ = ((IHex1bTerminalWorkloadFilter)recorder).OnResizeAsync(50, 12, TimeSpan.FromSeconds(1));
+            recorder.AddMarker("done", TimeSpan.FromSeconds(2));
+        });
+
+        await Hex1bRecordingConverter.ToAsciicastAsync(path, castPath, TestContext.Current.CancellationToken);
+
+        var lines = await File.ReadAllLinesAsync(castPath, TestContext.Current.CancellationToken);
+        var header = JsonDocument.Parse(lines[0]).RootElement;
+        Assert.Equal(2, header.GetProperty("version").GetInt32());
+        Assert.Equal(40, header.GetProperty("width").GetInt32());
+        Assert.Equal("Demo", header.GetProperty("title").GetString());
+
+        var events = lines.Skip(1).Select(l => JsonDocument.Parse(l).RootElement).ToList();
+        var output = Assert.Single(events, e => e[1].GetString() == "o");
+        Assert.Equal("é!", output[2].GetString());
+        Assert.Equal(1.0, output[0].GetDouble(), 3);
+        Assert.Contains(events, e => e[1].GetString() == "r" && e[2].GetString() == "50x12");
+        Assert.Contains(events, e => e[1].GetString() == "m" && e[2].GetString() == "done");
+    }
+
+    [Fact]
+    public async Task FromAsciicast_BuildsKeyframesForSeeking()
+    {
+        var castPath = GetTempFile(".cast");
+        var path = GetTempFile();
+        await File.WriteAllLinesAsync(castPath,
+        [
+            "{\"version\": 2, \"width\": 30, \"height\": 5, \"title\": \"Imported\"}",
+            "[0.5, \"o\", \"First\\r\\n\"]",
+            "[12.0, \"o\", \"Second\\r\\n\"]",
+            "[13.0, \"m\", \"end\"]",
+        ], TestContext.Current.CancellationToken);
+
+        await Hex1bRecordingConverter.FromAsciicastAsync(castPath, path, ct: TestContext.Current.CancellationToken);
+
+        using var reader = Hex1bRecordingReader.Open(path);
+        Assert.Equal(30, reader.Width);
+        Assert.Equal("Imported", reader.Title);
+        Assert.Equal(TimeSpan.FromSeconds(13), reader.Duration);
+
+        // The default interval puts a second keyframe after the output at 12s
+        Assert.Equal(2, reader.Keyframes.Count);
+        var keyframe = reader.FindKeyframe(TimeSpan.FromSeconds(12.5))!.Value;
+        Assert.Equal(TimeSpan.FromSeconds(12), keyframe.Time);
+
+        await using var restored = new Hex1bTerminal(new Hex1bAppWorkloadAdapter(), 30, 5);
+        restored.RestoreState(reader.ReadEvents(keyframe).First().Data.ToArray());
+        Assert.True(restored.ContainsText("First"));
+        Assert.True(restored.ContainsText("Second"));
+    }
+
+    #endregion
+
+    private static async Task RecordAsync(
+        string path,
+        Hex1bRecorderOptions? recorderOptions,
+        Action<Hex1bAppWorkloadAdapter, Hex1bTerminal, FakeTimeProvider, Hex1bRecorder> record)
+    {
+        var time = new FakeTimeProvider(DateTimeOffset.UnixEpoch.AddYears(50));
+        var workload = new Hex1bAppWorkloadAdapter();
+        var options = new Hex1bTerminalOptions
+        {
+            Width = 40,
+            Height = 10,
+            WorkloadAdapter = workload,
+            TimeProvider = time
+        };
+        await using var recorder = options.AddHex1bRecorder(path, recorderOptions);
+        await using var terminal = new Hex1bTerminal(options);
+
+        record(workload, terminal, time, recorder);
+    }
+
+    private sealed class NullPresentationAdapter(int width, int height) : IHex1bTerminalPresentationAdapter
+    {
+        private readonly TaskCompletionSource _disposed = new(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        public int Width => width;
+        public int Height => height;
+        public TerminalCapabilities Capabilities => TerminalCapabilities.Minimal;
+#pragma warning disable CS0067 // Event is never used - required by interface
+        public event Action<int, int>? Resized;
+        public event Action? Disconnected;
+#pragma warning restore CS0067
+
+        public ValueTask WriteOutputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default) => ValueTask.CompletedTask;
+
+        public async ValueTask<ReadOnlyMemory<byte>> ReadInputAsync(CancellationToken ct = default)
+        {
+            try
+            {
+                await _disposed.Task.WaitAsync(ct);
+            }
+            catch (OperationCanceledException) { }
+            return ReadOnlyMemory<byte>.Empty;
+        }
+
+        public ValueTask FlushAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+
+        public ValueTask DisposeAsync()
+        {
+            _disposed.TrySetResult();
+            return ValueTask.CompletedTask;
+        }
+    }
+}
@@ -0,0 +1,187 @@
+using Hex1b.Terminal;
+using Hex1b.Tokens;
+using Microsoft.Extensions.Time.Testing;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for seeking through recordings with <see cref="Hex1bRecordingPlayer"/>.
+/// </summary>
+public class Hex1bRecordingPlayerTests : IDisposable
+{
+    private readonly List<string> _tempFiles = new();
+
+    private string GetTempFile()
+    {
+        var path = Path.Combine(Path.GetTempPath(), $"hex1b_test_{Guid.NewGuid()}.hxr");
+        _tempFiles.Add(path);
+        return path;
+    }
+
+    public void Dispose()
+    {
+        foreach (var file in _tempFiles)
+        {
+            try { File.Delete(file); } catch { }
+        }
+    }
+
+    #region Seek Tests
+
+    [Fact]
+    public async Task Seek_ShowsScreenAtTime()
+    {
+        var path = await RecordLinesAsync(30);
+        using var player = Hex1bRecordingPlayer.Open(path);
+
+        player.Seek(TimeSpan.FromSeconds(12.5));
+
+        using var snapshot = player.CreateSnapshot();
+        Assert.Equal(TimeSpan.FromSeconds(12.5), player.Position);
+        Assert.Contains("Line 12", snapshot.GetScreenText());
+        Assert.DoesNotContain("Line 13", snapshot.GetScreenText());
+    }
+
+    [Fact]
+    public async Task Seek_InAnyOrder_MatchesReplayFromStart()
+    {
+        var path = await RecordLinesAsync(30);
+        using var reader = Hex1bRecordingReader.Open(path);
+        using var player = new Hex1bRecordingPlayer(reader);
+
+        foreach (var seconds in new[] { 20.0, 3.0, 3.5, 29.0, 0.0, 17.2, 100.0, 8.0 })
+        {
+            var time = TimeSpan.FromSeconds(seconds);
+            player.Seek(time);
+
+            using var snapshot = player.CreateSnapshot();
+            Assert.Equal(ReplayFromStart(reader, time), snapshot.GetScreenText());
+        }
+    }
+
+    [Fact]
+    public async Task Seek_AppliesResizes()
+    {
+        var path = GetTempFile();
+        await RecordAsync(path, new Hex1bRecorderOptions { KeyframeInterval = TimeSpan.FromSeconds(1) }, (workload, terminal, time, recorder) =>
+        {
+            time.Advance(TimeSpan.FromSeconds(2));
+            terminal.Resize(60, 20);
+            _ = ((IHex1bTerminalWorkloadFilter)recorder).OnResizeAsync(60, 20, TimeSpan.FromSeconds(2));
+            workload.Write("Wide");
+            terminal.FlushOutput();
+        });
+
+        using var player = Hex1bRecordingPlayer.Open(path);
+
+        player.Seek(TimeSpan.FromSeconds(3));
+        using (var snapshot = player.CreateSnapshot())
+        {
+            Assert.Equal(60, snapshot.Width);
+            Assert.Contains("Wide", snapshot.GetScreenText());
+        }
+
+        player.Seek(TimeSpan.FromSeconds(1));
+        using (var snapshot = player.CreateSnapshot())
+        {
+            Assert.Equal(40, snapshot.Width);
+            Assert.DoesNotContain("Wide", snapshot.GetScreenText());
+        }
+    }
+
+    #endregion
+
+    #region Index Tests
+
+    [Fact]
+    public async Task BuildIndex_AddsKeyframesToSparseRecording()
+    {
+        // Without its index and trailer the recording is scanned, and has only its first keyframe
+        var path = await RecordLinesAsync(30, keyframeInterval: TimeSpan.FromMinutes(1));
+        var bytes = await File.ReadAllBytesAsync(path, TestContext.Current.CancellationToken);
+        using var stream = new MemoryStream(bytes[..^20]);
+        using var reader = new Hex1bRecordingReader(stream);
+        Assert.Single(reader.Keyframes);
+
+        using var player = new Hex1bRecordingPlayer(reader, new Hex1bRecordingPlayerOptions { KeyframeInterval = TimeSpan.FromSeconds(5) });
+        var before = player.KeyframeCount;
+        player.BuildIndex();
+
+        Assert.True(player.KeyframeCount >= before + 4, $"Expected keyframes every 5s, got {player.KeyframeCount}");
+        Assert.Equal(reader.Duration, player.Position);
+
+        player.Seek(TimeSpan.FromSeconds(21));
+        using var snapshot = player.CreateSnapshot();
+        Assert.Equal(ReplayFromStart(reader, TimeSpan.FromSeconds(21)), snapshot.GetScreenText());
+    }
+
+    [Fact]
+    public async Task Seek_KeepsKeyframesWhilePlayingThroughGaps()
+    {
+        var path = await RecordLinesAsync(30, keyframeInterval: TimeSpan.FromMinutes(1));
+        using var player = Hex1bRecordingPlayer.Open(path, new Hex1bRecordingPlayerOptions { KeyframeInterval = TimeSpan.FromSeconds(5) });
+        var before = player.KeyframeCount;
+
+        player.Seek(TimeSpan.FromSeconds(12));
+
+        Assert.Equal(before + 2, player.KeyframeCount);
+    }
+
+    #endregion
+
+    private async Task<string> RecordLinesAsync(int count, TimeSpan? keyframeInterval = null)
+    {
+        var path = GetTempFile();
+        var options = new Hex1bRecorderOptions { KeyframeInterval = keyframeInterval ?? TimeSpan.FromSeconds(5) };
+        await RecordAsync(path, options, (workload, terminal, time, recorder) =>
+        {
+            for (var i = 0; i < count; i++)
+            {
+                workload.Write($"\x1b[3{i % 8}mLine {i}\x1b[0m\r\n");
+                terminal.FlushOutput();
+                time.Advance(TimeSpan.FromSeconds(1));
+            }
+        });
+        return path;
+    }
+
+    private static string ReplayFromStart(Hex1bRecordingReader reader, TimeSpan time)
+    {
+        using var terminal = new Hex1bTerminal(new Hex1bAppWorkloadAdapter(), reader.Width, reader.Height);
+        foreach (var evt in reader.ReadEvents().TakeWhile(e => e.Time <= time))
+        {
+            if (evt.Kind == Hex1bRecordingEventKind.Output)
+            {
+                terminal.ApplyTokens(AnsiTokenizer.Tokenize(evt.GetText()));
+            }
+            else if (evt.Kind == Hex1bRecordingEventKind.Resize)
+            {
+                var (width, height) = evt.GetSize();
+                terminal.Resize(width, height);
+            }
+        }
+
+        using var snapshot = terminal.CreateSnapshot();
+        return snapshot.GetScreenText();
+    }
+
+    private static async Task RecordAsync(
+        string path,
+        Hex1bRecorderOptions? recorderOptions,
+        Action<Hex1bAppWorkloadAdapter, Hex1bTerminal, FakeTimeProvider, Hex1bRecorder> record)
+    {
+        var time = new FakeTimeProvider(DateTimeOffset.UnixEpoch.AddYears(50));
+        var workload = new Hex1bAppWorkloadAdapter();
+        var options = new Hex1bTerminalOptions
+        {
+            Width = 40,
+            Height = 10,
+            WorkloadAdapter = workload,
+            TimeProvider = time
+        };
+        await using var recorder = options.AddHex1bRecorder(path, recorderOptions);
+        await using var terminal = new Hex1bTerminal(options);
+
+        record(workload, terminal, time, recorder);
+    }
+}
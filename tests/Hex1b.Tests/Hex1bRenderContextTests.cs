@@ -1,5 +1,8 @@
 using Hex1b.Layout;
+using Hex1b.Nodes;
 using Hex1b.Terminal.Automation;
+using Hex1b.Theming;
+using Hex1b.Widgets;
 
 namespace Hex1b.Tests;
 
@@ -130,4 +133,150 @@ public class Hex1bRenderContextTests
     }
 
     #endregion
+
+    #region Styled Run Tests
+
+    [Fact]
+    public void WriteClipped_StyledRuns_ClipsToLayoutProvider()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 20, 3);
+        var context = new Hex1bRenderContext(workload);
+        var clip = new LayoutNode();
+        clip.Arrange(new Rect(2, 0, 4, 1));
+        context.CurrentLayoutProvider = clip;
+
+        var red = new TextStyle(Hex1bColor.Red);
+        context.WriteClipped(0, 0, [new StyledRun("AB", red), new StyledRun("CDEFG")]);
+        context.WriteClipped(0, 1, [new StyledRun("hidden", red)]);
+        terminal.FlushOutput();
+
+        var snapshot = terminal.CreateSnapshot();
+        Assert.Equal("  CDEF", snapshot.GetLineTrimmed(0));
+        Assert.Equal("", snapshot.GetLineTrimmed(1));
+    }
+
+    [Fact]
+    public void WriteClipped_StyledRuns_KeepStyleWhenLeftClipped()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 20, 3);
+        var context = new Hex1bRenderContext(workload);
+        var clip = new LayoutNode();
+        clip.Arrange(new Rect(2, 0, 10, 1));
+        context.CurrentLayoutProvider = clip;
+
+        var red = new TextStyle(Hex1bColor.Red);
+        context.WriteClipped(0, 0, [new StyledRun("> ", red), new StyledRun("Item", red)]);
+        context.SetCursorPosition(10, 0);
+        context.Write("x");
+        terminal.FlushOutput();
+
+        var snapshot = terminal.CreateSnapshot();
+        Assert.Equal("  Item", snapshot.GetLine(0)[..6]);
+        var fg = snapshot.GetForegroundColor(2, 0);
+        Assert.NotNull(fg);
+        Assert.Equal(255, fg.Value.R);
+        // The line ends with a reset so later writes are not tinted
+        Assert.Null(snapshot.GetForegroundColor(10, 0));
+    }
+
+    [Fact]
+    public void WriteClipped_StyledRuns_PadsWideCharacterCutByClipEdge()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 20, 3);
+        var context = new Hex1bRenderContext(workload);
+        var clip = new LayoutNode();
+        clip.Arrange(new Rect(1, 0, 4, 1));
+        context.CurrentLayoutProvider = clip;
+
+        // "😀" spans columns 0-1 and "😀" after "AB" spans columns 4-5; both are cut
+        context.WriteClipped(0, 0, [new StyledRun("😀AB"), new StyledRun("😀")]);
+        terminal.FlushOutput();
+
+        var snapshot = terminal.CreateSnapshot();
+        Assert.Equal("  AB", snapshot.GetLineTrimmed(0));
+        Assert.DoesNotContain("😀", snapshot.GetLine(0));
+    }
+
+    [Fact]
+    public void WriteClipped_StyledRunSlice_WritesOnlyTheSlice()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 20, 3);
+        var context = new Hex1bRenderContext(workload);
+
+        context.WriteClipped(0, 0, [new StyledRun("Hello World", 6, 5)]);
+        terminal.FlushOutput();
+
+        Assert.Equal("World", terminal.CreateSnapshot().GetLineTrimmed(0));
+    }
+
+    #endregion
+
+    #region Clip Stack Tests
+
+    [Fact]
+    public void PushLayoutProvider_IntersectsWithParentClip()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        var context = new Hex1bRenderContext(workload);
+        var outer = new LayoutNode();
+        outer.Arrange(new Rect(0, 0, 10, 5));
+        var inner = new LayoutNode();
+        inner.Arrange(new Rect(5, 2, 10, 10));
+
+        context.PushLayoutProvider(outer);
+        context.PushLayoutProvider(inner);
+
+        Assert.Same(inner, context.CurrentLayoutProvider);
+        Assert.Same(outer, inner.ParentLayoutProvider);
+        Assert.True(context.ShouldRenderAt(9, 4));
+        Assert.False(context.ShouldRenderAt(10, 4)); // Outside outer
+        Assert.False(context.ShouldRenderAt(4, 2));  // Outside inner
+    }
+
+    [Fact]
+    public void PopLayoutProvider_RestoresPreviousScope()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        var context = new Hex1bRenderContext(workload);
+        var outer = new LayoutNode();
+        outer.Arrange(new Rect(0, 0, 10, 5));
+        var inner = new LayoutNode();
+        inner.Arrange(new Rect(5, 2, 10, 10));
+
+        context.PushLayoutProvider(outer);
+        context.PushLayoutProvider(inner);
+        context.PopLayoutProvider();
+
+        Assert.Same(outer, context.CurrentLayoutProvider);
+        Assert.Null(inner.ParentLayoutProvider);
+        Assert.True(context.ShouldRenderAt(4, 2));
+
+        context.PopLayoutProvider();
+
+        Assert.Null(context.CurrentLayoutProvider);
+        Assert.True(context.ShouldRenderAt(100, 100));
+        Assert.Throws<InvalidOperationException>(() => context.PopLayoutProvider());
+    }
+
+    [Fact]
+    public void PushLayoutProvider_OverflowUnderOverflow_DoesNotClip()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        var context = new Hex1bRenderContext(workload);
+        var outer = new LayoutNode { ClipMode = ClipMode.Overflow };
+        outer.Arrange(new Rect(0, 0, 2, 2));
+        var inner = new LayoutNode { ClipMode = ClipMode.Overflow };
+        inner.Arrange(new Rect(0, 0, 2, 2));
+
+        context.PushLayoutProvider(outer);
+        context.PushLayoutProvider(inner);
+
+        Assert.True(context.ShouldRenderAt(50, 50));
+    }
+
+    #endregion
 }
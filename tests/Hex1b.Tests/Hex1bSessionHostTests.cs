@@ -0,0 +1,275 @@
+using System.Text;
+using Hex1b.Terminal;
+using Hex1b.Terminal.Automation;
+using Hex1b.Widgets;
+using Microsoft.Extensions.Time.Testing;
+
+namespace Hex1b.Tests;
+
+public class Hex1bSessionHostTests
+{
+    #region Session Tests
+
+    [Fact]
+    public async Task Session_RendersAppThroughPresentation()
+    {
+        await using var host = new Hex1bSessionHost(new Hex1bSessionHostOptions { WorkerCount = 1 });
+        var presentation = new CapturingPresentationAdapter(40, 5);
+        var session = host.CreateSession(presentation);
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+
+        var runTask = session.RunAppAsync(ctx => Task.FromResult<Hex1bWidget>(ctx.Text("Hello")), cancellationToken: cts.Token);
+        await TestWaitHelper.WaitUntilAsync(() => presentation.Output.Contains("Hello"));
+
+        cts.Cancel();
+        await runTask;
+
+        Assert.Equal(1, host.SessionCount);
+        Assert.True(session.GetMetrics().FramesRendered >= 1);
+
+        await session.DisposeAsync();
+        Assert.Equal(0, host.SessionCount);
+    }
+
+    #endregion
+
+    #region Budget Tests
+
+    [Fact]
+    public async Task FrameRateLimit_ThrottlesRapidInvalidation()
+    {
+        await using var host = new Hex1bSessionHost(new Hex1bSessionHostOptions
+        {
+            WorkerCount = 1,
+            MaxFramesPerSecond = 10,
+            RenderTimeBudget = Timeout.InfiniteTimeSpan
+        });
+        await using var session = host.CreateSession(new CapturingPresentationAdapter(40, 5));
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+
+        var counter = 0;
+        await using var app = new Hex1bApp(
+            ctx => Task.FromResult<Hex1bWidget>(ctx.Text($"Count {counter}")),
+            new Hex1bAppOptions { WorkloadAdapter = session.Workload });
+        var runTask = app.RunAsync(cts.Token);
+
+        var start = DateTime.UtcNow;
+        while (DateTime.UtcNow - start < TimeSpan.FromMilliseconds(500))
+        {
+            Interlocked.Increment(ref counter);
+            app.Invalidate();
+            await Task.Delay(5, TestContext.Current.CancellationToken);
+        }
+
+        cts.Cancel();
+        await runTask;
+
+        // About five frames fit in half a second at 10 fps; allow for timer slack
+        var metrics = session.GetMetrics();
+        Assert.InRange(metrics.FramesRendered, 2, 8);
+        Assert.True(metrics.FramesThrottled > 0);
+    }
+
+    [Fact]
+    public async Task WorkerCount_LimitsConcurrentFrames()
+    {
+        await using var host = new Hex1bSessionHost(new Hex1bSessionHostOptions
+        {
+            WorkerCount = 2,
+            MaxFramesPerSecond = 0,
+            RenderTimeBudget = Timeout.InfiniteTimeSpan
+        });
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+
+        var rendering = 0;
+        var maxRendering = 0;
+        var sessions = new List<Hex1bSession>();
+        var runTasks = new List<Task>();
+        for (var i = 0; i < 6; i++)
+        {
+            var session = host.CreateSession(new CapturingPresentationAdapter(20, 3));
+            sessions.Add(session);
+            runTasks.Add(session.RunAppAsync(async ctx =>
+            {
+                var now = Interlocked.Increment(ref rendering);
+                InterlockedMax(ref maxRendering, now);
+                await Task.Delay(20);
+                Interlocked.Decrement(ref rendering);
+                return ctx.Text("Busy");
+            }, cancellationToken: cts.Token));
+        }
+
+        await TestWaitHelper.WaitUntilAsync(() => sessions.All(s => s.GetMetrics().FramesRendered >= 1));
+        cts.Cancel();
+        await Task.WhenAll(runTasks);
+
+        Assert.InRange(maxRendering, 1, 2);
+        Assert.All(host.GetMetrics(), m => Assert.True(m.TotalQueueTime >= TimeSpan.Zero));
+    }
+
+    #endregion
+
+    #region Parking Tests
+
+    [Fact]
+    public async Task IdleSession_IsParkedAndRedrawnOnNextFrame()
+    {
+        var time = new FakeTimeProvider();
+        await using var host = new Hex1bSessionHost(new Hex1bSessionHostOptions
+        {
+            WorkerCount = 1,
+            MaxFramesPerSecond = 0,
+            RenderTimeBudget = Timeout.InfiniteTimeSpan,
+            IdleTimeout = TimeSpan.FromSeconds(1),
+            TimeProvider = time
+        });
+        var presentation = new CapturingPresentationAdapter(40, 5);
+        await using var session = host.CreateSession(presentation);
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+
+        await using var app = new Hex1bApp(
+            ctx => Task.FromResult<Hex1bWidget>(ctx.Text("Parked")),
+            new Hex1bAppOptions { WorkloadAdapter = session.Workload });
+        var runTask = app.RunAsync(cts.Token);
+
+        await TestWaitHelper.WaitUntilAsync(() => presentation.Output.Contains("Parked"));
+        await TestWaitHelper.WaitUntilAsync(() => session.GetMetrics().FramesRendered == 1);
+
+        // An unchanged frame sends nothing while the shadow buffers are intact
+        presentation.Clear();
+        app.Invalidate();
+        await TestWaitHelper.WaitUntilAsync(() => session.GetMetrics().FramesRendered == 2);
+        Assert.DoesNotContain("Parked", presentation.Output);
+
+        time.Advance(TimeSpan.FromSeconds(2));
+        Assert.True(session.IsParked);
+        Assert.Equal(1, session.GetMetrics().ParkCount);
+
+        // The first frame after parking redraws the whole screen
+        app.Invalidate();
+        await TestWaitHelper.WaitUntilAsync(() => presentation.Output.Contains("Parked"));
+        Assert.False(session.IsParked);
+
+        cts.Cancel();
+        await runTask;
+    }
+
+    [Fact]
+    public async Task IdleSession_IsHibernatedAndRestoredOnNextFrame()
+    {
+        var time = new FakeTimeProvider();
+        var directory = Directory.CreateTempSubdirectory("hex1b-sessions-");
+        try
+        {
+            await using var host = new Hex1bSessionHost(new Hex1bSessionHostOptions
+            {
+                WorkerCount = 1,
+                MaxFramesPerSecond = 0,
+                RenderTimeBudget = Timeout.InfiniteTimeSpan,
+                IdleTimeout = TimeSpan.FromSeconds(1),
+                HibernateTimeout = TimeSpan.FromSeconds(5),
+                HibernationDirectory = directory.FullName,
+                TimeProvider = time
+            });
+            var presentation = new CapturingPresentationAdapter(40, 5);
+            await using var session = host.CreateSession(presentation);
+            using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+
+            var label = "Before";
+            await using var app = new Hex1bApp(
+                ctx => Task.FromResult<Hex1bWidget>(ctx.Text(label)),
+                new Hex1bAppOptions { WorkloadAdapter = session.Workload });
+            var runTask = app.RunAsync(cts.Token);
+            await TestWaitHelper.WaitUntilAsync(() => session.GetMetrics().FramesRendered == 1);
+
+            time.Advance(TimeSpan.FromSeconds(2));
+            Assert.True(session.IsParked);
+            Assert.False(session.Terminal.IsHibernated);
+
+            time.Advance(TimeSpan.FromSeconds(5));
+            Assert.True(session.Terminal.IsHibernated);
+            Assert.Single(directory.GetFiles());
+
+            label = "After";
+            app.Invalidate();
+            await TestWaitHelper.WaitUntilAsync(() => session.GetMetrics().FramesRendered == 2);
+
+            var metrics = session.GetMetrics();
+            Assert.False(metrics.IsHibernated);
+            Assert.Equal(1, metrics.HibernateCount);
+            Assert.NotNull(metrics.LastRestoreLatency);
+            Assert.Empty(directory.GetFiles());
+            Assert.Contains("After", session.Terminal.CreateSnapshot().GetLine(0));
+
+            cts.Cancel();
+            await runTask;
+        }
+        finally
+        {
+            directory.Delete(recursive: true);
+        }
+    }
+
+    #endregion
+
+    private static void InterlockedMax(ref int target, int value)
+    {
+        var current = Volatile.Read(ref target);
+        while (value > current)
+        {
+            var observed = Interlocked.CompareExchange(ref target, value, current);
+            if (observed == current) return;
+            current = observed;
+        }
+    }
+
+    private sealed class CapturingPresentationAdapter(int width, int height) : IHex1bTerminalPresentationAdapter
+    {
+        private readonly StringBuilder _output = new();
+        private readonly TaskCompletionSource _disposed = new(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        public string Output
+        {
+            get { lock (_output) return _output.ToString(); }
+        }
+
+        public void Clear()
+        {
+            lock (_output) _output.Clear();
+        }
+
+        public int Width => width;
+        public int Height => height;
+        public TerminalCapabilities Capabilities => TerminalCapabilities.Minimal;
+#pragma warning disable CS0067 // Event is never used - required by interface
+        public event Action<int, int>? Resized;
+        public event Action? Disconnected;
+#pragma warning restore CS0067
+
+        public ValueTask WriteOutputAsync(ReadOnlyMemory<byte> data, CancellationToken ct = default)
+        {
+            lock (_output) _output.Append(Encoding.UTF8.GetString(data.Span));
+            return ValueTask.CompletedTask;
+        }
+
+        public async ValueTask<ReadOnlyMemory<byte>> ReadInputAsync(CancellationToken ct = default)
+        {
+            try
+            {
+                await _disposed.Task.WaitAsync(ct);
+            }
+            catch (OperationCanceledException) { }
+            return ReadOnlyMemory<byte>.Empty;
+        }
+
+        public ValueTask FlushAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask EnterTuiModeAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+        public ValueTask ExitTuiModeAsync(CancellationToken ct = default) => ValueTask.CompletedTask;
+
+        public ValueTask DisposeAsync()
+        {
+            _disposed.TrySetResult();
+            return ValueTask.CompletedTask;
+        }
+    }
+}
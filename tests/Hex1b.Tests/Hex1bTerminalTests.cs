@@ -1,4 +1,5 @@
 using Hex1b.Input;
+using Hex1b.Tokens;
 using Hex1b.Terminal.Automation;
 
 namespace Hex1b.Tests;
@@ -267,6 +268,21 @@ public class Hex1bTerminalTests
         Assert.False(terminal.CreateSnapshot().InAlternateScreen);
     }
 
+    [Fact]
+    public async Task AppWorkload_TuiMode_TogglesBracketedPaste()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+
+        workload.EnterTuiMode();
+        var enter = System.Text.Encoding.UTF8.GetString((await workload.ReadOutputAsync(TestContext.Current.CancellationToken)).Span);
+        workload.ExitTuiMode();
+        var exit = System.Text.Encoding.UTF8.GetString((await workload.ReadOutputAsync(TestContext.Current.CancellationToken)).Span);
+
+        // Only the app asks for pastes to be bracketed; a raw child process asks for itself
+        Assert.Contains("\x1b[?2004h", enter);
+        Assert.Contains("\x1b[?2004l", exit);
+    }
+
     #region Resize Behavior
 
     [Fact]
@@ -329,4 +345,105 @@ public class Hex1bTerminalTests
     }
 
     #endregion
+
+    #region Hibernation
+
+    [Fact]
+    public void SaveState_RestoreState_RoundTripsScreenCursorAndModes()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var source = new Hex1bTerminal(workload, 30, 6);
+        source.ApplyTokens(AnsiTokenizer.Tokenize(
+            "\x1b[?1049h\x1b[1;31mRed\x1b[0m plain\r\n" +
+            "\x1b]8;;https://example.com\x1b\\link\x1b]8;;\x1b\\\r\n" +
+            "\x1bPq#0;2;100;0;0#0~~~~~~\x1b\\" +
+            "\x1b[5;3H\x1b[38;2;1;2;3mrgb"));
+
+        var state = source.SaveState();
+
+        using var targetWorkload = new Hex1bAppWorkloadAdapter();
+        using var target = new Hex1bTerminal(targetWorkload, 30, 6);
+        target.RestoreState(state);
+
+        var expected = source.GetScreenBuffer();
+        var actual = target.GetScreenBuffer();
+        for (var y = 0; y < 6; y++)
+        {
+            for (var x = 0; x < 30; x++)
+            {
+                // Tracked objects belong to each terminal's own store; compare what they hold
+                Assert.Equal(
+                    expected[y, x] with { WrittenAt = default, TrackedSixel = null, TrackedHyperlink = null },
+                    actual[y, x] with { WrittenAt = default, TrackedSixel = null, TrackedHyperlink = null });
+                Assert.Equal(expected[y, x].SixelData?.Payload, actual[y, x].SixelData?.Payload);
+                Assert.Equal(expected[y, x].HyperlinkData?.Uri, actual[y, x].HyperlinkData?.Uri);
+            }
+        }
+        Assert.Equal(source.CursorX, target.CursorX);
+        Assert.Equal(source.CursorY, target.CursorY);
+        Assert.True(target.InAlternateScreen);
+        Assert.Equal(1, target.TrackedSixelCount);
+        Assert.Equal(1, target.TrackedHyperlinkCount);
+        Assert.Equal("https://example.com", target.GetHyperlinkDataAt(0, 1)?.Uri);
+    }
+
+    [Fact]
+    public void SaveState_BlankScreen_IsCompact()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 200, 60);
+
+        Assert.True(terminal.SaveState().Length < 64);
+    }
+
+    [Fact]
+    public void RestoreState_InvalidData_Throws()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 10, 2);
+        var state = terminal.SaveState();
+
+        Assert.Throws<InvalidDataException>(() => terminal.RestoreState("nope"u8));
+        Assert.Throws<InvalidDataException>(() => terminal.RestoreState(state.AsSpan(0, state.Length - 1)));
+    }
+
+    [Fact]
+    public void Hibernate_ReleasesTrackedObjectsUntilNextUse()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 20, 4);
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(
+            "\x1b]8;;https://example.com\x1b\\link\x1b]8;;\x1b\\\r\n\x1bPq#0;2;100;0;0#0~~~~~~\x1b\\"));
+
+        terminal.Hibernate();
+
+        Assert.True(terminal.IsHibernated);
+        Assert.Equal(0, terminal.TrackedSixelCount);
+        Assert.Equal(0, terminal.TrackedHyperlinkCount);
+
+        // Reading the screen wakes it
+        Assert.Equal("link", terminal.GetLineTrimmed(0));
+        Assert.False(terminal.IsHibernated);
+        Assert.Equal(1, terminal.TrackedSixelCount);
+        Assert.Equal(1, terminal.TrackedHyperlinkCount);
+    }
+
+    [Fact]
+    public void Hibernate_ToFile_DeletesFileOnWake()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 20, 4);
+        workload.Write("Sleeping");
+        var path = Path.Combine(Path.GetTempPath(), $"hex1b-test-{Guid.NewGuid():N}.state");
+
+        terminal.Hibernate(path);
+        Assert.True(File.Exists(path));
+
+        // Output wakes the terminal before it is applied
+        workload.Write(" and awake");
+        Assert.Equal("Sleeping and awake", terminal.GetLineTrimmed(0));
+        Assert.False(File.Exists(path));
+    }
+
+    #endregion
 }
@@ -0,0 +1,258 @@
+#pragma warning disable HEX1B_IMAGES // Testing experimental image API
+
+using System.IO.Compression;
+using Hex1b;
+using Hex1b.Layout;
+using Hex1b.Nodes;
+using Hex1b.Terminal;
+using Hex1b.Tokens;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for kitty graphics: command building, tokenizing and the terminal's image and placement tracking.
+/// </summary>
+public class KittyGraphicsTests
+{
+    private static byte[] CreatePixels(int width, int height, byte value = 0x80)
+    {
+        var pixels = new byte[width * height * 4];
+        Array.Fill(pixels, value);
+        return pixels;
+    }
+
+    [Fact]
+    public void Tokenize_PlacementCommand_ParsesControlData()
+    {
+        var tokens = AnsiTokenizer.Tokenize("\x1b_Ga=p,i=7,p=2,c=4,r=3,C=1;\x1b\\");
+
+        var token = Assert.IsType<KittyGraphicsToken>(Assert.Single(tokens));
+        Assert.Equal('p', token.Action);
+        Assert.Equal(7u, token.GetNumber('i'));
+        Assert.Equal(2u, token.GetNumber('p'));
+        Assert.Equal(4u, token.GetNumber('c'));
+        Assert.Equal(3u, token.GetNumber('r'));
+        Assert.Equal(0u, token.GetNumber('s'));
+        Assert.Null(token.GetValue('d'));
+        Assert.Equal("", token.Payload);
+    }
+
+    [Fact]
+    public void Serialize_KittyGraphicsToken_RoundTrips()
+    {
+        var command = "\x1b_Ga=t,f=32,s=1,v=1,i=3;AAAAAA==\x1b\\";
+
+        var token = Assert.IsType<KittyGraphicsToken>(Assert.Single(AnsiTokenizer.Tokenize(command)));
+
+        Assert.Equal("AAAAAA==", token.Payload);
+        Assert.Equal(command, AnsiTokenSerializer.Serialize(token));
+    }
+
+    [Fact]
+    public void Transmit_LargeImage_SplitsIntoChunks()
+    {
+        // 64x64 RGBA is 16 KiB, well over one 4096-character chunk once base64-encoded
+        var transmission = KittyGraphics.Transmit(5, CreatePixels(64, 64), 64, 64);
+
+        var tokens = AnsiTokenizer.Tokenize(transmission).Cast<KittyGraphicsToken>().ToArray();
+
+        Assert.True(tokens.Length > 1);
+        Assert.Equal(64u, tokens[0].GetNumber('s'));
+        Assert.Equal(64u, tokens[0].GetNumber('v'));
+        Assert.Equal(5u, tokens[0].GetNumber('i'));
+        Assert.All(tokens[..^1], t => Assert.Equal(1u, t.GetNumber('m')));
+        Assert.Equal(0u, tokens[^1].GetNumber('m'));
+        Assert.All(tokens, t => Assert.True(t.Payload.Length <= KittyGraphics.MaxChunkSize));
+        Assert.All(tokens.Skip(1), t => Assert.Null(t.GetValue('i')));
+    }
+
+    [Fact]
+    public void Terminal_TransmitAndPlace_TracksImageAndPlacement()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(
+            KittyGraphics.Transmit(1, CreatePixels(64, 64), 64, 64)
+            + "\x1b[3;5H"
+            + KittyGraphics.Place(1, 9, 10, 4)));
+
+        Assert.Equal(1, terminal.KittyImageCount);
+        var placement = Assert.Single(terminal.GetKittyPlacements());
+        Assert.Equal(1u, placement.ImageId);
+        Assert.Equal(9u, placement.PlacementId);
+        Assert.Equal(4, placement.Column);
+        Assert.Equal(2, placement.Row);
+        Assert.Equal(10, placement.Columns);
+        Assert.Equal(4, placement.Rows);
+        Assert.Equal(64 * 64 * 4, placement.Image.Data.Data.Length);
+    }
+
+    [Fact]
+    public void Terminal_PlaceAgainWithSameIds_MovesPlacement()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(
+            KittyGraphics.Transmit(1, CreatePixels(2, 2), 2, 2)
+            + "\x1b[1;1H" + KittyGraphics.Place(1, 1, 2, 1)
+            + "\x1b[6;8H" + KittyGraphics.Place(1, 1, 2, 1)));
+
+        var placement = Assert.Single(terminal.GetKittyPlacements());
+        Assert.Equal(7, placement.Column);
+        Assert.Equal(5, placement.Row);
+    }
+
+    [Fact]
+    public void Terminal_PlaceUnknownImage_IsIgnored()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(KittyGraphics.Place(42, 1, 2, 2)));
+
+        Assert.Empty(terminal.GetKittyPlacements());
+    }
+
+    [Fact]
+    public void Terminal_DeletePlacement_KeepsImageUntilFreed()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(
+            KittyGraphics.Transmit(1, CreatePixels(2, 2), 2, 2)
+            + KittyGraphics.Place(1, 1, 2, 1)
+            + KittyGraphics.Place(1, 2, 2, 1)
+            + KittyGraphics.Delete(1, 1)));
+
+        Assert.Equal(2u, Assert.Single(terminal.GetKittyPlacements()).PlacementId);
+        Assert.Equal(1, terminal.KittyImageCount);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(KittyGraphics.Delete(1, freeData: true)));
+
+        Assert.Empty(terminal.GetKittyPlacements());
+        Assert.Equal(0, terminal.KittyImageCount);
+    }
+
+    [Fact]
+    public void Terminal_MalformedUpload_IsIgnored()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b_Ga=t,f=32,s=1,v=1,i=1;not base64!\x1b\\"));
+
+        Assert.Equal(0, terminal.KittyImageCount);
+    }
+
+    [Fact]
+    public void Terminal_CompressedUploadLargerThanItsSize_IsIgnored()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+
+        // 2x2 RGBA is 16 bytes, but the data inflates to far more
+        using var compressed = new MemoryStream();
+        using (var zlib = new ZLibStream(compressed, CompressionLevel.Optimal, leaveOpen: true))
+        {
+            zlib.Write(new byte[1024 * 1024]);
+        }
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(
+            $"\x1b_Ga=t,f=32,s=2,v=2,i=1,o=z;{Convert.ToBase64String(compressed.ToArray())}\x1b\\"));
+
+        Assert.Equal(0, terminal.KittyImageCount);
+    }
+
+    [Fact]
+    public void ImageNode_WithKittySupport_UploadsOnceAndPlaces()
+    {
+        var image = new TerminalImage(CreatePixels(8, 8), 8, 8);
+        var node = new ImageNode { Image = image };
+
+        using var workload = new Hex1bAppWorkloadAdapter(new TerminalCapabilities { SupportsKittyGraphics = true });
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+        var context = new Hex1bRenderContext(workload);
+        node.Arrange(new Rect(2, 1, 6, 3));
+        node.Render(context);
+        node.Render(context);
+
+        Assert.Equal(1, terminal.KittyImageCount);
+        var placement = Assert.Single(terminal.GetKittyPlacements());
+        Assert.Equal(image.Id, placement.ImageId);
+        Assert.Equal(2, placement.Column);
+        Assert.Equal(1, placement.Row);
+        Assert.Equal(6, placement.Columns);
+        Assert.Equal(3, placement.Rows);
+    }
+
+    [Fact]
+    public void ImageNode_ImageChanged_ReplacesPlacement()
+    {
+        var first = new TerminalImage(CreatePixels(8, 8), 8, 8);
+        var second = new TerminalImage(CreatePixels(8, 8, 0x20), 8, 8);
+        var node = new ImageNode { Image = first };
+
+        using var workload = new Hex1bAppWorkloadAdapter(new TerminalCapabilities { SupportsKittyGraphics = true });
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+        var context = new Hex1bRenderContext(workload);
+        node.Arrange(new Rect(0, 0, 4, 2));
+        node.Render(context);
+
+        node.Image = second;
+        node.Render(context);
+
+        Assert.Equal(second.Id, Assert.Single(terminal.GetKittyPlacements()).ImageId);
+    }
+
+    [Fact]
+    public void ImageNode_BoundsShrinkToZero_DeletesPlacement()
+    {
+        var node = new ImageNode { Image = new TerminalImage(CreatePixels(8, 8), 8, 8) };
+
+        using var workload = new Hex1bAppWorkloadAdapter(new TerminalCapabilities { SupportsKittyGraphics = true });
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+        var context = new Hex1bRenderContext(workload);
+        node.Arrange(new Rect(0, 0, 4, 2));
+        node.Render(context);
+
+        node.Arrange(new Rect(0, 0, 0, 0));
+        node.Render(context);
+
+        Assert.Empty(terminal.GetKittyPlacements());
+    }
+
+    [Fact]
+    public void ImageNode_RemovedFromTree_DeletesPlacement()
+    {
+        var node = new ImageNode { Image = new TerminalImage(CreatePixels(8, 8), 8, 8) };
+
+        using var workload = new Hex1bAppWorkloadAdapter(new TerminalCapabilities { SupportsKittyGraphics = true });
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+        var context = new Hex1bRenderContext(workload);
+        node.Arrange(new Rect(0, 0, 4, 2));
+        node.Render(context);
+
+        context.DeleteDetachedKittyPlacements(node);
+        Assert.Single(terminal.GetKittyPlacements());
+
+        context.DeleteDetachedKittyPlacements(new VStackNode());
+        Assert.Empty(terminal.GetKittyPlacements());
+    }
+
+    [Fact]
+    public void ImageNode_WithoutImageSupport_RendersPlaceholder()
+    {
+        var node = new ImageNode { Image = new TerminalImage(CreatePixels(2, 2), 2, 2) };
+
+        using var workload = new Hex1bAppWorkloadAdapter(new TerminalCapabilities());
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+        var context = new Hex1bRenderContext(workload);
+        node.Arrange(new Rect(0, 0, 30, 2));
+        node.Render(context);
+
+        Assert.True(terminal.CreateSnapshot().ContainsText("[Images not supported]"));
+    }
+}
@@ -167,6 +167,56 @@ public class Osc8HyperlinkTests
         Assert.Equal(4, trackedLink.RefCount);
     }
 
+    [Fact]
+    public void TrackedHyperlink_RewrittenInPlace_KeepsRefCount()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+        var frame = "\x1b[1;1H\x1b]8;;https://example.com\x1b\\Link\x1b]8;;\x1b\\";
+        
+        // Render the same frame twice, as an app re-rendering would
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(frame));
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(frame));
+        
+        var trackedLink = terminal.GetTrackedHyperlinkAt(0, 0);
+        Assert.NotNull(trackedLink);
+        Assert.Equal(4, trackedLink.RefCount);
+        Assert.Equal(1, terminal.TrackedHyperlinkCount);
+    }
+
+    [Fact]
+    public void TrackedHyperlink_WhenScrolledOff_ReleasesReference()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 10, 2);
+        
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b]8;;https://example.com\x1b\\Link\x1b]8;;\x1b\\"));
+        Assert.Equal(1, terminal.TrackedHyperlinkCount);
+        
+        // Two full rows of plain text scroll the link's row off the top
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[2;1H" + new string('x', 20) + "y"));
+        
+        Assert.Equal(0, terminal.TrackedHyperlinkCount);
+    }
+
+    [Fact]
+    public void TrackedHyperlink_ClearedAndRedrawnInOneBatch_IsReused()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+        var link = "\x1b]8;;https://example.com\x1b\\Link\x1b]8;;\x1b\\";
+        
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize(link));
+        var before = terminal.GetTrackedHyperlinkAt(0, 0);
+        
+        // The clear releases every cell's reference, but the redraw in the same batch takes the link back
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[2J\x1b[1;1H" + link));
+        
+        Assert.Same(before, terminal.GetTrackedHyperlinkAt(0, 0));
+        Assert.Equal(4, before!.RefCount);
+        Assert.Equal(1, terminal.TrackedHyperlinkCount);
+    }
+
     [Fact]
     public void TrackedHyperlink_DifferentParameters_CreatesSeparateObjects()
     {
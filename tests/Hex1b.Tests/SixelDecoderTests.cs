@@ -0,0 +1,123 @@
+using Hex1b.Terminal.Automation;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for the streaming SixelDecoder.
+/// </summary>
+public class SixelDecoderTests
+{
+    private const string Red = "#1;2;100;0;0";
+    private const string Blue = "#2;2;0;0;100";
+
+    private static (int R, int G, int B, int A) PixelAt(SixelImage image, int x, int y)
+    {
+        var i = (y * image.Width + x) * 4;
+        return (image.Pixels[i], image.Pixels[i + 1], image.Pixels[i + 2], image.Pixels[i + 3]);
+    }
+
+    [Fact]
+    public void Decode_WithoutRasterAttributes_CoversBandsDrawn()
+    {
+        var image = SixelDecoder.Decode($"\x1bPq{Red}#1~~~\x1b\\");
+
+        Assert.NotNull(image);
+        Assert.Equal(3, image.Width);
+        Assert.Equal(6, image.Height);
+        Assert.Equal((255, 0, 0, 255), PixelAt(image, 2, 5));
+    }
+
+    [Fact]
+    public void Decode_RasterAttributes_SetImageSize()
+    {
+        // Ph;Pv is width;height
+        var image = SixelDecoder.Decode($"\x1bPq\"1;1;10;4{Red}#1!2F\x1b\\");
+
+        Assert.NotNull(image);
+        Assert.Equal(10, image.Width);
+        Assert.Equal(4, image.Height);
+        Assert.Equal((255, 0, 0, 255), PixelAt(image, 1, 2));
+        Assert.Equal(0, PixelAt(image, 1, 3).A);
+        Assert.Equal(0, PixelAt(image, 5, 0).A);
+    }
+
+    [Fact]
+    public void Decode_WideRasterAttributes_AreNotPadded()
+    {
+        // A 400x100 image as standard encoders write it; read height first it would be 400x400
+        var image = SixelDecoder.Decode($"\x1bPq\"1;1;400;100{Red}#1!400~\x1b\\");
+
+        Assert.NotNull(image);
+        Assert.Equal(400, image.Width);
+        Assert.Equal(100, image.Height);
+    }
+
+    [Fact]
+    public void Decode_DataOutsideRasterAttributes_GrowsImage()
+    {
+        var image = SixelDecoder.Decode($"\x1bPq\"1;1;2;6{Red}#1!5~-!3~\x1b\\");
+
+        Assert.NotNull(image);
+        Assert.Equal(5, image.Width);
+        Assert.Equal(12, image.Height);
+        Assert.Equal((255, 0, 0, 255), PixelAt(image, 4, 0));
+        Assert.Equal((255, 0, 0, 255), PixelAt(image, 2, 11));
+    }
+
+    [Fact]
+    public void Decode_RepeatInLaterBand_DrawsInThatBand()
+    {
+        var image = SixelDecoder.Decode($"\x1bPq{Red}{Blue}#1!4~-#2!4~$#1!2@\x1b\\");
+
+        Assert.NotNull(image);
+        Assert.Equal(12, image.Height);
+        Assert.Equal((255, 0, 0, 255), PixelAt(image, 3, 5));
+        Assert.Equal((0, 0, 255, 255), PixelAt(image, 3, 7));
+        // '@' is the top pixel only, drawn over the blue after the carriage return
+        Assert.Equal((255, 0, 0, 255), PixelAt(image, 1, 6));
+        Assert.Equal((0, 0, 255, 255), PixelAt(image, 1, 7));
+    }
+
+    [Fact]
+    public void Decode_NoSixelData_ReturnsNull()
+    {
+        Assert.Null(SixelDecoder.Decode(""));
+        Assert.Null(SixelDecoder.Decode($"\x1bPq{Red}\x1b\\"));
+    }
+
+    [Fact]
+    public void DecodeScaled_LargeImage_SamplesIntoSmallerImage()
+    {
+        // Left half red, right half blue, 40x12
+        var payload = $"\x1bPq\"1;1;40;12{Red}{Blue}#1!20~#2!20~-#1!20~#2!20~\x1b\\";
+
+        var image = SixelDecoder.DecodeScaled(payload, 10, 10);
+
+        Assert.NotNull(image);
+        Assert.Equal(10, image.Width);
+        Assert.Equal(3, image.Height);
+        Assert.Equal(image.Width * image.Height * 4, image.Pixels.Length);
+        Assert.Equal((255, 0, 0, 255), PixelAt(image, 4, 2));
+        Assert.Equal((0, 0, 255, 255), PixelAt(image, 5, 0));
+    }
+
+    [Fact]
+    public void DecodeScaled_WithoutRasterAttributes_MeasuresFirst()
+    {
+        var image = SixelDecoder.DecodeScaled($"\x1bPq{Red}#1!40~\x1b\\", 20, 20);
+
+        Assert.NotNull(image);
+        Assert.Equal(20, image.Width);
+        Assert.Equal(3, image.Height);
+    }
+
+    [Fact]
+    public void DecodeScaled_ImageThatFits_DecodesAtFullSize()
+    {
+        var image = SixelDecoder.DecodeScaled($"\x1bPq\"1;1;8;6{Red}#1!8~\x1b\\", 20, 20);
+
+        Assert.NotNull(image);
+        Assert.Equal(8, image.Width);
+        Assert.Equal(6, image.Height);
+    }
+}
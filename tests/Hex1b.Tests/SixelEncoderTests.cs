@@ -0,0 +1,189 @@
+#pragma warning disable HEX1B_SIXEL // Testing experimental Sixel API
+
+using Hex1b;
+using Hex1b.Terminal.Automation;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for the core SixelEncoder and SixelEncoderCache.
+/// </summary>
+public class SixelEncoderTests
+{
+    private static byte[] CreateImage(int width, int height, Func<int, int, (int R, int G, int B, int A)> pixel)
+    {
+        var rgba = new byte[width * height * 4];
+        for (var y = 0; y < height; y++)
+        {
+            for (var x = 0; x < width; x++)
+            {
+                var (r, g, b, a) = pixel(x, y);
+                var i = (y * width + x) * 4;
+                rgba[i] = (byte)r;
+                rgba[i + 1] = (byte)g;
+                rgba[i + 2] = (byte)b;
+                rgba[i + 3] = (byte)a;
+            }
+        }
+        return rgba;
+    }
+
+    private static int CountColorDefinitions(string sixel)
+        => sixel.Split('#').Count(part => part.Contains(";2;"));
+
+    [Fact]
+    public void Encode_WritesDcsSequenceWithRasterAttributes()
+    {
+        var rgba = CreateImage(40, 12, (_, _) => (255, 0, 0, 255));
+
+        var sixel = SixelEncoder.Encode(rgba, 40, 12);
+
+        // Raster attributes are Pan;Pad;Ph;Pv with the width (Ph) first
+        Assert.StartsWith("\x1bPq\"1;1;40;12#0;2;100;0;0", sixel);
+        Assert.EndsWith("\x1b\\", sixel);
+        // Two bands of 40 full columns, each written as one run
+        Assert.Equal("#0!40~-#0!40~", sixel[sixel.IndexOf("#0!", StringComparison.Ordinal)..^2]);
+    }
+
+    [Fact]
+    public void Encode_FewColors_RoundTripsExactly()
+    {
+        // Wider than a vector so both the vector and scalar packing paths are used
+        var rgba = CreateImage(37, 6, (x, y) => (x + y) % 3 switch
+        {
+            0 => (255, 0, 0, 255),
+            1 => (0, 255, 0, 255),
+            _ => (0, 0, 255, 255),
+        });
+
+        var image = SixelDecoder.Decode(SixelEncoder.Encode(rgba, 37, 6));
+
+        Assert.NotNull(image);
+        Assert.Equal(37, image.Width);
+        Assert.Equal(rgba, image.Pixels);
+    }
+
+    [Fact]
+    public void Encode_TransparentPixels_AreNotDrawn()
+    {
+        var rgba = CreateImage(20, 6, (x, _) => x < 10 ? (255, 255, 255, 255) : (0, 0, 0, 0));
+
+        var sixel = SixelEncoder.Encode(rgba, 20, 6);
+        var image = SixelDecoder.Decode(sixel);
+
+        Assert.Equal(1, CountColorDefinitions(sixel));
+        Assert.StartsWith("\x1bPq\"1;1;20;6", sixel);
+        Assert.EndsWith("#0!10~\x1b\\", sixel);
+        Assert.NotNull(image);
+        // Trailing empty columns are not written, but the width from the raster attributes
+        // (Ph, written first as standard encoders do) keeps them
+        Assert.Equal(20, image.Width);
+        Assert.Equal(6, image.Height);
+        Assert.Equal(0, image.Pixels[(15 * 4) + 3]);
+    }
+
+    [Fact]
+    public void Encode_ManyColors_QuantizesToMaxColors()
+    {
+        var rgba = CreateImage(64, 6, (x, y) => (x * 4, y * 40, 255 - x * 4, 255));
+        var options = new SixelEncoderOptions { MaxColors = 16 };
+
+        var sixel = SixelEncoder.Encode(rgba, 64, 6, options);
+        var image = SixelDecoder.Decode(sixel);
+
+        Assert.Equal(16, CountColorDefinitions(sixel));
+        Assert.NotNull(image);
+        for (var i = 0; i < rgba.Length; i += 4)
+        {
+            Assert.InRange(Math.Abs(image.Pixels[i] - rgba[i]), 0, 64);
+            Assert.InRange(Math.Abs(image.Pixels[i + 2] - rgba[i + 2]), 0, 64);
+        }
+    }
+
+    [Fact]
+    public void Encode_WithDither_StaysWithinPalette()
+    {
+        var rgba = CreateImage(64, 12, (x, _) => (x * 4, x * 4, x * 4, 255));
+
+        var plain = SixelEncoder.Encode(rgba, 64, 12, new SixelEncoderOptions { MaxColors = 4 });
+        var dithered = SixelEncoder.Encode(rgba, 64, 12, new SixelEncoderOptions { MaxColors = 4, Dither = true });
+
+        Assert.Equal(4, CountColorDefinitions(dithered));
+        Assert.NotEqual(plain, dithered);
+    }
+
+    [Fact]
+    public void Encode_TooFewBytes_Throws()
+    {
+        Assert.Throws<ArgumentException>(() => SixelEncoder.Encode(new byte[10], 2, 2));
+    }
+
+    [Fact]
+    public void EncodeTiledImage_SplitsImageIntoCellAlignedTiles()
+    {
+        var rgba = CreateImage(20, 12, (_, _) => (255, 255, 0, 255));
+        var options = new SixelEncoderOptions { TileWidthInCells = 2, TileHeightInCells = 1 };
+
+        var image = SixelEncoder.EncodeTiledImage(rgba, 20, 12, 4, 6, options);
+
+        Assert.NotNull(image.Tiles);
+        Assert.Equal(6, image.Tiles.Count);
+        (int, int, int, int)[] expected = [(0, 0, 2, 1), (2, 0, 2, 1), (4, 0, 1, 1), (0, 1, 2, 1), (2, 1, 2, 1), (4, 1, 1, 1)];
+        Assert.Equal(expected, image.Tiles.Select(t => (t.Column, t.Row, t.WidthInCells, t.HeightInCells)));
+        Assert.All(image.Tiles, t => Assert.StartsWith("\x1bPq", t.Payload));
+        // The single-sequence form is still available
+        Assert.Equal(SixelEncoder.Encode(rgba, 20, 12, options), image.Payload);
+    }
+
+    [Fact]
+    public void EncodeTiledImage_SmallChange_ChangesOnlyThatTile()
+    {
+        var options = new SixelEncoderOptions { TileWidthInCells = 2, TileHeightInCells = 1 };
+        var before = CreateImage(20, 12, (_, _) => (0, 128, 255, 255));
+        var after = CreateImage(20, 12, (x, y) => x == 17 && y == 7 ? (255, 0, 0, 255) : (0, 128, 255, 255));
+
+        var first = SixelEncoder.EncodeTiledImage(before, 20, 12, 4, 6, options);
+        var second = SixelEncoder.EncodeTiledImage(after, 20, 12, 4, 6, options);
+
+        var changed = Enumerable.Range(0, 6)
+            .Where(i => first.Tiles![i].Payload != second.Tiles![i].Payload)
+            .ToList();
+        Assert.Equal(5, Assert.Single(changed));
+        Assert.False(first.HasSameContent(second));
+        Assert.True(first.HasSameContent(SixelEncoder.EncodeTiledImage(before, 20, 12, 4, 6, options)));
+    }
+
+    [Fact]
+    public void Cache_SameKeyAndCellSize_ReturnsSameImage()
+    {
+        var cache = new SixelEncoderCache();
+        var rgba = CreateImage(8, 6, (_, _) => (0, 0, 255, 255));
+
+        var first = cache.GetOrEncode("chart", 10, 20, rgba, 8, 6);
+        var second = cache.GetOrEncode("chart", 10, 20, rgba, 8, 6);
+        var resized = cache.GetOrEncode("chart", 8, 16, rgba, 8, 6);
+
+        Assert.Same(first, second);
+        Assert.NotSame(first, resized);
+        Assert.True(cache.TryGet("chart", 10, 20, out var cached));
+        Assert.Same(first, cached);
+        Assert.Equal(2, cache.Count);
+    }
+
+    [Fact]
+    public void Cache_OverCapacity_EvictsLeastRecentlyUsed()
+    {
+        var cache = new SixelEncoderCache(capacity: 2);
+        var rgba = CreateImage(8, 6, (_, _) => (0, 255, 0, 255));
+
+        cache.GetOrEncode(1, 10, 20, rgba, 8, 6);
+        cache.GetOrEncode(2, 10, 20, rgba, 8, 6);
+        Assert.True(cache.TryGet(1, 10, 20, out _));
+        cache.GetOrEncode(3, 10, 20, rgba, 8, 6);
+
+        Assert.Equal(2, cache.Count);
+        Assert.True(cache.TryGet(1, 10, 20, out _));
+        Assert.False(cache.TryGet(2, 10, 20, out _));
+        Assert.True(cache.TryGet(3, 10, 20, out _));
+    }
+}
@@ -222,6 +222,56 @@ public class SixelNodeTests
         Assert.Contains("#0;2;100;0;0#0~~~~~~", trackedSixel.Payload);
     }
 
+    [Fact]
+    public void Render_WithImageHandle_WritesWrappedPayload()
+    {
+        var image = SixelImageHandle.Create("#0;2;100;0;0#0~~~~~~");
+        var node = new SixelNode { Image = image };
+
+        using var workload = CreateSixelEnabledWorkload();
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+        var context = new Hex1bRenderContext(workload);
+        node.Arrange(new Rect(0, 0, 40, 20));
+        node.Render(context);
+        terminal.FlushOutput();
+
+        Assert.Equal("\x1bPq#0;2;100;0;0#0~~~~~~\x1b\\", image.Payload);
+        Assert.Equal(image.Payload, terminal.GetSixelDataAt(0, 0)?.Payload);
+    }
+
+    [Fact]
+    public void ImageHandle_SameContent_DoesNotMarkDirty()
+    {
+        var node = new SixelNode { ImageData = "#0;2;100;0;0#0~~~~~~" };
+        var image = node.Image;
+        Assert.NotNull(image);
+        node.ClearDirty();
+
+        // An equal string, and a handle for the same image, keep the node's handle
+        node.ImageData = new string("#0;2;100;0;0#0~~~~~~".AsSpan());
+        node.Image = SixelImageHandle.Create("\x1bPq#0;2;100;0;0#0~~~~~~\x1b\\");
+
+        Assert.Same(image, node.Image);
+        Assert.False(node.IsDirty);
+
+        node.ImageData = "#0;2;0;100;0#0~~~~~~";
+
+        Assert.NotEqual(image.Id, node.Image!.Id);
+        Assert.True(node.IsDirty);
+    }
+
+    [Fact]
+    public async Task Reconcile_WithImageHandle_KeepsHandle()
+    {
+        var image = SixelImageHandle.Create("#0;2;100;0;0#0~~~~~~");
+        var widget = new SixelWidget(image, new TextBlockWidget("fallback"));
+
+        var node = (SixelNode)await widget.ReconcileAsync(null, ReconcileContext.CreateRoot());
+
+        Assert.Same(image, node.Image);
+        Assert.Equal("#0;2;100;0;0#0~~~~~~", node.ImageData);
+    }
+
     [Fact]
     public void Render_WithSmpteColorBars_ProducesSvgWithEmbeddedImage()
     {
@@ -0,0 +1,161 @@
+using System.Buffers.Binary;
+using Hex1b.Terminal;
+using Hex1b.Terminal.Automation;
+using Microsoft.Extensions.Time.Testing;
+
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Tests for batch rendering of frames with <see cref="TerminalFrameExporter"/>.
+/// </summary>
+public class TerminalFrameExporterTests : IDisposable
+{
+    private readonly string _directory = Path.Combine(Path.GetTempPath(), $"hex1b_test_{Guid.NewGuid()}");
+
+    public void Dispose()
+    {
+        try { Directory.Delete(_directory, recursive: true); } catch { }
+    }
+
+    #region Snapshot Tests
+
+    [Fact]
+    public async Task ExportAsync_Svg_MatchesToSvg()
+    {
+        using var terminal = CreateTerminal(out var workload);
+        var snapshots = new List<Hex1bTerminalSnapshot>();
+        for (var i = 0; i < 8; i++)
+        {
+            workload.Write($"\x1b[3{i}mFrame {i}\x1b[0m\r\n");
+            snapshots.Add(terminal.CreateSnapshot());
+        }
+
+        try
+        {
+            var files = await TerminalFrameExporter.ExportAsync(snapshots, _directory, ct: TestContext.Current.CancellationToken);
+
+            Assert.Equal(8, files.Count);
+            for (var i = 0; i < files.Count; i++)
+            {
+                Assert.Equal(Path.Combine(_directory, $"frame-{i:D5}.svg"), files[i]);
+                Assert.Equal(snapshots[i].ToSvg(), await File.ReadAllTextAsync(files[i], TestContext.Current.CancellationToken));
+            }
+        }
+        finally
+        {
+            snapshots.ForEach(s => s.Dispose());
+        }
+    }
+
+    [Fact]
+    public async Task ExportAsync_Html_MatchesToHtml()
+    {
+        using var terminal = CreateTerminal(out var workload);
+        workload.Write("\x1b[1mInspect\x1b[0m me");
+        using var snapshot = terminal.CreateSnapshot();
+        var options = new TerminalFrameExportOptions
+        {
+            Format = TerminalFrameFormat.Html,
+            RenderOptions = TerminalRegionSvgExtensions.DefaultOptions,
+            FileNameFormat = "page-{0}"
+        };
+
+        var files = await TerminalFrameExporter.ExportAsync([snapshot, snapshot], _directory, options, TestContext.Current.CancellationToken);
+
+        Assert.EndsWith("page-1.html", files[1]);
+        var expected = snapshot.ToHtml();
+        Assert.Equal(expected, await File.ReadAllTextAsync(files[0], TestContext.Current.CancellationToken));
+        Assert.Equal(expected, await File.ReadAllTextAsync(files[1], TestContext.Current.CancellationToken));
+    }
+
+    [Fact]
+    public async Task ExportAsync_Bmp_PaintsCellColors()
+    {
+        using var terminal = CreateTerminal(out var workload);
+        workload.Write("\x1b[48;2;255;0;0m  \x1b[0m");
+        using var snapshot = terminal.CreateSnapshot();
+        var renderOptions = new TerminalSvgOptions { CellWidth = 4, CellHeight = 8 };
+        var options = new TerminalFrameExportOptions { Format = TerminalFrameFormat.Bmp, RenderOptions = renderOptions };
+
+        var files = await TerminalFrameExporter.ExportAsync([snapshot], _directory, options, TestContext.Current.CancellationToken);
+        var bmp = await File.ReadAllBytesAsync(files[0], TestContext.Current.CancellationToken);
+
+        Assert.Equal(snapshot.ToBmp(renderOptions), bmp);
+        Assert.Equal((byte)'B', bmp[0]);
+        Assert.Equal(bmp.Length, BinaryPrimitives.ReadInt32LittleEndian(bmp.AsSpan(2)));
+        var width = BinaryPrimitives.ReadInt32LittleEndian(bmp.AsSpan(18));
+        var height = BinaryPrimitives.ReadInt32LittleEndian(bmp.AsSpan(22));
+        Assert.Equal(20 * 4, width);
+        Assert.Equal(4 * 8, height);
+
+        // Rows are stored bottom-up as BGR; the top-left cell's background is red
+        var stride = (width * 3 + 3) & ~3;
+        var topRow = 54 + (height - 1) * stride;
+        Assert.Equal([0, 0, 255], bmp[(topRow + 3 * 5)..(topRow + 3 * 6)]);
+        // The default background past the red cells
+        Assert.Equal([0x1e, 0x1e, 0x1e], bmp[(topRow + 3 * 12)..(topRow + 3 * 13)]);
+    }
+
+    #endregion
+
+    #region Recording Tests
+
+    [Fact]
+    public async Task ExportRecordingAsync_RendersScreenAtEachTime()
+    {
+        var recording = Path.Combine(_directory, "session.hxr");
+        Directory.CreateDirectory(_directory);
+        await RecordLinesAsync(recording, 20);
+
+        TimeSpan[] times = [TimeSpan.FromSeconds(15), TimeSpan.FromSeconds(2), TimeSpan.FromSeconds(9.5), TimeSpan.FromSeconds(2), TimeSpan.FromSeconds(19)];
+        var options = new TerminalFrameExportOptions { MaxDegreeOfParallelism = 2 };
+        var files = await TerminalFrameExporter.ExportRecordingAsync(recording, times, Path.Combine(_directory, "frames"), options, TestContext.Current.CancellationToken);
+
+        using var player = Hex1bRecordingPlayer.Open(recording);
+        for (var i = 0; i < times.Length; i++)
+        {
+            player.Seek(times[i]);
+            using var snapshot = player.CreateSnapshot();
+            Assert.Equal(snapshot.ToSvg(), await File.ReadAllTextAsync(files[i], TestContext.Current.CancellationToken));
+        }
+    }
+
+    [Fact]
+    public async Task ExportRecordingAsync_WithInterval_CoversWholeRecording()
+    {
+        var recording = Path.Combine(_directory, "session.hxr");
+        Directory.CreateDirectory(_directory);
+        await RecordLinesAsync(recording, 10);
+
+        var files = await TerminalFrameExporter.ExportRecordingAsync(
+            recording, TimeSpan.FromSeconds(2), Path.Combine(_directory, "frames"), ct: TestContext.Current.CancellationToken);
+
+        // The last line is written at 9s: frames at 0, 2, 4, 6 and 8s
+        Assert.Equal(5, files.Count);
+        Assert.All(files, f => Assert.True(File.Exists(f)));
+    }
+
+    #endregion
+
+    private static Hex1bTerminal CreateTerminal(out Hex1bAppWorkloadAdapter workload)
+    {
+        workload = new Hex1bAppWorkloadAdapter();
+        return new Hex1bTerminal(workload, 20, 4);
+    }
+
+    private static async Task RecordLinesAsync(string path, int count)
+    {
+        var time = new FakeTimeProvider(DateTimeOffset.UnixEpoch.AddYears(50));
+        var workload = new Hex1bAppWorkloadAdapter();
+        var options = new Hex1bTerminalOptions { Width = 30, Height = 6, WorkloadAdapter = workload, TimeProvider = time };
+        await using var recorder = options.AddHex1bRecorder(path, new Hex1bRecorderOptions { KeyframeInterval = TimeSpan.FromSeconds(3) });
+        await using var terminal = new Hex1bTerminal(options);
+
+        for (var i = 0; i < count; i++)
+        {
+            workload.Write($"\x1b[3{i % 8}mLine {i}\x1b[0m\r\n");
+            terminal.FlushOutput();
+            time.Advance(TimeSpan.FromSeconds(1));
+        }
+    }
+}
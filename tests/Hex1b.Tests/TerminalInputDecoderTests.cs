@@ -0,0 +1,265 @@
+using System.Text;
+using Hex1b.Input;
+
+namespace Hex1b.Tests;
+
+public class TerminalInputDecoderTests
+{
+    private static List<Hex1bEvent> Decode(TerminalInputDecoder decoder, string input)
+    {
+        var events = new List<Hex1bEvent>();
+        decoder.Decode(Encoding.UTF8.GetBytes(input), events);
+        return events;
+    }
+
+    private static List<Hex1bEvent> Decode(string input) => Decode(new TerminalInputDecoder(), input);
+
+    [Fact]
+    public void Decode_PlainText_EmitsKeyPerCharacter()
+    {
+        var events = Decode("aB1 \r");
+
+        Assert.Collection(events,
+            e => Assert.Equal(new Hex1bKeyEvent(Hex1bKey.A, 'a', Hex1bModifiers.None), e),
+            e => Assert.Equal(new Hex1bKeyEvent(Hex1bKey.B, 'B', Hex1bModifiers.Shift), e),
+            e => Assert.Equal(new Hex1bKeyEvent(Hex1bKey.D1, '1', Hex1bModifiers.None), e),
+            e => Assert.Equal(Hex1bKey.Spacebar, Assert.IsType<Hex1bKeyEvent>(e).Key),
+            e => Assert.Equal(Hex1bKey.Enter, Assert.IsType<Hex1bKeyEvent>(e).Key));
+    }
+
+    [Fact]
+    public void Decode_CsiWithModifiers_EmitsModifiedKey()
+    {
+        var events = Decode("\x1b[1;5A\x1b[3~\x1b[Z");
+
+        Assert.Collection(events,
+            e => Assert.Equal(new Hex1bKeyEvent(Hex1bKey.UpArrow, '\0', Hex1bModifiers.Control), e),
+            e => Assert.Equal(new Hex1bKeyEvent(Hex1bKey.Delete, '\0', Hex1bModifiers.None), e),
+            e => Assert.Equal(new Hex1bKeyEvent(Hex1bKey.Tab, '\0', Hex1bModifiers.Shift), e));
+    }
+
+    [Fact]
+    public void Decode_Ss3_EmitsFunctionKey()
+    {
+        var key = Assert.IsType<Hex1bKeyEvent>(Assert.Single(Decode("\x1bOP")));
+
+        Assert.Equal(Hex1bKey.F1, key.Key);
+    }
+
+    [Fact]
+    public void Decode_AltLetter_EmitsAltKey()
+    {
+        var key = Assert.IsType<Hex1bKeyEvent>(Assert.Single(Decode("\x1b" + "f")));
+
+        Assert.Equal(Hex1bKey.F, key.Key);
+        Assert.Equal(Hex1bModifiers.Alt, key.Modifiers);
+    }
+
+    [Fact]
+    public void Decode_SgrMouse_EmitsMouseEvent()
+    {
+        var mouse = Assert.IsType<Hex1bMouseEvent>(Assert.Single(Decode("\x1b[<0;11;6m")));
+
+        Assert.Equal(MouseButton.Left, mouse.Button);
+        Assert.Equal(MouseAction.Up, mouse.Action);
+        Assert.Equal(10, mouse.X);
+        Assert.Equal(5, mouse.Y);
+    }
+
+    [Fact]
+    public void Decode_RepeatedMouseReport_ReusesEvent()
+    {
+        // The keys in between keep the reports from being merged
+        var events = Decode("\x1b[<35;4;4Mx\x1b[<35;5;4Mx\x1b[<35;4;4M");
+
+        Assert.Equal(5, events.Count);
+        Assert.Same(events[0], events[4]);
+        Assert.NotSame(events[0], events[2]);
+    }
+
+    [Fact]
+    public void Decode_ConsecutiveMotion_KeepsLatestPosition()
+    {
+        var events = Decode("\x1b[<35;1;1M\x1b[<35;2;1M\x1b[<35;3;2M");
+
+        var mouse = Assert.IsType<Hex1bMouseEvent>(Assert.Single(events));
+        Assert.Equal(MouseAction.Move, mouse.Action);
+        Assert.Equal(2, mouse.X);
+        Assert.Equal(1, mouse.Y);
+    }
+
+    [Fact]
+    public void Decode_ConsecutiveWheelTicks_AreSummed()
+    {
+        var events = Decode("\x1b[<65;5;5M\x1b[<65;5;5M\x1b[<65;5;5M\x1b[<64;5;5M");
+
+        Assert.Collection(events,
+            e =>
+            {
+                var mouse = Assert.IsType<Hex1bMouseEvent>(e);
+                Assert.Equal(MouseButton.ScrollDown, mouse.Button);
+                Assert.Equal(3, mouse.ScrollTicks);
+            },
+            e =>
+            {
+                var mouse = Assert.IsType<Hex1bMouseEvent>(e);
+                Assert.Equal(MouseButton.ScrollUp, mouse.Button);
+                Assert.Equal(1, mouse.ScrollTicks);
+            });
+    }
+
+    [Fact]
+    public void Decode_KeyBetweenMotion_IsNotReordered()
+    {
+        var events = Decode("\x1b[<35;1;1Ma\x1b[<35;2;1M\x1b[<35;3;1M");
+
+        Assert.Collection(events,
+            e => Assert.Equal(0, Assert.IsType<Hex1bMouseEvent>(e).X),
+            e => Assert.Equal(Hex1bKey.A, Assert.IsType<Hex1bKeyEvent>(e).Key),
+            e => Assert.Equal(2, Assert.IsType<Hex1bMouseEvent>(e).X));
+    }
+
+    [Fact]
+    public void Decode_ClicksAreNotMerged()
+    {
+        var events = Decode("\x1b[<0;1;1M\x1b[<0;1;1m\x1b[<0;1;1M\x1b[<0;1;1m");
+
+        Assert.Equal(4, events.Count);
+    }
+
+    [Fact]
+    public void Decode_Da1Response_IsSwallowed()
+    {
+        var events = Decode("\x1b[?62;4;22cx");
+
+        var key = Assert.IsType<Hex1bKeyEvent>(Assert.Single(events));
+        Assert.Equal(Hex1bKey.X, key.Key);
+    }
+
+    [Fact]
+    public void Decode_SequenceSplitAcrossChunks_IsDecodedWhenComplete()
+    {
+        var decoder = new TerminalInputDecoder();
+
+        Assert.Empty(Decode(decoder, "\x1b[<35;1"));
+        Assert.True(decoder.HasPendingInput);
+
+        var mouse = Assert.IsType<Hex1bMouseEvent>(Assert.Single(Decode(decoder, "2;7M")));
+        Assert.Equal(MouseAction.Move, mouse.Action);
+        Assert.Equal(11, mouse.X);
+        Assert.Equal(6, mouse.Y);
+        Assert.False(decoder.HasPendingInput);
+    }
+
+    [Fact]
+    public void Decode_Utf8SplitAcrossChunks_IsDecodedWhenComplete()
+    {
+        var decoder = new TerminalInputDecoder();
+        var bytes = Encoding.UTF8.GetBytes("é😀");
+        var events = new List<Hex1bEvent>();
+
+        // Feed one byte at a time
+        foreach (var b in bytes)
+        {
+            decoder.Decode([b], events);
+        }
+
+        Assert.Collection(events,
+            e => Assert.Equal("é", Assert.IsType<Hex1bKeyEvent>(e).Text),
+            e => Assert.Equal("😀", Assert.IsType<Hex1bKeyEvent>(e).Text));
+    }
+
+    [Fact]
+    public void Decode_LoneEscape_WaitsUntilFlushed()
+    {
+        var decoder = new TerminalInputDecoder();
+
+        Assert.Empty(Decode(decoder, "\x1b"));
+
+        var events = new List<Hex1bEvent>();
+        decoder.Flush(events);
+
+        var key = Assert.IsType<Hex1bKeyEvent>(Assert.Single(events));
+        Assert.Equal(Hex1bKey.Escape, key.Key);
+        Assert.False(decoder.HasPendingInput);
+    }
+
+    [Fact]
+    public void Decode_EscapeThenSequenceInNextChunk_EmitsOnlyTheSequenceKey()
+    {
+        var decoder = new TerminalInputDecoder();
+
+        Assert.Empty(Decode(decoder, "\x1b"));
+        var key = Assert.IsType<Hex1bKeyEvent>(Assert.Single(Decode(decoder, "[B")));
+
+        Assert.Equal(Hex1bKey.DownArrow, key.Key);
+    }
+
+    [Fact]
+    public void Decode_BracketedPaste_EmitsOnePasteEvent()
+    {
+        var decoder = new TerminalInputDecoder();
+
+        var events = Decode(decoder, "\x1b[200~a\x1b[Ab\r\nline 2\x1b[20");
+        Assert.Empty(events);
+        Assert.True(decoder.InPaste);
+        events.AddRange(Decode(decoder, "1~c"));
+
+        Assert.False(decoder.InPaste);
+        Assert.Collection(events,
+            e => Assert.Equal("a[Ab\nline 2", Assert.IsType<Hex1bPasteEvent>(e).Text),
+            e => Assert.Equal(Hex1bKey.C, Assert.IsType<Hex1bKeyEvent>(e).Key));
+    }
+
+    [Fact]
+    public void Decode_LargePasteInManyChunks_EmitsOnePasteEvent()
+    {
+        var decoder = new TerminalInputDecoder();
+        var text = string.Concat(Enumerable.Repeat("héllo wörld ", 20_000));
+        var bytes = Encoding.UTF8.GetBytes("\x1b[200~" + text + "\x1b[201~");
+        var events = new List<Hex1bEvent>();
+
+        // Chunk boundaries land inside multi-byte characters and the end marker
+        for (var offset = 0; offset < bytes.Length; offset += 4093)
+        {
+            decoder.Decode(bytes.AsSpan(offset, Math.Min(4093, bytes.Length - offset)), events);
+        }
+
+        Assert.Equal(text, Assert.IsType<Hex1bPasteEvent>(Assert.Single(events)).Text);
+    }
+
+    [Fact]
+    public void Decode_PasteEndMarkerSplitAcrossFlush_EndsPaste()
+    {
+        var decoder = new TerminalInputDecoder();
+        var events = Decode(decoder, "\x1b[200~abc\x1b[20");
+
+        // The pump flushes when a read ends in a partial sequence and nothing follows soon
+        decoder.Flush(events);
+        Assert.Empty(events);
+        Assert.True(decoder.InPaste);
+
+        events.AddRange(Decode(decoder, "1~x"));
+
+        Assert.False(decoder.InPaste);
+        Assert.Collection(events,
+            e => Assert.Equal("abc", Assert.IsType<Hex1bPasteEvent>(e).Text),
+            e => Assert.Equal(Hex1bKey.X, Assert.IsType<Hex1bKeyEvent>(e).Key));
+    }
+
+    [Fact]
+    public void Decode_OversizedPaste_IsDeliveredInParts()
+    {
+        var decoder = new TerminalInputDecoder();
+        var text = string.Concat(Enumerable.Repeat("héllo\r\nwörld ", TerminalInputDecoder.MaxPasteLength / 8));
+        var bytes = Encoding.UTF8.GetBytes("\x1b[200~" + text + "\x1b[201~");
+        var events = new List<Hex1bEvent>();
+
+        decoder.Decode(bytes, events);
+
+        Assert.True(events.Count > 1);
+        var parts = events.Select(e => Assert.IsType<Hex1bPasteEvent>(e).Text).ToArray();
+        Assert.Equal(text.Replace("\r\n", "\n"), string.Concat(parts));
+        Assert.False(decoder.InPaste);
+    }
+}
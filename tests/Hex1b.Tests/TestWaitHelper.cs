@@ -0,0 +1,21 @@
+namespace Hex1b.Tests;
+
+/// <summary>
+/// Helper for waiting on state that background tasks (pumps, send loops) update.
+/// </summary>
+public static class TestWaitHelper
+{
+    /// <summary>
+    /// Polls <paramref name="condition"/> until it holds, failing the test after five seconds.
+    /// </summary>
+    /// <param name="condition">The condition to wait for.</param>
+    public static async Task WaitUntilAsync(Func<bool> condition)
+    {
+        using var cts = CancellationTokenSource.CreateLinkedTokenSource(TestContext.Current.CancellationToken);
+        cts.CancelAfter(TimeSpan.FromSeconds(5));
+        while (!condition())
+        {
+            await Task.Delay(10, cts.Token);
+        }
+    }
+}
@@ -321,6 +321,30 @@ public class TextBoxNodeTests
         Assert.Equal("helloX", node.Text);
     }
 
+    [Fact]
+    public async Task HandlePaste_WhenFocused_InsertsWholeTextAtCursor()
+    {
+        var node = new TextBoxNode { Text = "hello", IsFocused = true };
+        node.State.CursorPosition = 2;
+
+        var result = await InputRouter.RoutePasteAsync(node, new Hex1bPasteEvent("ABC\nD\u0007E"), new FocusRing(), new InputRouterState(), cancellationToken: TestContext.Current.CancellationToken);
+
+        Assert.Equal(InputResult.Handled, result);
+        Assert.Equal("heABC DEllo", node.Text);
+        Assert.Equal(8, node.State.CursorPosition);
+    }
+
+    [Fact]
+    public async Task HandlePaste_WithSelection_ReplacesSelection()
+    {
+        var node = new TextBoxNode { Text = "hello", IsFocused = true };
+        node.State.SelectAll();
+
+        await InputRouter.RoutePasteAsync(node, new Hex1bPasteEvent("bye"), new FocusRing(), new InputRouterState(), cancellationToken: TestContext.Current.CancellationToken);
+
+        Assert.Equal("bye", node.Text);
+    }
+
     [Fact]
     public async Task HandleInput_WhenNotFocused_DoesNotHandle()
     {
@@ -114,6 +114,31 @@ public class TextBoxStateTests
         Assert.Equal(5, state.CursorPosition);
     }
 
+    [Fact]
+    public void HandleInput_ArrowKeys_MoveByGraphemeCluster()
+    {
+        var state = new TextBoxState { Text = "a👍🏽b", CursorPosition = 1 };
+        
+        state.HandleInput(new Hex1bKeyEvent(Hex1bKey.RightArrow, '\0', Hex1bModifiers.None));
+        Assert.Equal(5, state.CursorPosition);
+        
+        state.HandleInput(new Hex1bKeyEvent(Hex1bKey.LeftArrow, '\0', Hex1bModifiers.None));
+        Assert.Equal(1, state.CursorPosition);
+    }
+
+    [Fact]
+    public void HandleInput_BackspaceAndDelete_RemoveWholeGraphemeCluster()
+    {
+        var state = new TextBoxState { Text = "😀e\u0301", CursorPosition = 2 };
+        
+        state.HandleInput(new Hex1bKeyEvent(Hex1bKey.Delete, '\0', Hex1bModifiers.None));
+        Assert.Equal("😀", state.Text);
+        
+        state.HandleInput(new Hex1bKeyEvent(Hex1bKey.Backspace, '\b', Hex1bModifiers.None));
+        Assert.Equal("", state.Text);
+        Assert.Equal(0, state.CursorPosition);
+    }
+
     [Fact]
     public void HandleInput_Home_MovesCursorToStart()
     {
@@ -510,4 +510,63 @@ public class ThemePanelNodeTests
     }
 
     #endregion
+
+    #region Theme Layering Tests
+
+    [Fact]
+    public void Clone_OfLockedTheme_LayersOverridesOverBase()
+    {
+        var baseTheme = new Hex1bTheme("Base")
+            .Set(ButtonTheme.FocusedForegroundColor, Hex1bColor.Red)
+            .Set(ButtonTheme.FocusedBackgroundColor, Hex1bColor.Blue)
+            .Lock();
+
+        var layered = baseTheme.Clone()
+            .Set(ButtonTheme.FocusedBackgroundColor, Hex1bColor.Green);
+
+        Assert.Equal(Hex1bColor.Red, layered.Get(ButtonTheme.FocusedForegroundColor));
+        Assert.Equal(Hex1bColor.Green, layered.Get(ButtonTheme.FocusedBackgroundColor));
+        Assert.Equal(Hex1bColor.Blue, baseTheme.Get(ButtonTheme.FocusedBackgroundColor));
+    }
+
+    [Fact]
+    public void Clone_OfUnlockedTheme_IsNotAffectedByLaterChanges()
+    {
+        var original = new Hex1bTheme("Original")
+            .Set(ButtonTheme.FocusedForegroundColor, Hex1bColor.Red);
+
+        var clone = original.Clone();
+        original.Set(ButtonTheme.FocusedForegroundColor, Hex1bColor.Yellow);
+
+        Assert.Equal(Hex1bColor.Red, clone.Get(ButtonTheme.FocusedForegroundColor));
+    }
+
+    [Fact]
+    public void GetForegroundAnsi_ReturnsCachedSequenceForValue()
+    {
+        var theme = new Hex1bTheme("Test")
+            .Set(ButtonTheme.FocusedForegroundColor, Hex1bColor.FromRgb(1, 2, 3));
+
+        var first = theme.GetForegroundAnsi(ButtonTheme.FocusedForegroundColor);
+
+        Assert.Equal("\x1b[38;2;1;2;3m", first);
+        Assert.Same(first, theme.GetForegroundAnsi(ButtonTheme.FocusedForegroundColor));
+        Assert.Equal("\x1b[49m", theme.GetBackgroundAnsi(GlobalTheme.BackgroundColor));
+
+        theme.Set(ButtonTheme.FocusedForegroundColor, Hex1bColor.FromRgb(4, 5, 6));
+        Assert.Equal("\x1b[38;2;4;5;6m", theme.GetForegroundAnsi(ButtonTheme.FocusedForegroundColor));
+    }
+
+    [Fact]
+    public void GetResetToGlobalCodes_IsInvalidatedBySet()
+    {
+        var theme = new Hex1bTheme("Test");
+        Assert.Equal("\x1b[0m", theme.GetResetToGlobalCodes());
+
+        theme.Set(GlobalTheme.ForegroundColor, Hex1bColor.FromRgb(1, 2, 3));
+
+        Assert.Equal("\x1b[0m\x1b[38;2;1;2;3m", theme.GetResetToGlobalCodes());
+    }
+
+    #endregion
 }
@@ -155,4 +155,77 @@ public class TrackedObjectTests
         // RefCount should be 2 (one for each cell)
         Assert.Equal(2, trackedSixel.RefCount);
     }
+
+    [Fact]
+    public void TrackedSixel_DifferentPayloads_AreNotShared()
+    {
+        using var workload = new Hex1bAppWorkloadAdapter();
+        using var terminal = new Hex1bTerminal(workload, 80, 24);
+
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1bPq#0;2;100;0;0#0~~~~~~\x1b\\"));
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1b[2;1H"));
+        terminal.ApplyTokens(AnsiTokenizer.Tokenize("\x1bPq#0;2;0;100;0#0~~~~~~\x1b\\"));
+
+        Assert.Equal(2, terminal.TrackedSixelCount);
+        Assert.NotSame(terminal.GetSixelDataAt(0, 0), terminal.GetSixelDataAt(0, 1));
+    }
+
+    [Fact]
+    public void SixelContentHash_MatchesXxHash64()
+    {
+        // Reference values for XXH64 with seed 0
+        Assert.Equal(0xEF46DB3751D8E999UL, XxHash64.Hash(ReadOnlySpan<byte>.Empty));
+        Assert.Equal(0x44BC2CF5AD770999UL, XxHash64.Hash("abc"u8));
+
+        var data = new byte[256 * 3 + 5];
+        for (var i = 0; i < 256 * 3; i++) data[i] = (byte)i;
+        "tail!"u8.CopyTo(data.AsSpan(256 * 3));
+        Assert.Equal(0x26BBFF34E506DAFFUL, XxHash64.Hash(data));
+
+        // Payloads are hashed as UTF-16, without encoding them first
+        Assert.Equal(XxHash64.Hash("\x1bPq~\x1b\\"u8.ToArray().SelectMany(b => new byte[] { b, 0 }).ToArray()), SixelData.ComputeHash("\x1bPq~\x1b\\"));
+    }
+
+    [Fact]
+    public void Store_ConcurrentLookups_ShareOneObject()
+    {
+        var store = new TrackedObjectStore();
+        var links = new TrackedObject<HyperlinkData>[1000];
+
+        Parallel.For(0, links.Length, i => links[i] = store.GetOrCreateHyperlink("https://example.com", ""));
+
+        Assert.All(links, link => Assert.Same(links[0], link));
+        Assert.Equal(links.Length, links[0].RefCount);
+
+        Parallel.For(0, links.Length, i => links[i].Release());
+
+        Assert.Equal(0, store.HyperlinkCount);
+    }
+
+    [Fact]
+    public void Store_ObjectReferencedAgainBeforeReclaim_IsReused()
+    {
+        var store = new TrackedObjectStore();
+        var first = store.GetOrCreateHyperlink("https://example.com", "");
+
+        Assert.True(first.Release());
+        var second = store.GetOrCreateHyperlink("https://example.com", "");
+        store.Reclaim();
+
+        Assert.Same(first, second);
+        Assert.Equal(1, second.RefCount);
+        Assert.Equal(1, store.HyperlinkCount);
+    }
+
+    [Fact]
+    public void Release_MoreReferencesThanHeld_Throws()
+    {
+        var store = new TrackedObjectStore();
+        var link = store.GetOrCreateHyperlink("https://example.com", "");
+        link.AddRefs(2);
+
+        Assert.Throws<InvalidOperationException>(() => link.Release(4));
+        Assert.Equal(3, link.RefCount);
+        Assert.True(link.Release(3));
+    }
 }
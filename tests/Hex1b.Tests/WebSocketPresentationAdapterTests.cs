@@ -0,0 +1,203 @@
+using System.IO.Compression;
+using System.Net;
+using System.Net.Sockets;
+using System.Net.WebSockets;
+using System.Text;
+using Hex1b.Terminal;
+
+namespace Hex1b.Tests;
+
+public class WebSocketPresentationAdapterTests
+{
+    #region Negotiation Tests
+
+    [Fact]
+    public void NegotiateSubProtocol_PrefersDeflate()
+    {
+        Assert.Equal(
+            WebSocketPresentationOptions.BinaryDeflateSubProtocol,
+            WebSocketPresentationOptions.NegotiateSubProtocol(
+                [WebSocketPresentationOptions.BinarySubProtocol, WebSocketPresentationOptions.BinaryDeflateSubProtocol]));
+        Assert.Equal(
+            WebSocketPresentationOptions.BinarySubProtocol,
+            WebSocketPresentationOptions.NegotiateSubProtocol(["other", WebSocketPresentationOptions.BinarySubProtocol]));
+        Assert.Null(WebSocketPresentationOptions.NegotiateSubProtocol(["other"]));
+    }
+
+    [Fact]
+    public async Task Constructor_WithoutOptions_UsesAcceptedSubProtocol()
+    {
+        var (server, client) = await CreatePairAsync(WebSocketPresentationOptions.BinarySubProtocol);
+        await using var adapter = new WebSocketPresentationAdapter(server, 80, 24);
+        using var clientSocket = client;
+
+        Assert.True(adapter.UsesBinaryFraming);
+    }
+
+    #endregion
+
+    #region Binary Framing Tests
+
+    [Fact]
+    public async Task BinaryFraming_SendsOneSequencedMessagePerFlush()
+    {
+        var (server, client) = await CreatePairAsync(WebSocketPresentationOptions.BinarySubProtocol);
+        await using var adapter = new WebSocketPresentationAdapter(server, 80, 24);
+        using var clientSocket = client;
+
+        await adapter.WriteOutputAsync("\x1b[1;1H"u8.ToArray());
+        await adapter.WriteOutputAsync("Hello"u8.ToArray());
+        await adapter.FlushAsync();
+        await adapter.WriteOutputAsync("World"u8.ToArray());
+        await adapter.FlushAsync();
+
+        var first = await ReceiveAsync(client);
+        Assert.Equal(WebSocketMessageType.Binary, first.Type);
+        Assert.True(WebSocketFrame.TryReadOutputHeader(first.Data, out var firstSequence, out var firstCompressed));
+        Assert.Equal(0u, firstSequence);
+        Assert.False(firstCompressed);
+        Assert.Equal("\x1b[1;1HHello", Encoding.UTF8.GetString(first.Data.AsSpan(WebSocketFrame.OutputHeaderSize)));
+
+        var second = await ReceiveAsync(client);
+        Assert.True(WebSocketFrame.TryReadOutputHeader(second.Data, out var secondSequence, out _));
+        Assert.Equal(1u, secondSequence);
+        Assert.Equal("World", Encoding.UTF8.GetString(second.Data.AsSpan(WebSocketFrame.OutputHeaderSize)));
+    }
+
+    [Fact]
+    public async Task BinaryFraming_Deflate_CompressesFramesWithSharedContext()
+    {
+        var (server, client) = await CreatePairAsync(WebSocketPresentationOptions.BinaryDeflateSubProtocol);
+        await using var adapter = new WebSocketPresentationAdapter(server, 80, 24);
+        using var clientSocket = client;
+
+        var frame = Encoding.UTF8.GetBytes(string.Concat(Enumerable.Repeat("\x1b[38;2;255;255;255m  item  ", 50)));
+        await adapter.WriteOutputAsync(frame);
+        await adapter.FlushAsync();
+        await adapter.WriteOutputAsync(frame);
+        await adapter.FlushAsync();
+
+        var compressed = new MemoryStream();
+        for (var i = 0; i < 2; i++)
+        {
+            var message = await ReceiveAsync(client);
+            Assert.True(WebSocketFrame.TryReadOutputHeader(message.Data, out _, out var isCompressed));
+            Assert.True(isCompressed);
+            Assert.True(message.Data.Length < frame.Length);
+            compressed.Write(message.Data, WebSocketFrame.OutputHeaderSize, message.Data.Length - WebSocketFrame.OutputHeaderSize);
+        }
+
+        // A client inflates every message with one stream
+        compressed.Position = 0;
+        using var inflater = new DeflateStream(compressed, CompressionMode.Decompress);
+        var decoded = new byte[frame.Length * 2];
+        inflater.ReadExactly(decoded);
+        Assert.Equal([.. frame, .. frame], decoded);
+    }
+
+    [Fact]
+    public async Task BinaryFraming_ControlMessages_HandleResizeAndPing()
+    {
+        var (server, client) = await CreatePairAsync(WebSocketPresentationOptions.BinarySubProtocol);
+        await using var adapter = new WebSocketPresentationAdapter(server, 80, 24);
+        using var clientSocket = client;
+
+        (int Width, int Height)? resized = null;
+        adapter.Resized += (w, h) => resized = (w, h);
+
+        var resize = new byte[WebSocketFrame.HeaderSize + 4];
+        WebSocketFrame.WriteResize(resize, 120, 40);
+        await client.SendAsync(resize, WebSocketMessageType.Binary, true, CancellationToken.None);
+
+        byte[] ping = [WebSocketFrame.Ping, 0, 1, 2, 3];
+        await client.SendAsync(ping, WebSocketMessageType.Binary, true, CancellationToken.None);
+
+        byte[] input = [WebSocketFrame.Input, 0, (byte)'q'];
+        await client.SendAsync(input, WebSocketMessageType.Binary, true, CancellationToken.None);
+
+        // Control messages are consumed; only the input is returned
+        var read = await adapter.ReadInputAsync();
+        Assert.Equal("q", Encoding.UTF8.GetString(read.Span));
+        Assert.Equal((120, 40), resized);
+        Assert.Equal(120, adapter.Width);
+
+        var pong = await ReceiveAsync(client);
+        Assert.Equal([WebSocketFrame.Pong, 0, 1, 2, 3], pong.Data);
+    }
+
+    [Fact]
+    public async Task BinaryFraming_SendPing_RecordsRoundTripTime()
+    {
+        var (server, client) = await CreatePairAsync(WebSocketPresentationOptions.BinarySubProtocol);
+        await using var adapter = new WebSocketPresentationAdapter(server, 80, 24);
+        using var clientSocket = client;
+
+        await adapter.SendPingAsync();
+        var ping = await ReceiveAsync(client);
+        Assert.Equal(WebSocketFrame.Ping, ping.Data[0]);
+
+        ping.Data[0] = WebSocketFrame.Pong;
+        await client.SendAsync(ping.Data, WebSocketMessageType.Binary, true, CancellationToken.None);
+        await client.SendAsync(new byte[] { WebSocketFrame.Input, 0, (byte)'x' }, WebSocketMessageType.Binary, true, CancellationToken.None);
+        await adapter.ReadInputAsync();
+
+        Assert.NotNull(adapter.RoundTripTime);
+    }
+
+    #endregion
+
+    #region Text Protocol Tests
+
+    [Fact]
+    public async Task TextProtocol_HandlesResizeAndAssemblesFragmentedInput()
+    {
+        var (server, client) = await CreatePairAsync(null);
+        await using var adapter = new WebSocketPresentationAdapter(server, 80, 24);
+        using var clientSocket = client;
+
+        Assert.False(adapter.UsesBinaryFraming);
+
+        await client.SendAsync("{\"type\":\"resize\",\"cols\":100,\"rows\":30}"u8.ToArray(), WebSocketMessageType.Text, true, CancellationToken.None);
+        var large = new string('a', 10_000);
+        var bytes = Encoding.UTF8.GetBytes(large);
+        await client.SendAsync(bytes.AsMemory(0, 6000), WebSocketMessageType.Text, false, CancellationToken.None);
+        await client.SendAsync(bytes.AsMemory(6000), WebSocketMessageType.Text, true, CancellationToken.None);
+
+        var read = await adapter.ReadInputAsync();
+        Assert.Equal(large, Encoding.UTF8.GetString(read.Span));
+        Assert.Equal(100, adapter.Width);
+        Assert.Equal(30, adapter.Height);
+    }
+
+    #endregion
+
+    private static async Task<(WebSocket Server, WebSocket Client)> CreatePairAsync(string? subProtocol)
+    {
+        using var listener = new TcpListener(IPAddress.Loopback, 0);
+        listener.Start();
+        var clientSocket = new TcpClient();
+        var accept = listener.AcceptTcpClientAsync();
+        await clientSocket.ConnectAsync(IPAddress.Loopback, ((IPEndPoint)listener.LocalEndpoint).Port);
+        var serverSocket = await accept;
+
+        var server = WebSocket.CreateFromStream(serverSocket.GetStream(), isServer: true, subProtocol, Timeout.InfiniteTimeSpan);
+        var client = WebSocket.CreateFromStream(clientSocket.GetStream(), isServer: false, subProtocol, Timeout.InfiniteTimeSpan);
+        return (server, client);
+    }
+
+    private static async Task<(WebSocketMessageType Type, byte[] Data)> ReceiveAsync(WebSocket socket)
+    {
+        using var cts = new CancellationTokenSource(TimeSpan.FromSeconds(5));
+        var buffer = new byte[64 * 1024];
+        var count = 0;
+        while (true)
+        {
+            var result = await socket.ReceiveAsync(buffer.AsMemory(count), cts.Token);
+            count += result.Count;
+            if (result.EndOfMessage)
+            {
+                return (result.MessageType, buffer[..count]);
+            }
+        }
+    }
+}